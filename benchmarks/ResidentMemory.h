@@ -0,0 +1,84 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#ifndef KTUTORIAL_BENCHMARKS_RESIDENTMEMORY_H
+#define KTUTORIAL_BENCHMARKS_RESIDENTMEMORY_H
+
+#include <QFile>
+#include <QList>
+
+/**
+ * Returns the value, in bytes, of the given field of /proc/self/status.
+ * The field is expected to be given in kB, like VmRSS or VmHWM. If the field
+ * can not be read (for example, because it is not a Linux system), 0 is
+ * returned.
+ *
+ * @param fieldName The name of the field, including the trailing ':'.
+ * @return The value of the field, in bytes.
+ */
+inline qint64 processStatusValue(const QByteArray& fieldName) {
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+
+    foreach (const QByteArray& line, status.readAll().split('\n')) {
+        if (line.startsWith(fieldName)) {
+            QList<QByteArray> fields = line.simplified().split(' ');
+            if (fields.count() < 2) {
+                return 0;
+            }
+
+            return fields[1].toLongLong() * 1024;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Returns the resident memory of the current process, in bytes.
+ *
+ * @return The resident memory of the current process, in bytes.
+ */
+inline qint64 residentMemory() {
+    return processStatusValue("VmRSS:");
+}
+
+/**
+ * Returns the peak resident memory of the current process, in bytes.
+ * The peak can be reset with resetPeakResidentMemory().
+ *
+ * @return The peak resident memory of the current process, in bytes.
+ */
+inline qint64 peakResidentMemory() {
+    return processStatusValue("VmHWM:");
+}
+
+/**
+ * Resets the peak resident memory of the current process to the current
+ * resident memory.
+ * It needs Linux 4.0 or newer; in other systems, the peak is not reset.
+ */
+inline void resetPeakResidentMemory() {
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+}
+
+#endif
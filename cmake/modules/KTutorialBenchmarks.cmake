@@ -0,0 +1,46 @@
+# Macros to build and run the benchmarks of KTutorial library and editor.
+#
+# Benchmarks are built like unit tests (only if KDE4_BUILD_TESTS is enabled),
+# but they are not run by ctest, as their results are meant to be compared
+# between versions rather than checked.
+# Instead, "make ktutorial-benchmarks" builds and runs all the benchmarks (of
+# the library and of the editor, if they are built), and writes the results of
+# each one in QTestLib XML format to the benchmark-results directory of the
+# build tree.
+#
+# The helpers shared by the benchmarks, like ResidentMemory.h, are added to the
+# include directories.
+#
+# BENCHMARK_RESULTS(benchmarkName)
+#   Adds the target to run the given benchmark executable and write its results.
+#
+# BENCHMARKS(libraries className1 className2 ...)
+#   Builds and links against the given libraries a <className>Benchmark
+#   executable from <className>Benchmark.cpp for each class name, and adds the
+#   target to run it. Several libraries are given as a ';' separated list.
+
+get_filename_component(_ktutorialBenchmarksModuleDir ${CMAKE_CURRENT_LIST_FILE} PATH)
+include_directories(${_ktutorialBenchmarksModuleDir}/../../benchmarks)
+
+set(BENCHMARK_RESULTS_DIR ${CMAKE_BINARY_DIR}/benchmark-results)
+
+if (NOT TARGET ktutorial-benchmarks)
+    add_custom_target(ktutorial-benchmarks)
+endif (NOT TARGET ktutorial-benchmarks)
+
+MACRO(BENCHMARK_RESULTS _benchmarkName)
+    add_custom_target(${_benchmarkName}Results
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${BENCHMARK_RESULTS_DIR}
+        COMMAND ${_benchmarkName} -xml -o ${BENCHMARK_RESULTS_DIR}/${_benchmarkName}.xml
+        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+    add_dependencies(ktutorial-benchmarks ${_benchmarkName}Results)
+ENDMACRO(BENCHMARK_RESULTS)
+
+MACRO(BENCHMARKS _libraries)
+    FOREACH(_className ${ARGN})
+        set(_benchmarkName ${_className}Benchmark)
+        kde4_add_executable(${_benchmarkName} TEST ${_benchmarkName}.cpp)
+        target_link_libraries(${_benchmarkName} ${_libraries})
+        benchmark_results(${_benchmarkName})
+    ENDFOREACH(_className)
+ENDMACRO(BENCHMARKS)
@@ -21,12 +21,14 @@
 
 #include <KAction>
 #include <KActionCollection>
+#include <KConfigGroup>
+#include <KGlobal>
 #include <KLocalizedString>
-#include <KUndoStack>
 
 #include "KTutorialEditor.h"
 #include "commands/StepCommands.h"
 #include "commands/TutorialCommands.h"
+#include "commands/UndoStack.h"
 #include "data/Reaction.h"
 #include "data/Step.h"
 #include "view/DialogRunner.h"
@@ -46,10 +48,14 @@ EditActions::EditActions(KTutorialEditor* tutorialEditor):
     mCurrentStep(0),
     mCurrentReaction(0) {
 
-    mUndoStack = new KUndoStack(this);
+    mUndoStack = new UndoStack(this);
     connect(mUndoStack, SIGNAL(cleanChanged(bool)),
             this, SIGNAL(cleanChanged(bool)));
 
+    KConfigGroup undoGroup = KGlobal::config()->group("Undo");
+    mUndoStack->setMemoryBudget(
+                    undoGroup.readEntry("MemoryBudget", 32768) * 1024LL);
+
     setupActions();
 }
 
@@ -61,6 +67,10 @@ void EditActions::setClean() {
     mUndoStack->setClean();
 }
 
+qint64 EditActions::undoMemoryUsage() const {
+    return mUndoStack->memoryUsage();
+}
+
 //public slots:
 
 void EditActions::selectStep(Step* step) {
@@ -24,9 +24,9 @@
 
 class CommandWidget;
 class KTutorialEditor;
-class KUndoStack;
 class Reaction;
 class Step;
+class UndoStack;
 
 /**
  * Edition related actions.
@@ -39,6 +39,13 @@ class Step;
  * time it was saved) or not, and allows to clear the command stack (for
  * example, when a new file is opened) or set it as clean.
  *
+ * The memory used by the command stack is limited by a budget, set in the
+ * "MemoryBudget" entry (in KiB) of the "Undo" group of the configuration file.
+ * When the commands use more memory than the budget, the oldest commands are
+ * discarded. If the tutorial was clean before a discarded command, it is still
+ * marked as modified until it is saved, as it can not be reverted to its clean
+ * state any longer.
+ *
  * The KTutorialEditor window is also used as the parent for every dialog shown
  * by the actions.
  */
@@ -66,6 +73,14 @@ public:
      */
     void setClean();
 
+    /**
+     * Returns an estimation of the memory used by the commands in the stack,
+     * in bytes.
+     *
+     * @return The memory used by the commands in the stack.
+     */
+    qint64 undoMemoryUsage() const;
+
 public Q_SLOTS:
 
     /**
@@ -104,7 +119,7 @@ private:
     /**
      * The stack of undoable commands.
      */
-    KUndoStack* mUndoStack;
+    UndoStack* mUndoStack;
 
     /**
      * The currently selected step.
@@ -133,6 +148,7 @@ private:
 
 private Q_SLOTS:
 
+
     /**
      * Shows a TutorialInformationWidget for the tutorial.
      */
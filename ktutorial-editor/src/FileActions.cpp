@@ -254,9 +254,11 @@ void FileActions::exportTutorial() {
     }
 
     try {
-        Serialization(mTutorialEditor).exportTutorial(tutorial,
-                                                      dialog->currentFilter(),
-                                                      dialog->selectedUrl());
+        Serialization serialization(mTutorialEditor);
+        serialization.setJavaScriptExporter(
+                                        mTutorialEditor->javaScriptExporter());
+        serialization.exportTutorial(tutorial, dialog->currentFilter(),
+                                     dialog->selectedUrl());
     } catch (IOException e) {
         QString text = i18nc("@label", "There was a problem when trying to "
 "save the exported tutorial:<nl/>%1", e.message());
@@ -32,6 +32,7 @@
 #include "EditActions.h"
 #include "FileActions.h"
 #include "data/Tutorial.h"
+#include "serialization/JavaScriptExporter.h"
 #include "view/ActionListWidget.h"
 #include "view/AutoExpandableTreeView.h"
 #include "view/TreeModel.h"
@@ -46,7 +47,8 @@
 //public:
 
 KTutorialEditor::KTutorialEditor(): KXmlGuiWindow(0),
-    mTutorial(0) {
+    mTutorial(0),
+    mJavaScriptExporter(new JavaScriptExporter(this)) {
 
     mTreeView = new AutoExpandableTreeView();
     mTreeView->setObjectName("centralTreeView");
@@ -84,6 +86,10 @@ Tutorial* KTutorialEditor::tutorial() {
     return mTutorial;
 }
 
+JavaScriptExporter* KTutorialEditor::javaScriptExporter() {
+    return mJavaScriptExporter;
+}
+
 void KTutorialEditor::setClean() {
     mEditActions->setClean();
 
@@ -26,6 +26,7 @@ class KUrl;
 
 class EditActions;
 class FileActions;
+class JavaScriptExporter;
 class QTreeView;
 class Tutorial;
 
@@ -59,6 +60,15 @@ public:
      */
     Tutorial* tutorial();
 
+    /**
+     * Returns the JavaScriptExporter to export the tutorial being edited.
+     * The same exporter is used in every export, so the code of the steps not
+     * modified since the previous export does not need to be generated again.
+     *
+     * @return The JavaScriptExporter to export the tutorial being edited.
+     */
+    JavaScriptExporter* javaScriptExporter();
+
     /**
      * Sets the tutorial as clean (not modified after the last time it was
      * saved).
@@ -170,6 +180,11 @@ private:
      */
     Tutorial* mTutorial;
 
+    /**
+     * The JavaScriptExporter to export the tutorial being edited.
+     */
+    JavaScriptExporter* mJavaScriptExporter;
+
     /**
      * Sets up the dock widgets.
      */
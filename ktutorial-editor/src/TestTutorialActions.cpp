@@ -79,18 +79,33 @@ void TestTutorialActions::setupActions() {
     actionCollection->addAction("testTutorialFromCurrentStep", action);
     connect(action, SIGNAL(triggered(bool)),
             this, SLOT(testTutorialFromCurrentStep()));
+
+    action = new KAction(this);
+    action->setText(i18nc("@action", "Update current step in tested tutorial"));
+    action->setStatusTip(i18nc("@info:status", "Replaces the current step in "
+"the tutorial being tested in the target application without restarting it."));
+    action->setIcon(KIcon("view-refresh"));
+    action->setEnabled(false);
+    actionCollection->addAction("updateTestedTutorialStep", action);
+    connect(action, SIGNAL(triggered(bool)),
+            this, SLOT(updateTestedTutorialStep()));
 }
 
 //private slots:
 
 void TestTutorialActions::updateTestTutorialFromCurrentStepActionState() {
     KActionCollection* actionCollection = mTutorialEditor->actionCollection();
-    QAction* action = actionCollection->action("testTutorialFromCurrentStep");
+    QAction* testAction =
+                        actionCollection->action("testTutorialFromCurrentStep");
+    QAction* updateAction =
+                        actionCollection->action("updateTestedTutorialStep");
 
     if (mCurrentStep && !mCurrentStep->id().isEmpty()) {
-        action->setEnabled(true);
+        testAction->setEnabled(true);
+        updateAction->setEnabled(true);
     } else {
-        action->setEnabled(false);
+        testAction->setEnabled(false);
+        updateAction->setEnabled(false);
     }
 }
 
@@ -106,3 +121,10 @@ void TestTutorialActions::testTutorialFromCurrentStep() {
     tutorialTester->setStepToTestFrom(mCurrentStep->id());
     tutorialTester->testTutorial();
 }
+
+void TestTutorialActions::updateTestedTutorialStep() {
+    Q_ASSERT(mCurrentStep);
+
+    TutorialTester* tutorialTester = new TutorialTester(mTutorialEditor);
+    tutorialTester->updateStep(mCurrentStep);
+}
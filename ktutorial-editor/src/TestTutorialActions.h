@@ -27,7 +27,8 @@ class Step;
 /**
  * Test tutorial related actions.
  * TestTutorialActions provide the actions to test the current tutorial in the
- * target application (from the start or from the selected step).
+ * target application (from the start or from the selected step), and to update
+ * the selected step in the tutorial being tested without restarting it.
  *
  * KTutorialEditor notifies TestTutorialActions when a step is selected, so it
  * can know from which step test the tutorial.
@@ -74,8 +75,8 @@ private:
 private Q_SLOTS:
 
     /**
-     * Enables or disables the "test tutorial from current step" action based on
-     * the current step.
+     * Enables or disables the "test tutorial from current step" and "update
+     * current step in tested tutorial" actions based on the current step.
      */
     void updateTestTutorialFromCurrentStepActionState();
 
@@ -90,6 +91,12 @@ private Q_SLOTS:
      */
     void testTutorialFromCurrentStep();
 
+    /**
+     * Updates the current step in the tutorial being tested in the target
+     * application.
+     */
+    void updateTestedTutorialStep();
+
 };
 
 #endif
@@ -25,6 +25,8 @@
 #include <KUrl>
 
 #include "KTutorialEditor.h"
+#include "data/Step.h"
+#include "serialization/JavaScriptExporter.h"
 #include "serialization/Serialization.h"
 #include "targetapplication/RemoteEditorSupport.h"
 #include "targetapplication/TargetApplication.h"
@@ -58,6 +60,43 @@ void TutorialTester::testTutorial() {
     }
 }
 
+void TutorialTester::updateStep(Step* step) {
+    Q_ASSERT(step);
+
+    deleteLater();
+
+    RemoteEditorSupport* remoteEditorSupport =
+                            TargetApplication::self()->remoteEditorSupport();
+    QString caption = i18nc("@title:window", "Step could not be updated");
+    if (!remoteEditorSupport) {
+        QString text = i18nc("@label", "The target application is not "
+"running. Test the tutorial before updating its steps.");
+        KMessageBox::sorry(mTutorialEditor, text, caption);
+        return;
+    }
+
+    QString stepScript =
+                    mTutorialEditor->javaScriptExporter()->exportStep(step);
+
+    bool updated;
+    try {
+        updated = remoteEditorSupport->updateTestScriptedTutorialSteps(
+                                                QStringList() << step->id(),
+                                                QStringList() << stepScript);
+    } catch (DBusException e) {
+        QString text = i18nc("@label", "There was a problem when trying to "
+"tell the target application to update the step:<nl/>%1", e.message());
+        KMessageBox::error(mTutorialEditor, text, caption);
+        return;
+    }
+
+    if (!updated) {
+        QString text = i18nc("@label", "The step could not be updated in the "
+"tutorial being tested. Test the tutorial again to see the changes.");
+        KMessageBox::sorry(mTutorialEditor, text, caption);
+    }
+}
+
 //private slots:
 
 void TutorialTester::sendTutorialToTargetApplication() {
@@ -74,8 +113,11 @@ void TutorialTester::sendTutorialToTargetApplication() {
 
     const Tutorial* tutorial = mTutorialEditor->tutorial();
     try {
-        Serialization(mTutorialEditor).
-                    exportTutorial(tutorial, "*.js", temporaryFile->fileName());
+        Serialization serialization(mTutorialEditor);
+        serialization.setJavaScriptExporter(
+                                        mTutorialEditor->javaScriptExporter());
+        serialization.exportTutorial(tutorial, "*.js",
+                                     temporaryFile->fileName());
     } catch (IOException e) {
         QString text = i18nc("@label", "There was a problem when trying to "
 "save the tutorial to a temporary file (to be used by the target application "
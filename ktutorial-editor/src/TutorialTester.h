@@ -23,6 +23,7 @@
 #include <QObject>
 
 class KTutorialEditor;
+class Step;
 
 /**
  * Utility class to test a tutorial in the target application, starting it if
@@ -54,6 +55,20 @@ public:
      */
     void testTutorial();
 
+    /**
+     * Updates the given step in the tutorial being tested in the target
+     * application.
+     * The step is exported to JavaScript and sent to the target application,
+     * which replaces the old version of the step without restarting the
+     * tutorial. If the tutorial is not being tested (or the step could not be
+     * replaced), the user is told to test the tutorial again.
+     *
+     * The TutorialTester is deleted once the step was sent.
+     *
+     * @param step The step to update.
+     */
+    void updateStep(Step* step);
+
 private:
 
     /**
@@ -22,6 +22,7 @@
 
 #include <KLocalizedString>
 
+#include "TextChangeCommand.h"
 #include "../data/Reaction.h"
 #include "../data/WaitFor.h"
 
@@ -47,24 +48,28 @@ public:
 
 };
 
-class SetReactionOptionName: public QUndoCommand {
+class SetReactionOptionName: public TextChangeCommand {
 public:
 
     Reaction* mReaction;
-    QString mOldOptionName;
-    QString mNewOptionName;
 
-    SetReactionOptionName(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetReactionOptionName(QUndoCommand* parent = 0):
+            TextChangeCommand(ReactionOptionNameChange, parent) {
         setText(i18nc("@action", "Set reaction option name"));
     }
 
-    virtual void redo() {
-        mOldOptionName = mReaction->optionName();
-        mReaction->setOptionName(mNewOptionName);
+protected:
+
+    virtual const QObject* object() const {
+        return mReaction;
     }
 
-    virtual void undo() {
-        mReaction->setOptionName(mOldOptionName);
+    virtual QString value() const {
+        return mReaction->optionName();
+    }
+
+    virtual void setValue(const QString& value) {
+        mReaction->setOptionName(value);
     }
 
 };
@@ -125,46 +130,54 @@ public:
 
 };
 
-class SetReactionNextStepId: public QUndoCommand {
+class SetReactionNextStepId: public TextChangeCommand {
 public:
 
     Reaction* mReaction;
-    QString mOldNextStepId;
-    QString mNewNextStepId;
 
-    SetReactionNextStepId(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetReactionNextStepId(QUndoCommand* parent = 0):
+            TextChangeCommand(ReactionNextStepIdChange, parent) {
         setText(i18nc("@action", "Set reaction next step id"));
     }
 
-    virtual void redo() {
-        mOldNextStepId = mReaction->nextStepId();
-        mReaction->setNextStepId(mNewNextStepId);
+protected:
+
+    virtual const QObject* object() const {
+        return mReaction;
     }
 
-    virtual void undo() {
-        mReaction->setNextStepId(mOldNextStepId);
+    virtual QString value() const {
+        return mReaction->nextStepId();
+    }
+
+    virtual void setValue(const QString& value) {
+        mReaction->setNextStepId(value);
     }
 
 };
 
-class SetReactionCustomCode: public QUndoCommand {
+class SetReactionCustomCode: public TextChangeCommand {
 public:
 
     Reaction* mReaction;
-    QString mOldCustomCode;
-    QString mNewCustomCode;
 
-    SetReactionCustomCode(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetReactionCustomCode(QUndoCommand* parent = 0):
+            TextChangeCommand(ReactionCustomCodeChange, parent) {
         setText(i18nc("@action", "Set reaction custom code"));
     }
 
-    virtual void redo() {
-        mOldCustomCode = mReaction->customCode();
-        mReaction->setCustomCode(mNewCustomCode);
+protected:
+
+    virtual const QObject* object() const {
+        return mReaction;
     }
 
-    virtual void undo() {
-        mReaction->setCustomCode(mOldCustomCode);
+    virtual QString value() const {
+        return mReaction->customCode();
+    }
+
+    virtual void setValue(const QString& value) {
+        mReaction->setCustomCode(value);
     }
 
 };
@@ -188,7 +201,7 @@ QUndoCommand* ReactionCommands::setOptionName(const QString& optionName,
                                               QUndoCommand* parent) {
     SetReactionOptionName* command = new SetReactionOptionName(parent);
     command->mReaction = mReaction;
-    command->mNewOptionName = optionName;
+    command->setNewValue(optionName);
     return command;
 }
 
@@ -213,7 +226,7 @@ QUndoCommand* ReactionCommands::setNextStepId(const QString& nextStepId,
                                               QUndoCommand* parent) {
     SetReactionNextStepId* command = new SetReactionNextStepId(parent);
     command->mReaction = mReaction;
-    command->mNewNextStepId = nextStepId;
+    command->setNewValue(nextStepId);
     return command;
 }
 
@@ -221,6 +234,6 @@ QUndoCommand* ReactionCommands::setCustomCode(const QString& customCode,
                                               QUndoCommand* parent) {
     SetReactionCustomCode* command = new SetReactionCustomCode(parent);
     command->mReaction = mReaction;
-    command->mNewCustomCode = customCode;
+    command->setNewValue(customCode);
     return command;
 }
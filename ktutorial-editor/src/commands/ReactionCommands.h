@@ -35,6 +35,9 @@ class WaitFor;
  * Note that each method just creates and returns the command. It does not
  * execute it before returning.
  *
+ * The commands that set a text are TextChangeCommands, so consecutive commands
+ * that set the same text are merged when pushed to a QUndoStack.
+ *
  * @see QUndoCommand
  */
 class ReactionCommands {
@@ -22,93 +22,110 @@
 
 #include <KLocalizedString>
 
+#include "TextChangeCommand.h"
 #include "../data/Reaction.h"
 #include "../data/Step.h"
 
-class SetStepId: public QUndoCommand {
+class SetStepId: public TextChangeCommand {
 public:
 
     Step* mStep;
-    QString mOldId;
-    QString mNewId;
 
-    SetStepId(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetStepId(QUndoCommand* parent = 0):
+            TextChangeCommand(StepIdChange, parent) {
         setText(i18nc("@action", "Set step id"));
     }
 
-    virtual void redo() {
-        mOldId = mStep->id();
-        mStep->setId(mNewId);
+protected:
+
+    virtual const QObject* object() const {
+        return mStep;
     }
 
-    virtual void undo() {
-        mStep->setId(mOldId);
+    virtual QString value() const {
+        return mStep->id();
+    }
+
+    virtual void setValue(const QString& value) {
+        mStep->setId(value);
     }
 
 };
 
-class SetStepText: public QUndoCommand {
+class SetStepText: public TextChangeCommand {
 public:
 
     Step* mStep;
-    QString mOldText;
-    QString mNewText;
 
-    SetStepText(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetStepText(QUndoCommand* parent = 0):
+            TextChangeCommand(StepTextChange, parent) {
         setText(i18nc("@action", "Set step text"));
     }
 
-    virtual void redo() {
-        mOldText = mStep->text();
-        mStep->setText(mNewText);
+protected:
+
+    virtual const QObject* object() const {
+        return mStep;
     }
 
-    virtual void undo() {
-        mStep->setText(mOldText);
+    virtual QString value() const {
+        return mStep->text();
+    }
+
+    virtual void setValue(const QString& value) {
+        mStep->setText(value);
     }
 
 };
 
-class SetStepCustomSetupCode: public QUndoCommand {
+class SetStepCustomSetupCode: public TextChangeCommand {
 public:
 
     Step* mStep;
-    QString mOldCustomSetupCode;
-    QString mNewCustomSetupCode;
 
-    SetStepCustomSetupCode(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetStepCustomSetupCode(QUndoCommand* parent = 0):
+            TextChangeCommand(StepCustomSetupCodeChange, parent) {
         setText(i18nc("@action", "Set step setup code"));
     }
 
-    virtual void redo() {
-        mOldCustomSetupCode = mStep->customSetupCode();
-        mStep->setCustomSetupCode(mNewCustomSetupCode);
+protected:
+
+    virtual const QObject* object() const {
+        return mStep;
     }
 
-    virtual void undo() {
-        mStep->setCustomSetupCode(mOldCustomSetupCode);
+    virtual QString value() const {
+        return mStep->customSetupCode();
+    }
+
+    virtual void setValue(const QString& value) {
+        mStep->setCustomSetupCode(value);
     }
 
 };
 
-class SetStepCustomTearDownCode: public QUndoCommand {
+class SetStepCustomTearDownCode: public TextChangeCommand {
 public:
 
     Step* mStep;
-    QString mOldCustomTearDownCode;
-    QString mNewCustomTearDownCode;
 
-    SetStepCustomTearDownCode(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetStepCustomTearDownCode(QUndoCommand* parent = 0):
+            TextChangeCommand(StepCustomTearDownCodeChange, parent) {
         setText(i18nc("@action", "Set step tear down code"));
     }
 
-    virtual void redo() {
-        mOldCustomTearDownCode = mStep->customTearDownCode();
-        mStep->setCustomTearDownCode(mNewCustomTearDownCode);
+protected:
+
+    virtual const QObject* object() const {
+        return mStep;
     }
 
-    virtual void undo() {
-        mStep->setCustomTearDownCode(mOldCustomTearDownCode);
+    virtual QString value() const {
+        return mStep->customTearDownCode();
+    }
+
+    virtual void setValue(const QString& value) {
+        mStep->setCustomTearDownCode(value);
     }
 
 };
@@ -209,14 +226,14 @@ StepCommands::StepCommands(Step* step):
 QUndoCommand* StepCommands::setId(const QString& id, QUndoCommand* parent) {
     SetStepId* command = new SetStepId(parent);
     command->mStep = mStep;
-    command->mNewId = id;
+    command->setNewValue(id);
     return command;
 }
 
 QUndoCommand* StepCommands::setText(const QString& text, QUndoCommand* parent) {
     SetStepText* command = new SetStepText(parent);
     command->mStep = mStep;
-    command->mNewText = text;
+    command->setNewValue(text);
     return command;
 }
 
@@ -224,7 +241,7 @@ QUndoCommand* StepCommands::setCustomSetupCode(const QString& code,
                                                QUndoCommand* parent) {
     SetStepCustomSetupCode* command = new SetStepCustomSetupCode(parent);
     command->mStep = mStep;
-    command->mNewCustomSetupCode = code;
+    command->setNewValue(code);
     return command;
 }
 
@@ -232,7 +249,7 @@ QUndoCommand* StepCommands::setCustomTearDownCode(const QString& code,
                                                   QUndoCommand* parent) {
     SetStepCustomTearDownCode* command = new SetStepCustomTearDownCode(parent);
     command->mStep = mStep;
-    command->mNewCustomTearDownCode = code;
+    command->setNewValue(code);
     return command;
 }
 
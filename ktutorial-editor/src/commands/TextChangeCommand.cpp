@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include "TextChangeCommand.h"
+
+//public:
+
+int TextChangeCommand::memoryUsage(const QUndoCommand* command) {
+    int usage = sizeof(QUndoCommand) + command->text().size() * sizeof(QChar);
+
+    //Other commands, like those created when saving the changes of a
+    //CommandWidget, may return the id of a TextChangeCommand
+    const TextChangeCommand* textChangeCommand =
+                            dynamic_cast<const TextChangeCommand*>(command);
+    if (textChangeCommand) {
+        usage += sizeof(TextChangeCommand) - sizeof(QUndoCommand);
+        usage += (textChangeCommand->mNewValue.size() +
+                  textChangeCommand->mRemovedText.size() +
+                  textChangeCommand->mInsertedText.size()) * sizeof(QChar);
+    }
+
+    for (int i=0; i<command->childCount(); ++i) {
+        usage += memoryUsage(command->child(i));
+    }
+
+    return usage;
+}
+
+TextChangeCommand::TextChangeCommand(Id id, QUndoCommand* parent):
+        QUndoCommand(parent),
+    mId(id),
+    mExecuted(false),
+    mPosition(0) {
+}
+
+void TextChangeCommand::setNewValue(const QString& newValue) {
+    mNewValue = newValue;
+}
+
+int TextChangeCommand::id() const {
+    return mId;
+}
+
+bool TextChangeCommand::mergeWith(const QUndoCommand* other) {
+    //Commands created when saving the changes of a CommandWidget are wrapped
+    //in a parent command
+    if (other->childCount() == 1) {
+        other = other->child(0);
+    }
+
+    const TextChangeCommand* command =
+                                dynamic_cast<const TextChangeCommand*>(other);
+    if (!command || command->id() != id()) {
+        return false;
+    }
+
+    if (command->object() != object() || !mExecuted || !command->mExecuted) {
+        return false;
+    }
+
+    QString value = this->value();
+    storeChange(previousValue(command->previousValue(value)), value);
+
+    return true;
+}
+
+void TextChangeCommand::redo() {
+    if (!mExecuted) {
+        storeChange(value(), mNewValue);
+        setValue(mNewValue);
+        mNewValue.clear();
+        mExecuted = true;
+        return;
+    }
+
+    QString value = this->value();
+    value.replace(mPosition, mRemovedText.size(), mInsertedText);
+    setValue(value);
+}
+
+void TextChangeCommand::undo() {
+    setValue(previousValue(value()));
+}
+
+//private:
+
+void TextChangeCommand::storeChange(const QString& oldValue,
+                                    const QString& newValue) {
+    int maximumLength = qMin(oldValue.size(), newValue.size());
+
+    int prefixLength = 0;
+    while (prefixLength < maximumLength &&
+           oldValue[prefixLength] == newValue[prefixLength]) {
+        prefixLength++;
+    }
+
+    int suffixLength = 0;
+    while (suffixLength < maximumLength - prefixLength &&
+           oldValue[oldValue.size() - suffixLength - 1] ==
+                                newValue[newValue.size() - suffixLength - 1]) {
+        suffixLength++;
+    }
+
+    mPosition = prefixLength;
+    mRemovedText = oldValue.mid(prefixLength,
+                                oldValue.size() - prefixLength - suffixLength);
+    mInsertedText = newValue.mid(prefixLength,
+                                 newValue.size() - prefixLength - suffixLength);
+}
+
+QString TextChangeCommand::previousValue(const QString& value) const {
+    QString previousValue = value;
+    previousValue.replace(mPosition, mInsertedText.size(), mRemovedText);
+    return previousValue;
+}
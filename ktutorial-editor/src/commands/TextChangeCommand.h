@@ -0,0 +1,190 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef TEXTCHANGECOMMAND_H
+#define TEXTCHANGECOMMAND_H
+
+#include <QUndoCommand>
+
+/**
+ * Base class for the commands that set a text property of a data object.
+ * Subclasses just provide the edited object and the getter and setter of the
+ * property.
+ *
+ * To keep the undo stack small when long texts (like custom code) are edited,
+ * the command does not keep a full copy of the old and the new text. The new
+ * text is kept only until the command is executed for the first time; from
+ * then on, only the fragment of the text that changed is stored, and it is
+ * applied to the current value of the property when the command is undone or
+ * redone. Thus, the command must be undone and redone in the order set by the
+ * undo stack.
+ *
+ * Consecutive commands that set the same property of the same object are
+ * merged when pushed to a QUndoStack, so undoing them restores the text that
+ * was set before the first one. A command that is the only child of another
+ * command (like those created when saving the changes of a CommandWidget) can
+ * be merged with too.
+ */
+class TextChangeCommand: public QUndoCommand {
+public:
+
+    /**
+     * The id of each kind of TextChangeCommand.
+     * Commands are only merged with commands of the same kind.
+     */
+    enum Id {
+        StepIdChange = 1000,
+        StepTextChange,
+        StepCustomSetupCodeChange,
+        StepCustomTearDownCodeChange,
+        TutorialNameChange,
+        TutorialDescriptionChange,
+        TutorialLicenseTextChange,
+        TutorialCustomSetupCodeChange,
+        TutorialCustomTearDownCodeChange,
+        ReactionOptionNameChange,
+        ReactionNextStepIdChange,
+        ReactionCustomCodeChange
+    };
+
+    /**
+     * Returns an estimation of the memory used by the given command and its
+     * children, in bytes.
+     * The changes stored by TextChangeCommands are taken into account.
+     *
+     * @param command The command to get its memory usage.
+     * @return The memory used by the command, in bytes.
+     */
+    static int memoryUsage(const QUndoCommand* command);
+
+    /**
+     * Creates a new TextChangeCommand with the given id.
+     *
+     * @param id The id of the kind of command.
+     * @param parent The parent QUndoCommand.
+     */
+    explicit TextChangeCommand(Id id, QUndoCommand* parent = 0);
+
+    /**
+     * Sets the text to set in the property when the command is executed.
+     *
+     * @param newValue The new text of the property.
+     */
+    void setNewValue(const QString& newValue);
+
+    /**
+     * Returns the id of the kind of command.
+     *
+     * @return The id of the kind of command.
+     */
+    virtual int id() const;
+
+    /**
+     * Merges the given command with this one if both set the same property of
+     * the same object.
+     * The given command, or its only child, must have been executed already.
+     *
+     * @param other The command to merge.
+     * @return True if the command was merged, false otherwise.
+     */
+    virtual bool mergeWith(const QUndoCommand* other);
+
+    /**
+     * Sets the new text in the property.
+     */
+    virtual void redo();
+
+    /**
+     * Restores the previous text of the property.
+     */
+    virtual void undo();
+
+protected:
+
+    /**
+     * Returns the object that the property belongs to.
+     *
+     * @return The edited object.
+     */
+    virtual const QObject* object() const = 0;
+
+    /**
+     * Returns the current text of the property.
+     *
+     * @return The current text of the property.
+     */
+    virtual QString value() const = 0;
+
+    /**
+     * Sets the text of the property.
+     *
+     * @param value The text to set.
+     */
+    virtual void setValue(const QString& value) = 0;
+
+private:
+
+    /**
+     * The id of the kind of command.
+     */
+    Id mId;
+
+    /**
+     * The text to set, until the command is executed for the first time.
+     */
+    QString mNewValue;
+
+    /**
+     * Whether the command was executed or not.
+     */
+    bool mExecuted;
+
+    /**
+     * The position of the changed fragment in the text.
+     */
+    int mPosition;
+
+    /**
+     * The fragment of the previous text that was replaced.
+     */
+    QString mRemovedText;
+
+    /**
+     * The fragment of the new text that replaced the old one.
+     */
+    QString mInsertedText;
+
+    /**
+     * Stores the fragments that change between the old and the new text.
+     *
+     * @param oldValue The text before executing the command.
+     * @param newValue The text after executing the command.
+     */
+    void storeChange(const QString& oldValue, const QString& newValue);
+
+    /**
+     * Returns the text that there was before executing the command.
+     *
+     * @param value The text after executing the command.
+     * @return The text before executing the command.
+     */
+    QString previousValue(const QString& value) const;
+
+};
+
+#endif
@@ -22,116 +22,136 @@
 
 #include <KLocalizedString>
 
+#include "TextChangeCommand.h"
 #include "../data/Step.h"
 #include "../data/Tutorial.h"
 
-class SetTutorialName: public QUndoCommand {
+class SetTutorialName: public TextChangeCommand {
 public:
 
     Tutorial* mTutorial;
-    QString mOldName;
-    QString mNewName;
 
-    SetTutorialName(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetTutorialName(QUndoCommand* parent = 0):
+            TextChangeCommand(TutorialNameChange, parent) {
         setText(i18nc("@action", "Set tutorial name"));
     }
 
-    virtual void redo() {
-        mOldName = mTutorial->name();
-        mTutorial->setName(mNewName);
+protected:
+
+    virtual const QObject* object() const {
+        return mTutorial;
     }
 
-    virtual void undo() {
-        mTutorial->setName(mOldName);
+    virtual QString value() const {
+        return mTutorial->name();
+    }
+
+    virtual void setValue(const QString& value) {
+        mTutorial->setName(value);
     }
 
 };
 
-class SetTutorialDescription: public QUndoCommand {
+class SetTutorialDescription: public TextChangeCommand {
 public:
 
     Tutorial* mTutorial;
-    QString mOldDescription;
-    QString mNewDescription;
 
-    SetTutorialDescription(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetTutorialDescription(QUndoCommand* parent = 0):
+            TextChangeCommand(TutorialDescriptionChange, parent) {
         setText(i18nc("@action", "Set tutorial description"));
     }
 
-    virtual void redo() {
-        mOldDescription = mTutorial->description();
-        mTutorial->setDescription(mNewDescription);
+protected:
+
+    virtual const QObject* object() const {
+        return mTutorial;
     }
 
-    virtual void undo() {
-        mTutorial->setDescription(mOldDescription);
+    virtual QString value() const {
+        return mTutorial->description();
+    }
+
+    virtual void setValue(const QString& value) {
+        mTutorial->setDescription(value);
     }
 
 };
 
-class SetTutorialLicenseText: public QUndoCommand {
+class SetTutorialLicenseText: public TextChangeCommand {
 public:
 
     Tutorial* mTutorial;
-    QString mOldLicenseText;
-    QString mNewLicenseText;
 
-    SetTutorialLicenseText(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetTutorialLicenseText(QUndoCommand* parent = 0):
+            TextChangeCommand(TutorialLicenseTextChange, parent) {
         setText(i18nc("@action", "Set tutorial license"));
     }
 
-    virtual void redo() {
-        mOldLicenseText = mTutorial->licenseText();
-        mTutorial->setLicenseText(mNewLicenseText);
+protected:
+
+    virtual const QObject* object() const {
+        return mTutorial;
     }
 
-    virtual void undo() {
-        mTutorial->setLicenseText(mOldLicenseText);
+    virtual QString value() const {
+        return mTutorial->licenseText();
+    }
+
+    virtual void setValue(const QString& value) {
+        mTutorial->setLicenseText(value);
     }
 
 };
 
-class SetTutorialCustomSetupCode: public QUndoCommand {
+class SetTutorialCustomSetupCode: public TextChangeCommand {
 public:
 
     Tutorial* mTutorial;
-    QString mOldCustomSetupCode;
-    QString mNewCustomSetupCode;
 
-    SetTutorialCustomSetupCode(QUndoCommand* parent = 0): QUndoCommand(parent) {
+    SetTutorialCustomSetupCode(QUndoCommand* parent = 0):
+            TextChangeCommand(TutorialCustomSetupCodeChange, parent) {
         setText(i18nc("@action", "Set tutorial setup code"));
     }
 
-    virtual void redo() {
-        mOldCustomSetupCode = mTutorial->customSetupCode();
-        mTutorial->setCustomSetupCode(mNewCustomSetupCode);
+protected:
+
+    virtual const QObject* object() const {
+        return mTutorial;
     }
 
-    virtual void undo() {
-        mTutorial->setCustomSetupCode(mOldCustomSetupCode);
+    virtual QString value() const {
+        return mTutorial->customSetupCode();
+    }
+
+    virtual void setValue(const QString& value) {
+        mTutorial->setCustomSetupCode(value);
     }
 
 };
 
-class SetTutorialCustomTearDownCode: public QUndoCommand {
+class SetTutorialCustomTearDownCode: public TextChangeCommand {
 public:
 
     Tutorial* mTutorial;
-    QString mOldCustomTearDownCode;
-    QString mNewCustomTearDownCode;
 
     SetTutorialCustomTearDownCode(QUndoCommand* parent = 0):
-            QUndoCommand(parent) {
+            TextChangeCommand(TutorialCustomTearDownCodeChange, parent) {
         setText(i18nc("@action", "Set tutorial tear down code"));
     }
 
-    virtual void redo() {
-        mOldCustomTearDownCode = mTutorial->customTearDownCode();
-        mTutorial->setCustomTearDownCode(mNewCustomTearDownCode);
+protected:
+
+    virtual const QObject* object() const {
+        return mTutorial;
     }
 
-    virtual void undo() {
-        mTutorial->setCustomTearDownCode(mOldCustomTearDownCode);
+    virtual QString value() const {
+        return mTutorial->customTearDownCode();
+    }
+
+    virtual void setValue(const QString& value) {
+        mTutorial->setCustomTearDownCode(value);
     }
 
 };
@@ -233,7 +253,7 @@ QUndoCommand* TutorialCommands::setName(const QString& name,
                                         QUndoCommand* parent) {
     SetTutorialName* command = new SetTutorialName(parent);
     command->mTutorial = mTutorial;
-    command->mNewName = name;
+    command->setNewValue(name);
     return command;
 }
 
@@ -241,7 +261,7 @@ QUndoCommand* TutorialCommands::setDescription(const QString& description,
                                                QUndoCommand* parent) {
     SetTutorialDescription* command = new SetTutorialDescription(parent);
     command->mTutorial = mTutorial;
-    command->mNewDescription = description;
+    command->setNewValue(description);
     return command;
 }
 
@@ -249,7 +269,7 @@ QUndoCommand* TutorialCommands::setLicenseText(const QString& licenseText,
                                                QUndoCommand* parent) {
     SetTutorialLicenseText* command = new SetTutorialLicenseText(parent);
     command->mTutorial = mTutorial;
-    command->mNewLicenseText = licenseText;
+    command->setNewValue(licenseText);
     return command;
 }
 
@@ -258,7 +278,7 @@ QUndoCommand* TutorialCommands::setCustomSetupCode(const QString& code,
     SetTutorialCustomSetupCode* command =
                                         new SetTutorialCustomSetupCode(parent);
     command->mTutorial = mTutorial;
-    command->mNewCustomSetupCode = code;
+    command->setNewValue(code);
     return command;
 }
 
@@ -267,7 +287,7 @@ QUndoCommand* TutorialCommands::setCustomTearDownCode(const QString& code,
     SetTutorialCustomTearDownCode* command =
                                     new SetTutorialCustomTearDownCode(parent);
     command->mTutorial = mTutorial;
-    command->mNewCustomTearDownCode = code;
+    command->setNewValue(code);
     return command;
 }
 
@@ -0,0 +1,291 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include "UndoStack.h"
+
+#include <QUndoCommand>
+
+#include <KAction>
+#include <KActionCollection>
+#include <KLocalizedString>
+#include <KStandardAction>
+
+#include "TextChangeCommand.h"
+
+//public:
+
+UndoStack::UndoStack(QObject* parent /*= 0*/): QObject(parent),
+    mMemoryUsage(0),
+    mMemoryBudget(0),
+    mIndex(0),
+    mCleanIndex(0) {
+}
+
+UndoStack::~UndoStack() {
+    qDeleteAll(mCommands);
+}
+
+qint64 UndoStack::memoryBudget() const {
+    return mMemoryBudget;
+}
+
+void UndoStack::setMemoryBudget(qint64 memoryBudget) {
+    mMemoryBudget = memoryBudget;
+
+    bool wasClean = isClean();
+    bool couldUndo = canUndo();
+    bool couldRedo = canRedo();
+    int previousCount = mCommands.count();
+
+    discardOldestCommands();
+
+    if (mCommands.count() != previousCount) {
+        setIndex(mIndex, wasClean, couldUndo, couldRedo);
+    }
+}
+
+qint64 UndoStack::memoryUsage() const {
+    return mMemoryUsage;
+}
+
+int UndoStack::count() const {
+    return mCommands.count();
+}
+
+int UndoStack::index() const {
+    return mIndex;
+}
+
+const QUndoCommand* UndoStack::command(int index) const {
+    if (index < 0 || index >= mCommands.count()) {
+        return 0;
+    }
+
+    return mCommands[index];
+}
+
+bool UndoStack::canUndo() const {
+    return mIndex > 0;
+}
+
+bool UndoStack::canRedo() const {
+    return mIndex < mCommands.count();
+}
+
+QString UndoStack::undoText() const {
+    if (!canUndo()) {
+        return QString();
+    }
+
+    return mCommands[mIndex - 1]->text();
+}
+
+QString UndoStack::redoText() const {
+    if (!canRedo()) {
+        return QString();
+    }
+
+    return mCommands[mIndex]->text();
+}
+
+bool UndoStack::isClean() const {
+    return mIndex == mCleanIndex;
+}
+
+void UndoStack::push(QUndoCommand* command) {
+    bool wasClean = isClean();
+    bool couldUndo = canUndo();
+    bool couldRedo = canRedo();
+
+    command->redo();
+
+    while (mCommands.count() > mIndex) {
+        deleteCommand(mCommands.count() - 1);
+    }
+
+    if (mCleanIndex > mIndex) {
+        mCleanIndex = -1;
+    }
+
+    //Like in QUndoStack, the command in the clean state is not modified
+    QUndoCommand* top = mIndex > 0? mCommands[mIndex - 1]: 0;
+    if (top && top->id() != -1 && top->id() == command->id() &&
+            mIndex != mCleanIndex && top->mergeWith(command)) {
+        delete command;
+        updateMemoryUsage(mIndex - 1);
+    } else {
+        mCommands.append(command);
+        mMemoryUsages.append(0);
+        updateMemoryUsage(mIndex);
+        mIndex++;
+    }
+
+    discardOldestCommands();
+
+    setIndex(mIndex, wasClean, couldUndo, couldRedo);
+}
+
+KAction* UndoStack::createUndoAction(KActionCollection* actionCollection) {
+    mUndoAction = KStandardAction::undo(this, SLOT(undo()), actionCollection);
+    mUndoAction->setEnabled(canUndo());
+    connect(this, SIGNAL(canUndoChanged(bool)),
+            mUndoAction, SLOT(setEnabled(bool)));
+
+    updateActionTexts();
+
+    return mUndoAction;
+}
+
+KAction* UndoStack::createRedoAction(KActionCollection* actionCollection) {
+    mRedoAction = KStandardAction::redo(this, SLOT(redo()), actionCollection);
+    mRedoAction->setEnabled(canRedo());
+    connect(this, SIGNAL(canRedoChanged(bool)),
+            mRedoAction, SLOT(setEnabled(bool)));
+
+    updateActionTexts();
+
+    return mRedoAction;
+}
+
+//public slots:
+
+void UndoStack::undo() {
+    if (!canUndo()) {
+        return;
+    }
+
+    bool wasClean = isClean();
+    bool couldUndo = canUndo();
+    bool couldRedo = canRedo();
+
+    mCommands[mIndex - 1]->undo();
+    updateMemoryUsage(mIndex - 1);
+
+    setIndex(mIndex - 1, wasClean, couldUndo, couldRedo);
+}
+
+void UndoStack::redo() {
+    if (!canRedo()) {
+        return;
+    }
+
+    bool wasClean = isClean();
+    bool couldUndo = canUndo();
+    bool couldRedo = canRedo();
+
+    mCommands[mIndex]->redo();
+    updateMemoryUsage(mIndex);
+    mIndex++;
+
+    discardOldestCommands();
+
+    setIndex(mIndex, wasClean, couldUndo, couldRedo);
+}
+
+void UndoStack::clear() {
+    bool wasClean = isClean();
+    bool couldUndo = canUndo();
+    bool couldRedo = canRedo();
+
+    qDeleteAll(mCommands);
+    mCommands.clear();
+    mMemoryUsages.clear();
+    mMemoryUsage = 0;
+    mCleanIndex = 0;
+
+    setIndex(0, wasClean, couldUndo, couldRedo);
+}
+
+void UndoStack::setClean() {
+    bool wasClean = isClean();
+
+    mCleanIndex = mIndex;
+
+    if (!wasClean) {
+        emit cleanChanged(true);
+    }
+}
+
+//private:
+
+void UndoStack::updateMemoryUsage(int index) {
+    int memoryUsage = TextChangeCommand::memoryUsage(mCommands[index]);
+    mMemoryUsage += memoryUsage - mMemoryUsages[index];
+    mMemoryUsages[index] = memoryUsage;
+}
+
+void UndoStack::deleteCommand(int index) {
+    mMemoryUsage -= mMemoryUsages.takeAt(index);
+    delete mCommands.takeAt(index);
+}
+
+void UndoStack::discardOldestCommands() {
+    if (mMemoryBudget <= 0) {
+        return;
+    }
+
+    while (mMemoryUsage > mMemoryBudget && mIndex > 1) {
+        deleteCommand(0);
+        mIndex--;
+
+        //The state before the discarded command can not be reached again
+        if (mCleanIndex == 0) {
+            mCleanIndex = -1;
+        } else if (mCleanIndex > 0) {
+            mCleanIndex--;
+        }
+    }
+}
+
+void UndoStack::setIndex(int index, bool wasClean, bool couldUndo,
+                         bool couldRedo) {
+    mIndex = index;
+
+    emit indexChanged(mIndex);
+
+    if (isClean() != wasClean) {
+        emit cleanChanged(isClean());
+    }
+    if (canUndo() != couldUndo) {
+        emit canUndoChanged(canUndo());
+    }
+    if (canRedo() != couldRedo) {
+        emit canRedoChanged(canRedo());
+    }
+
+    updateActionTexts();
+}
+
+void UndoStack::updateActionTexts() {
+    if (mUndoAction) {
+        if (canUndo()) {
+            mUndoAction->setText(i18nc("@action Undo the given command",
+                                       "Undo: %1", undoText()));
+        } else {
+            mUndoAction->setText(i18nc("@action", "Undo"));
+        }
+    }
+
+    if (mRedoAction) {
+        if (canRedo()) {
+            mRedoAction->setText(i18nc("@action Redo the given command",
+                                       "Redo: %1", redoText()));
+        } else {
+            mRedoAction->setText(i18nc("@action", "Redo"));
+        }
+    }
+}
@@ -0,0 +1,318 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#ifndef UNDOSTACK_H
+#define UNDOSTACK_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+class KAction;
+class KActionCollection;
+class QUndoCommand;
+
+/**
+ * Stack of undoable commands with a memory budget.
+ * UndoStack works like QUndoStack (without macros): pushed commands are
+ * executed, consecutive commands with the same id are merged, and the clean
+ * state is kept track of. However, it also estimates the memory used by its
+ * commands (using TextChangeCommand::memoryUsage(const QUndoCommand*)) and,
+ * when the memory used exceeds the budget, the oldest commands are discarded
+ * until the budget is met again. At least the last executed command is always
+ * kept, so it can be undone.
+ *
+ * The memory used is a running total: the memory used by a command is
+ * estimated when it is pushed, merged, undone or redone (as the memory used by
+ * some commands changes after they are executed for the first time), and
+ * subtracted when the command is discarded. The whole stack is never traversed
+ * to know the memory used.
+ *
+ * QUndoStack can not remove single commands, so it can not be used to discard
+ * only the oldest commands.
+ *
+ * If a discarded command was the clean state of the stack, the stack can not
+ * become clean again until it is explicitly set as clean.
+ */
+class UndoStack: public QObject {
+Q_OBJECT
+public:
+
+    /**
+     * Creates a new empty UndoStack with no memory budget.
+     *
+     * @param parent The parent object.
+     */
+    explicit UndoStack(QObject* parent = 0);
+
+    /**
+     * Destroys this UndoStack.
+     * All the commands in the stack are deleted.
+     */
+    virtual ~UndoStack();
+
+    /**
+     * Returns the maximum memory, in bytes, that the commands can use.
+     *
+     * @return The memory budget, or 0 if there is no budget.
+     */
+    qint64 memoryBudget() const;
+
+    /**
+     * Sets the maximum memory, in bytes, that the commands can use.
+     * If the commands already use more memory than the new budget, the oldest
+     * ones are discarded.
+     *
+     * @param memoryBudget The memory budget, or 0 to set no budget.
+     */
+    void setMemoryBudget(qint64 memoryBudget);
+
+    /**
+     * Returns an estimation of the memory used by the commands in the stack,
+     * in bytes.
+     *
+     * @return The memory used by the commands in the stack.
+     */
+    qint64 memoryUsage() const;
+
+    /**
+     * Returns the number of commands in the stack.
+     *
+     * @return The number of commands in the stack.
+     */
+    int count() const;
+
+    /**
+     * Returns the index of the current command.
+     * This is the command that will be executed by the next call to redo(),
+     * and the command after the one that will be undone by the next call to
+     * undo().
+     *
+     * @return The index of the current command.
+     */
+    int index() const;
+
+    /**
+     * Returns the command at the given index.
+     *
+     * @param index The index of the command.
+     * @return The command, or a null pointer if the index is out of bounds.
+     */
+    const QUndoCommand* command(int index) const;
+
+    /**
+     * Returns whether there is a command to undo or not.
+     *
+     * @return True if there is a command to undo, false otherwise.
+     */
+    bool canUndo() const;
+
+    /**
+     * Returns whether there is a command to redo or not.
+     *
+     * @return True if there is a command to redo, false otherwise.
+     */
+    bool canRedo() const;
+
+    /**
+     * Returns the text of the command that will be undone next.
+     *
+     * @return The text of the command, or an empty string if there is none.
+     */
+    QString undoText() const;
+
+    /**
+     * Returns the text of the command that will be redone next.
+     *
+     * @return The text of the command, or an empty string if there is none.
+     */
+    QString redoText() const;
+
+    /**
+     * Returns whether the stack is in its clean state or not.
+     *
+     * @return True if the stack is clean, false otherwise.
+     */
+    bool isClean() const;
+
+    /**
+     * Executes the given command and pushes it on the top of the stack.
+     * The commands that could be redone are deleted. If the command can be
+     * merged with the one on the top of the stack, the command is merged and
+     * deleted instead of pushed. Then, if the memory budget is exceeded, the
+     * oldest commands are discarded.
+     * The stack takes ownership of the command.
+     *
+     * @param command The command to push.
+     */
+    void push(QUndoCommand* command);
+
+    /**
+     * Creates an undo action, and adds it to the given action collection.
+     * The action is enabled only when there is a command to undo, and its text
+     * shows the text of that command.
+     *
+     * @param actionCollection The action collection to add the action to.
+     * @return The created action.
+     */
+    KAction* createUndoAction(KActionCollection* actionCollection);
+
+    /**
+     * Creates a redo action, and adds it to the given action collection.
+     * The action is enabled only when there is a command to redo, and its text
+     * shows the text of that command.
+     *
+     * @param actionCollection The action collection to add the action to.
+     * @return The created action.
+     */
+    KAction* createRedoAction(KActionCollection* actionCollection);
+
+public Q_SLOTS:
+
+    /**
+     * Undoes the command below the current one.
+     */
+    void undo();
+
+    /**
+     * Redoes the current command.
+     */
+    void redo();
+
+    /**
+     * Deletes all the commands in the stack.
+     * The stack becomes clean.
+     */
+    void clear();
+
+    /**
+     * Marks the current state of the stack as clean.
+     */
+    void setClean();
+
+Q_SIGNALS:
+
+    /**
+     * Emitted when the index of the current command changes.
+     *
+     * @param index The new index.
+     */
+    void indexChanged(int index);
+
+    /**
+     * Emitted when the clean state changes.
+     *
+     * @param clean True if the stack is clean, false otherwise.
+     */
+    void cleanChanged(bool clean);
+
+    /**
+     * Emitted when the value of canUndo() changes.
+     *
+     * @param canUndo True if a command can be undone, false otherwise.
+     */
+    void canUndoChanged(bool canUndo);
+
+    /**
+     * Emitted when the value of canRedo() changes.
+     *
+     * @param canRedo True if a command can be redone, false otherwise.
+     */
+    void canRedoChanged(bool canRedo);
+
+private:
+
+    /**
+     * The commands in the stack, from the oldest to the newest.
+     */
+    QList<QUndoCommand*> mCommands;
+
+    /**
+     * The memory used by each command in mCommands.
+     */
+    QList<int> mMemoryUsages;
+
+    /**
+     * The memory used by all the commands.
+     */
+    qint64 mMemoryUsage;
+
+    /**
+     * The maximum memory that the commands can use, or 0 if there is no budget.
+     */
+    qint64 mMemoryBudget;
+
+    /**
+     * The index of the current command.
+     */
+    int mIndex;
+
+    /**
+     * The index of the clean state, or -1 if it can not be reached.
+     */
+    int mCleanIndex;
+
+    /**
+     * The undo action, if any.
+     */
+    QPointer<KAction> mUndoAction;
+
+    /**
+     * The redo action, if any.
+     */
+    QPointer<KAction> mRedoAction;
+
+    /**
+     * Estimates again the memory used by the command at the given index and
+     * updates the running total.
+     *
+     * @param index The index of the command.
+     */
+    void updateMemoryUsage(int index);
+
+    /**
+     * Removes and deletes the command at the given index.
+     * Neither the current index nor the clean index are modified.
+     *
+     * @param index The index of the command.
+     */
+    void deleteCommand(int index);
+
+    /**
+     * Discards the oldest commands while the memory budget is exceeded.
+     * The last executed command is never discarded.
+     */
+    void discardOldestCommands();
+
+    /**
+     * Sets the current index and emits the signals for the changed states.
+     *
+     * @param index The new index.
+     * @param wasClean Whether the stack was clean before changing it.
+     * @param couldUndo Whether a command could be undone before changing it.
+     * @param couldRedo Whether a command could be redone before changing it.
+     */
+    void setIndex(int index, bool wasClean, bool couldUndo, bool couldRedo);
+
+    /**
+     * Updates the text of the undo and redo actions.
+     */
+    void updateActionTexts();
+
+};
+
+#endif
@@ -40,6 +40,7 @@ void Reaction::setTriggerType(TriggerType triggerType) {
     mTriggerType = triggerType;
 
     emit dataChanged(this);
+    emit fieldChanged(this, TriggerTypeField);
 }
 
 QString Reaction::optionName() const {
@@ -50,6 +51,7 @@ void Reaction::setOptionName(const QString& optionName) {
     mOptionName = optionName;
 
     emit dataChanged(this);
+    emit fieldChanged(this, OptionNameField);
 }
 
 WaitFor* Reaction::waitFor() const {
@@ -60,6 +62,7 @@ void Reaction::setWaitFor(WaitFor* waitFor) {
     mWaitFor = waitFor;
 
     emit dataChanged(this);
+    emit fieldChanged(this, WaitForField);
 }
 
 Reaction::ResponseType Reaction::responseType() const {
@@ -70,6 +73,7 @@ void Reaction::setResponseType(ResponseType responseType) {
     mResponseType = responseType;
 
     emit dataChanged(this);
+    emit fieldChanged(this, ResponseTypeField);
 }
 
 QString Reaction::nextStepId() const {
@@ -80,6 +84,7 @@ void Reaction::setNextStepId(const QString& nextStepId) {
     mNextStepId = nextStepId;
 
     emit dataChanged(this);
+    emit fieldChanged(this, NextStepIdField);
 }
 
 QString Reaction::customCode() const {
@@ -90,4 +95,5 @@ void Reaction::setCustomCode(const QString& customCode) {
     mCustomCode = customCode;
 
     emit dataChanged(this);
+    emit fieldChanged(this, CustomCodeField);
 }
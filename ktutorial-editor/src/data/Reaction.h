@@ -33,7 +33,9 @@ class WaitFor;
  * The response can be changing to another step, or custom code for complexer
  * behavior.
  *
- * When any attribute is modified, dataChanged(Step*) signal is emitted.
+ * When any attribute is modified, dataChanged(Reaction*) signal is emitted,
+ * followed by fieldChanged(Reaction*, Reaction::Field) with the modified
+ * attribute.
  */
 class Reaction: public QObject {
 Q_OBJECT
@@ -49,6 +51,18 @@ public:
         CustomCode
     };
 
+    /**
+     * The attributes of a reaction, used to tell which one was modified.
+     */
+    enum Field {
+        TriggerTypeField,
+        OptionNameField,
+        WaitForField,
+        ResponseTypeField,
+        NextStepIdField,
+        CustomCodeField
+    };
+
     explicit Reaction(QObject* parent = 0);
     virtual ~Reaction();
 
@@ -88,6 +102,15 @@ Q_SIGNALS:
      */
     void dataChanged(Reaction* reaction);
 
+    /**
+     * Emitted when an attribute of the reaction changed, after
+     * dataChanged(Reaction*).
+     *
+     * @param reaction This reaction.
+     * @param field The attribute that changed.
+     */
+    void fieldChanged(Reaction* reaction, Reaction::Field field);
+
 private:
 
     TriggerType mTriggerType;
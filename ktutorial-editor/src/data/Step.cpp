@@ -36,6 +36,7 @@ void Step::setId(const QString& id) {
     mId = id;
 
     emit dataChanged(this);
+    emit fieldChanged(this, IdField);
 }
 
 QString Step::text() const {
@@ -46,6 +47,7 @@ void Step::setText(const QString& text) {
     mText = text;
 
     emit dataChanged(this);
+    emit fieldChanged(this, TextField);
 }
 
 QString Step::customSetupCode() const {
@@ -56,6 +58,7 @@ void Step::setCustomSetupCode(const QString& code) {
     mCustomSetupCode = code;
 
     emit dataChanged(this);
+    emit fieldChanged(this, CustomSetupCodeField);
 }
 
 QString Step::customTearDownCode() const {
@@ -66,6 +69,7 @@ void Step::setCustomTearDownCode(const QString& code) {
     mCustomTearDownCode = code;
 
     emit dataChanged(this);
+    emit fieldChanged(this, CustomTearDownCodeField);
 }
 
 void Step::addReaction(Reaction* reaction) {
@@ -29,14 +29,25 @@ class Reaction;
  * them (they don't even know each other). Its purpose is store the data needed to
  * generate the code to create a true KTutorial::Step.
  *
- * When any attribute is modified, dataChanged(Step*) signal is emitted. When
- * reactions are added or removed, reactionAdded(Reaction*, int) and
+ * When any attribute is modified, dataChanged(Step*) signal is emitted,
+ * followed by fieldChanged(Step*, Step::Field) with the modified attribute.
+ * When reactions are added or removed, reactionAdded(Reaction*, int) and
  * reactionRemoved(Reaction*) are emitted.
  */
 class Step: public QObject {
 Q_OBJECT
 public:
 
+    /**
+     * The attributes of a step, used to tell which one was modified.
+     */
+    enum Field {
+        IdField,
+        TextField,
+        CustomSetupCodeField,
+        CustomTearDownCodeField
+    };
+
     explicit Step(QObject* parent = 0);
 
     /**
@@ -94,6 +105,14 @@ Q_SIGNALS:
      */
     void dataChanged(Step* step);
 
+    /**
+     * Emitted when an attribute of the step changed, after dataChanged(Step*).
+     *
+     * @param step This step.
+     * @param field The attribute that changed.
+     */
+    void fieldChanged(Step* step, Step::Field field);
+
     /**
      * Emitted when the reaction is added to this Step.
      *
@@ -43,6 +43,7 @@ void Tutorial::setName(const QString& name) {
     mName = name;
 
     emit dataChanged(this);
+    emit fieldChanged(this, NameField);
 }
 
 QString Tutorial::description() const {
@@ -53,6 +54,7 @@ void Tutorial::setDescription(const QString& description) {
     mDescription = description;
 
     emit dataChanged(this);
+    emit fieldChanged(this, DescriptionField);
 }
 
 QString Tutorial::licenseText() const {
@@ -63,6 +65,7 @@ void Tutorial::setLicenseText(const QString& licenseText) {
     mLicenseText = licenseText;
 
     emit dataChanged(this);
+    emit fieldChanged(this, LicenseTextField);
 }
 
 QString Tutorial::customSetupCode() const {
@@ -73,6 +76,7 @@ void Tutorial::setCustomSetupCode(const QString& code) {
     mCustomSetupCode = code;
 
     emit dataChanged(this);
+    emit fieldChanged(this, CustomSetupCodeField);
 }
 
 QString Tutorial::customTearDownCode() const {
@@ -83,6 +87,7 @@ void Tutorial::setCustomTearDownCode(const QString& code) {
     mCustomTearDownCode = code;
 
     emit dataChanged(this);
+    emit fieldChanged(this, CustomTearDownCodeField);
 }
 
 void Tutorial::addStep(Step* step) {
@@ -30,7 +30,9 @@ class Step;
  * it (they don't even know each other). Its purpose is store the data needed to
  * generate the code to create a true KTutorial::Tutorial.
  *
- * When any attribute is modified, dataChanged(Tutorial*) signal is emitted.
+ * When any attribute is modified, dataChanged(Tutorial*) signal is emitted,
+ * followed by fieldChanged(Tutorial*, Tutorial::Field) with the modified
+ * attribute.
  * When steps are added or removed, stepAdded(Step*, int) and stepRemoved(Step*)
  * are emitted.
  */
@@ -38,6 +40,17 @@ class Tutorial: public QObject {
 Q_OBJECT
 public:
 
+    /**
+     * The attributes of a tutorial, used to tell which one was modified.
+     */
+    enum Field {
+        NameField,
+        DescriptionField,
+        LicenseTextField,
+        CustomSetupCodeField,
+        CustomTearDownCodeField
+    };
+
     explicit Tutorial(QObject* parent = 0);
 
     /**
@@ -106,6 +119,15 @@ Q_SIGNALS:
      */
     void dataChanged(Tutorial* tutorial);
 
+    /**
+     * Emitted when an attribute of the tutorial changed, after
+     * dataChanged(Tutorial*).
+     *
+     * @param tutorial This tutorial.
+     * @param field The attribute that changed.
+     */
+    void fieldChanged(Tutorial* tutorial, Tutorial::Field field);
+
     /**
      * Emitted when the step is added to the tutorial.
      *
@@ -37,7 +37,8 @@
 
 //public:
 
-JavaScriptExporter::JavaScriptExporter(): mIndentationLevel(0) {
+JavaScriptExporter::JavaScriptExporter(QObject* parent): QObject(parent),
+    mIndentationLevel(0) {
 }
 
 QString JavaScriptExporter::exportTutorial(const Tutorial* tutorial) {
@@ -45,21 +46,117 @@ QString JavaScriptExporter::exportTutorial(const Tutorial* tutorial) {
     mOut.setString(&code);
 
     writeLicense(tutorial);
-    out() << "t = Kross.module(\"kdetranslation\");\n\n";
+    writeTranslationModule();
     writeInformation(tutorial);
     writeSetup(tutorial);
     writeTearDown(tutorial);
 
+    mOut.setString(0);
+
     foreach (Step* step, tutorial->steps()) {
-        writeStep(step);
+        code += stepCode(step);
     }
 
-    mOut.setString(0);
     return code;
 }
 
+QString JavaScriptExporter::exportStep(Step* step) {
+    QString code;
+    mOut.setString(&code);
+
+    writeTranslationModule();
+
+    mOut.setString(0);
+
+    return code + stepCode(step);
+}
+
 //private:
 
+QString JavaScriptExporter::stepCode(Step* step) {
+    QHash<const Step*, QString>::const_iterator cachedCode =
+                                                    mStepCodes.constFind(step);
+    if (cachedCode != mStepCodes.constEnd()) {
+        return cachedCode.value();
+    }
+
+    QString code;
+    mOut.setString(&code);
+    writeStep(step);
+    mOut.setString(0);
+
+    mStepCodes.insert(step, code);
+    track(step);
+
+    return code;
+}
+
+void JavaScriptExporter::track(Step* step) {
+    registerObject(step, step);
+    connect(step, SIGNAL(dataChanged(Step*)),
+            this, SLOT(invalidateSenderStep()));
+    connect(step, SIGNAL(reactionAdded(Reaction*,int)),
+            this, SLOT(invalidateSenderStep()));
+    connect(step, SIGNAL(reactionRemoved(Reaction*)),
+            this, SLOT(invalidateSenderStep()));
+
+    foreach (Reaction* reaction, step->reactions()) {
+        registerObject(reaction, step);
+        //The WaitFor of the reaction is set through the reaction, so changing
+        //it emits dataChanged(Reaction*)
+        connect(reaction, SIGNAL(dataChanged(Reaction*)),
+                this, SLOT(invalidateSenderStep()));
+
+        if (reaction->waitFor()) {
+            track(reaction->waitFor(), step);
+        }
+    }
+}
+
+void JavaScriptExporter::track(WaitFor* waitFor, const Step* step) {
+    registerObject(waitFor, step);
+    connect(waitFor, SIGNAL(dataChanged(WaitFor*)),
+            this, SLOT(invalidateSenderStep()));
+
+    if (qobject_cast<WaitForComposed*>(waitFor)) {
+        WaitForComposed* waitForComposed =
+                                    static_cast<WaitForComposed*>(waitFor);
+        connect(waitForComposed, SIGNAL(waitForAdded(WaitFor*)),
+                this, SLOT(invalidateSenderStep()));
+        connect(waitForComposed, SIGNAL(waitForRemoved(WaitFor*)),
+                this, SLOT(invalidateSenderStep()));
+
+        foreach (WaitFor* childWaitFor, waitForComposed->waitFors()) {
+            track(childWaitFor, step);
+        }
+    }
+
+    //The negated WaitFor is set through the WaitForNot, so changing it emits
+    //dataChanged(WaitFor*)
+    if (qobject_cast<WaitForNot*>(waitFor)) {
+        WaitForNot* waitForNot = static_cast<WaitForNot*>(waitFor);
+        if (waitForNot->negatedWaitFor()) {
+            track(waitForNot->negatedWaitFor(), step);
+        }
+    }
+}
+
+void JavaScriptExporter::registerObject(QObject* object, const Step* step) {
+    mTrackedObjects.insert(object, step);
+    mTrackedObjectsOfStep[step].append(object);
+    connect(object, SIGNAL(destroyed(QObject*)),
+            this, SLOT(invalidateSenderStep()));
+}
+
+void JavaScriptExporter::invalidate(const Step* step) {
+    foreach (QObject* object, mTrackedObjectsOfStep.take(step)) {
+        disconnect(object, 0, this, 0);
+        mTrackedObjects.remove(object);
+    }
+
+    mStepCodes.remove(step);
+}
+
 void JavaScriptExporter::writeLicense(const Tutorial* tutorial) {
     if (tutorial->licenseText().isEmpty()) {
         return;
@@ -82,6 +179,10 @@ void JavaScriptExporter::writeLicense(const Tutorial* tutorial) {
     out() << " ****" << QString('*').repeated(maximumLineLength) << "****/\n\n";
 }
 
+void JavaScriptExporter::writeTranslationModule() {
+    out() << "t = Kross.module(\"kdetranslation\");\n\n";
+}
+
 void JavaScriptExporter::writeInformation(const Tutorial* tutorial) {
     if (tutorial->name().isEmpty()) {
         out() << "//Error: Tutorial without name!\n";
@@ -581,3 +682,15 @@ bool JavaScriptExporter::mightContainSemanticMarkup(const QString& text) const {
 
     return false;
 }
+
+//private slots:
+
+void JavaScriptExporter::invalidateSenderStep() {
+    QHash<QObject*, const Step*>::const_iterator step =
+                                        mTrackedObjects.constFind(sender());
+    if (step == mTrackedObjects.constEnd()) {
+        return;
+    }
+
+    invalidate(step.value());
+}
@@ -21,6 +21,7 @@
 #define JAVASCRIPTEXPORTER_H
 
 #include <QHash>
+#include <QObject>
 #include <QStringList>
 #include <QTextStream>
 
@@ -58,14 +59,24 @@ class WaitForWindow;
  *
  * If some necessary data is missing (for example, the id in a step), a comment
  * explaining the error is written instead of the code for that element.
+ *
+ * The code of each step does not depend on the rest of the tutorial, so it is
+ * cached once generated. When the step, any of its reactions or any of their
+ * WaitFors change the cached code is discarded, so it is generated again the
+ * next time that the tutorial is exported. Exporting several times the same
+ * tutorial with the same JavaScriptExporter only generates the code of the
+ * steps modified since the previous export.
  */
-class JavaScriptExporter {
+class JavaScriptExporter: public QObject {
+Q_OBJECT
 public:
 
     /**
      * Creates a new JavaScriptExporter.
+     *
+     * @param parent The parent QObject.
      */
-    JavaScriptExporter();
+    explicit JavaScriptExporter(QObject* parent = 0);
 
     /**
      * Exports the tutorial to JavaScript code.
@@ -75,8 +86,36 @@ public:
      */
     QString exportTutorial(const Tutorial* tutorial);
 
+    /**
+     * Exports the step to JavaScript code.
+     * The code creates the step and adds it to the tutorial, like the code of
+     * the step in the exported tutorial. However, unlike that code, it can be
+     * executed on its own, so it can be used to replace the step in a tutorial
+     * already running.
+     *
+     * @param step The step to export.
+     * @return The JavaScript code.
+     */
+    QString exportStep(Step* step);
+
 private:
 
+    /**
+     * The cached code of each step.
+     */
+    QHash<const Step*, QString> mStepCodes;
+
+    /**
+     * The step that each object (the step itself, its reactions and their
+     * WaitFors) with cached code belongs to.
+     */
+    QHash<QObject*, const Step*> mTrackedObjects;
+
+    /**
+     * The objects tracked for each step with cached code.
+     */
+    QHash<const Step*, QList<QObject*> > mTrackedObjectsOfStep;
+
     /**
      * The text stream to write the JavaScript code to.
      */
@@ -106,6 +145,11 @@ private:
      */
     void writeLicense(const Tutorial* tutorial);
 
+    /**
+     * Writes the code to load the translation module used in the texts.
+     */
+    void writeTranslationModule();
+
     /**
      * Writes the name and description code of a tutorial.
      * An error message is written if the name or the tutorial is missing.
@@ -130,6 +174,50 @@ private:
      */
     void writeTearDown(const Tutorial* tutorial);
 
+    /**
+     * Returns the full code of the given step.
+     * The cached code is returned if there is one. Otherwise, the code is
+     * written, cached and returned.
+     *
+     * @param step The step to get its code.
+     * @return The code of the step.
+     */
+    QString stepCode(Step* step);
+
+    /**
+     * Tracks the changes in the step, its reactions and their WaitFors to
+     * discard the cached code of the step when any of them changes.
+     *
+     * @param step The step to track.
+     */
+    void track(Step* step);
+
+    /**
+     * Tracks the changes in the given WaitFor and its child WaitFors, if any.
+     *
+     * @param waitFor The WaitFor to track.
+     * @param step The step that the WaitFor belongs to.
+     */
+    void track(WaitFor* waitFor, const Step* step);
+
+    /**
+     * Registers the given object as part of the given step.
+     * The step is invalidated when the object is destroyed. The signals emitted
+     * when the object changes must be connected to invalidateSenderStep() by
+     * the caller.
+     *
+     * @param object The object to register.
+     * @param step The step that the object belongs to.
+     */
+    void registerObject(QObject* object, const Step* step);
+
+    /**
+     * Discards the cached code of the given step and stops tracking it.
+     *
+     * @param step The step to invalidate.
+     */
+    void invalidate(const Step* step);
+
     /**
      * Writes the full code (step creation, setup, tear down and adding to the
      * tutorial) of a step.
@@ -360,6 +448,14 @@ private:
      */
     bool mightContainSemanticMarkup(const QString& text) const;
 
+private Q_SLOTS:
+
+    /**
+     * Discards the cached code of the step that the sender of the signal
+     * belongs to.
+     */
+    void invalidateSenderStep();
+
 };
 
 #endif
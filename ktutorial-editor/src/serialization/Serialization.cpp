@@ -18,7 +18,11 @@
 
 #include "Serialization.h"
 
+#include <QBuffer>
+#include <QFileInfo>
+
 #include <KLocalizedString>
+#include <KSaveFile>
 #include <KTemporaryFile>
 #include <KUrl>
 #include <KIO/NetAccess>
@@ -30,7 +34,13 @@
 //public:
 
 Serialization::Serialization(QWidget* window):
-    mWindow(window) {
+    mWindow(window),
+    mJavaScriptExporter(0) {
+}
+
+void Serialization::setJavaScriptExporter(
+                                    JavaScriptExporter* javaScriptExporter) {
+    mJavaScriptExporter = javaScriptExporter;
 }
 
 Tutorial* Serialization::loadTutorial(const KUrl& url)
@@ -42,22 +52,11 @@ throw (DeserializationException, IOException) {
                                 "is a folder", url.prettyUrl()));
     }
 
-    QString temporaryFileName;
-    if (!KIO::NetAccess::download(url, temporaryFileName, mWindow)) {
-        throw IOException(KIO::NetAccess::lastErrorString());
-    }
-
-    QFile temporaryFile(temporaryFileName);
-    temporaryFile.open(QIODevice::ReadOnly | QIODevice::Text);
-
-    QString data;
-    QTextStream in(&temporaryFile);
-    while (!in.atEnd()) {
-        data += in.readAll();
+    if (url.isLocalFile()) {
+        return loadLocalTutorial(url.toLocalFile());
     }
-    temporaryFile.close();
 
-    return TutorialReader().readTutorial(data);
+    return loadRemoteTutorial(url);
 }
 
 void Serialization::saveTutorial(const Tutorial* tutorial, const KUrl& url)
@@ -65,8 +64,12 @@ throw (IOException) {
     Q_ASSERT(tutorial);
     Q_ASSERT(url.isValid());
 
-    QString serializedTutorial = TutorialWriter().writeTutorial(tutorial);
-    writeFile(serializedTutorial, url);
+    if (url.isLocalFile()) {
+        saveLocalTutorial(tutorial, url.toLocalFile());
+        return;
+    }
+
+    saveRemoteTutorial(tutorial, url);
 }
 
 QString Serialization::availableExporterTypes() {
@@ -88,7 +91,9 @@ throw (IOException) {
     Q_ASSERT(url.isValid());
 
     QString exportedCode;
-    if (type == "*.js") {
+    if (type == "*.js" && mJavaScriptExporter) {
+        exportedCode = mJavaScriptExporter->exportTutorial(tutorial);
+    } else if (type == "*.js") {
         exportedCode = JavaScriptExporter().exportTutorial(tutorial);
     } else {
         Q_ASSERT(false);
@@ -106,7 +111,148 @@ QStringList Serialization::availableExporterTypeList() {
     return types;
 }
 
+void Serialization::checkLocalFileIsNotDirectory(const QString& fileName)
+throw (IOException) {
+    if (QFileInfo(fileName).isDir()) {
+        throw IOException(i18nc("@info/plain", "A file was expected, but '%1' "
+                                "is a folder", fileName));
+    }
+}
+
+void Serialization::checkLocalFileIsWritable(const QString& fileName)
+throw (IOException) {
+    checkLocalFileIsNotDirectory(fileName);
+
+    //KSaveFile writes to a temporary file that replaces the target file once
+    //finalized, so the permissions of an existing file must be checked
+    //explicitly
+    QFileInfo fileInfo(fileName);
+    if (fileInfo.exists() && !fileInfo.isWritable()) {
+        throw IOException(i18nc("@info/plain", "The file '%1' is not writable",
+                                fileName));
+    }
+}
+
+Tutorial* Serialization::loadLocalTutorial(const QString& fileName)
+throw (DeserializationException, IOException) {
+    checkLocalFileIsNotDirectory(fileName);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw IOException(file.errorString());
+    }
+
+    //If the file can be mapped in memory the reader gets its contents without
+    //copying them to any intermediate buffer. Otherwise (for example, if the
+    //file is empty), the file is read directly. In any case, the XML reader
+    //takes care of the encoding and the line endings
+    qint64 size = file.size();
+    uchar* data = size > 0? file.map(0, size): 0;
+    if (!data) {
+        return TutorialReader().readTutorial(&file);
+    }
+
+    QByteArray mappedData = QByteArray::fromRawData(
+                                        reinterpret_cast<const char*>(data),
+                                        size);
+    QBuffer buffer(&mappedData);
+    buffer.open(QIODevice::ReadOnly);
+
+    //The file is unmapped when it is closed, which happens when it is
+    //destroyed (even if an exception is thrown)
+    return TutorialReader().readTutorial(&buffer);
+}
+
+Tutorial* Serialization::loadRemoteTutorial(const KUrl& url)
+throw (DeserializationException, IOException) {
+    QString temporaryFileName;
+    if (!KIO::NetAccess::download(url, temporaryFileName, mWindow)) {
+        throw IOException(KIO::NetAccess::lastErrorString());
+    }
+
+    QFile temporaryFile(temporaryFileName);
+    if (!temporaryFile.open(QIODevice::ReadOnly)) {
+        throw IOException(temporaryFile.errorString());
+    }
+
+    //The XML reader takes care of the encoding and the line endings
+    return TutorialReader().readTutorial(&temporaryFile);
+}
+
+void Serialization::saveLocalTutorial(const Tutorial* tutorial,
+                                      const QString& fileName)
+throw (IOException) {
+    checkLocalFileIsWritable(fileName);
+
+    KSaveFile saveFile(fileName);
+    if (!saveFile.open()) {
+        throw IOException(saveFile.errorString());
+    }
+
+    if (!TutorialWriter().writeTutorial(tutorial, &saveFile)) {
+        QString errorString = saveFile.errorString();
+        saveFile.abort();
+        throw IOException(errorString);
+    }
+
+    if (!saveFile.finalize()) {
+        throw IOException(saveFile.errorString());
+    }
+}
+
+void Serialization::saveRemoteTutorial(const Tutorial* tutorial,
+                                       const KUrl& url) throw (IOException) {
+    KTemporaryFile temporaryFile;
+    if (!temporaryFile.open()) {
+        throw IOException(temporaryFile.errorString());
+    }
+
+    if (!TutorialWriter().writeTutorial(tutorial, &temporaryFile)) {
+        throw IOException(temporaryFile.errorString());
+    }
+    temporaryFile.close();
+
+    if (!KIO::NetAccess::upload(temporaryFile.fileName(), url, mWindow)) {
+        throw IOException(KIO::NetAccess::lastErrorString());
+    }
+}
+
 void Serialization::writeFile(const QString& data, const KUrl& url)
+throw (IOException) {
+    if (url.isLocalFile()) {
+        writeLocalFile(data, url.toLocalFile());
+        return;
+    }
+
+    writeRemoteFile(data, url);
+}
+
+void Serialization::writeLocalFile(const QString& data,
+                                   const QString& fileName)
+throw (IOException) {
+    checkLocalFileIsWritable(fileName);
+
+    KSaveFile saveFile(fileName);
+    if (!saveFile.open()) {
+        throw IOException(saveFile.errorString());
+    }
+
+    QTextStream out(&saveFile);
+    out << data;
+    out.flush();
+
+    if (out.status() != QTextStream::Ok) {
+        QString errorString = saveFile.errorString();
+        saveFile.abort();
+        throw IOException(errorString);
+    }
+
+    if (!saveFile.finalize()) {
+        throw IOException(saveFile.errorString());
+    }
+}
+
+void Serialization::writeRemoteFile(const QString& data, const KUrl& url)
 throw (IOException) {
     KTemporaryFile temporaryFile;
     temporaryFile.open();
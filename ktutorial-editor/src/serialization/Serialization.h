@@ -24,6 +24,7 @@
 #include "DeserializationException.h"
 #include "IOException.h"
 
+class JavaScriptExporter;
 class KUrl;
 class QWidget;
 class Tutorial;
@@ -48,6 +49,18 @@ public:
      */
     explicit Serialization(QWidget* window = 0);
 
+    /**
+     * Sets the JavaScriptExporter to use when exporting tutorials to
+     * JavaScript.
+     * JavaScriptExporter caches the code of the steps, so using the same
+     * exporter to export several times the same tutorial is faster than using
+     * a new exporter each time. If no exporter is set, a new one is used in
+     * each export.
+     *
+     * @param javaScriptExporter The JavaScriptExporter to use.
+     */
+    void setJavaScriptExporter(JavaScriptExporter* javaScriptExporter);
+
     /**
      * Loads a tutorial from the file specified by the given url.
      * The file must be a XML file that validates against the W3C Schema in
@@ -110,6 +123,11 @@ private:
 
     QWidget* mWindow;
 
+    /**
+     * The JavaScriptExporter to use, if any.
+     */
+    JavaScriptExporter* mJavaScriptExporter;
+
     /**
      * Returns a list of strings with the available exporter types.
      *
@@ -117,6 +135,85 @@ private:
      */
     QStringList availableExporterTypeList();
 
+    /**
+     * Throws an IOException if the local file with the given name is a
+     * directory.
+     *
+     * @param fileName The name of the local file to check.
+     * @throw IOException If the file is a directory.
+     */
+    void checkLocalFileIsNotDirectory(const QString& fileName)
+    throw (IOException);
+
+    /**
+     * Throws an IOException if the local file with the given name can not be
+     * written.
+     * A file that does not exist yet is considered writable; if it can not be
+     * created, the error will be detected when trying to create it.
+     *
+     * @param fileName The name of the local file to check.
+     * @throw IOException If the file is a directory or an existing file that
+     *        is not writable.
+     */
+    void checkLocalFileIsWritable(const QString& fileName) throw (IOException);
+
+    /**
+     * Loads a tutorial from the local file with the given name.
+     * The file is mapped in memory and read directly from there, without any
+     * temporary copy.
+     *
+     * @param fileName The name of the local file to load the tutorial from.
+     * @return The loaded tutorial.
+     * @throw DeserializationException If there was a problem deserializing the
+     *        tutorial.
+     * @throw IOException If there was a problem reading the contents from the
+     *        file.
+     */
+    Tutorial* loadLocalTutorial(const QString& fileName)
+    throw (DeserializationException, IOException);
+
+    /**
+     * Loads a tutorial from the file specified by the given url.
+     * The file is downloaded to a temporary file using KIO, so any url
+     * supported by KIO can be used.
+     *
+     * @param url The url to load the tutorial from.
+     * @return The loaded tutorial.
+     * @throw DeserializationException If there was a problem deserializing the
+     *        tutorial.
+     * @throw IOException If there was a problem reading the contents from the
+     *        file.
+     */
+    Tutorial* loadRemoteTutorial(const KUrl& url)
+    throw (DeserializationException, IOException);
+
+    /**
+     * Saves the tutorial to the local file with the given name.
+     * The tutorial is written directly to the file, without using a temporary
+     * copy of its serialization. The file is replaced atomically, so an
+     * existing file is kept unmodified if the tutorial can not be saved.
+     *
+     * @param tutorial The tutorial to save.
+     * @param fileName The name of the local file to save the tutorial to.
+     * @throw IOException If there was a problem writing the contents to the
+     *        file.
+     */
+    void saveLocalTutorial(const Tutorial* tutorial, const QString& fileName)
+    throw (IOException);
+
+    /**
+     * Saves the tutorial to the file specified by the given url.
+     * The tutorial is written to a temporary file that is uploaded using KIO,
+     * so any url supported by KIO can be used.
+     *
+     * @param tutorial The tutorial to save.
+     * @param url The url to save the tutorial to.
+     * @throw IOException If there was a problem writing the contents to the
+     *        file.
+     */
+    void saveRemoteTutorial(const Tutorial* tutorial, const KUrl& url)
+    throw (IOException);
+
     /**
      * Writes the data to the file specified by the given url.
      * The url can be local or remote.
@@ -128,6 +225,32 @@ private:
      */
     void writeFile(const QString& data, const KUrl& url) throw (IOException);
 
+    /**
+     * Writes the data to the local file with the given name.
+     * The file is replaced atomically, so an existing file is kept unmodified
+     * if the data can not be written.
+     *
+     * @param data The data to write to the file.
+     * @param fileName The name of the local file to save the data to.
+     * @throw IOException If there was a problem writing the contents to the
+     *        file.
+     */
+    void writeLocalFile(const QString& data, const QString& fileName)
+    throw (IOException);
+
+    /**
+     * Writes the data to the file specified by the given url.
+     * The data is written to a temporary file that is uploaded using KIO, so
+     * any url supported by KIO can be used.
+     *
+     * @param data The data to write to the file.
+     * @param url The url of the file to save the data to.
+     * @throw IOException If there was a problem writing the contents to the
+     *        file.
+     */
+    void writeRemoteFile(const QString& data, const KUrl& url)
+    throw (IOException);
+
 };
 
 #endif
@@ -19,7 +19,7 @@
 
 #include "TutorialReader.h"
 
-#include <QDomDocument>
+#include <QXmlStreamReader>
 
 #include <KLocalizedString>
 
@@ -36,262 +36,330 @@
 
 //public:
 
-TutorialReader::TutorialReader() {
+TutorialReader::TutorialReader(): mXmlReader(0) {
 }
 
 Tutorial* TutorialReader::readTutorial(const QString& data)
 throw (DeserializationException) {
-    QDomDocument document;
+    QXmlStreamReader xmlReader(data);
+    return readDocument(&xmlReader);
+}
 
-    QString errorMessage;
-    int errorLine;
-    int errorColumn;
+Tutorial* TutorialReader::readTutorial(QIODevice* device)
+throw (DeserializationException) {
+    Q_ASSERT(device);
 
-    if (!document.setContent(data, &errorMessage, &errorLine, &errorColumn)) {
-        throw DeserializationException(i18n("XML document is not well formed: "
-"%1, line %2, column %3", errorMessage, errorLine, errorColumn));
+    QXmlStreamReader xmlReader(device);
+    return readDocument(&xmlReader);
+}
+
+//private:
+
+Tutorial* TutorialReader::readDocument(QXmlStreamReader* xmlReader)
+throw (DeserializationException) {
+    mXmlReader = xmlReader;
+
+    Tutorial* tutorial = 0;
+    try {
+        tutorial = readDocument();
+    } catch (DeserializationException e) {
+        mXmlReader = 0;
+        throw;
+    }
+
+    mXmlReader = 0;
+
+    return tutorial;
+}
+
+Tutorial* TutorialReader::readDocument() throw (DeserializationException) {
+    if (!mXmlReader->readNextStartElement()) {
+        readToEnd();
     }
 
-    if (document.documentElement().tagName() != "tutorial") {
+    if (!isElement("tutorial")) {
+        QString rootName = mXmlReader->name().toString();
+        //A document that is not well formed takes precedence over an unknown
+        //root element
+        readToEnd();
+
         throw DeserializationException(i18n("Unknown root element, "
-"<emphasis>tutorial</emphasis> expected, got: %1",
-document.documentElement().tagName()));
+"<emphasis>tutorial</emphasis> expected, got: %1", rootName));
     }
 
-    return readTutorial(document.documentElement());
+    Tutorial* tutorial = readTutorial();
+
+    try {
+        readToEnd();
+    } catch (DeserializationException e) {
+        delete tutorial;
+        throw;
+    }
+
+    return tutorial;
 }
 
-//private:
+void TutorialReader::readToEnd() throw (DeserializationException) {
+    while (!mXmlReader->atEnd()) {
+        mXmlReader->readNext();
+    }
+
+    if (mXmlReader->hasError()) {
+        throw DeserializationException(i18n("XML document is not well formed: "
+"%1, line %2, column %3", mXmlReader->errorString(), mXmlReader->lineNumber(),
+mXmlReader->columnNumber()));
+    }
+}
 
-Tutorial* TutorialReader::readTutorial(const QDomElement& element) {
+Tutorial* TutorialReader::readTutorial() {
     Tutorial* tutorial = new Tutorial();
 
-    if (element.hasAttribute("name")) {
-        tutorial->setName(element.attribute("name"));
-    }
-
-    QDomElement childElement = element.firstChildElement();
-    while (!childElement.isNull()) {
-        if (childElement.tagName() == "description") {
-            tutorial->setDescription(childElement.text());
-        } else if (childElement.tagName() == "license") {
-            tutorial->setLicenseText(childElement.text());
-        } else if (childElement.tagName() == "setup") {
-            tutorial->setCustomSetupCode(childElement.text());
-        } else if (childElement.tagName() == "tearDown") {
-            tutorial->setCustomTearDownCode(childElement.text());
-        } else if (childElement.tagName() == "step") {
-            tutorial->addStep(readStep(childElement));
-        }
+    if (hasAttribute("name")) {
+        tutorial->setName(attribute("name"));
+    }
 
-        childElement = childElement.nextSiblingElement();
+    while (mXmlReader->readNextStartElement()) {
+        if (isElement("description")) {
+            tutorial->setDescription(readText());
+        } else if (isElement("license")) {
+            tutorial->setLicenseText(readText());
+        } else if (isElement("setup")) {
+            tutorial->setCustomSetupCode(readText());
+        } else if (isElement("tearDown")) {
+            tutorial->setCustomTearDownCode(readText());
+        } else if (isElement("step")) {
+            tutorial->addStep(readStep());
+        } else {
+            mXmlReader->skipCurrentElement();
+        }
     }
 
     return tutorial;
 }
 
-Step* TutorialReader::readStep(const QDomElement& element) {
+Step* TutorialReader::readStep() {
     Step* step = new Step;
 
-    if (element.hasAttribute("id")) {
-        step->setId(element.attribute("id"));
+    if (hasAttribute("id")) {
+        step->setId(attribute("id"));
     }
 
-    QDomElement childElement = element.firstChildElement();
-    while (!childElement.isNull()) {
-        if (childElement.tagName() == "text") {
-            step->setText(childElement.text());
-        } else if (childElement.tagName() == "setup") {
-            step->setCustomSetupCode(childElement.text());
-        } else if (childElement.tagName() == "tearDown") {
-            step->setCustomTearDownCode(childElement.text());
-        } else if (childElement.tagName() == "reaction") {
-            step->addReaction(readReaction(childElement));
+    while (mXmlReader->readNextStartElement()) {
+        if (isElement("text")) {
+            step->setText(readText());
+        } else if (isElement("setup")) {
+            step->setCustomSetupCode(readText());
+        } else if (isElement("tearDown")) {
+            step->setCustomTearDownCode(readText());
+        } else if (isElement("reaction")) {
+            step->addReaction(readReaction());
+        } else {
+            mXmlReader->skipCurrentElement();
         }
-
-        childElement = childElement.nextSiblingElement();
     }
 
     return step;
 }
 
-Reaction* TutorialReader::readReaction(const QDomElement& element) {
+Reaction* TutorialReader::readReaction() {
     Reaction* reaction = new Reaction();
 
-    if (element.hasAttribute("triggerType")) {
+    if (hasAttribute("triggerType")) {
         Reaction::TriggerType triggerType = Reaction::OptionSelected;
-        if (element.attribute("triggerType") == "ConditionMet") {
+        if (attribute("triggerType") == "ConditionMet") {
             triggerType = Reaction::ConditionMet;
         }
 
         reaction->setTriggerType(triggerType);
     }
 
-    if (element.hasAttribute("responseType")) {
+    if (hasAttribute("responseType")) {
         Reaction::ResponseType responseType = Reaction::NextStep;
-        if (element.attribute("responseType") == "CustomCode") {
+        if (attribute("responseType") == "CustomCode") {
             responseType = Reaction::CustomCode;
         }
 
         reaction->setResponseType(responseType);
     }
 
-    QDomElement childElement = element.firstChildElement();
-    while (!childElement.isNull()) {
-        if (childElement.tagName() == "option") {
-            if (childElement.hasAttribute("name")) {
-                reaction->setOptionName(childElement.attribute("name"));
+    while (mXmlReader->readNextStartElement()) {
+        if (isElement("option")) {
+            if (hasAttribute("name")) {
+                reaction->setOptionName(attribute("name"));
             }
-        } else if (isWaitForElement(childElement)) {
-            reaction->setWaitFor(readWaitFor(childElement));
-        } else if (childElement.tagName() == "customCode") {
-            reaction->setCustomCode(childElement.text());
-        } else if (childElement.tagName() == "nextStep") {
-            if (childElement.hasAttribute("id")) {
-                reaction->setNextStepId(childElement.attribute("id"));
+            mXmlReader->skipCurrentElement();
+        } else if (isWaitForElement()) {
+            reaction->setWaitFor(readWaitFor());
+        } else if (isElement("customCode")) {
+            reaction->setCustomCode(readText());
+        } else if (isElement("nextStep")) {
+            if (hasAttribute("id")) {
+                reaction->setNextStepId(attribute("id"));
             }
+            mXmlReader->skipCurrentElement();
+        } else {
+            mXmlReader->skipCurrentElement();
         }
-
-        childElement = childElement.nextSiblingElement();
     }
 
     return reaction;
 }
 
-WaitFor* TutorialReader::readWaitFor(const QDomElement& element) {
-    if (element.tagName() == "waitForComposed") {
-        return readWaitForComposed(element);
+WaitFor* TutorialReader::readWaitFor() {
+    if (isElement("waitForComposed")) {
+        return readWaitForComposed();
     }
-    if (element.tagName() == "waitForEvent") {
-        return readWaitForEvent(element);
+    if (isElement("waitForEvent")) {
+        return readWaitForEvent();
     }
-    if (element.tagName() == "waitForNot") {
-        return readWaitForNot(element);
+    if (isElement("waitForNot")) {
+        return readWaitForNot();
     }
-    if (element.tagName() == "waitForProperty") {
-        return readWaitForProperty(element);
+    if (isElement("waitForProperty")) {
+        return readWaitForProperty();
     }
-    if (element.tagName() == "waitForSignal") {
-        return readWaitForSignal(element);
+    if (isElement("waitForSignal")) {
+        return readWaitForSignal();
     }
-    if (element.tagName() == "waitForStepActivation") {
-        return readWaitForStepActivation(element);
+    if (isElement("waitForStepActivation")) {
+        return readWaitForStepActivation();
     }
-    if (element.tagName() == "waitForWindow") {
-        return readWaitForWindow(element);
+    if (isElement("waitForWindow")) {
+        return readWaitForWindow();
     }
 
     Q_ASSERT(false);
     return 0;
 }
 
-WaitFor* TutorialReader::readWaitForComposed(const QDomElement& element) {
+WaitFor* TutorialReader::readWaitForComposed() {
     WaitForComposed* waitForComposed = new WaitForComposed();
 
-    if (element.hasAttribute("compositionType")) {
+    if (hasAttribute("compositionType")) {
         WaitForComposed::CompositionType compositionType = WaitForComposed::And;
-        if (element.attribute("compositionType") == "Or") {
+        if (attribute("compositionType") == "Or") {
             compositionType = WaitForComposed::Or;
         }
 
         waitForComposed->setCompositionType(compositionType);
     }
 
-    QDomElement childElement = element.firstChildElement();
-    while (!childElement.isNull()) {
-        if (isWaitForElement(childElement)) {
-            waitForComposed->addWaitFor(readWaitFor(childElement));
+    while (mXmlReader->readNextStartElement()) {
+        if (isWaitForElement()) {
+            waitForComposed->addWaitFor(readWaitFor());
+        } else {
+            mXmlReader->skipCurrentElement();
         }
-
-        childElement = childElement.nextSiblingElement();
     }
 
     return waitForComposed;
 }
 
-WaitFor* TutorialReader::readWaitForEvent(const QDomElement& element) {
+WaitFor* TutorialReader::readWaitForEvent() {
     WaitForEvent* waitForEvent = new WaitForEvent();
 
-    if (element.hasAttribute("receiverName")) {
-        waitForEvent->setReceiverName(element.attribute("receiverName"));
+    if (hasAttribute("receiverName")) {
+        waitForEvent->setReceiverName(attribute("receiverName"));
     }
-    if (element.hasAttribute("eventName")) {
-        waitForEvent->setEventName(element.attribute("eventName"));
+    if (hasAttribute("eventName")) {
+        waitForEvent->setEventName(attribute("eventName"));
     }
 
+    mXmlReader->skipCurrentElement();
+
     return waitForEvent;
 }
 
-WaitFor* TutorialReader::readWaitForNot(const QDomElement& element) {
+WaitFor* TutorialReader::readWaitForNot() {
     WaitForNot* waitForNot = new WaitForNot();
 
-    QDomElement childElement = element.firstChildElement();
-    while (!childElement.isNull()) {
-        if (isWaitForElement(childElement)) {
+    while (mXmlReader->readNextStartElement()) {
+        if (isWaitForElement()) {
             delete waitForNot->negatedWaitFor();
-            waitForNot->setNegatedWaitFor(readWaitFor(childElement));
+            waitForNot->setNegatedWaitFor(readWaitFor());
+        } else {
+            mXmlReader->skipCurrentElement();
         }
-
-        childElement = childElement.nextSiblingElement();
     }
 
     return waitForNot;
 }
 
-WaitFor* TutorialReader::readWaitForProperty(const QDomElement& element) {
+WaitFor* TutorialReader::readWaitForProperty() {
     WaitForProperty* waitForProperty = new WaitForProperty();
 
-    if (element.hasAttribute("objectName")) {
-        waitForProperty->setObjectName(element.attribute("objectName"));
+    if (hasAttribute("objectName")) {
+        waitForProperty->setObjectName(attribute("objectName"));
     }
-    if (element.hasAttribute("propertyName")) {
-        waitForProperty->setPropertyName(element.attribute("propertyName"));
+    if (hasAttribute("propertyName")) {
+        waitForProperty->setPropertyName(attribute("propertyName"));
     }
-    if (element.hasAttribute("value")) {
-        waitForProperty->setValue(element.attribute("value"));
+    if (hasAttribute("value")) {
+        waitForProperty->setValue(attribute("value"));
     }
 
+    mXmlReader->skipCurrentElement();
+
     return waitForProperty;
 }
 
-WaitFor* TutorialReader::readWaitForSignal(const QDomElement& element) {
+WaitFor* TutorialReader::readWaitForSignal() {
     WaitForSignal* waitForSignal = new WaitForSignal();
 
-    if (element.hasAttribute("emitterName")) {
-        waitForSignal->setEmitterName(element.attribute("emitterName"));
+    if (hasAttribute("emitterName")) {
+        waitForSignal->setEmitterName(attribute("emitterName"));
     }
-    if (element.hasAttribute("signalName")) {
-        waitForSignal->setSignalName(element.attribute("signalName"));
+    if (hasAttribute("signalName")) {
+        waitForSignal->setSignalName(attribute("signalName"));
     }
 
+    mXmlReader->skipCurrentElement();
+
     return waitForSignal;
 }
 
-WaitFor* TutorialReader::readWaitForStepActivation(const QDomElement& element) {
-    Q_UNUSED(element);
+WaitFor* TutorialReader::readWaitForStepActivation() {
+    mXmlReader->skipCurrentElement();
 
     return new WaitForStepActivation();
 }
 
-WaitFor* TutorialReader::readWaitForWindow(const QDomElement& element) {
+WaitFor* TutorialReader::readWaitForWindow() {
     WaitForWindow* waitForWindow = new WaitForWindow();
 
-    if (element.hasAttribute("windowObjectName")) {
-        waitForWindow->setWindowObjectName(
-                                        element.attribute("windowObjectName"));
+    if (hasAttribute("windowObjectName")) {
+        waitForWindow->setWindowObjectName(attribute("windowObjectName"));
     }
 
+    mXmlReader->skipCurrentElement();
+
     return waitForWindow;
 }
 
-bool TutorialReader::isWaitForElement(const QDomElement& element) {
-    if (element.tagName() != "waitForComposed" &&
-            element.tagName() != "waitForEvent" &&
-            element.tagName() != "waitForNot" &&
-            element.tagName() != "waitForProperty" &&
-            element.tagName() != "waitForSignal" &&
-            element.tagName() != "waitForStepActivation" &&
-            element.tagName() != "waitForWindow") {
+QString TutorialReader::readText() {
+    return mXmlReader->readElementText(QXmlStreamReader::IncludeChildElements);
+}
+
+QString TutorialReader::attribute(const QString& name) const {
+    return mXmlReader->attributes().value(name).toString();
+}
+
+bool TutorialReader::hasAttribute(const QString& name) const {
+    return mXmlReader->attributes().hasAttribute(name);
+}
+
+bool TutorialReader::isElement(const char* name) const {
+    return mXmlReader->name() == QLatin1String(name);
+}
+
+bool TutorialReader::isWaitForElement() const {
+    if (!isElement("waitForComposed") &&
+            !isElement("waitForEvent") &&
+            !isElement("waitForNot") &&
+            !isElement("waitForProperty") &&
+            !isElement("waitForSignal") &&
+            !isElement("waitForStepActivation") &&
+            !isElement("waitForWindow")) {
         return false;
     }
 
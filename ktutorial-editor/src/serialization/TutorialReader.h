@@ -22,7 +22,9 @@
 
 #include "DeserializationException.h"
 
-class QDomElement;
+class QIODevice;
+class QXmlStreamReader;
+
 class Reaction;
 class Step;
 class Tutorial;
@@ -35,6 +37,9 @@ class WaitFor;
  * ignores unknown attributes and elements, and uses those known to create the
  * tutorial.
  *
+ * The XML data is read in a single pass as a stream, so no intermediate
+ * representation of the whole document is built; only the Tutorial is.
+ *
  * @see TutorialWriter
  */
 class TutorialReader {
@@ -63,104 +68,178 @@ public:
     Tutorial* readTutorial(const QString& data)
     throw (DeserializationException);
 
+    /**
+     * Returns the Tutorial stored in the XML serialization read from the given
+     * device.
+     * The device must be already open for reading. The encoding of the data is
+     * got from the XML declaration, or UTF-8 if there is none.
+     *
+     * Apart from that, it behaves like readTutorial(const QString&).
+     *
+     * @param device The device to read the XML serialization from.
+     * @return The Tutorial stored in the given XML serialization.
+     * @throw DeserializationException If there was a problem deserializing the
+     *        tutorial.
+     */
+    Tutorial* readTutorial(QIODevice* device)
+    throw (DeserializationException);
+
 private:
 
     /**
-     * Reads a new Tutorial from the "tutorial" XML element.
+     * The XML reader to use.
+     */
+    QXmlStreamReader* mXmlReader;
+
+    /**
+     * Reads the whole document from the given XML reader and returns its
+     * Tutorial.
+     *
+     * @param xmlReader The XML reader to read the document from.
+     * @return The Tutorial stored in the document.
+     * @throw DeserializationException If there was a problem deserializing the
+     *        tutorial.
+     */
+    Tutorial* readDocument(QXmlStreamReader* xmlReader)
+    throw (DeserializationException);
+
+    /**
+     * Reads the whole document from the XML reader and returns its Tutorial.
+     *
+     * @return The Tutorial stored in the document.
+     * @throw DeserializationException If there was a problem deserializing the
+     *        tutorial.
+     */
+    Tutorial* readDocument() throw (DeserializationException);
+
+    /**
+     * Reads the rest of the document to check that it is well formed.
+     *
+     * @throw DeserializationException If the document is not well formed.
+     */
+    void readToEnd() throw (DeserializationException);
+
+    /**
+     * Reads a new Tutorial from the current "tutorial" XML element.
      *
-     * @param element The element to read the Tutorial from.
      * @return The new Tutorial.
      */
-    Tutorial* readTutorial(const QDomElement& element);
+    Tutorial* readTutorial();
 
     /**
-     * Reads a new Step from the "step" XML element.
+     * Reads a new Step from the current "step" XML element.
      *
-     * @param element The element to read the Step from.
      * @return The new Step.
      */
-    Step* readStep(const QDomElement& element);
+    Step* readStep();
 
     /**
-     * Reads a new Reaction from the "reaction" XML element.
+     * Reads a new Reaction from the current "reaction" XML element.
      *
-     * @param element The element to read the Reaction from.
      * @return The new Reaction.
      */
-    Reaction* readReaction(const QDomElement& element);
+    Reaction* readReaction();
 
     /**
      * Returns a new WaitFor object from the appropriate subclass.
      *
-     * @param element The element to read the WaitFor from.
      * @return The new WaitFor.
      */
-    WaitFor* readWaitFor(const QDomElement& element);
+    WaitFor* readWaitFor();
 
     /**
-     * Reads a new WaitForComposed from the "waitForComposed" XML element.
+     * Reads a new WaitForComposed from the current "waitForComposed" XML
+     * element.
      *
-     * @param element The element to read the WaitForComposed from.
      * @return The new WaitForComposed.
      */
-    WaitFor* readWaitForComposed(const QDomElement& element);
+    WaitFor* readWaitForComposed();
 
     /**
-     * Reads a new WaitForEvent from the "waitForEvent" XML element.
+     * Reads a new WaitForEvent from the current "waitForEvent" XML element.
      *
-     * @param element The element to read the WaitForEvent from.
      * @return The new WaitForEvent.
      */
-    WaitFor* readWaitForEvent(const QDomElement& element);
+    WaitFor* readWaitForEvent();
 
     /**
-     * Reads a new WaitForNot from the "waitForNot" XML element.
+     * Reads a new WaitForNot from the current "waitForNot" XML element.
      *
-     * @param element The element to read the WaitForNot from.
      * @return The new WaitForNot.
      */
-    WaitFor* readWaitForNot(const QDomElement& element);
+    WaitFor* readWaitForNot();
 
     /**
-     * Reads a new WaitForProperty from the "waitForProperty" XML element.
+     * Reads a new WaitForProperty from the current "waitForProperty" XML
+     * element.
      *
-     * @param element The element to read the WaitForProperty from.
      * @return The new WaitForProperty.
      */
-    WaitFor* readWaitForProperty(const QDomElement& element);
+    WaitFor* readWaitForProperty();
 
     /**
-     * Reads a new WaitForSignal from the "waitForSignal" XML element.
+     * Reads a new WaitForSignal from the current "waitForSignal" XML element.
      *
-     * @param element The element to read the WaitForSignal from.
      * @return The new WaitForSignal.
      */
-    WaitFor* readWaitForSignal(const QDomElement& element);
+    WaitFor* readWaitForSignal();
 
     /**
-     * Reads a new WaitForStepActivation from the "waitForStepActivation" XML
-     * element.
+     * Reads a new WaitForStepActivation from the current
+     * "waitForStepActivation" XML element.
      *
-     * @param element The element to read the WaitForStepActivation from.
      * @return The new WaitForStepActivation.
      */
-    WaitFor* readWaitForStepActivation(const QDomElement& element);
+    WaitFor* readWaitForStepActivation();
 
     /**
-     * Reads a new WaitForWindow from the "waitForWindow" XML element.
+     * Reads a new WaitForWindow from the current "waitForWindow" XML element.
      *
-     * @param element The element to read the WaitForWindow from.
      * @return The new WaitForWindow.
      */
-    WaitFor* readWaitForWindow(const QDomElement& element);
+    WaitFor* readWaitForWindow();
+
+    /**
+     * Returns the text of the current element.
+     * The text of all the child elements is included too, and the reader is
+     * left at the end of the current element.
+     *
+     * @return The text of the current element.
+     */
+    QString readText();
+
+    /**
+     * Returns the value of the given attribute of the current element.
+     *
+     * @param name The name of the attribute.
+     * @return The value of the attribute.
+     */
+    QString attribute(const QString& name) const;
+
+    /**
+     * Returns whether the current element has the given attribute or not.
+     *
+     * @param name The name of the attribute.
+     * @return True if the current element has the attribute, false otherwise.
+     */
+    bool hasAttribute(const QString& name) const;
+
+    /**
+     * Returns whether the current element has the given name or not.
+     *
+     * @param name The name to check.
+     * @return True if the current element has the given name, false otherwise.
+     */
+    bool isElement(const char* name) const;
 
     /**
-     * Returns whether the given element is one of the WaitFor elements or not.
+     * Returns whether the current element is one of the WaitFor elements or
+     * not.
      *
-     * @param element The element to check.
-     * @return Whether the given element is one of the WaitFor elements or not.
+     * @return Whether the current element is one of the WaitFor elements or
+     *         not.
      */
-    bool isWaitForElement(const QDomElement& element);
+    bool isWaitForElement() const;
 
 };
 
@@ -19,6 +19,8 @@
 
 #include "TutorialWriter.h"
 
+#include <QFile>
+#include <QIODevice>
 #include <QXmlStreamWriter>
 
 #include "../data/Reaction.h"
@@ -32,19 +34,73 @@
 #include "../data/WaitForStepActivation.h"
 #include "../data/WaitForWindow.h"
 
+#define XML_DECLARATION "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+
 //public:
 
 TutorialWriter::TutorialWriter(): mXmlWriter(0) {
 }
 
 QString TutorialWriter::writeTutorial(const Tutorial* tutorial) {
-    QString serializedTutorial;
+    //QXmlStreamWriter doesn't write the encoding information when a string is
+    //used instead of a QIODevice, so the declaration is written directly. The
+    //writer appends to the string, and the new line is written by
+    //QXmlStreamWriter before the first element.
+    QString serializedTutorial = QLatin1String(XML_DECLARATION);
 
     mXmlWriter = new QXmlStreamWriter(&serializedTutorial);
     mXmlWriter->setAutoFormatting(true);
     mXmlWriter->setAutoFormattingIndent(4);
 
-    mXmlWriter->writeStartDocument();
+    write(tutorial);
+    mXmlWriter->writeEndDocument();
+
+    delete mXmlWriter;
+    mXmlWriter = 0;
+
+    return serializedTutorial;
+}
+
+bool TutorialWriter::writeTutorial(const Tutorial* tutorial,
+                                   QIODevice* device) {
+    Q_ASSERT(device);
+
+    //QXmlStreamWriter::hasError() is not available before Qt 4.8, so the write
+    //errors are checked in the device itself. Files keep their error state,
+    //and other devices set a new error string when a write fails.
+    QFile* file = qobject_cast<QFile*>(device);
+    if (file) {
+        file->unsetError();
+    }
+    QString previousErrorString = device->errorString();
+
+    //The declaration is written directly instead of using writeStartDocument()
+    //to get the same declaration as when writing to a string
+    if (device->write(XML_DECLARATION) == -1) {
+        return false;
+    }
+
+    mXmlWriter = new QXmlStreamWriter(device);
+    mXmlWriter->setCodec("UTF-8");
+    mXmlWriter->setAutoFormatting(true);
+    mXmlWriter->setAutoFormattingIndent(4);
+
+    write(tutorial);
+    mXmlWriter->writeEndDocument();
+
+    delete mXmlWriter;
+    mXmlWriter = 0;
+
+    if (file) {
+        return file->flush() && file->error() == QFile::NoError;
+    }
+
+    return device->errorString() == previousErrorString;
+}
+
+//private:
+
+void TutorialWriter::write(const Tutorial* tutorial) {
     mXmlWriter->writeStartElement("tutorial");
 
     if (!tutorial->name().isEmpty()) {
@@ -68,20 +124,8 @@ QString TutorialWriter::writeTutorial(const Tutorial* tutorial) {
     }
 
     mXmlWriter->writeEndElement();
-    mXmlWriter->writeEndDocument();
-
-    delete mXmlWriter;
-    mXmlWriter = 0;
-
-    //QXmlStreamWriter doesn't write the encoding information when a string is
-    //used instead of a QIODevice
-    serializedTutorial.replace("<?xml version=\"1.0\"?>\n",
-                               "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n");
-    return serializedTutorial;
 }
 
-//private:
-
 void TutorialWriter::write(const Step* step) {
     mXmlWriter->writeStartElement("step");
 
@@ -22,6 +22,7 @@
 
 #include <QString>
 
+class QIODevice;
 class QXmlStreamWriter;
 
 class Reaction;
@@ -69,6 +70,19 @@ public:
      */
     QString writeTutorial(const Tutorial* tutorial);
 
+    /**
+     * Writes the XML serialization of the given tutorial to the given device.
+     * The serialization is encoded in UTF-8 and written as it is generated, so
+     * the whole serialization is never kept in memory. The device must be
+     * already open for writing.
+     *
+     * @param tutorial The tutorial to get its XML serialization.
+     * @param device The device to write the XML serialization to.
+     * @return True if the serialization was written, false if there was an
+     *         error writing to the device.
+     */
+    bool writeTutorial(const Tutorial* tutorial, QIODevice* device);
+
 private:
 
     /**
@@ -76,6 +90,13 @@ private:
      */
     QXmlStreamWriter* mXmlWriter;
 
+    /**
+     * Writes the XML serialization of the given tutorial.
+     *
+     * @param tutorial The Tutorial to get its XML serialization.
+     */
+    void write(const Tutorial* tutorial);
+
     /**
      * Writes the XML serialization of the given step.
      *
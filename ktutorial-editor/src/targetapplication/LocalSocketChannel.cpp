@@ -0,0 +1,319 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include "LocalSocketChannel.h"
+
+#include <QDataStream>
+#include <QLocalSocket>
+#include <QTime>
+
+/**
+ * The milliseconds to wait for a reply before giving up.
+ * The calls block the event loop, and the server answers them right away
+ * unless the target application is busy, so the timeout is much shorter than
+ * the default timeout of D-Bus calls. When it expires, the connection is
+ * closed and the D-Bus interfaces are used instead.
+ */
+const int REPLY_TIMEOUT = 2000;
+
+//public:
+
+LocalSocketChannel::LocalSocketChannel(QObject* parent /*= 0*/):
+        QObject(parent),
+    mWaitingForReply(false) {
+    mSocket = new QLocalSocket(this);
+    connect(mSocket, SIGNAL(readyRead()), this, SLOT(handleReadyRead()));
+    connect(mSocket, SIGNAL(disconnected()), this, SIGNAL(disconnected()));
+}
+
+bool LocalSocketChannel::connectToServer(const QString& serverName,
+                                         const QString& token) {
+    mSocket->connectToServer(serverName);
+
+    if (!mSocket->waitForConnected(REPLY_TIMEOUT)) {
+        return false;
+    }
+
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)AuthenticateRequest << token;
+
+    bool authenticated = false;
+    try {
+        QDataStream reply(call(request));
+        reply.setVersion(QDataStream::Qt_4_6);
+        reply >> authenticated;
+    } catch (DBusException e) {
+    }
+
+    if (!authenticated) {
+        mSocket->abort();
+    }
+
+    return authenticated;
+}
+
+bool LocalSocketChannel::isConnected() const {
+    return mSocket->state() == QLocalSocket::ConnectedState;
+}
+
+QString LocalSocketChannel::objectName(int objectId) throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ObjectNameRequest << (qint32)objectId;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QString objectName;
+    reply >> objectName;
+
+    return objectName;
+}
+
+QString LocalSocketChannel::className(int objectId) throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ClassNameRequest << (qint32)objectId;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QString className;
+    reply >> className;
+
+    return className;
+}
+
+QList<int> LocalSocketChannel::childObjectIds(int objectId)
+                                                        throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ChildObjectIdsRequest << (qint32)objectId;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QList<qint32> childObjectIds;
+    reply >> childObjectIds;
+
+    QList<int> ids;
+    foreach (qint32 childObjectId, childObjectIds) {
+        ids.append(childObjectId);
+    }
+
+    return ids;
+}
+
+QString LocalSocketChannel::superClass(const QString& className)
+                                                        throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)SuperClassRequest << className;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QString superClass;
+    reply >> superClass;
+
+    return superClass;
+}
+
+QStringList LocalSocketChannel::propertyList(const QString& className)
+                                                        throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)PropertyListRequest << className;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QStringList propertyList;
+    reply >> propertyList;
+
+    return propertyList;
+}
+
+QStringList LocalSocketChannel::signalList(const QString& className)
+                                                        throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)SignalListRequest << className;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QStringList signalList;
+    reply >> signalList;
+
+    return signalList;
+}
+
+QVariantMap LocalSocketChannel::classHierarchy() throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ClassHierarchyRequest;
+
+    QDataStream reply(call(request));
+    reply.setVersion(QDataStream::Qt_4_6);
+    QVariantMap classHierarchy;
+    reply >> classHierarchy;
+
+    return classHierarchy;
+}
+
+void LocalSocketChannel::subscribeToEvents() throw (DBusException) {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)SubscribeToEventsRequest;
+
+    send(request);
+}
+
+//private:
+
+QByteArray LocalSocketChannel::call(const QByteArray& request)
+                                                        throw (DBusException) {
+    send(request);
+
+    //waitForReadyRead emits readyRead, so handleReadyRead must not consume the
+    //reply
+    mWaitingForReply = true;
+
+    QTime time;
+    time.start();
+
+    QByteArray message;
+    while (true) {
+        while (readMessage(message)) {
+            if (message.isEmpty()) {
+                continue;
+            }
+
+            if ((quint8)message[0] == ReplyMessage) {
+                mWaitingForReply = false;
+                return message.mid(1);
+            }
+
+            if ((quint8)message[0] == ErrorMessage) {
+                mWaitingForReply = false;
+
+                QDataStream error(message.mid(1));
+                error.setVersion(QDataStream::Qt_4_6);
+                QString errorMessage;
+                error >> errorMessage;
+                throw DBusException(errorMessage);
+            }
+
+            queueEvent(message);
+        }
+
+        int remainingTime = REPLY_TIMEOUT - time.elapsed();
+        if (remainingTime <= 0 || !mSocket->waitForReadyRead(remainingTime)) {
+            mWaitingForReply = false;
+
+            //A late reply would be taken as the reply to the next request
+            QString errorString = mSocket->errorString();
+            mSocket->abort();
+            throw DBusException("No reply received from the local socket: " +
+                                errorString);
+        }
+    }
+}
+
+void LocalSocketChannel::send(const QByteArray& request) throw (DBusException) {
+    if (!isConnected()) {
+        throw DBusException("The local socket is not connected");
+    }
+
+    QDataStream out(mSocket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << request;
+
+    mSocket->flush();
+}
+
+bool LocalSocketChannel::readMessage(QByteArray& message) {
+    if (mSocket->bytesAvailable() < (qint64)sizeof(quint32)) {
+        return false;
+    }
+
+    QByteArray sizeData = mSocket->peek(sizeof(quint32));
+    QDataStream sizeStream(sizeData);
+    quint32 size;
+    sizeStream >> size;
+
+    if (mSocket->bytesAvailable() < (qint64)(sizeof(quint32) + size)) {
+        return false;
+    }
+
+    QDataStream in(mSocket);
+    in.setVersion(QDataStream::Qt_4_6);
+    in >> message;
+
+    return true;
+}
+
+void LocalSocketChannel::queueEvent(const QByteArray& message) {
+    if (mPendingEvents.isEmpty()) {
+        QMetaObject::invokeMethod(this, "emitPendingEvents",
+                                  Qt::QueuedConnection);
+    }
+
+    mPendingEvents.append(message);
+}
+
+//private slots:
+
+void LocalSocketChannel::handleReadyRead() {
+    if (mWaitingForReply) {
+        return;
+    }
+
+    QByteArray message;
+    while (readMessage(message)) {
+        if (!message.isEmpty() && (quint8)message[0] != ReplyMessage &&
+                (quint8)message[0] != ErrorMessage) {
+            queueEvent(message);
+        }
+    }
+
+    emitPendingEvents();
+}
+
+void LocalSocketChannel::emitPendingEvents() {
+    while (!mPendingEvents.isEmpty()) {
+        QDataStream in(mPendingEvents.takeFirst());
+        in.setVersion(QDataStream::Qt_4_6);
+        quint8 messageType;
+        qint32 objectId;
+        in >> messageType >> objectId;
+
+        if (messageType == EventReceivedMessage) {
+            QString eventType;
+            in >> eventType;
+            emit eventReceived(objectId, eventType);
+        } else if (messageType == ObjectDestroyedMessage) {
+            emit objectDestroyed(objectId);
+        }
+    }
+}
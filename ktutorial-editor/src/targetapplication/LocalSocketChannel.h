@@ -0,0 +1,279 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef LOCALSOCKETCHANNEL_H
+#define LOCALSOCKETCHANNEL_H
+
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+#include "DBusException.h"
+
+class QLocalSocket;
+
+/**
+ * Client for the local socket server exposed by the KTutorial editor support
+ * module in the target application.
+ * The local socket server provides the same data as the
+ * "org.kde.ktutorial.ObjectRegister" and "org.kde.ktutorial.ClassRegister"
+ * interfaces and the same events as the "org.kde.ktutorial.EventSpy"
+ * interface, but using a compact binary protocol directly between both
+ * applications, which is much faster than going through the D-Bus daemon. The
+ * name of the server is discovered using D-Bus, though. The server only serves
+ * the clients that authenticate with the token that KTutorial editor gave to
+ * the target application when it was started.
+ *
+ * The calls are synchronous, like the D-Bus calls made by the remote proxies,
+ * but they time out much sooner. If no reply is received in time, the
+ * connection is closed, as any late reply would be mistaken for the reply to
+ * the next call; the remote proxies use D-Bus once the channel is no longer
+ * connected.
+ * The events notified by the server while waiting for a reply are queued and
+ * emitted once the control returns to the event loop, so the eventReceived
+ * signal is never emitted in the middle of a call.
+ *
+ * Like the D-Bus proxies, the methods throw a DBusException if something goes
+ * wrong (for example, if the target application was closed).
+ *
+ * @see RemoteEditorSupport::useLocalSocketChannel()
+ */
+class LocalSocketChannel: public QObject {
+Q_OBJECT
+public:
+
+    /**
+     * Creates a new LocalSocketChannel.
+     *
+     * @param parent The parent QObject.
+     */
+    explicit LocalSocketChannel(QObject* parent = 0);
+
+    /**
+     * Connects to the local socket server with the given name and
+     * authenticates with the given token.
+     * If the server does not accept the token, it closes the connection.
+     *
+     * @param serverName The full name of the local socket server.
+     * @param token The token to authenticate with.
+     * @return True if the connection was established and authenticated, false
+     *         otherwise.
+     */
+    bool connectToServer(const QString& serverName, const QString& token);
+
+    /**
+     * Returns whether this LocalSocketChannel is connected to the server or
+     * not.
+     *
+     * @return True if it is connected, false otherwise.
+     */
+    bool isConnected() const;
+
+    /**
+     * Returns the name of the remote object with the given id.
+     *
+     * @param objectId The id of the remote object.
+     * @return The name of the remote object.
+     * @throws DBusException If a communication error happened.
+     */
+    QString objectName(int objectId) throw (DBusException);
+
+    /**
+     * Returns the class name of the remote object with the given id.
+     *
+     * @param objectId The id of the remote object.
+     * @return The class name of the remote object.
+     * @throws DBusException If a communication error happened.
+     */
+    QString className(int objectId) throw (DBusException);
+
+    /**
+     * Returns the ids of the children of the remote object with the given id.
+     *
+     * @param objectId The id of the remote object.
+     * @return The ids of the children of the remote object.
+     * @throws DBusException If a communication error happened.
+     */
+    QList<int> childObjectIds(int objectId) throw (DBusException);
+
+    /**
+     * Returns the name of the super class of the remote class with the given
+     * name.
+     *
+     * @param className The name of the remote class.
+     * @return The name of the super class, or an empty string if there is none.
+     * @throws DBusException If a communication error happened.
+     */
+    QString superClass(const QString& className) throw (DBusException);
+
+    /**
+     * Returns the properties defined in the remote class with the given name.
+     *
+     * @param className The name of the remote class.
+     * @return The list of properties.
+     * @throws DBusException If a communication error happened.
+     */
+    QStringList propertyList(const QString& className) throw (DBusException);
+
+    /**
+     * Returns the signals defined in the remote class with the given name.
+     *
+     * @param className The name of the remote class.
+     * @return The list of signals.
+     * @throws DBusException If a communication error happened.
+     */
+    QStringList signalList(const QString& className) throw (DBusException);
+
+    /**
+     * Returns the super class, properties and signals of all the classes
+     * registered in the remote ClassRegister.
+     * The map has the same format as the one returned by the "classHierarchy"
+     * D-Bus method of the "org.kde.ktutorial.ClassRegister" interface.
+     *
+     * @return The information of all the registered classes.
+     * @throws DBusException If a communication error happened.
+     */
+    QVariantMap classHierarchy() throw (DBusException);
+
+    /**
+     * Requests the server to send the events received by the remote EventSpy.
+     * The events are only sent while the remote EventSpy is enabled.
+     *
+     * @throws DBusException If a communication error happened.
+     */
+    void subscribeToEvents() throw (DBusException);
+
+Q_SIGNALS:
+
+    /**
+     * Emitted when the remote EventSpy notifies that some object received an
+     * event.
+     *
+     * @param objectId The id of the remote object that received the event.
+     * @param eventType The type of the event received.
+     */
+    void eventReceived(int objectId, const QString& eventType);
+
+    /**
+     * Emitted when the remote EventSpy notifies that some registered object was
+     * destroyed.
+     *
+     * @param objectId The id of the destroyed remote object.
+     */
+    void objectDestroyed(int objectId);
+
+    /**
+     * Emitted when the connection to the server is closed, either by the
+     * server or because a call timed out.
+     */
+    void disconnected();
+
+private:
+
+    /**
+     * The requests that can be sent to the server.
+     * They must be kept in sync with the requests in the KTutorial library.
+     */
+    enum Request {
+        ObjectNameRequest = 1,
+        ClassNameRequest = 2,
+        ChildObjectIdsRequest = 3,
+        SuperClassRequest = 4,
+        PropertyListRequest = 5,
+        SignalListRequest = 6,
+        SubscribeToEventsRequest = 7,
+        AuthenticateRequest = 8,
+        ClassHierarchyRequest = 9
+    };
+
+    /**
+     * The messages that can be sent by the server.
+     * They must be kept in sync with the messages in the KTutorial library.
+     */
+    enum Message {
+        ReplyMessage = 1,
+        EventReceivedMessage = 2,
+        ObjectDestroyedMessage = 3,
+        ErrorMessage = 4
+    };
+
+    /**
+     * The socket connected to the server.
+     */
+    QLocalSocket* mSocket;
+
+    /**
+     * Whether a call is waiting for its reply or not.
+     */
+    bool mWaitingForReply;
+
+    /**
+     * The event messages received while waiting for a reply, not emitted yet.
+     */
+    QList<QByteArray> mPendingEvents;
+
+    /**
+     * Sends the given request and waits for its reply.
+     *
+     * @param request The request to send.
+     * @return The reply, without the message type.
+     * @throws DBusException If the reply could not be received, or if the
+     *         server answered with an error.
+     */
+    QByteArray call(const QByteArray& request) throw (DBusException);
+
+    /**
+     * Sends the given request without waiting for any reply.
+     *
+     * @param request The request to send.
+     * @throws DBusException If the request could not be sent.
+     */
+    void send(const QByteArray& request) throw (DBusException);
+
+    /**
+     * Reads the next complete message from the socket, if any.
+     *
+     * @param message The message read.
+     * @return True if a complete message was read, false otherwise.
+     */
+    bool readMessage(QByteArray& message);
+
+    /**
+     * Queues the event or object destruction notified in the given message.
+     * The pending events are emitted once the control returns to the event
+     * loop.
+     *
+     * @param message The event message.
+     */
+    void queueEvent(const QByteArray& message);
+
+private Q_SLOTS:
+
+    /**
+     * Handles the messages received while no call is waiting for a reply.
+     */
+    void handleReadyRead();
+
+    /**
+     * Emits the eventReceived or objectDestroyed signal for each pending event.
+     */
+    void emitPendingEvents();
+
+};
+
+#endif
@@ -21,17 +21,16 @@
 
 #include <QtDBus/QtDBus>
 
+#include "LocalSocketChannel.h"
 #include "RemoteObjectMapper.h"
 
 //public:
 
-RemoteClass::RemoteClass(const QString& service, RemoteObjectMapper* mapper,
-                         const QString& className):
-        QDBusAbstractInterface(service, "/ktutorial/ObjectRegister",
-                               "org.kde.ktutorial.ClassRegister",
-                               QDBusConnection::sessionBus(), 0),
+RemoteClass::RemoteClass(RemoteObjectMapper* mapper, const QString& className):
+        QObject(),
     mMapper(mapper),
-    mClassName(className) {
+    mClassName(className),
+    mDataCached(false) {
 }
 
 QString RemoteClass::className() const {
@@ -39,7 +38,30 @@ QString RemoteClass::className() const {
 }
 
 RemoteClass* RemoteClass::superClass() throw (DBusException) {
-    QDBusReply<QString> reply = call("superClass", mClassName);
+    if (fetchClassHierarchy()) {
+        if (mSuperClassName.isEmpty()) {
+            return 0;
+        }
+
+        return mMapper->remoteClass(mSuperClassName);
+    }
+
+    if (mMapper->localSocketChannel()) {
+        try {
+            QString superClassName =
+                        mMapper->localSocketChannel()->superClass(mClassName);
+            if (superClassName.isEmpty()) {
+                return 0;
+            }
+
+            return mMapper->remoteClass(superClassName);
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
+    QDBusReply<QString> reply =
+            mMapper->classRegisterInterface()->call("superClass", mClassName);
     if (!reply.isValid()) {
         throw DBusException(reply.error().message());
     }
@@ -52,7 +74,20 @@ RemoteClass* RemoteClass::superClass() throw (DBusException) {
 }
 
 QStringList RemoteClass::propertyList() throw (DBusException) {
-    QDBusReply<QStringList> reply = call("propertyList", mClassName);
+    if (fetchClassHierarchy()) {
+        return mPropertyList;
+    }
+
+    if (mMapper->localSocketChannel()) {
+        try {
+            return mMapper->localSocketChannel()->propertyList(mClassName);
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
+    QDBusReply<QStringList> reply =
+            mMapper->classRegisterInterface()->call("propertyList", mClassName);
     if (!reply.isValid()) {
         throw DBusException(reply.error().message());
     }
@@ -61,10 +96,45 @@ QStringList RemoteClass::propertyList() throw (DBusException) {
 }
 
 QStringList RemoteClass::signalList() throw (DBusException) {
-    QDBusReply<QStringList> reply = call("signalList", mClassName);
+    if (fetchClassHierarchy()) {
+        return mSignalList;
+    }
+
+    if (mMapper->localSocketChannel()) {
+        try {
+            return mMapper->localSocketChannel()->signalList(mClassName);
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
+    QDBusReply<QStringList> reply =
+            mMapper->classRegisterInterface()->call("signalList", mClassName);
     if (!reply.isValid()) {
         throw DBusException(reply.error().message());
     }
 
     return reply.value();
 }
+
+//private:
+
+bool RemoteClass::fetchClassHierarchy() {
+    if (mDataCached) {
+        return true;
+    }
+
+    QVariantMap classHierarchy = mMapper->classHierarchy(mClassName);
+    if (!classHierarchy.contains(mClassName)) {
+        return false;
+    }
+
+    QVariant classDataVariant = classHierarchy.value(mClassName);
+    QVariantMap classData = qdbus_cast<QVariantMap>(classDataVariant);
+    mSuperClassName = classData.value("superClass").toString();
+    mPropertyList = classData.value("propertyList").toStringList();
+    mSignalList = classData.value("signalList").toStringList();
+    mDataCached = true;
+
+    return true;
+}
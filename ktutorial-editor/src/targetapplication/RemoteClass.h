@@ -20,7 +20,8 @@
 #ifndef REMOTECLASS_H
 #define REMOTECLASS_H
 
-#include <QDBusAbstractInterface>
+#include <QObject>
+#include <QStringList>
 
 #include "DBusException.h"
 
@@ -35,27 +36,34 @@ class RemoteObjectMapper;
  * behind it.
  *
  * To get the data, RemoteClass makes DBus calls to the
- * "org.kde.ktutorial.ClassRegistry" interface in the DBus service specified in
- * the constructor.
+ * "org.kde.ktutorial.ClassRegistry" interface in the DBus service of its
+ * RemoteObjectMapper. Like RemoteObject, RemoteClass is just a lightweight
+ * handle that uses the DBus interface shared by all the RemoteClasses.
  *
  * Although the idea is let other objects use it like a local object, it has to
  * communicate with the remote ObjectRegistry through DBus anyway, so the
  * methods may throw a DBusException if something goes wrong.
+ *
+ * The data of a class does not change, so it is cached. The first time that
+ * the data is needed, it is got from the class hierarchy of the
+ * RemoteObjectMapper, which requests the whole class hierarchy registered in
+ * the remote ObjectRegistry just once for all the RemoteClasses. If the remote
+ * ObjectRegistry does not provide the class hierarchy, or the class was
+ * registered after it was requested, the data is requested for the class
+ * alone.
  */
-class RemoteClass: public QDBusAbstractInterface {
+class RemoteClass: public QObject {
 Q_OBJECT
 public:
 
     /**
      * Creates a new RemoteClass to represent the remote class with the given
-     * class name in the given DBus service name.
+     * class name in the DBus service of the given mapper.
      *
-     * @param service The DBus service name.
      * @param mapper The RemoteObjectMapper to get RemoteClasses from.
      * @param className The name of the remote class.
      */
-    RemoteClass(const QString& service, RemoteObjectMapper* mapper,
-                const QString& className);
+    RemoteClass(RemoteObjectMapper* mapper, const QString& className);
 
     /**
      * Returns the class name.
@@ -105,6 +113,33 @@ private:
      */
     QString mClassName;
 
+    /**
+     * Whether the data of the class is cached or not.
+     */
+    bool mDataCached;
+
+    /**
+     * The cached name of the super class.
+     */
+    QString mSuperClassName;
+
+    /**
+     * The cached properties.
+     */
+    QStringList mPropertyList;
+
+    /**
+     * The cached signals.
+     */
+    QStringList mSignalList;
+
+    /**
+     * Caches the data of this class from the class hierarchy of the mapper.
+     *
+     * @return True if the data of this class is cached, false otherwise.
+     */
+    bool fetchClassHierarchy();
+
 };
 
 #endif
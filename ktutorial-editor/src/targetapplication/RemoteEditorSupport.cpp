@@ -19,8 +19,11 @@
 
 #include "RemoteEditorSupport.h"
 
+#include <QDBusInterface>
 #include <QDBusReply>
+#include <QSharedMemory>
 
+#include "LocalSocketChannel.h"
 #include "RemoteEventSpy.h"
 #include "RemoteObject.h"
 #include "RemoteObjectMapper.h"
@@ -41,6 +44,35 @@ RemoteEditorSupport::~RemoteEditorSupport() {
     delete mRemoteEventSpy;
 }
 
+QString RemoteEditorSupport::localServerName() {
+    QDBusInterface properties(service(), path(),
+                              "org.freedesktop.DBus.Properties");
+    QDBusReply<QDBusVariant> reply = properties.call("Get", interface(),
+                                                     "localServerName");
+    if (!reply.isValid()) {
+        return "";
+    }
+
+    return reply.value().variant().toString();
+}
+
+bool RemoteEditorSupport::useLocalSocketChannel(const QString& token) {
+    QString serverName = localServerName();
+    if (serverName.isEmpty()) {
+        return false;
+    }
+
+    LocalSocketChannel* localSocketChannel = new LocalSocketChannel();
+    if (!localSocketChannel->connectToServer(serverName, token)) {
+        delete localSocketChannel;
+        return false;
+    }
+
+    mMapper->setLocalSocketChannel(localSocketChannel);
+
+    return true;
+}
+
 RemoteObject* RemoteEditorSupport::mainWindow() throw (DBusException) {
     QDBusReply<int> reply = call("mainWindowObjectId");
     if (!reply.isValid()) {
@@ -76,6 +108,43 @@ void RemoteEditorSupport::stopHighlighting(RemoteObject* remoteWidget)
     }
 }
 
+QImage RemoteEditorSupport::grabWidget(RemoteObject* remoteWidget,
+                                       const QSize& maxSize)
+                                                        throw (DBusException) {
+    QDBusReply<QVariantMap> reply = call("grabWidget",
+                                         remoteWidget->objectId(),
+                                         maxSize.width(), maxSize.height());
+    if (!reply.isValid()) {
+        throw DBusException(reply.error().message());
+    }
+
+    QString key = reply.value().value("key").toString();
+    int width = reply.value().value("width").toInt();
+    int height = reply.value().value("height").toInt();
+    if (key.isEmpty() || width <= 0 || height <= 0) {
+        return QImage();
+    }
+
+    QSharedMemory thumbnailMemory(key);
+    if (!thumbnailMemory.attach(QSharedMemory::ReadOnly)) {
+        return QImage();
+    }
+
+    if (thumbnailMemory.size() < width * height * 4) {
+        return QImage();
+    }
+
+    //The image does not own the data, so it is copied before detaching from
+    //the shared memory
+    thumbnailMemory.lock();
+    QImage thumbnail = QImage(
+                    static_cast<const uchar*>(thumbnailMemory.constData()),
+                    width, height, width * 4, QImage::Format_ARGB32).copy();
+    thumbnailMemory.unlock();
+
+    return thumbnail;
+}
+
 RemoteEventSpy* RemoteEditorSupport::enableEventSpy() throw (DBusException) {
     if (mRemoteEventSpy) {
         mNumberOfPendingEnableEventSpyCalls++;
@@ -125,3 +194,16 @@ void RemoteEditorSupport::testScriptedTutorial(const QString& filename,
         throw DBusException(reply.error().message());
     }
 }
+
+bool RemoteEditorSupport::updateTestScriptedTutorialSteps(
+                                            const QStringList& stepIds,
+                                            const QStringList& stepScripts)
+                                                        throw (DBusException) {
+    QDBusReply<bool> reply = call("updateTestScriptedTutorialSteps", stepIds,
+                                  stepScripts);
+    if (!reply.isValid()) {
+        throw DBusException(reply.error().message());
+    }
+
+    return reply.value();
+}
@@ -21,6 +21,8 @@
 #define REMOTEEDITORSUPPORT_H
 
 #include <QDBusAbstractInterface>
+#include <QImage>
+#include <QStringList>
 
 #include "DBusException.h"
 
@@ -61,6 +63,29 @@ public:
      */
     virtual ~RemoteEditorSupport();
 
+    /**
+     * Returns the name of the local socket server advertised by the remote
+     * EditorSupport.
+     * Old versions of the remote EditorSupport do not provide a local socket
+     * server; in that case, an empty string is returned.
+     *
+     * @return The full name of the local socket server, if any.
+     */
+    QString localServerName();
+
+    /**
+     * Connects to the local socket server of the remote EditorSupport and makes
+     * the RemoteObjects, RemoteClasses and RemoteEventSpies use it instead of
+     * DBus.
+     * The token is the one given to the target application when it was
+     * started. If there is no local socket server, it can not be connected to,
+     * or it does not accept the token, DBus is still used.
+     *
+     * @param token The token to authenticate with.
+     * @return True if the local socket is used, false otherwise.
+     */
+    bool useLocalSocketChannel(const QString& token);
+
     /**
      * Returns the RemoteObject that represents the main window of the
      * application.
@@ -97,6 +122,25 @@ public:
      */
     void stopHighlighting(RemoteObject* remoteWidget) throw (DBusException);
 
+    /**
+     * Returns a thumbnail of the widget represented by the given remote object.
+     * The thumbnail is scaled down to fit in the given maximum size, keeping
+     * its aspect ratio.
+     * The remote EditorSupport renders the thumbnail into a shared memory
+     * segment and only its key and the size of the thumbnail are sent through
+     * DBus; the image is read directly from the shared memory.
+     *
+     * If the object does not represent a widget, or the shared memory can not
+     * be read, a null image is returned.
+     *
+     * @param remoteWidget The RemoteObject for the widget to grab.
+     * @param maxSize The maximum size of the thumbnail.
+     * @return The thumbnail of the widget.
+     * @throws DBusException If a DBus error happens.
+     */
+    QImage grabWidget(RemoteObject* remoteWidget, const QSize& maxSize)
+                                                        throw (DBusException);
+
     /**
      * Enables the EventSpy in the remote EditorSupport and returns a proxy for
      * it.
@@ -137,6 +181,23 @@ public:
                               const QString& stepId = QString())
     throw (DBusException);
 
+    /**
+     * Replaces the steps of the scripted tutorial being tested in the target
+     * application.
+     * Each step is replaced by the step created by the script at the same
+     * position in the list of step scripts. Unlike testing again the tutorial,
+     * the tutorial is not started again, and the current step is kept unless it
+     * is one of the replaced steps.
+     *
+     * @param stepIds The ids of the steps to replace.
+     * @param stepScripts The scripts that create and add the new steps.
+     * @return True if all the steps were replaced, false if there is no tested
+     *         tutorial running or some step could not be replaced.
+     */
+    bool updateTestScriptedTutorialSteps(const QStringList& stepIds,
+                                         const QStringList& stepScripts)
+    throw (DBusException);
+
 private:
 
     /**
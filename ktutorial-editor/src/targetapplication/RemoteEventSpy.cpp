@@ -20,27 +20,75 @@
 
 #include <QDBusInterface>
 
+#include "LocalSocketChannel.h"
+#include "RemoteObject.h"
 #include "RemoteObjectMapper.h"
 
 //public:
 
 RemoteEventSpy::RemoteEventSpy(const QString& service,
                                RemoteObjectMapper* mapper): QObject(),
-    mMapper(mapper) {
+    mMapper(mapper),
+    mService(service) {
 
+    LocalSocketChannel* localSocketChannel = mapper->localSocketChannel();
+    if (localSocketChannel) {
+        try {
+            localSocketChannel->subscribeToEvents();
+            connect(localSocketChannel, SIGNAL(eventReceived(int,QString)),
+                    this, SLOT(handleEventReceived(int,QString)));
+            connect(localSocketChannel, SIGNAL(objectDestroyed(int)),
+                    this, SLOT(handleObjectDestroyed(int)));
+            connect(localSocketChannel, SIGNAL(disconnected()),
+                    this, SLOT(handleLocalSocketChannelDisconnected()));
+            return;
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
+    connectToDBus();
+}
+
+//private:
+
+void RemoteEventSpy::connectToDBus() {
     //RemoteEventSpy class can not inherit from QDBusInterface as that breaks
     //the "magic" done by QDbusInterface (it redefines qt_metacall and things
     //like that) and signals can not be connected so easily
     QDBusInterface* interface = new QDBusInterface(
-                service, "/ktutorial/EventSpy", "org.kde.ktutorial.EventSpy",
+                mService, "/ktutorial/EventSpy", "org.kde.ktutorial.EventSpy",
                 QDBusConnection::sessionBus(), this);
     connect(interface, SIGNAL(eventReceived(int,QString)),
             this, SLOT(handleEventReceived(int,QString)));
+
+    //Connected directly through the bus, as older versions of the remote
+    //EventSpy do not provide the signal
+    QDBusConnection::sessionBus().connect(mService, "/ktutorial/EventSpy",
+                    "org.kde.ktutorial.EventSpy", "objectDestroyed",
+                    this, SLOT(handleObjectDestroyed(int)));
 }
 
-//private:
+//private slots:
 
 void RemoteEventSpy::handleEventReceived(int objectId,
                                          const QString& eventType) {
     emit eventReceived(mMapper->remoteObject(objectId), eventType);
 }
+
+void RemoteEventSpy::handleObjectDestroyed(int objectId) {
+    RemoteObject* remoteObject = mMapper->takeRemoteObject(objectId);
+    if (!remoteObject) {
+        return;
+    }
+
+    emit remoteObjectAboutToBeDestroyed(remoteObject);
+
+    delete remoteObject;
+}
+
+void RemoteEventSpy::handleLocalSocketChannelDisconnected() {
+    disconnect(sender(), 0, this, 0);
+
+    connectToDBus();
+}
@@ -35,6 +35,15 @@ class RemoteObjectMapper;
  * "org.kde.ktutorial.EventSpy" interface in the DBus service specified in the
  * constructor and emits an equivalent signal replacing the object id with a
  * RemoteObject proxy.
+ *
+ * RemoteEventSpy also handles the objectDestroyed signal, removing the
+ * RemoteObject of the destroyed remote object from the RemoteObjectMapper.
+ * Before the RemoteObject is destroyed, remoteObjectAboutToBeDestroyed is
+ * emitted, so the objects that store it can forget it.
+ *
+ * If the RemoteObjectMapper has a LocalSocketChannel, the events are received
+ * through it instead of through D-Bus. If the LocalSocketChannel is
+ * disconnected, the events are received through D-Bus from then on.
  */
 class RemoteEventSpy: public QObject {
 Q_OBJECT
@@ -59,6 +68,14 @@ Q_SIGNALS:
      */
     void eventReceived(RemoteObject* remoteObject, const QString& eventType);
 
+    /**
+     * Emitted when the remote object was destroyed, just before its
+     * RemoteObject is removed from the mapper and destroyed.
+     *
+     * @param remoteObject The proxy for the destroyed remote object.
+     */
+    void remoteObjectAboutToBeDestroyed(RemoteObject* remoteObject);
+
 private:
 
     /**
@@ -66,6 +83,16 @@ private:
      */
     RemoteObjectMapper* mMapper;
 
+    /**
+     * The DBus service name.
+     */
+    QString mService;
+
+    /**
+     * Receives the events through the "org.kde.ktutorial.EventSpy" interface.
+     */
+    void connectToDBus();
+
 private Q_SLOTS:
 
     /**
@@ -76,6 +103,21 @@ private Q_SLOTS:
      */
     void handleEventReceived(int objectId, const QString& eventType);
 
+    /**
+     * Handles the destruction of a remote object notified by the EventSpy.
+     * Its RemoteObject is removed from the mapper and, once
+     * remoteObjectAboutToBeDestroyed is emitted, destroyed.
+     *
+     * @param objectId The id of the destroyed remote object.
+     */
+    void handleObjectDestroyed(int objectId);
+
+    /**
+     * Receives the events through D-Bus once the LocalSocketChannel is
+     * disconnected.
+     */
+    void handleLocalSocketChannelDisconnected();
+
 };
 
 #endif
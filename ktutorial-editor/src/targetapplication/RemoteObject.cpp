@@ -20,17 +20,16 @@
 
 #include <QtDBus/QtDBus>
 
+#include "LocalSocketChannel.h"
 #include "RemoteObjectMapper.h"
 
 //public:
 
-RemoteObject::RemoteObject(const QString& service, RemoteObjectMapper* mapper,
-                           int objectId):
-        QDBusAbstractInterface(service, "/ktutorial/ObjectRegister",
-                               "org.kde.ktutorial.ObjectRegister",
-                               QDBusConnection::sessionBus(), 0),
+RemoteObject::RemoteObject(RemoteObjectMapper* mapper, int objectId):
+        QObject(),
     mMapper(mapper),
-    mObjectId(objectId) {
+    mObjectId(objectId),
+    mRemoteClass(0) {
 }
 
 int RemoteObject::objectId() const {
@@ -38,7 +37,16 @@ int RemoteObject::objectId() const {
 }
 
 QString RemoteObject::name() throw (DBusException) {
-    QDBusReply<QString> reply = call("objectName", mObjectId);
+    if (mMapper->localSocketChannel()) {
+        try {
+            return mMapper->localSocketChannel()->objectName(mObjectId);
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
+    QDBusReply<QString> reply =
+            mMapper->objectRegisterInterface()->call("objectName", mObjectId);
     if (!reply.isValid()) {
         throw DBusException(reply.error().message());
     }
@@ -47,20 +55,54 @@ QString RemoteObject::name() throw (DBusException) {
 }
 
 RemoteClass* RemoteObject::remoteClass() throw (DBusException) {
-    QDBusReply<QString> reply = call("className", mObjectId);
+    if (mRemoteClass) {
+        return mRemoteClass;
+    }
+
+    if (mMapper->localSocketChannel()) {
+        try {
+            QString className =
+                        mMapper->localSocketChannel()->className(mObjectId);
+            mRemoteClass = mMapper->remoteClass(className);
+            return mRemoteClass;
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
+    QDBusReply<QString> reply =
+            mMapper->objectRegisterInterface()->call("className", mObjectId);
     if (!reply.isValid()) {
         throw DBusException(reply.error().message());
     }
 
-    return mMapper->remoteClass(reply.value());
+    mRemoteClass = mMapper->remoteClass(reply.value());
+    return mRemoteClass;
 }
 
 Q_DECLARE_METATYPE(QList<int>)
 
 QList<RemoteObject*> RemoteObject::children() throw (DBusException) {
+    if (mMapper->localSocketChannel()) {
+        try {
+            QList<int> childObjectIds =
+                    mMapper->localSocketChannel()->childObjectIds(mObjectId);
+
+            QList<RemoteObject*> children;
+            foreach (int childObjectId, childObjectIds) {
+                children.append(mMapper->remoteObject(childObjectId));
+            }
+
+            return children;
+        } catch (DBusException e) {
+            //Fall back to D-Bus if the local socket is not usable
+        }
+    }
+
     qDBusRegisterMetaType< QList<int> >();
 
-    QDBusReply< QList<int> > reply = call("childObjectIds", mObjectId);
+    QDBusReply< QList<int> > reply =
+        mMapper->objectRegisterInterface()->call("childObjectIds", mObjectId);
     if (!reply.isValid()) {
         throw DBusException(reply.error().message());
     }
@@ -19,7 +19,7 @@
 #ifndef REMOTEOBJECT_H
 #define REMOTEOBJECT_H
 
-#include <QDBusAbstractInterface>
+#include <QObject>
 
 #include "DBusException.h"
 
@@ -35,27 +35,31 @@ class RemoteObjectMapper;
  * it.
  *
  * To get the data, RemoteObject makes DBus calls to the
- * "org.kde.ktutorial.ObjectRegistry" interface in the DBus service specified in
- * the constructor.
+ * "org.kde.ktutorial.ObjectRegistry" interface in the DBus service of its
+ * RemoteObjectMapper. RemoteObject is just a lightweight handle for the remote
+ * object: all the RemoteObjects share the same DBus interface, provided by the
+ * RemoteObjectMapper, so browsing a large target application does not create
+ * a DBus interface for each remote object.
+ *
+ * The class of an object never changes, so the RemoteClass is cached once it
+ * has been got.
  *
  * Although the idea is let other objects use it like a local object, it has to
  * communicate with the remote ObjectRegistry through DBus anyway, so the
  * methods may throw a DBusException if something goes wrong.
  */
-class RemoteObject: public QDBusAbstractInterface {
+class RemoteObject: public QObject {
 Q_OBJECT
 public:
 
     /**
      * Creates a new RemoteObject to represent the remote object with the given
-     * id in the given DBus service name.
+     * id in the DBus service of the given mapper.
      *
-     * @param service The DBus service name.
      * @param mapper The RemoteObjectMapper to get RemoteObjects from.
      * @param objectId The id of the remote object.
      */
-    RemoteObject(const QString& service, RemoteObjectMapper* mapper,
-                 int objectId);
+    RemoteObject(RemoteObjectMapper* mapper, int objectId);
 
     /**
      * Returns the id of the remote object.
@@ -101,6 +105,11 @@ private:
      */
     int mObjectId;
 
+    /**
+     * The cached remote class, if already got.
+     */
+    RemoteClass* mRemoteClass;
+
 };
 
 #endif
@@ -18,20 +18,49 @@
 
 #include "RemoteObjectMapper.h"
 
+#include <QDBusAbstractInterface>
+#include <QDBusReply>
 #include <QHash>
 
+#include "LocalSocketChannel.h"
 #include "RemoteClass.h"
 #include "RemoteObject.h"
 
+/**
+ * The minimum milliseconds between two requests of the class hierarchy.
+ */
+const int CLASS_HIERARCHY_REQUEST_INTERVAL = 1000;
+
+/**
+ * DBus interface to the remote "/ktutorial/ObjectRegister" object.
+ * QDBusAbstractInterface constructor is protected, so it has to be subclassed
+ * to be used without generating a specific proxy class.
+ */
+class RemoteRegisterInterface: public QDBusAbstractInterface {
+public:
+
+    RemoteRegisterInterface(const QString& service, const char* interface):
+        QDBusAbstractInterface(service, "/ktutorial/ObjectRegister", interface,
+                               QDBusConnection::sessionBus(), 0) {
+    }
+
+};
+
 //public:
 
 RemoteObjectMapper::RemoteObjectMapper(const QString& service):
-    mService(service) {
+    mService(service),
+    mObjectRegisterInterface(0),
+    mClassRegisterInterface(0),
+    mLocalSocketChannel(0) {
 }
 
 RemoteObjectMapper::~RemoteObjectMapper() {
     qDeleteAll(mRemoteObjects);
     qDeleteAll(mRemoteClasses);
+    delete mObjectRegisterInterface;
+    delete mClassRegisterInterface;
+    delete mLocalSocketChannel;
 }
 
 RemoteObject* RemoteObjectMapper::remoteObject(int objectId) {
@@ -43,19 +72,105 @@ RemoteObject* RemoteObjectMapper::remoteObject(int objectId) {
         return mRemoteObjects.value(objectId);
     }
 
-    RemoteObject* remoteObject = new RemoteObject(mService, this, objectId);
+    RemoteObject* remoteObject = new RemoteObject(this, objectId);
     mRemoteObjects.insert(objectId, remoteObject);
 
     return remoteObject;
 }
 
+void RemoteObjectMapper::removeRemoteObject(int objectId) {
+    delete takeRemoteObject(objectId);
+}
+
+RemoteObject* RemoteObjectMapper::takeRemoteObject(int objectId) {
+    return mRemoteObjects.take(objectId);
+}
+
 RemoteClass* RemoteObjectMapper::remoteClass(const QString& className) {
     if (mRemoteClasses.contains(className)) {
         return mRemoteClasses.value(className);
     }
 
-    RemoteClass* remoteClass = new RemoteClass(mService, this, className);
+    RemoteClass* remoteClass = new RemoteClass(this, className);
     mRemoteClasses.insert(className, remoteClass);
 
     return remoteClass;
 }
+
+QDBusAbstractInterface* RemoteObjectMapper::objectRegisterInterface() {
+    if (!mObjectRegisterInterface) {
+        mObjectRegisterInterface = new RemoteRegisterInterface(mService,
+                                            "org.kde.ktutorial.ObjectRegister");
+    }
+
+    return mObjectRegisterInterface;
+}
+
+QDBusAbstractInterface* RemoteObjectMapper::classRegisterInterface() {
+    if (!mClassRegisterInterface) {
+        mClassRegisterInterface = new RemoteRegisterInterface(mService,
+                                            "org.kde.ktutorial.ClassRegister");
+    }
+
+    return mClassRegisterInterface;
+}
+
+QVariantMap RemoteObjectMapper::classHierarchy(
+                                    const QString& className /*= QString()*/) {
+    if (mClassHierarchyRequestTime.isNull()) {
+        requestClassHierarchy();
+    } else if (!className.isEmpty() && !mClassHierarchy.contains(className) &&
+               mClassHierarchyRequestTime.elapsed() >=
+                                        CLASS_HIERARCHY_REQUEST_INTERVAL) {
+        requestClassHierarchy();
+    }
+
+    return mClassHierarchy;
+}
+
+void RemoteObjectMapper::addToClassHierarchy(
+                                        const QVariantMap& classHierarchy) {
+    QMapIterator<QString, QVariant> it(classHierarchy);
+    while (it.hasNext()) {
+        it.next();
+        mClassHierarchy.insert(it.key(), it.value());
+    }
+}
+
+LocalSocketChannel* RemoteObjectMapper::localSocketChannel() const {
+    if (mLocalSocketChannel && !mLocalSocketChannel->isConnected()) {
+        return 0;
+    }
+
+    return mLocalSocketChannel;
+}
+
+void RemoteObjectMapper::setLocalSocketChannel(
+                                    LocalSocketChannel* localSocketChannel) {
+    if (mLocalSocketChannel == localSocketChannel) {
+        return;
+    }
+
+    delete mLocalSocketChannel;
+    mLocalSocketChannel = localSocketChannel;
+}
+
+//private:
+
+void RemoteObjectMapper::requestClassHierarchy() {
+    mClassHierarchyRequestTime.start();
+
+    if (localSocketChannel()) {
+        try {
+            addToClassHierarchy(mLocalSocketChannel->classHierarchy());
+            return;
+        } catch (DBusException e) {
+        }
+    }
+
+    QDBusReply<QVariantMap> reply =
+                        classRegisterInterface()->call("classHierarchy");
+    if (reply.isValid()) {
+        addToClassHierarchy(reply.value());
+    }
+}
@@ -20,7 +20,11 @@
 #define REMOTEOBJECTMAPPER_H
 
 #include <QHash>
+#include <QTime>
+#include <QVariantMap>
 
+class LocalSocketChannel;
+class QDBusAbstractInterface;
 class RemoteClass;
 class RemoteObject;
 
@@ -33,6 +37,17 @@ class RemoteObject;
  *
  * The RemoteObjectMapper also has ownership of the RemoteObjects and
  * RemoteClasses, so they are deleted when the mapper is destroyed.
+ *
+ * The RemoteObjects and RemoteClasses are lightweight handles that make their
+ * DBus calls through the interfaces provided by the mapper, which are shared
+ * by all of them. When the target application reports that a remote object
+ * was destroyed, its RemoteObject can be removed from the mapper, so browsing a
+ * target application where lots of objects are created and destroyed does not
+ * keep growing the memory used by the editor.
+ *
+ * If a LocalSocketChannel is set, the RemoteObjects, RemoteClasses and
+ * RemoteEventSpies use it instead of D-Bus to communicate with the target
+ * application.
  */
 class RemoteObjectMapper {
 public:
@@ -62,6 +77,27 @@ public:
      */
     RemoteObject* remoteObject(int objectId);
 
+    /**
+     * Removes and destroys the RemoteObject associated with the given object
+     * id, if any.
+     * It must be called only when the remote object was destroyed, as the
+     * RemoteObject should not be used anymore.
+     *
+     * @param objectId The id of the destroyed remote object.
+     */
+    void removeRemoteObject(int objectId);
+
+    /**
+     * Removes the RemoteObject associated with the given object id, if any,
+     * but does not destroy it.
+     * The caller takes ownership of the RemoteObject, so it can notify the
+     * objects that store it before destroying it.
+     *
+     * @param objectId The id of the destroyed remote object.
+     * @return The removed RemoteObject, or a null pointer if there was none.
+     */
+    RemoteObject* takeRemoteObject(int objectId);
+
     /**
      * Returns the RemoteClass associated with the given class name.
      * The RemoteClass is destroyed when this RemoteObjectMapper is destroyed,
@@ -72,6 +108,71 @@ public:
      */
     RemoteClass* remoteClass(const QString& className);
 
+    /**
+     * Returns the DBus interface to the remote ObjectRegister.
+     * It is shared by all the RemoteObjects of this mapper.
+     *
+     * @return The DBus interface to the remote ObjectRegister.
+     */
+    QDBusAbstractInterface* objectRegisterInterface();
+
+    /**
+     * Returns the DBus interface to the remote ClassRegister.
+     * It is shared by all the RemoteClasses of this mapper.
+     *
+     * @return The DBus interface to the remote ClassRegister.
+     */
+    QDBusAbstractInterface* classRegisterInterface();
+
+    /**
+     * Returns the class hierarchy received from the remote ObjectRegistry.
+     * It is shared by all the RemoteClasses, so the class hierarchy has to be
+     * requested just once instead of once for each class.
+     *
+     * The first time it is called the whole class hierarchy is requested to
+     * the remote ObjectRegistry. Classes registered after that request are
+     * missing from the class hierarchy, so if the given class is missing the
+     * class hierarchy is requested again and merged with the classes already
+     * received. However, to avoid requesting the whole class hierarchy for
+     * each missing class (for example, a class that will never be registered),
+     * it is requested again at most once a second; in the meantime, missing
+     * classes have to be queried on their own.
+     *
+     * The class hierarchy is requested through the LocalSocketChannel, if
+     * any, or through D-Bus otherwise.
+     *
+     * @param className The name of the class that should be in the class
+     *                  hierarchy, if any.
+     * @return The class hierarchy, as returned by the remote ObjectRegistry.
+     */
+    QVariantMap classHierarchy(const QString& className = QString());
+
+    /**
+     * Adds the given classes to the class hierarchy.
+     * The classes already in the class hierarchy are replaced.
+     *
+     * @param classHierarchy The classes to add.
+     */
+    void addToClassHierarchy(const QVariantMap& classHierarchy);
+
+    /**
+     * Returns the LocalSocketChannel to the target application, if any.
+     * Once the channel is disconnected it is no longer returned, so D-Bus is
+     * used instead.
+     *
+     * @return The LocalSocketChannel, or a null pointer if there is none or
+     *         it is not connected.
+     */
+    LocalSocketChannel* localSocketChannel() const;
+
+    /**
+     * Sets the LocalSocketChannel to communicate with the target application.
+     * The RemoteObjectMapper takes ownership of the channel.
+     *
+     * @param localSocketChannel The LocalSocketChannel to set.
+     */
+    void setLocalSocketChannel(LocalSocketChannel* localSocketChannel);
+
 private:
 
     /**
@@ -89,6 +190,39 @@ private:
      */
     QHash<QString, RemoteClass*> mRemoteClasses;
 
+    /**
+     * The DBus interface to the remote ObjectRegister, created when needed.
+     */
+    QDBusAbstractInterface* mObjectRegisterInterface;
+
+    /**
+     * The DBus interface to the remote ClassRegister, created when needed.
+     */
+    QDBusAbstractInterface* mClassRegisterInterface;
+
+    /**
+     * The class hierarchy received from the remote ObjectRegistry.
+     */
+    QVariantMap mClassHierarchy;
+
+    /**
+     * When the class hierarchy was last requested, or a null time if it was
+     * never requested.
+     */
+    QTime mClassHierarchyRequestTime;
+
+    /**
+     * The LocalSocketChannel to the target application, if any.
+     */
+    LocalSocketChannel* mLocalSocketChannel;
+
+    /**
+     * Requests the whole class hierarchy and adds it to the classes already
+     * received.
+     * If the request fails, the class hierarchy is not modified.
+     */
+    void requestClassHierarchy();
+
 };
 
 #endif
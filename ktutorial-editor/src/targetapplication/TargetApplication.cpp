@@ -19,6 +19,7 @@
 
 #include "TargetApplication.h"
 
+#include <QUuid>
 #include <QtDBus/QtDBus>
 
 #include <KProcess>
@@ -60,6 +61,10 @@ RemoteEditorSupport* TargetApplication::remoteEditorSupport() {
     return mRemoteEditorSupport;
 }
 
+QString TargetApplication::rendezvousToken() const {
+    return mRendezvousToken;
+}
+
 void TargetApplication::start() {
     if (mProcess && mProcess->program()[0] == mTargetApplicationFilePath) {
         return;
@@ -83,6 +88,15 @@ void TargetApplication::start() {
 
     mServiceName.clear();
 
+    QDBusConnection::sessionBus().registerObject(
+                    "/ktutorial/TargetApplication", this,
+                    QDBusConnection::ExportScriptableSlots);
+
+    mRendezvousToken = QUuid::createUuid().toString();
+    mProcess->setEnv("KTUTORIAL_EDITOR_SERVICE",
+                     QDBusConnection::sessionBus().baseService());
+    mProcess->setEnv("KTUTORIAL_EDITOR_TOKEN", mRendezvousToken);
+
     QDBusConnectionInterface* interface =
                                     QDBusConnection::sessionBus().interface();
     connect(interface, SIGNAL(serviceRegistered(QString)),
@@ -104,6 +118,21 @@ void TargetApplication::start() {
     mProcess->start();
 }
 
+//public slots:
+
+void TargetApplication::editorSupportRegistered(const QString& token) {
+    if (!mProcess || mRemoteEditorSupport || token != mRendezvousToken ||
+            !calledFromDBus()) {
+        return;
+    }
+
+    disconnect(QDBusConnection::sessionBus().interface(), 0, this, 0);
+
+    mServiceName = message().service();
+
+    setUpRemoteEditorSupport();
+}
+
 //private:
 
 TargetApplication* TargetApplication::sSelf = new TargetApplication();
@@ -117,6 +146,16 @@ TargetApplication::TargetApplication():
             this, SLOT(handleTargetApplicationDoesNotSupportKTutorial()));
 }
 
+void TargetApplication::setUpRemoteEditorSupport() {
+    mKTutorialSupportModuleDiscoveryTimer.stop();
+
+    mMapper = new RemoteObjectMapper(mServiceName);
+    mRemoteEditorSupport = new RemoteEditorSupport(mServiceName, mMapper);
+    mRemoteEditorSupport->useLocalSocketChannel(mRendezvousToken);
+
+    emit started();
+}
+
 //private slots:
 
 void TargetApplication::checkNewService(const QString& service) {
@@ -175,12 +214,7 @@ void TargetApplication::checkKTutorialSupportModule() {
         return;
     }
 
-    mKTutorialSupportModuleDiscoveryTimer.stop();
-
-    mMapper = new RemoteObjectMapper(mServiceName);
-    mRemoteEditorSupport = new RemoteEditorSupport(mServiceName, mMapper);
-
-    emit started();
+    setUpRemoteEditorSupport();
 }
 
 void TargetApplication::handleProcessError(QProcess::ProcessError error) {
@@ -20,6 +20,7 @@
 #ifndef TARGETAPPLICATION_H
 #define TARGETAPPLICATION_H
 
+#include <QDBusContext>
 #include <QObject>
 #include <QProcess>
 #include <QTimer>
@@ -51,6 +52,17 @@ class RemoteObjectMapper;
  * Note that startFailed(Error) signal is also emitted if the target application
  * is closed too soon to check if it uses KTutorial.
  *
+ * When the target application is executed, the D-Bus service of KTutorial
+ * editor and a token that identifies this execution are passed to it in the
+ * "KTUTORIAL_EDITOR_SERVICE" and "KTUTORIAL_EDITOR_TOKEN" environment
+ * variables. Once its KTutorial editor support module is registered, the target
+ * application calls editorSupportRegistered(QString) in the
+ * "org.kde.ktutorial.TargetApplication" interface of the
+ * "/ktutorial/TargetApplication" object, so the started() signal is emitted
+ * without waiting. Target applications using an older KTutorial version that
+ * does not call back are found looking for new services in the session bus and
+ * polling them for the "/ktutorial" object instead.
+ *
  * Once the target application has been started, remoteEditorSupport
  * returns a RemoteEditorSupport connected to the remote
  * "org.kde.ktutorial.EditorSupport" interface exposed by the target
@@ -62,8 +74,9 @@ class RemoteObjectMapper;
  * was closed externally (by the user), finished() signal is emitted (but only
  * if, preiously, it was successfully started).
  */
-class TargetApplication: public QObject {
+class TargetApplication: public QObject, protected QDBusContext {
 Q_OBJECT
+Q_CLASSINFO("D-Bus Interface", "org.kde.ktutorial.TargetApplication")
 public:
 
     /**
@@ -126,6 +139,15 @@ public:
      */
     RemoteEditorSupport* remoteEditorSupport();
 
+    /**
+     * Returns the token passed to the last started target application.
+     * It is needed to authenticate with the local socket server of the target
+     * application.
+     *
+     * @return The token passed to the target application.
+     */
+    QString rendezvousToken() const;
+
     /**
      * Starts a new TargetApplication.
      * When the target application is running, started() signal is emitted. If
@@ -139,6 +161,19 @@ public:
      */
     void start();
 
+public Q_SLOTS:
+
+    /**
+     * Called through D-Bus by the target application when its KTutorial editor
+     * support module has been registered.
+     * The caller is used as the D-Bus service of the target application if the
+     * token matches the one passed to the last started target application.
+     * Otherwise, nothing is done.
+     *
+     * @param token The token passed to the target application.
+     */
+    Q_SCRIPTABLE void editorSupportRegistered(const QString& token);
+
 Q_SIGNALS:
 
     /**
@@ -192,6 +227,11 @@ private:
      */
     QString mServiceName;
 
+    /**
+     * The token passed to the last started target application.
+     */
+    QString mRendezvousToken;
+
     /**
      * The mapper that associates RemoteObjects with their object id.
      */
@@ -209,6 +249,12 @@ private:
      */
     TargetApplication();
 
+    /**
+     * Creates the RemoteEditorSupport for the service of the target
+     * application and emits started() signal.
+     */
+    void setUpRemoteEditorSupport();
+
 private Q_SLOTS:
 
     /**
@@ -18,7 +18,38 @@
 
 #include "CommandWidget.h"
 
-#include <QUndoStack>
+#include <QUndoCommand>
+
+#include "../commands/UndoStack.h"
+
+/**
+ * Parent command created automatically when saving the changes.
+ * If it has just one child, its id is the id of the child, and it is merged
+ * with other commands by merging its child, so consecutive edits of the same
+ * data can be merged even if each one is wrapped in its own parent command.
+ */
+class SaveChangesCommand: public QUndoCommand {
+public:
+
+    virtual int id() const {
+        if (childCount() != 1) {
+            return -1;
+        }
+
+        return child(0)->id();
+    }
+
+    virtual bool mergeWith(const QUndoCommand* other) {
+        if (childCount() != 1) {
+            return false;
+        }
+
+        //QUndoCommand::child(int) is const, but the child is owned by this
+        //command, so it can be modified
+        return const_cast<QUndoCommand*>(child(0))->mergeWith(other);
+    }
+
+};
 
 //public:
 
@@ -30,7 +61,7 @@ CommandWidget::CommandWidget(QWidget* parent): EditionWidget(parent),
 void CommandWidget::saveChanges() {
     QUndoCommand* parent = mParentUndoCommand;
     if (!parent) {
-        parent = new QUndoCommand();
+        parent = new SaveChangesCommand();
     }
 
     QList<QUndoCommand*> commands = createSaveCommands(parent);
@@ -63,6 +94,6 @@ void CommandWidget::setParentUndoCommand(QUndoCommand* parentUndoCommand) {
     mParentUndoCommand = parentUndoCommand;
 }
 
-void CommandWidget::setUndoStack(QUndoStack* undoStack) {
+void CommandWidget::setUndoStack(UndoStack* undoStack) {
     mUndoStack = undoStack;
 }
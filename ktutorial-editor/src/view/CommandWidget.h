@@ -22,7 +22,7 @@
 #include "EditionWidget.h"
 
 class QUndoCommand;
-class QUndoStack;
+class UndoStack;
 
 /**
  * Base abstract class for command widgets.
@@ -31,7 +31,7 @@ class QUndoStack;
  *
  * To be done or undone by the user, the command must be added to a stack of
  * commands. The stack that the commands will be added to can be set using
- * setUndoStack(QUndoStack*) method. When the stack is set, the commands that
+ * setUndoStack(UndoStack*) method. When the stack is set, the commands that
  * are executed to save the data are added to the stack, which effectively
  * causes them to be executed.
  *
@@ -45,7 +45,9 @@ class QUndoStack;
  * the one added directly to the stack. If no parent command was set, a new one
  * is created automatically. If it has several children, its name will be the
  * window title of the widget. If it has only one child, its name will be the
- * name of its child.
+ * name of its child. An automatically created parent command with only one
+ * child is merged with the previous command in the stack if its child can be
+ * merged (for example, consecutive changes to the text of the same step).
  *
  * Note that if there is a stack, but no parent command and no child commands
  * (for example, because there were no changes to save), the automatically
@@ -92,7 +94,7 @@ public:
      *
      * @param undoStack The undo stack.
      */
-    void setUndoStack(QUndoStack* undoStack);
+    void setUndoStack(UndoStack* undoStack);
 
 protected:
 
@@ -115,7 +117,7 @@ private:
     /**
      * The undo stack to add the commands to.
      */
-    QUndoStack* mUndoStack;
+    UndoStack* mUndoStack;
 
 };
 
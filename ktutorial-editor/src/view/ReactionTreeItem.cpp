@@ -38,13 +38,14 @@ ReactionTreeItem::ReactionTreeItem(Reaction* reaction, TreeItem* parent):
     mResponseCustomCodeItem = 0;
     mResponseNextStepItem = 0;
 
-    //Add two dummy children, as update method expects always to child items
+    //Add two dummy children, as update methods expect always two child items
     appendChild(new TextTreeItem(this));
     appendChild(new TextTreeItem(this));
-    update(reaction);
+    updateTriggerItem(reaction);
+    updateResponseItem(reaction);
 
-    connect(reaction, SIGNAL(dataChanged(Reaction*)),
-            this, SLOT(update(Reaction*)));
+    connect(reaction, SIGNAL(fieldChanged(Reaction*,Reaction::Field)),
+            this, SLOT(update(Reaction*,Reaction::Field)));
 }
 
 QString ReactionTreeItem::text() const {
@@ -141,11 +142,7 @@ void ReactionTreeItem::updateNextStepItem(Reaction* reaction) {
                             i18nc("@item", "Change to step %1", nextStepId));
 }
 
-//private slots:
-
-void ReactionTreeItem::update(Reaction* reaction) {
-    Q_ASSERT(reaction);
-
+void ReactionTreeItem::updateTriggerItem(Reaction* reaction) {
     if (reaction->triggerType() == Reaction::ConditionMet) {
         updateConditionItem(reaction);
     }
@@ -153,7 +150,9 @@ void ReactionTreeItem::update(Reaction* reaction) {
     if (reaction->triggerType() == Reaction::OptionSelected) {
         updateOptionItem(reaction);
     }
+}
 
+void ReactionTreeItem::updateResponseItem(Reaction* reaction) {
     if (reaction->responseType() == Reaction::CustomCode) {
         updateCustomCodeItem(reaction);
     }
@@ -162,3 +161,25 @@ void ReactionTreeItem::update(Reaction* reaction) {
         updateNextStepItem(reaction);
     }
 }
+
+//private slots:
+
+void ReactionTreeItem::update(Reaction* reaction, Reaction::Field field) {
+    Q_ASSERT(reaction);
+
+    if (field == Reaction::TriggerTypeField ||
+        (field == Reaction::OptionNameField &&
+         reaction->triggerType() == Reaction::OptionSelected) ||
+        (field == Reaction::WaitForField &&
+         reaction->triggerType() == Reaction::ConditionMet)) {
+        updateTriggerItem(reaction);
+    }
+
+    if (field == Reaction::ResponseTypeField ||
+        (field == Reaction::NextStepIdField &&
+         reaction->responseType() == Reaction::NextStep) ||
+        (field == Reaction::CustomCodeField &&
+         reaction->responseType() == Reaction::CustomCode)) {
+        updateResponseItem(reaction);
+    }
+}
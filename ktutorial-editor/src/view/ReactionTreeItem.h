@@ -21,8 +21,8 @@
 
 #include <QPointer>
 #include "TreeItem.h"
+#include "../data/Reaction.h"
 
-class Reaction;
 class TextTreeItem;
 class WaitForTreeItem;
 
@@ -172,19 +172,38 @@ private:
      */
     void updateNextStepItem(Reaction* reaction);
 
+    /**
+     * Updates the trigger item (the option or the condition, depending on the
+     * trigger type).
+     *
+     * @param reaction The reaction.
+     */
+    void updateTriggerItem(Reaction* reaction);
+
+    /**
+     * Updates the response item (the next step or the custom code, depending
+     * on the response type).
+     *
+     * @param reaction The reaction.
+     */
+    void updateResponseItem(Reaction* reaction);
+
 private Q_SLOTS:
 
     /**
-     * Updates this ReactionTreeItem when the data of its reaction changed.
-     * If a child item is needed to show some data, it is inserted or updated
-     * (depending on whether it existed previously or not).
-     * If the child item is no longer needed, it is removed.
+     * Updates this ReactionTreeItem when an attribute of its reaction changed.
+     * If a child item is needed to show the attribute, it is inserted or
+     * updated (depending on whether it existed previously or not).
+     * If the child item is no longer needed, it is removed. Changing the
+     * trigger (or the response) data only updates the trigger (or the
+     * response) item.
      *
      * Items may be flat or nested, depending on the data to show.
      *
      * @param reaction The reaction.
+     * @param field The attribute that changed.
      */
-    void update(Reaction* reaction);
+    void update(Reaction* reaction, Reaction::Field field);
 
 };
 
@@ -20,7 +20,9 @@
 #include "RemoteObjectChooser.h"
 #include "ui_RemoteObjectChooser.h"
 
+#include <QAbstractProxyModel>
 #include <QPushButton>
+#include <QTimer>
 
 #include <KDebug>
 #include <KDialogButtonBox>
@@ -37,6 +39,17 @@
 #include "../targetapplication/RemoteObject.h"
 #include "../targetapplication/TargetApplication.h"
 
+/**
+ * The maximum size of the previews.
+ */
+const QSize PREVIEW_SIZE(256, 192);
+
+/**
+ * The time, in milliseconds, the mouse has to stay over a remote object before
+ * its preview is requested.
+ */
+const int PREVIEW_DELAY = 300;
+
 //public:
 
 RemoteObjectChooser::RemoteObjectChooser(QWidget* parent):
@@ -58,6 +71,20 @@ RemoteObjectChooser::RemoteObjectChooser(QWidget* parent):
     button->setObjectName("cancelButton");
     connect(button, SIGNAL(clicked(bool)), this, SLOT(cancel()));
 
+    mPreviewTimer = new QTimer(this);
+    mPreviewTimer->setSingleShot(true);
+    mPreviewTimer->setInterval(PREVIEW_DELAY);
+    connect(mPreviewTimer, SIGNAL(timeout()), this, SLOT(requestPreview()));
+
+    ui->previewLabel->setMinimumSize(PREVIEW_SIZE);
+    ui->previewLabel->hide();
+
+    ui->remoteObjectsTreeView->setMouseTracking(true);
+    connect(ui->remoteObjectsTreeView, SIGNAL(entered(QModelIndex)),
+            this, SLOT(handleItemEntered(QModelIndex)));
+    connect(ui->remoteObjectsTreeView, SIGNAL(viewportEntered()),
+            this, SLOT(clearPreview()));
+
     connect(TargetApplication::self(), SIGNAL(started()),
             this, SLOT(handleTargetApplicationStarted()));
     connect(TargetApplication::self(),
@@ -131,6 +158,38 @@ void RemoteObjectChooser::warnAboutFinishedTargetApplicationBeforeClosing() {
     close();
 }
 
+RemoteObject* RemoteObjectChooser::remoteObjectForIndex(
+                                            const QModelIndex& index) const {
+    QModelIndex treeModelIndex = index;
+    const QAbstractProxyModel* proxyModel =
+                        qobject_cast<const QAbstractProxyModel*>(index.model());
+    if (proxyModel) {
+        treeModelIndex = proxyModel->mapToSource(index);
+    }
+
+    TreeItem* item = static_cast<TreeItem*>(treeModelIndex.internalPointer());
+    while (item && !qobject_cast<RemoteObjectTreeItem*>(item)) {
+        item = item->parent();
+    }
+
+    if (!item) {
+        return 0;
+    }
+
+    return static_cast<RemoteObjectTreeItem*>(item)->remoteObject();
+}
+
+void RemoteObjectChooser::showPreview(const QPixmap& preview) {
+    if (preview.isNull()) {
+        ui->previewLabel->setPixmap(QPixmap());
+        ui->previewLabel->setText(i18nc("@info", "No preview available"));
+    } else {
+        ui->previewLabel->setPixmap(preview);
+    }
+
+    ui->previewLabel->show();
+}
+
 //private slots:
 
 void RemoteObjectChooser::handleTargetApplicationStarted() {
@@ -232,8 +291,61 @@ void RemoteObjectChooser::setCurrentRemoteObject(RemoteObject* remoteObject) {
     }
 }
 
+void RemoteObjectChooser::handleItemEntered(const QModelIndex& index) {
+    RemoteObject* remoteObject = remoteObjectForIndex(index);
+    if (!remoteObject) {
+        clearPreview();
+        return;
+    }
+
+    if (remoteObject == mHoveredRemoteObject) {
+        return;
+    }
+
+    mHoveredRemoteObject = remoteObject;
+
+    if (mPreviews.contains(remoteObject->objectId())) {
+        mPreviewTimer->stop();
+        showPreview(mPreviews.value(remoteObject->objectId()));
+        return;
+    }
+
+    mPreviewTimer->start();
+}
+
+void RemoteObjectChooser::clearPreview() {
+    mHoveredRemoteObject = 0;
+    mPreviewTimer->stop();
+    ui->previewLabel->hide();
+}
+
+void RemoteObjectChooser::requestPreview() {
+    RemoteEditorSupport* remoteEditorSupport =
+                            TargetApplication::self()->remoteEditorSupport();
+    if (!mHoveredRemoteObject || !remoteEditorSupport) {
+        return;
+    }
+
+    QPixmap preview;
+    try {
+        preview = QPixmap::fromImage(remoteEditorSupport->grabWidget(
+                                        mHoveredRemoteObject, PREVIEW_SIZE));
+    } catch (DBusException e) {
+        kWarning() << "The preview of the remote object could not be got ("
+                   << e.message() << ").";
+        return;
+    }
+
+    mPreviews.insert(mHoveredRemoteObject->objectId(), preview);
+    showPreview(preview);
+}
+
 void RemoteObjectChooser::accept() {
-    Q_ASSERT(mCurrentRemoteObject);
+    //The remote object may have been destroyed after being selected
+    if (!mCurrentRemoteObject) {
+        ui->dialogButtonBox->button(QDialogButtonBox::Ok)->setEnabled(false);
+        return;
+    }
 
     emit remoteObjectChosen(mCurrentRemoteObject);
     close();
@@ -20,8 +20,13 @@
 #ifndef REMOTEOBJECTCHOOSER_H
 #define REMOTEOBJECTCHOOSER_H
 
+#include <QHash>
+#include <QPixmap>
+#include <QPointer>
 #include <QWidget>
 
+class QModelIndex;
+class QTimer;
 class RemoteObject;
 
 namespace Ui {
@@ -46,6 +51,12 @@ class RemoteObjectChooser;
  * When the user selects a remote object in the list and that object represents
  * a widget, the widget is highlighted in the target application.
  *
+ * When the mouse hovers over a remote object in the list and that object
+ * represents a widget, a preview of the widget is shown below the list. The
+ * preview is requested to the target application only when the mouse stays
+ * over the object for a short time, and it is cached, so moving the mouse over
+ * the list does not flood the target application with requests.
+ *
  * The list shows all the available remote objects in the target application.
  * Some of them may not be useful at all (for example, those without name), so
  * the user can select some filters to narrow the remote objects shown in the
@@ -114,8 +125,10 @@ private:
 
     /**
      * The RemoteObject currently selected in the list.
+     * A guarded pointer is needed, as the RemoteObject is destroyed if the
+     * remote object is destroyed in the target application.
      */
-    RemoteObject* mCurrentRemoteObject;
+    QPointer<RemoteObject> mCurrentRemoteObject;
 
     /**
      * True if the target application has been successfully started, false
@@ -123,6 +136,24 @@ private:
      */
     bool mSuccessfullyStarted;
 
+    /**
+     * The RemoteObject the mouse is over in the list, if any.
+     */
+    QPointer<RemoteObject> mHoveredRemoteObject;
+
+    /**
+     * Timer to delay the preview request until the mouse stays over a remote
+     * object.
+     */
+    QTimer* mPreviewTimer;
+
+    /**
+     * The already requested previews, using the object id of the remote object
+     * as the key.
+     * Remote objects that are not widgets have a null pixmap.
+     */
+    QHash<int, QPixmap> mPreviews;
+
     /**
      * Hide all the parent widgets of the given widget that are windows or
      * dialogs.
@@ -145,6 +176,26 @@ private:
      */
     void warnAboutFinishedTargetApplicationBeforeClosing();
 
+    /**
+     * Returns the RemoteObject represented by the item at the given index of
+     * the list.
+     * If the item is not a RemoteObjectTreeItem, the RemoteObject of its
+     * nearest RemoteObjectTreeItem ancestor is returned.
+     *
+     * @param index The index of the item in the list.
+     * @return The RemoteObject represented by the item.
+     */
+    RemoteObject* remoteObjectForIndex(const QModelIndex& index) const;
+
+    /**
+     * Shows the given preview below the list.
+     * If the preview is null, a message telling that there is no preview is
+     * shown instead.
+     *
+     * @param preview The preview to show.
+     */
+    void showPreview(const QPixmap& preview);
+
 private Q_SLOTS:
 
     /**
@@ -168,6 +219,26 @@ private Q_SLOTS:
      */
     void setCurrentRemoteObject(RemoteObject* remoteObject);
 
+    /**
+     * Shows the preview of the remote object at the given index of the list.
+     * If the preview is not cached yet, it is requested once the mouse stays
+     * over the remote object for a short time.
+     *
+     * @param index The index of the item the mouse entered in.
+     */
+    void handleItemEntered(const QModelIndex& index);
+
+    /**
+     * Hides the preview and cancels any pending preview request.
+     */
+    void clearPreview();
+
+    /**
+     * Requests the preview of the hovered remote object to the target
+     * application, caches it and shows it.
+     */
+    void requestPreview();
+
     /**
      * Emits remoteObjectChosen(RemoteObject*) and closes this
      * RemoteObjectChooser.
@@ -130,8 +130,7 @@ throw (DBusException) {
 
 void RemoteObjectNameRegister::deregisterRemoteObject(
                                                     RemoteObject* remoteObject,
-                                                    RemoteObject* parent)
-throw (DBusException) {
+                                                    RemoteObject* parent) {
     Q_ASSERT(remoteObject);
 
     //The remote object is no longer accessible, so name() can't be called
@@ -142,7 +141,7 @@ throw (DBusException) {
     mRemoteObjectForName.remove(name, remoteObject);
     mRemoteObjectForParent.remove(parent, remoteObject);
 
-    foreach (RemoteObject* child, remoteObject->children()) {
+    foreach (RemoteObject* child, mRemoteObjectForParent.values(remoteObject)) {
         deregisterRemoteObject(child, remoteObject);
     }
 }
@@ -329,6 +328,9 @@ void RemoteObjectNameRegister::registerRemoteObjects() {
             TargetApplication::self()->remoteEditorSupport()->enableEventSpy();
         connect(remoteEventSpy, SIGNAL(eventReceived(RemoteObject*,QString)),
                 this, SLOT(updateRemoteObjects(RemoteObject*,QString)));
+        connect(remoteEventSpy,
+                SIGNAL(remoteObjectAboutToBeDestroyed(RemoteObject*)),
+                this, SLOT(deregisterDestroyedRemoteObject(RemoteObject*)));
     } catch (DBusException e) {
         kWarning() << "The remote event spy could not be connected to provide"
                    << "name completion updates (" << e.message() << ").";
@@ -383,6 +385,16 @@ void RemoteObjectNameRegister::updateRemoteObjects(RemoteObject* remoteObject,
     }
 }
 
+void RemoteObjectNameRegister::deregisterDestroyedRemoteObject(
+                                                RemoteObject* remoteObject) {
+    QList<RemoteObject*> parents = mRemoteObjectForParent.keys(remoteObject);
+    if (parents.isEmpty()) {
+        return;
+    }
+
+    deregisterRemoteObject(remoteObject, parents.first());
+}
+
 void RemoteObjectNameRegister::deferredRegisterRemoteObjectName() {
     QPointer<RemoteObject> remoteObject =
                                 mRemoteObjectsPendingNameRegister.takeFirst();
@@ -229,15 +229,14 @@ private:
     throw (DBusException);
 
     /**
-     * Deregisters the given RemoteObject and all its children.
+     * Deregisters the given RemoteObject and all its registered children.
+     * The remote object may no longer exist, so it is not queried.
      *
      * @param remoteObject The RemoteObject to deregister.
      * @param parent The parent of the RemoteObject to deregister.
-     * @throws DBusException If a DBus error happens.
      */
     void deregisterRemoteObject(RemoteObject* remoteObject,
-                                RemoteObject* parent)
-    throw (DBusException);
+                                RemoteObject* parent);
 
     /**
      * Returns the best name for the given remote object.
@@ -387,6 +386,14 @@ private Q_SLOTS:
     void updateRemoteObjects(RemoteObject* remoteObject,
                              const QString& eventType);
 
+    /**
+     * Deregisters the given RemoteObject and all its registered children, as
+     * it is about to be destroyed.
+     *
+     * @param remoteObject The RemoteObject about to be destroyed.
+     */
+    void deregisterDestroyedRemoteObject(RemoteObject* remoteObject);
+
     /**
      * Registers, if it is still available, the name of the remote object
      * pending since the longest time ago.
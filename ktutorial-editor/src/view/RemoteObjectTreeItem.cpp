@@ -75,6 +75,10 @@ void RemoteObjectTreeItem::setUpdater(RemoteObjectTreeItemUpdater* updater) {
 }
 
 void RemoteObjectTreeItem::updateChildren() {
+    if (!mRemoteObject) {
+        return;
+    }
+
     QList<RemoteObject*> children;
     try {
         children = mRemoteObject->children();
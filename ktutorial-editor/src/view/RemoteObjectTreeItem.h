@@ -19,6 +19,8 @@
 #ifndef REMOTEOBJECTTREEITEM_H
 #define REMOTEOBJECTTREEITEM_H
 
+#include <QPointer>
+
 #include "TreeItem.h"
 
 class RemoteObject;
@@ -73,6 +75,7 @@ public:
 
     /**
      * Returns the RemoteObject.
+     * If the remote object was destroyed, a null pointer is returned.
      *
      * @return The RemoteObject.
      */
@@ -95,8 +98,10 @@ private:
 
     /**
      * The RemoteObject.
+     * A guarded pointer is needed, as the RemoteObject is destroyed if the
+     * remote object is destroyed in the target application.
      */
-    RemoteObject* mRemoteObject;
+    QPointer<RemoteObject> mRemoteObject;
 
     /**
      * The updater for this RemoteObjectTreeItem and all its children.
@@ -30,6 +30,9 @@ void RemoteObjectTreeItemUpdater::setRemoteEventSpy(
                                             RemoteEventSpy* remoteEventSpy) {
     connect(remoteEventSpy, SIGNAL(eventReceived(RemoteObject*,QString)),
             this, SLOT(handleEventReceived(RemoteObject*,QString)));
+    connect(remoteEventSpy,
+            SIGNAL(remoteObjectAboutToBeDestroyed(RemoteObject*)),
+            this, SLOT(handleRemoteObjectAboutToBeDestroyed(RemoteObject*)));
 }
 
 void RemoteObjectTreeItemUpdater::registerRemoteObjectTreeItem(
@@ -58,3 +61,8 @@ void RemoteObjectTreeItemUpdater::handleEventReceived(
 
     mRemoteObjectTreeItems.value(remoteObject)->updateChildren();
 }
+
+void RemoteObjectTreeItemUpdater::handleRemoteObjectAboutToBeDestroyed(
+                                                RemoteObject* remoteObject) {
+    mRemoteObjectTreeItems.remove(remoteObject);
+}
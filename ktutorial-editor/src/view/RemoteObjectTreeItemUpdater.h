@@ -88,6 +88,14 @@ private Q_SLOTS:
     void handleEventReceived(RemoteObject* remoteObject,
                              const QString& eventType);
 
+    /**
+     * Forgets the RemoteObjectTreeItem of the given RemoteObject, as it is
+     * about to be destroyed.
+     *
+     * @param remoteObject The RemoteObject about to be destroyed.
+     */
+    void handleRemoteObjectAboutToBeDestroyed(RemoteObject* remoteObject);
+
 };
 
 #endif
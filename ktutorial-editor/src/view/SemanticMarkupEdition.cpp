@@ -19,6 +19,7 @@
 #include "SemanticMarkupEdition.h"
 
 #include <QRegExp>
+#include <QTextDocument>
 #include <QTextEdit>
 
 #include <KAction>
@@ -39,6 +40,10 @@ SemanticMarkupEdition::SemanticMarkupEdition(
     mTextEdit(textEdit) {
     Q_ASSERT(textEdit);
 
+    mParser.parse(mTextEdit->toPlainText());
+
+    connect(mTextEdit->document(), SIGNAL(contentsChange(int,int,int)),
+            this, SLOT(updateParser(int,int,int)));
     connect(mTextEdit, SIGNAL(cursorPositionChanged()),
             this, SLOT(updateActionStates()));
     //TODO Needed to update the action states when the user deletes a character;
@@ -240,6 +245,12 @@ QDialog* SemanticMarkupEdition::newLinkDialog( //krazy:exclude=qclasses
 
 //private slots:
 
+void SemanticMarkupEdition::updateParser(int position, int charsRemoved,
+                                         int charsAdded) {
+    mParser.update(mTextEdit->toPlainText(), position, charsRemoved,
+                   charsAdded);
+}
+
 void SemanticMarkupEdition::updateActionStates() {
     Q_ASSERT(!mActions.isEmpty());
 
@@ -250,11 +261,10 @@ void SemanticMarkupEdition::updateActionStates() {
 
     mLinkElementClosed = false;
 
-    SemanticMarkupParser parser;
-    parser.setCursorIndex(mTextEdit->textCursor().position());
-    parser.parse(mTextEdit->toPlainText());
+    mParser.setCursorIndex(mTextEdit->textCursor().position());
+    mParser.locateCursor();
 
-    if (parser.isCursorInsideTag()) {
+    if (mParser.isCursorInsideTag()) {
         foreach (QAction* action, mActions) {
             action->setEnabled(false);
         }
@@ -262,7 +272,7 @@ void SemanticMarkupEdition::updateActionStates() {
         return;
     }
 
-    QList<StartTag> openElementsAtCursor = parser.openElementsAtCursor();
+    QList<StartTag> openElementsAtCursor = mParser.openElementsAtCursor();
     if (openElementsAtCursor.isEmpty()) {
         mListAction->setEnabled(false);
         mItemAction->setEnabled(false);
@@ -283,7 +293,7 @@ void SemanticMarkupEdition::updateActionStates() {
 
         action->setChecked(true);
 
-        bool elementClosed = parser.isElementClosed(startTag);
+        bool elementClosed = mParser.isElementClosed(startTag);
         if (elementClosed && action != mLinkAction) {
             action->setEnabled(false);
         } else if (elementClosed && action == mLinkAction) {
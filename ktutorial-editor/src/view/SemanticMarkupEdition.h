@@ -21,14 +21,14 @@
 
 #include <QObject>
 
+#include "SemanticMarkupParser.h"
+
 class QAction;
 class QDialog;
 class QTextEdit;
 
 class KActionCollection;
 
-class StartTag;
-
 /**
  * Helper to edit KUIT semantic markup in a QTextEdit widget.
  * SemanticMarkupEdition provides several actions that ease the edition of the
@@ -145,6 +145,12 @@ private:
      */
     QTextEdit* mTextEdit; //krazy:exclude=qclasses
 
+    /**
+     * The parser for the text, kept up to date with the changes in the
+     * document of the text edit.
+     */
+    SemanticMarkupParser mParser;
+
     /**
      * Whether the cursor is between two paired start and end link elements or
      * not.
@@ -181,6 +187,16 @@ private:
 
 private Q_SLOTS:
 
+    /**
+     * Updates the parser with a change in the document of the text edit.
+     * Only the lines touched by the change are lexed again.
+     *
+     * @param position The position where the change happened.
+     * @param charsRemoved The number of characters removed.
+     * @param charsAdded The number of characters added.
+     */
+    void updateParser(int position, int charsRemoved, int charsAdded);
+
     /**
      * Updates the state of the edition actions based on the cursor position.
      */
@@ -18,14 +18,19 @@
 
 #include "SemanticMarkupParser.h"
 
-#include <QRegExp>
 #include <QStringList>
 
 //public:
 
 SemanticMarkupParser::SemanticMarkupParser():
+    mTextLength(0),
     mCursorIndex(-1),
     mCursorInsideTag(false) {
+    QString startTagPattern("<\\s*(\\w+)\\s*((\\w+=\"[^\"]*\"\\s*)*)>");
+    QString endTagPattern("</\\s*(\\w+)\\s*>");
+    QString emptyTagPattern("<\\s*(\\w+)\\s*((\\w+=\"[^\"]*\"\\s*)*)/>");
+    mTagRegExp.setPattern(startTagPattern + '|' + endTagPattern + '|' +
+                          emptyTagPattern);
 }
 
 void SemanticMarkupParser::setCursorIndex(int cursorIndex) {
@@ -33,64 +38,112 @@ void SemanticMarkupParser::setCursorIndex(int cursorIndex) {
 }
 
 void SemanticMarkupParser::parse(const QString& text) {
-    mCursorInsideTag = false;
-    mOpenElements.clear();
-    mOpenElementsAtCursor.clear();
-    mNotClosedChildElements.clear();
-
-    QRegExp startTagRegExp("<\\s*(\\w+)\\s*((\\w+=\"[^\"]*\"\\s*)*)>");
-    QRegExp endTagRegExp("</\\s*(\\w+)\\s*>");
-    QRegExp emptyTagRegExp("<\\s*(\\w+)\\s*((\\w+=\"[^\"]*\"\\s*)*)/>");
-    QRegExp tagRegExp(startTagRegExp.pattern() + '|' +
-                      endTagRegExp.pattern() + '|' +
-                      emptyTagRegExp.pattern());
-
-    bool parsingReachedCursor = false;
-
-    int parsingIndex = tagRegExp.indexIn(text);
-    while (parsingIndex >= 0) {
-        QString tag = tagRegExp.capturedTexts().at(0);
-
-        if (mCursorIndex > parsingIndex &&
-            mCursorIndex < parsingIndex + tagRegExp.matchedLength()) {
-            mCursorInsideTag = true;
-            mOpenElementsAtCursor.clear();
-            return;
-        }
+    mTags.clear();
+    mTextLength = text.length();
+
+    lex(text, 0, text.length(), 0);
+    computeElementState(0);
+    locateCursor();
+}
+
+void SemanticMarkupParser::update(const QString& text, int position,
+                                  int charsRemoved, int charsAdded) {
+    if (position < 0 || charsRemoved < 0 || charsAdded < 0 ||
+            position + charsRemoved > mTextLength ||
+            position + charsAdded > text.length() ||
+            mTextLength - charsRemoved + charsAdded != text.length()) {
+        parse(text);
+        return;
+    }
+
+    int lengthDifference = charsAdded - charsRemoved;
+
+    //Lex again the lines touched by the change, extended to the first
+    //unclosed '<' before them and the first unopened '>' after them, as a tag
+    //may span several lines
+    int start = 0;
+    if (position > 0) {
+        start = text.lastIndexOf('\n', position - 1) + 1;
+    }
+    if (start > 0 && text.lastIndexOf('<', start - 1) >
+                     text.lastIndexOf('>', start - 1)) {
+        start = text.lastIndexOf('<', start - 1);
+    }
+
+    int end = text.indexOf('\n', position + charsAdded);
+    if (end == -1) {
+        end = text.length();
+    }
+    int nextOpen = text.indexOf('<', end);
+    int nextClose = text.indexOf('>', end);
+    if (nextClose != -1 && (nextOpen == -1 || nextClose < nextOpen)) {
+        end = nextClose + 1;
+    }
+
+    //Remove the tags that overlap with the lexed text (extending it as
+    //needed) and shift the tags after the change
+    int firstRemoved = 0;
+    while (firstRemoved < mTags.count() &&
+           mTags[firstRemoved].mIndex + mTags[firstRemoved].mLength <= start) {
+        firstRemoved++;
+    }
 
-        if (!parsingReachedCursor && parsingIndex >= mCursorIndex) {
-            parsingReachedCursor = true;
-            mOpenElementsAtCursor = mOpenElements;
+    if (firstRemoved < mTags.count() && mTags[firstRemoved].mIndex < start) {
+        start = mTags[firstRemoved].mIndex;
+    }
+
+    int i = firstRemoved;
+    while (i < mTags.count() && mTags[i].mIndex < position + charsRemoved) {
+        int tagEnd = mTags[i].mIndex + mTags[i].mLength;
+        if (tagEnd > position + charsRemoved) {
+            end = qMax(end, tagEnd + lengthDifference);
         }
+        mTags.removeAt(i);
+    }
 
-        if (startTagRegExp.exactMatch(tag)) {
-            StartTag startTag;
-            startTag.mName = startTagRegExp.capturedTexts().at(1);
-            startTag.mAttributes = startTagRegExp.capturedTexts().at(2);
-            startTag.mIndex = parsingIndex;
-            mOpenElements.insert(0, startTag);
-        } else if (endTagRegExp.exactMatch(tag)) {
-            QString endTagName = endTagRegExp.capturedTexts().at(1);
-
-            int endElementIndex = indexOf(mOpenElements, endTagName);
-            if (endElementIndex >= 0) {
-                int index = 0;
-                while (index < endElementIndex) {
-                    mNotClosedChildElements.append(mOpenElements.first());
-                    mOpenElements.removeFirst();
-                    index++;
-                }
-                mOpenElements.removeFirst();
-            }
+    for (int j = i; j < mTags.count(); ++j) {
+        mTags[j].mIndex += lengthDifference;
+    }
+
+    while (i < mTags.count() && mTags[i].mIndex < end) {
+        end = qMax(end, mTags[i].mIndex + mTags[i].mLength);
+        mTags.removeAt(i);
+    }
+
+    mTextLength = text.length();
+
+    lex(text, start, end, firstRemoved);
+    computeElementState(firstRemoved);
+    locateCursor();
+}
+
+void SemanticMarkupParser::locateCursor() {
+    mCursorInsideTag = false;
+    mOpenElementsAtCursor.clear();
+
+    //Binary search for the first tag at or after the cursor
+    int first = 0;
+    int last = mTags.count();
+    while (first < last) {
+        int middle = (first + last) / 2;
+        if (mTags[middle].mIndex < mCursorIndex) {
+            first = middle + 1;
+        } else {
+            last = middle;
         }
+    }
 
-        parsingIndex = parsingIndex + tagRegExp.matchedLength();
-        parsingIndex = tagRegExp.indexIn(text, parsingIndex);
+    if (first == 0) {
+        return;
     }
 
-    if (!parsingReachedCursor) {
-        mOpenElementsAtCursor = mOpenElements;
+    const Tag& previousTag = mTags[first - 1];
+    if (mCursorIndex < previousTag.mIndex + previousTag.mLength) {
+        mCursorInsideTag = true;
+        return;
     }
+
+    mOpenElementsAtCursor = previousTag.mOpenElements;
 }
 
 bool SemanticMarkupParser::isElementClosed(const StartTag& startTag) const {
@@ -135,3 +188,79 @@ int SemanticMarkupParser::indexOf(const QList<StartTag>& startTags,
 
     return -1;
 }
+
+void SemanticMarkupParser::lex(const QString& text, int start, int end,
+                               int position) {
+    int parsingIndex = mTagRegExp.indexIn(text, start);
+    while (parsingIndex >= 0 && parsingIndex < end) {
+        Tag tag;
+        tag.mStart = mTagRegExp.pos(1) != -1;
+        tag.mEnd = mTagRegExp.pos(4) != -1;
+        if (tag.mStart) {
+            tag.mName = mTagRegExp.cap(1);
+            tag.mAttributes = mTagRegExp.cap(2);
+        } else if (tag.mEnd) {
+            tag.mName = mTagRegExp.cap(4);
+        } else {
+            tag.mName = mTagRegExp.cap(5);
+            tag.mAttributes = mTagRegExp.cap(6);
+        }
+        tag.mIndex = parsingIndex;
+        tag.mLength = mTagRegExp.matchedLength();
+        tag.mNotClosedChildElementsCount = 0;
+
+        mTags.insert(position, tag);
+        position++;
+
+        parsingIndex = parsingIndex + tag.mLength;
+
+        while (position < mTags.count() &&
+               mTags[position].mIndex < parsingIndex) {
+            end = qMax(end, mTags[position].mIndex + mTags[position].mLength);
+            mTags.removeAt(position);
+        }
+
+        parsingIndex = mTagRegExp.indexIn(text, parsingIndex);
+    }
+}
+
+void SemanticMarkupParser::computeElementState(int position) {
+    QList<StartTag> openElements;
+    int notClosedChildElementsCount = 0;
+    if (position > 0) {
+        openElements = mTags[position - 1].mOpenElements;
+        notClosedChildElementsCount =
+                            mTags[position - 1].mNotClosedChildElementsCount;
+    }
+
+    mNotClosedChildElements = mNotClosedChildElements.mid(0,
+                                                notClosedChildElementsCount);
+
+    for (int i = position; i < mTags.count(); ++i) {
+        Tag& tag = mTags[i];
+
+        if (tag.mStart) {
+            StartTag startTag;
+            startTag.mName = tag.mName;
+            startTag.mAttributes = tag.mAttributes;
+            startTag.mIndex = tag.mIndex;
+            openElements.insert(0, startTag);
+        } else if (tag.mEnd) {
+            int endElementIndex = indexOf(openElements, tag.mName);
+            if (endElementIndex >= 0) {
+                int index = 0;
+                while (index < endElementIndex) {
+                    mNotClosedChildElements.append(openElements.first());
+                    openElements.removeFirst();
+                    index++;
+                }
+                openElements.removeFirst();
+            }
+        }
+
+        tag.mOpenElements = openElements;
+        tag.mNotClosedChildElementsCount = mNotClosedChildElements.count();
+    }
+
+    mOpenElements = openElements;
+}
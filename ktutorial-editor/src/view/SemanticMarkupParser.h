@@ -20,6 +20,7 @@
 #define SEMANTICMARKUPPARSER_H
 
 #include <QList>
+#include <QRegExp>
 #include <QString>
 
 /**
@@ -80,7 +81,13 @@ struct StartTag {
  * Once parsed, the SemanticMarkupParser object provides information about the
  * parsed text regarding the cursor position. To update the information provided
  * the text must be parsed again; that is, even if the only change is in the
- * cursor index, parse(QString) has to be called again.
+ * cursor index, parse(QString) has to be called again. However, as the parser
+ * keeps the tags found in the text, the information can also be updated
+ * without lexing the text again. When only the cursor index changed,
+ * locateCursor() just looks for the cursor among the known tags. When the text
+ * was edited, update(QString, int, int, int) lexes again only the lines
+ * affected by the change, and reuses the element state computed for the tags
+ * before it.
  */
 class SemanticMarkupParser {
 public:
@@ -104,6 +111,29 @@ public:
      */
     void parse(const QString& text);
 
+    /**
+     * Updates the state of this parser after a change in the last parsed text.
+     * The parameters of the change are those provided by
+     * QTextDocument::contentsChange(int, int, int). Only the lines touched by
+     * the change are lexed again; if the change does not match the last parsed
+     * text, the whole text is parsed again.
+     *
+     * @param text The text after the change.
+     * @param position The position where the change happened.
+     * @param charsRemoved The number of characters removed.
+     * @param charsAdded The number of characters added.
+     */
+    void update(const QString& text, int position, int charsRemoved,
+                int charsAdded);
+
+    /**
+     * Updates the information regarding the cursor position without parsing
+     * the text again.
+     * It should be called when the cursor index was changed but the text was
+     * not.
+     */
+    void locateCursor();
+
     /**
      * Returns whether the cursor is inside a tag or not.
      *
@@ -132,6 +162,69 @@ public:
 
 private:
 
+    /**
+     * Structure to store a tag found in the text and the state of the elements
+     * after it.
+     */
+    struct Tag {
+
+        /**
+         * The tag is a start tag.
+         */
+        bool mStart;
+
+        /**
+         * The tag is an end tag.
+         */
+        bool mEnd;
+
+        /**
+         * The tag name.
+         */
+        QString mName;
+
+        /**
+         * The attributes, if any.
+         */
+        QString mAttributes;
+
+        /**
+         * The index of the tag in the text.
+         */
+        int mIndex;
+
+        /**
+         * The length of the tag in the text.
+         */
+        int mLength;
+
+        /**
+         * A list with all the open elements just after the tag.
+         */
+        QList<StartTag> mOpenElements;
+
+        /**
+         * The number of not closed child elements just after the tag.
+         */
+        int mNotClosedChildElementsCount;
+
+    };
+
+    /**
+     * The regular expression that matches start, end and empty element tags.
+     */
+    QRegExp mTagRegExp;
+
+    /**
+     * The tags found in the last parsed text, sorted by their index.
+     */
+    QList<Tag> mTags;
+
+    /**
+     * The length of the last parsed text.
+     */
+    int mTextLength;
+
     /**
      * The position of the cursor in the text.
      */
@@ -177,6 +270,29 @@ private:
     int indexOf(const QList<StartTag>& startTags,
                 const StartTag& startTag) const;
 
+    /**
+     * Lexes the text between the given indexes and inserts the tags found in
+     * the given position of the tag list.
+     * If a tag found extends beyond the end index, the following tags in the
+     * list that overlap with it are removed and the text is lexed until their
+     * end.
+     *
+     * @param text The text to lex.
+     * @param start The index to start lexing at.
+     * @param end The index to stop lexing at.
+     * @param position The position in the tag list to insert the tags at.
+     */
+    void lex(const QString& text, int start, int end, int position);
+
+    /**
+     * Updates the element state stored in the tags, starting at the given
+     * position in the tag list.
+     * The state of the tags before that position is reused.
+     *
+     * @param position The position in the tag list to start at.
+     */
+    void computeElementState(int position);
+
 };
 
 #endif
@@ -38,8 +38,8 @@ StepTreeItem::StepTreeItem(Step* step, TreeItem* parent):
     mTearDownItem = 0;
 
     update(step);
-    connect(step, SIGNAL(dataChanged(Step*)),
-            this, SLOT(update(Step*)));
+    connect(step, SIGNAL(fieldChanged(Step*,Step::Field)),
+            this, SLOT(update(Step*,Step::Field)));
 
     foreach(Reaction* reaction, step->reactions()) {
         addReaction(reaction, mReactionTreeItems.count());
@@ -76,9 +76,14 @@ ReactionTreeItem* StepTreeItem::reactionTreeItemForReaction(
     return 0;
 }
 
-//private slots:
-
 void StepTreeItem::update(Step* step) {
+    update(step, Step::IdField);
+    update(step, Step::TextField);
+    update(step, Step::CustomSetupCodeField);
+    update(step, Step::CustomTearDownCodeField);
+}
+
+void StepTreeItem::updateId(Step* step) {
     if (step->id().isEmpty()) {
         if (!mStepId.isEmpty()) {
             mStepId.clear();
@@ -88,7 +93,9 @@ void StepTreeItem::update(Step* step) {
         mStepId = step->id();
         emit dataChanged(this);
     }
+}
 
+void StepTreeItem::updateText(Step* step) {
     QString text;
     if (step->text().isEmpty()) {
         text = i18nc("@item:intext", "(text not set)");
@@ -96,26 +103,40 @@ void StepTreeItem::update(Step* step) {
         text = step->text();
     }
     mTextItem->setText(i18nc("@item", "Text: %1", text));
+}
+
+//private slots:
 
+void StepTreeItem::update(Step* step, Step::Field field) {
+    if (field == Step::IdField) {
+        updateId(step);
+    }
+
+    if (field == Step::TextField) {
+        updateText(step);
+    }
+
+    //The optional items are always shown after the text, and in the same
+    //order: setup and tear down
     int childIndex = 1;
 
-    if (step->customSetupCode().isEmpty()) {
-        TreeItemUtil::removeNestedItemIfNeeded(mSetupItem);
-    } else {
-        TreeItemUtil::addNestedItemIfNeeded(this, mSetupItem, childIndex,
-                                            i18nc("@item", "Setup:"));
-        mSetupItem->setText(step->customSetupCode());
+    if (field == Step::CustomSetupCodeField) {
+        TreeItemUtil::updateNestedItem(this, mSetupItem, childIndex,
+                                       i18nc("@item", "Setup:"),
+                                       step->customSetupCode());
+    }
 
+    if (mSetupItem) {
         childIndex++;
     }
 
-    if (step->customTearDownCode().isEmpty()) {
-        TreeItemUtil::removeNestedItemIfNeeded(mTearDownItem);
-    } else {
-        TreeItemUtil::addNestedItemIfNeeded(this, mTearDownItem, childIndex,
-                                            i18nc("@item", "Tear down:"));
-        mTearDownItem->setText(step->customTearDownCode());
+    if (field == Step::CustomTearDownCodeField) {
+        TreeItemUtil::updateNestedItem(this, mTearDownItem, childIndex,
+                                       i18nc("@item", "Tear down:"),
+                                       step->customTearDownCode());
+    }
 
+    if (mTearDownItem) {
         childIndex++;
     }
 
@@ -20,10 +20,10 @@
 #define STEPTREEITEM_H
 
 #include "TreeItem.h"
+#include "../data/Step.h"
 
 class Reaction;
 class ReactionTreeItem;
-class Step;
 class TextTreeItem;
 
 /**
@@ -54,7 +54,8 @@ class TextTreeItem;
  * even the parent item with just "Setup:".
  *
  * Whenever the step data changes, the StepTreeItem and its child items
- * are updated as needed.
+ * are updated as needed. Only the child items that show the changed data are
+ * updated.
  *
  * Also note that the order of the child elements is always the same. Even if,
  * for example, the tear down code is set first and then the setup code, the
@@ -141,19 +142,42 @@ private:
      */
     ReactionTreeItem* reactionTreeItemForReaction(Reaction* reaction) const;
 
+    /**
+     * Updates the child items for all the data of the step.
+     *
+     * @param step The step.
+     */
+    void update(Step* step);
+
+    /**
+     * Updates the id of this StepTreeItem.
+     *
+     * @param step The step.
+     */
+    void updateId(Step* step);
+
+    /**
+     * Updates the text item.
+     *
+     * @param step The step.
+     */
+    void updateText(Step* step);
+
 private Q_SLOTS:
 
     /**
-     * Updates this StepTreeItem when the data of its step changed.
-     * If a child item is needed to show some data, it is inserted or updated
-     * (depending on whether it existed previously or not).
-     * If the child item is no longer needed, it is removed.
+     * Updates this StepTreeItem when an attribute of its step changed.
+     * If a child item is needed to show the attribute, it is inserted or
+     * updated (depending on whether it existed previously or not).
+     * If the child item is no longer needed, it is removed. The child items for
+     * other attributes are not modified.
      *
      * Items may be flat or nested, depending on the data to show.
      *
      * @param step The step.
+     * @param field The attribute that changed.
      */
-    void update(Step* step);
+    void update(Step* step, Step::Field field);
 
     /**
      * Adds a new ReactionTreeItem when a Reaction is added in the step.
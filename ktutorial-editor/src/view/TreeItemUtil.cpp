@@ -58,3 +58,14 @@ void TreeItemUtil::removeNestedItemIfNeeded(TextTreeItem*& item) {
         item = 0;
     }
 }
+
+void TreeItemUtil::updateNestedItem(TreeItem* root, TextTreeItem*& item,
+                                    int index, const QString& parentText,
+                                    const QString& text) {
+    if (text.isEmpty()) {
+        removeNestedItemIfNeeded(item);
+    } else {
+        addNestedItemIfNeeded(root, item, index, parentText);
+        item->setText(text);
+    }
+}
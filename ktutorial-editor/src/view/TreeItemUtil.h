@@ -74,6 +74,25 @@ public:
      */
     static void removeNestedItemIfNeeded(TextTreeItem*& item);
 
+    /**
+     * Inserts, updates or removes the given nested item.
+     * If the text is empty, the item is removed. Otherwise, it is inserted (if
+     * it did not exist yet) at the given index in the root item and its text
+     * is set.
+     *
+     * @param root The root item to add the parent item to.
+     * @param item The item to update.
+     * @param index The index in the root item to add the parent item.
+     * @param parentText The text of the parent of the item.
+     * @param text The text to set in the item.
+     * @see addNestedItemIfNeeded(TreeItem*, TextTreeItem*&, int,
+     *                            const QString&)
+     * @see removeNestedItemIfNeeded(TextTreeItem*&)
+     */
+    static void updateNestedItem(TreeItem* root, TextTreeItem*& item,
+                                 int index, const QString& parentText,
+                                 const QString& text);
+
 };
 
 #endif
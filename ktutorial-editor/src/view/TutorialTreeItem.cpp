@@ -40,8 +40,8 @@ TutorialTreeItem::TutorialTreeItem(Tutorial* tutorial, TreeItem* parent):
     mTearDownItem = 0;
 
     update(tutorial);
-    connect(tutorial, SIGNAL(dataChanged(Tutorial*)),
-            this, SLOT(update(Tutorial*)));
+    connect(tutorial, SIGNAL(fieldChanged(Tutorial*,Tutorial::Field)),
+            this, SLOT(update(Tutorial*,Tutorial::Field)));
 
     foreach(Step* step, tutorial->steps()) {
         addStep(step, mStepTreeItems.count());
@@ -72,9 +72,15 @@ StepTreeItem* TutorialTreeItem::stepTreeItemForStep(Step* step) {
     return 0;
 }
 
-//private slots:
-
 void TutorialTreeItem::update(Tutorial* tutorial) {
+    update(tutorial, Tutorial::NameField);
+    update(tutorial, Tutorial::DescriptionField);
+    update(tutorial, Tutorial::LicenseTextField);
+    update(tutorial, Tutorial::CustomSetupCodeField);
+    update(tutorial, Tutorial::CustomTearDownCodeField);
+}
+
+void TutorialTreeItem::updateName(Tutorial* tutorial) {
     QString name;
     if (tutorial->name().isEmpty()) {
         name = i18nc("@item:intext", "(name not set)");
@@ -91,7 +97,9 @@ void TutorialTreeItem::update(Tutorial* tutorial) {
     }
     mNameItem->setText(i18nc("@item Noun, the name of a tutorial",
                              "Name: %1", name));
+}
 
+void TutorialTreeItem::updateDescription(Tutorial* tutorial) {
     QString description;
     if (tutorial->description().isEmpty()) {
         description = i18nc("@item:intext", "(description not set)");
@@ -99,36 +107,50 @@ void TutorialTreeItem::update(Tutorial* tutorial) {
         description = tutorial->description();
     }
     mDescriptionItem->setText(i18nc("@item", "Description: %1", description));
+}
+
+//private slots:
+
+void TutorialTreeItem::update(Tutorial* tutorial, Tutorial::Field field) {
+    if (field == Tutorial::NameField) {
+        updateName(tutorial);
+    }
+
+    if (field == Tutorial::DescriptionField) {
+        updateDescription(tutorial);
+    }
 
+    //The optional items are always shown after the name and the description,
+    //and in the same order: license, setup and tear down
     int childIndex = 2;
 
-    if (tutorial->licenseText().isEmpty()) {
-        TreeItemUtil::removeNestedItemIfNeeded(mLicenseItem);
-    } else {
-        TreeItemUtil::addNestedItemIfNeeded(this, mLicenseItem, childIndex,
-                                            i18nc("@item", "License:"));
-        mLicenseItem->setText(tutorial->licenseText());
+    if (field == Tutorial::LicenseTextField) {
+        TreeItemUtil::updateNestedItem(this, mLicenseItem, childIndex,
+                                       i18nc("@item", "License:"),
+                                       tutorial->licenseText());
+    }
 
+    if (mLicenseItem) {
         childIndex++;
     }
 
-    if (tutorial->customSetupCode().isEmpty()) {
-        TreeItemUtil::removeNestedItemIfNeeded(mSetupItem);
-    } else {
-        TreeItemUtil::addNestedItemIfNeeded(this, mSetupItem, childIndex,
-                                            i18nc("@item", "Setup:"));
-        mSetupItem->setText(tutorial->customSetupCode());
+    if (field == Tutorial::CustomSetupCodeField) {
+        TreeItemUtil::updateNestedItem(this, mSetupItem, childIndex,
+                                       i18nc("@item", "Setup:"),
+                                       tutorial->customSetupCode());
+    }
 
+    if (mSetupItem) {
         childIndex++;
     }
 
-    if (tutorial->customTearDownCode().isEmpty()) {
-        TreeItemUtil::removeNestedItemIfNeeded(mTearDownItem);
-    } else {
-        TreeItemUtil::addNestedItemIfNeeded(this, mTearDownItem, childIndex,
-                                            i18nc("@item", "Tear down:"));
-        mTearDownItem->setText(tutorial->customTearDownCode());
+    if (field == Tutorial::CustomTearDownCodeField) {
+        TreeItemUtil::updateNestedItem(this, mTearDownItem, childIndex,
+                                       i18nc("@item", "Tear down:"),
+                                       tutorial->customTearDownCode());
+    }
 
+    if (mTearDownItem) {
         childIndex++;
     }
 
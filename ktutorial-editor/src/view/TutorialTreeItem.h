@@ -20,11 +20,11 @@
 #define TUTORIALTREEITEM_H
 
 #include "TreeItem.h"
+#include "../data/Tutorial.h"
 
 class Step;
 class StepTreeItem;
 class TextTreeItem;
-class Tutorial;
 
 /**
  * A TreeItem that represents a Tutorial.
@@ -58,7 +58,8 @@ class Tutorial;
  * parent item with just "License:".
  *
  * Whenever the tutorial data changes, the TutorialTreeItem and its child items
- * are updated as needed.
+ * are updated as needed. Only the child items that show the changed data are
+ * updated.
  *
  * Also note that the order of the child elements is always the same. Even if,
  * for example, the tear down code is set first and then the license, the
@@ -145,19 +146,42 @@ private:
      */
     StepTreeItem* stepTreeItemForStep(Step* step);
 
+    /**
+     * Updates the child items for all the data of the tutorial.
+     *
+     * @param tutorial The tutorial.
+     */
+    void update(Tutorial* tutorial);
+
+    /**
+     * Updates the name item, and the id of this TutorialTreeItem.
+     *
+     * @param tutorial The tutorial.
+     */
+    void updateName(Tutorial* tutorial);
+
+    /**
+     * Updates the description item.
+     *
+     * @param tutorial The tutorial.
+     */
+    void updateDescription(Tutorial* tutorial);
+
 private Q_SLOTS:
 
     /**
-     * Updates this TutorialTreeItem when the data of its tutorial changed.
-     * If a child item is needed to show some data, it is inserted or updated
-     * (depending on whether it existed previously or not).
-     * If the child item is no longer needed, it is removed.
+     * Updates this TutorialTreeItem when an attribute of its tutorial changed.
+     * If a child item is needed to show the attribute, it is inserted or
+     * updated (depending on whether it existed previously or not).
+     * If the child item is no longer needed, it is removed. The child items for
+     * other attributes are not modified.
      *
      * Items may be flat or nested, depending on the data to show.
      *
      * @param tutorial The tutorial.
+     * @param field The attribute that changed.
      */
-    void update(Tutorial* tutorial);
+    void update(Tutorial* tutorial, Tutorial::Field field);
 
     /**
      * Adds a new StepTreeItem when a Step is added in the tutorial.
@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "JavaScriptExporter.h"
+#include "../data/Reaction.h"
+#include "../data/Step.h"
+#include "../data/Tutorial.h"
+#include "../data/WaitForSignal.h"
+
+/**
+ * Benchmarks the time needed to export a tutorial with 2000 steps to
+ * JavaScript with a new exporter, and to export it again with the same exporter
+ * with and without modifying one of its steps.
+ */
+class JavaScriptExporterBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkExportTutorial();
+    void benchmarkExportTutorialAgain();
+    void benchmarkExportTutorialAgainAfterChangingOneStep();
+
+private:
+
+    Tutorial* mTutorial;
+
+};
+
+void JavaScriptExporterBenchmark::initTestCase() {
+    QString customCode;
+    for (int i=0; i<16; ++i) {
+        customCode += QString("var value%1 = someObject.someMethod(\"some "
+                              "<argument>\", %1);\n").arg(i);
+    }
+
+    mTutorial = new Tutorial();
+    mTutorial->setName("A large tutorial");
+    mTutorial->setDescription("A tutorial with lots of steps");
+
+    for (int i=0; i<2000; ++i) {
+        Step* step = new Step();
+        step->setId(QString("step%1").arg(i));
+        step->setText(QString("The text of the step %1, with <emphasis>some "
+                              "markup</emphasis>").arg(i));
+        step->setCustomSetupCode(customCode);
+
+        WaitForSignal* waitForSignal = new WaitForSignal();
+        waitForSignal->setEmitterName(QString("emitter%1").arg(i));
+        waitForSignal->setSignalName(QString("theSignal%1()").arg(i));
+
+        Reaction* reaction = new Reaction();
+        reaction->setTriggerType(Reaction::ConditionMet);
+        reaction->setWaitFor(waitForSignal);
+        reaction->setResponseType(Reaction::NextStep);
+        reaction->setNextStepId(QString("step%1").arg(i + 1));
+        step->addReaction(reaction);
+
+        mTutorial->addStep(step);
+    }
+}
+
+void JavaScriptExporterBenchmark::cleanupTestCase() {
+    delete mTutorial;
+}
+
+void JavaScriptExporterBenchmark::benchmarkExportTutorial() {
+    QBENCHMARK {
+        JavaScriptExporter().exportTutorial(mTutorial);
+    }
+}
+
+void JavaScriptExporterBenchmark::benchmarkExportTutorialAgain() {
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(mTutorial);
+
+    QBENCHMARK {
+        exporter.exportTutorial(mTutorial);
+    }
+}
+
+void JavaScriptExporterBenchmark::
+                            benchmarkExportTutorialAgainAfterChangingOneStep() {
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(mTutorial);
+
+    Step* step = mTutorial->steps()[1000];
+    int iteration = 0;
+
+    QBENCHMARK {
+        step->setText(QString("The modified text %1").arg(iteration++));
+        exporter.exportTutorial(mTutorial);
+    }
+}
+
+QTEST_MAIN(JavaScriptExporterBenchmark)
+
+#include "JavaScriptExporterBenchmark.moc"
@@ -0,0 +1,66 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#ifndef LARGETUTORIAL_H
+#define LARGETUTORIAL_H
+
+#include <QIODevice>
+#include <QString>
+
+/**
+ * Writes to the given device the XML serialization of a tutorial of, at least,
+ * the given size.
+ * The tutorial has as many steps as needed to reach the size. Each step has a
+ * text, some custom setup code and a reaction that waits for a signal to go to
+ * the next step.
+ *
+ * @param device The device to write the tutorial to, already open.
+ * @param size The minimum size of the serialization, in bytes.
+ */
+inline void writeLargeTutorial(QIODevice* device, qint64 size) {
+    QString customCode;
+    for (int i=0; i<16; ++i) {
+        customCode += QString("    var value%1 = someObject.someMethod(&quot;"
+                              "some &lt;argument&gt;&quot;, %1);\n").arg(i);
+    }
+
+    device->write("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+                  "<tutorial name=\"A large tutorial\">\n"
+                  "    <description>A tutorial with lots of steps"
+                  "</description>\n");
+
+    int stepNumber = 0;
+    while (device->pos() < size) {
+        QString step = QString(
+"    <step id=\"step%1\">\n"
+"        <text>The text of the step %1, with &lt;em&gt;some markup"
+"&lt;/em&gt;</text>\n"
+"        <setup>%2</setup>\n"
+"        <reaction triggerType=\"ConditionMet\" responseType=\"NextStep\">\n"
+"            <waitForSignal emitterName=\"emitter%1\" "
+"signalName=\"theSignal%1()\"/>\n"
+"            <nextStep id=\"step%3\"/>\n"
+"        </reaction>\n"
+"    </step>\n").arg(stepNumber).arg(customCode).arg(stepNumber + 1);
+        device->write(step.toUtf8());
+        stepNumber++;
+    }
+
+    device->write("</tutorial>\n");
+}
+
+#endif
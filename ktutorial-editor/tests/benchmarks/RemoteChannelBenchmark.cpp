@@ -0,0 +1,161 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QApplication>
+#include <QElapsedTimer>
+
+#include "RemoteClass.h"
+#include "RemoteEditorSupport.h"
+#include "RemoteObject.h"
+#include "RemoteObjectMapper.h"
+#include "TargetApplication.h"
+
+/**
+ * Benchmarks the communication with a target application through D-Bus and
+ * through the local socket advertised by the target application.
+ * The target application is the stub used in TargetApplication unit test, so
+ * the unit tests must be built too. Like the unit tests, the benchmark needs a
+ * D-Bus session bus.
+ *
+ * The latency is measured with the round trip of a single call (getting the
+ * name of an object), and the throughput walking the whole object tree of the
+ * stub (getting the name, class and children of each object).
+ */
+class RemoteChannelBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+
+    void benchmarkRoundTrip_data();
+    void benchmarkRoundTrip();
+
+    void benchmarkObjectTreeWalk_data();
+    void benchmarkObjectTreeWalk();
+
+private:
+
+    QString mService;
+    QString mToken;
+
+    void addChannelRows() const;
+    RemoteObjectMapper* newMapper(bool localSocket) const;
+    int walkObjectTree(RemoteObject* remoteObject) const;
+
+};
+
+void RemoteChannelBenchmark::initTestCase() {
+    TargetApplication* targetApplication = TargetApplication::self();
+    targetApplication->setTargetApplicationFilePath(
+                QApplication::applicationDirPath() +
+                "/../unit/targetapplication/TargetApplicationStub");
+    targetApplication->start();
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!targetApplication->remoteEditorSupport() &&
+           timer.elapsed() < 10000) {
+        QTest::qWait(100);
+    }
+
+    QVERIFY(targetApplication->remoteEditorSupport());
+    QVERIFY(!targetApplication->remoteEditorSupport()->
+                                            localServerName().isEmpty());
+
+    mService = targetApplication->remoteEditorSupport()->service();
+    mToken = targetApplication->rendezvousToken();
+}
+
+void RemoteChannelBenchmark::benchmarkRoundTrip_data() {
+    addChannelRows();
+}
+
+void RemoteChannelBenchmark::benchmarkRoundTrip() {
+    QFETCH(bool, localSocket);
+
+    RemoteObjectMapper* mapper = newMapper(localSocket);
+    RemoteObject* remoteObject = mapper->remoteObject(42);
+
+    QBENCHMARK {
+        remoteObject->name();
+    }
+
+    delete mapper;
+}
+
+void RemoteChannelBenchmark::benchmarkObjectTreeWalk_data() {
+    addChannelRows();
+}
+
+void RemoteChannelBenchmark::benchmarkObjectTreeWalk() {
+    QFETCH(bool, localSocket);
+
+    RemoteObjectMapper* mapper = newMapper(localSocket);
+    RemoteObject* mainWindow = mapper->remoteObject(42);
+
+    int numberOfObjects = 0;
+    QBENCHMARK {
+        numberOfObjects = walkObjectTree(mainWindow);
+    }
+
+    qDebug() << "Objects walked:" << numberOfObjects
+             << "Calls:" << numberOfObjects * 3;
+
+    delete mapper;
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void RemoteChannelBenchmark::addChannelRows() const {
+    QTest::addColumn<bool>("localSocket");
+
+    QTest::newRow("D-Bus") << false;
+    QTest::newRow("local socket") << true;
+}
+
+RemoteObjectMapper* RemoteChannelBenchmark::newMapper(bool localSocket) const {
+    RemoteObjectMapper* mapper = new RemoteObjectMapper(mService);
+
+    if (localSocket) {
+        RemoteEditorSupport remoteEditorSupport(mService, mapper);
+        if (!remoteEditorSupport.useLocalSocketChannel(mToken)) {
+            qWarning() << "The local socket could not be used";
+        }
+    }
+
+    return mapper;
+}
+
+int RemoteChannelBenchmark::walkObjectTree(RemoteObject* remoteObject) const {
+    remoteObject->name();
+    remoteObject->remoteClass();
+
+    int numberOfObjects = 1;
+    foreach (RemoteObject* child, remoteObject->children()) {
+        numberOfObjects += walkObjectTree(child);
+    }
+
+    return numberOfObjects;
+}
+
+QTEST_MAIN(RemoteChannelBenchmark)
+
+#include "RemoteChannelBenchmark.moc"
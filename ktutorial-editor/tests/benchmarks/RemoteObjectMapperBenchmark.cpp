@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QDBusAbstractInterface>
+
+#include "RemoteObject.h"
+#include "RemoteObjectMapper.h"
+
+#include "ResidentMemory.h"
+
+/**
+ * Benchmarks the memory used by the editor to browse the objects of a large
+ * target application: 50000 remote objects are mapped, either keeping all of
+ * them or evicting each one as if the target application reported its
+ * destruction.
+ * As a reference, the memory used by a D-Bus interface per remote object (as
+ * it was done before RemoteObject became a lightweight handle) is measured
+ * too.
+ * No target application is needed, as the remote objects are just mapped, not
+ * queried.
+ */
+class RemoteObjectMapperBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void benchmarkBrowse_data();
+    void benchmarkBrowse();
+
+};
+
+/**
+ * QDBusAbstractInterface constructor is protected, so it has to be subclassed
+ * to create the reference interfaces.
+ */
+class ReferenceInterface: public QDBusAbstractInterface {
+public:
+
+    ReferenceInterface(const QString& service):
+        QDBusAbstractInterface(service, "/ktutorial/ObjectRegister",
+                               "org.kde.ktutorial.ObjectRegister",
+                               QDBusConnection::sessionBus(), 0) {
+    }
+
+};
+
+static const int OBJECT_COUNT = 50000;
+
+void RemoteObjectMapperBenchmark::benchmarkBrowse_data() {
+    QTest::addColumn<QString>("mode");
+
+    QTest::newRow("interface per object") << "interface";
+    QTest::newRow("browse") << "browse";
+    QTest::newRow("browse and evict") << "evict";
+}
+
+void RemoteObjectMapperBenchmark::benchmarkBrowse() {
+    QFETCH(QString, mode);
+
+    QString service = "org.kde.ktutorial.benchmark";
+    RemoteObjectMapper mapper(service);
+    QList<QDBusAbstractInterface*> interfaces;
+
+    qint64 residentMemoryBefore = residentMemory();
+
+    for (int i=1; i<=OBJECT_COUNT; ++i) {
+        if (mode == "interface") {
+            interfaces.append(new ReferenceInterface(service));
+        } else {
+            QVERIFY(mapper.remoteObject(i));
+
+            if (mode == "evict") {
+                mapper.removeRemoteObject(i);
+            }
+        }
+    }
+
+    qint64 residentMemoryGrowth = residentMemory() - residentMemoryBefore;
+    qDebug() << "Objects:" << OBJECT_COUNT
+             << "Resident memory growth (bytes):" << residentMemoryGrowth
+             << "Per object (bytes):" << residentMemoryGrowth / OBJECT_COUNT;
+
+    qDeleteAll(interfaces);
+}
+
+QTEST_MAIN(RemoteObjectMapperBenchmark)
+
+#include "RemoteObjectMapperBenchmark.moc"
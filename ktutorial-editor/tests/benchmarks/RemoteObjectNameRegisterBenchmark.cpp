@@ -0,0 +1,155 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+
+#include "RemoteEditorSupport.h"
+#include "RemoteObject.h"
+#include "RemoteObjectNameRegister.h"
+#include "TargetApplication.h"
+
+/**
+ * Benchmarks the registration of the names of all the objects in a target
+ * application, the computation of the unique name of each object and the best
+ * names for a name.
+ * The target application is the stub used in TargetApplication unit test, so
+ * the unit tests must be built too. Like the unit tests, the benchmark needs a
+ * D-Bus session bus.
+ */
+class RemoteObjectNameRegisterBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+
+    void benchmarkRegisterNames();
+
+    void benchmarkUniqueNames();
+
+    void benchmarkBestNames_data();
+    void benchmarkBestNames();
+
+private:
+
+    void waitForNamesToBeRegistered(
+            const RemoteObjectNameRegister& remoteObjectNameRegister) const;
+    QList<RemoteObject*> remoteObjects(RemoteObject* remoteObject) const;
+
+};
+
+void RemoteObjectNameRegisterBenchmark::initTestCase() {
+    TargetApplication* targetApplication = TargetApplication::self();
+    targetApplication->setTargetApplicationFilePath(
+                QApplication::applicationDirPath() +
+                "/../unit/targetapplication/TargetApplicationStub");
+    targetApplication->start();
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!targetApplication->remoteEditorSupport() &&
+           timer.elapsed() < 10000) {
+        QTest::qWait(100);
+    }
+
+    QVERIFY(targetApplication->remoteEditorSupport());
+}
+
+void RemoteObjectNameRegisterBenchmark::benchmarkRegisterNames() {
+    int numberOfNames = 0;
+    QBENCHMARK {
+        RemoteObjectNameRegister remoteObjectNameRegister;
+        waitForNamesToBeRegistered(remoteObjectNameRegister);
+        numberOfNames = remoteObjectNameRegister.names().count();
+    }
+
+    qDebug() << "Names registered:" << numberOfNames;
+}
+
+void RemoteObjectNameRegisterBenchmark::benchmarkUniqueNames() {
+    RemoteObjectNameRegister remoteObjectNameRegister;
+    waitForNamesToBeRegistered(remoteObjectNameRegister);
+
+    RemoteObject* mainWindow =
+                TargetApplication::self()->remoteEditorSupport()->mainWindow();
+    QList<RemoteObject*> allRemoteObjects = remoteObjects(mainWindow);
+
+    QBENCHMARK {
+        foreach (RemoteObject* remoteObject, allRemoteObjects) {
+            remoteObjectNameRegister.uniqueName(remoteObject);
+        }
+    }
+
+    qDebug() << "Objects:" << allRemoteObjects.count();
+}
+
+void RemoteObjectNameRegisterBenchmark::benchmarkBestNames_data() {
+    QTest::addColumn<QString>("name");
+
+    QTest::newRow("unique name") << QString("The object name 42");
+    QTest::newRow("duplicated parent name") << QString("Duplicated parent");
+    QTest::newRow("duplicated name") << QString("Duplicated object");
+}
+
+void RemoteObjectNameRegisterBenchmark::benchmarkBestNames() {
+    QFETCH(QString, name);
+
+    RemoteObjectNameRegister remoteObjectNameRegister;
+    waitForNamesToBeRegistered(remoteObjectNameRegister);
+
+    QStringList bestNames;
+    QBENCHMARK {
+        bestNames = remoteObjectNameRegister.bestNames(name);
+    }
+
+    QVERIFY(!bestNames.isEmpty());
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void RemoteObjectNameRegisterBenchmark::waitForNamesToBeRegistered(
+            const RemoteObjectNameRegister& remoteObjectNameRegister) const {
+    if (!remoteObjectNameRegister.isBeingUpdated()) {
+        return;
+    }
+
+    QEventLoop eventLoop;
+    connect(&remoteObjectNameRegister, SIGNAL(nameUpdateFinished()),
+            &eventLoop, SLOT(quit()));
+    eventLoop.exec();
+}
+
+QList<RemoteObject*> RemoteObjectNameRegisterBenchmark::remoteObjects(
+                                        RemoteObject* remoteObject) const {
+    QList<RemoteObject*> remoteObjects;
+    remoteObjects.append(remoteObject);
+
+    foreach (RemoteObject* child, remoteObject->children()) {
+        remoteObjects.append(this->remoteObjects(child));
+    }
+
+    return remoteObjects;
+}
+
+QTEST_MAIN(RemoteObjectNameRegisterBenchmark)
+
+#include "RemoteObjectNameRegisterBenchmark.moc"
@@ -0,0 +1,168 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#define private public
+#include "Serialization.h"
+#undef private
+
+#include <KTemporaryFile>
+#include <KUrl>
+
+#include "TutorialReader.h"
+#include "../data/Tutorial.h"
+
+#include "LargeTutorial.h"
+
+/**
+ * Benchmarks the time needed to load and save tutorials of 1 MB and 50 MB from
+ * and to local files, comparing the direct access to local files with the
+ * KIO based access used for remote files.
+ * Note that KIO does not copy local files when downloading them, so the KIO
+ * load path only adds the KIO overhead to reading the file. When saving, KIO
+ * copies the temporary file to the destination.
+ */
+class SerializationBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkLoadLocalTutorial_data();
+    void benchmarkLoadLocalTutorial();
+
+    void benchmarkLoadRemoteTutorial_data();
+    void benchmarkLoadRemoteTutorial();
+
+    void benchmarkSaveLocalTutorial_data();
+    void benchmarkSaveLocalTutorial();
+
+    void benchmarkSaveRemoteTutorial_data();
+    void benchmarkSaveRemoteTutorial();
+
+private:
+
+    KTemporaryFile* mSmallTutorialFile;
+    KTemporaryFile* mLargeTutorialFile;
+    KTemporaryFile* mSavedTutorialFile;
+
+    void addFileRows();
+
+};
+
+void SerializationBenchmark::initTestCase() {
+    mSmallTutorialFile = new KTemporaryFile();
+    mSmallTutorialFile->open();
+    writeLargeTutorial(mSmallTutorialFile, 1024 * 1024);
+    mSmallTutorialFile->close();
+
+    mLargeTutorialFile = new KTemporaryFile();
+    mLargeTutorialFile->open();
+    writeLargeTutorial(mLargeTutorialFile, 50 * 1024 * 1024);
+    mLargeTutorialFile->close();
+
+    mSavedTutorialFile = new KTemporaryFile();
+    mSavedTutorialFile->open();
+    mSavedTutorialFile->close();
+}
+
+void SerializationBenchmark::cleanupTestCase() {
+    delete mSmallTutorialFile;
+    delete mLargeTutorialFile;
+    delete mSavedTutorialFile;
+}
+
+void SerializationBenchmark::benchmarkLoadLocalTutorial_data() {
+    addFileRows();
+}
+
+void SerializationBenchmark::benchmarkLoadLocalTutorial() {
+    QFETCH(QString, fileName);
+
+    Serialization serialization;
+    QBENCHMARK {
+        delete serialization.loadLocalTutorial(fileName);
+    }
+}
+
+void SerializationBenchmark::benchmarkLoadRemoteTutorial_data() {
+    addFileRows();
+}
+
+void SerializationBenchmark::benchmarkLoadRemoteTutorial() {
+    QFETCH(QString, fileName);
+
+    Serialization serialization;
+    QBENCHMARK {
+        delete serialization.loadRemoteTutorial(KUrl(fileName));
+    }
+}
+
+void SerializationBenchmark::benchmarkSaveLocalTutorial_data() {
+    addFileRows();
+}
+
+void SerializationBenchmark::benchmarkSaveLocalTutorial() {
+    QFETCH(QString, fileName);
+
+    QFile file(fileName);
+    file.open(QIODevice::ReadOnly);
+    Tutorial* tutorial = TutorialReader().readTutorial(&file);
+
+    Serialization serialization;
+    QBENCHMARK {
+        serialization.saveLocalTutorial(tutorial,
+                                        mSavedTutorialFile->fileName());
+    }
+
+    delete tutorial;
+}
+
+void SerializationBenchmark::benchmarkSaveRemoteTutorial_data() {
+    addFileRows();
+}
+
+void SerializationBenchmark::benchmarkSaveRemoteTutorial() {
+    QFETCH(QString, fileName);
+
+    QFile file(fileName);
+    file.open(QIODevice::ReadOnly);
+    Tutorial* tutorial = TutorialReader().readTutorial(&file);
+
+    Serialization serialization;
+    QBENCHMARK {
+        serialization.saveRemoteTutorial(tutorial,
+                                         KUrl(mSavedTutorialFile->fileName()));
+    }
+
+    delete tutorial;
+}
+
+void SerializationBenchmark::addFileRows() {
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("1 MB") << mSmallTutorialFile->fileName();
+    QTest::newRow("50 MB") << mLargeTutorialFile->fileName();
+}
+
+QTEST_MAIN(SerializationBenchmark)
+
+#include "SerializationBenchmark.moc"
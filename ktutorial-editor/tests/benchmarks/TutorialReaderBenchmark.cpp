@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include <QTest>
+
+#include <KTemporaryFile>
+
+#include "TutorialReader.h"
+#include "../data/Tutorial.h"
+
+#include "LargeTutorial.h"
+#include "ResidentMemory.h"
+
+/**
+ * Benchmarks the time and the peak memory needed to read tutorials of 1 MB and
+ * 50 MB from a file.
+ */
+class TutorialReaderBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkReadTutorialFromDevice_data();
+    void benchmarkReadTutorialFromDevice();
+
+    void benchmarkPeakMemory_data();
+    void benchmarkPeakMemory();
+
+private:
+
+    KTemporaryFile* mSmallTutorialFile;
+    KTemporaryFile* mLargeTutorialFile;
+
+    void addFileRows();
+
+};
+
+void TutorialReaderBenchmark::initTestCase() {
+    mSmallTutorialFile = new KTemporaryFile();
+    mSmallTutorialFile->open();
+    writeLargeTutorial(mSmallTutorialFile, 1024 * 1024);
+    mSmallTutorialFile->close();
+
+    mLargeTutorialFile = new KTemporaryFile();
+    mLargeTutorialFile->open();
+    writeLargeTutorial(mLargeTutorialFile, 50 * 1024 * 1024);
+    mLargeTutorialFile->close();
+}
+
+void TutorialReaderBenchmark::cleanupTestCase() {
+    delete mSmallTutorialFile;
+    delete mLargeTutorialFile;
+}
+
+void TutorialReaderBenchmark::benchmarkReadTutorialFromDevice_data() {
+    addFileRows();
+}
+
+void TutorialReaderBenchmark::benchmarkReadTutorialFromDevice() {
+    QFETCH(QString, fileName);
+
+    QBENCHMARK {
+        QFile file(fileName);
+        file.open(QIODevice::ReadOnly);
+        delete TutorialReader().readTutorial(&file);
+    }
+}
+
+void TutorialReaderBenchmark::benchmarkPeakMemory_data() {
+    addFileRows();
+}
+
+void TutorialReaderBenchmark::benchmarkPeakMemory() {
+    QFETCH(QString, fileName);
+
+    QFile file(fileName);
+    file.open(QIODevice::ReadOnly);
+
+    resetPeakResidentMemory();
+    qint64 residentMemoryBefore = residentMemory();
+
+    Tutorial* tutorial = TutorialReader().readTutorial(&file);
+
+    qint64 peakMemory = peakResidentMemory() - residentMemoryBefore;
+    qint64 tutorialMemory = residentMemory() - residentMemoryBefore;
+
+    delete tutorial;
+
+    qDebug() << "File size (bytes):" << file.size();
+    qDebug() << "Peak memory while reading (bytes):" << peakMemory;
+    qDebug() << "Memory used by the read tutorial (bytes):" << tutorialMemory;
+}
+
+void TutorialReaderBenchmark::addFileRows() {
+    QTest::addColumn<QString>("fileName");
+
+    QTest::newRow("1 MB") << mSmallTutorialFile->fileName();
+    QTest::newRow("50 MB") << mLargeTutorialFile->fileName();
+}
+
+QTEST_MAIN(TutorialReaderBenchmark)
+
+#include "TutorialReaderBenchmark.moc"
@@ -0,0 +1,119 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QBuffer>
+
+#include "TutorialReader.h"
+#include "TutorialWriter.h"
+#include "../data/Tutorial.h"
+
+#include "LargeTutorial.h"
+
+/**
+ * Benchmarks the time needed to write tutorials of 1 MB and 10 MB, and to read
+ * and write them back (a round trip through TutorialReader and
+ * TutorialWriter), in memory to leave the file system out of the measure.
+ */
+class TutorialWriterBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+
+    void benchmarkWriteTutorialToDevice_data();
+    void benchmarkWriteTutorialToDevice();
+
+    void benchmarkRoundTrip_data();
+    void benchmarkRoundTrip();
+
+private:
+
+    QByteArray mSmallTutorialData;
+    QByteArray mLargeTutorialData;
+
+    void addDataRows();
+
+};
+
+void TutorialWriterBenchmark::initTestCase() {
+    QBuffer smallTutorialBuffer(&mSmallTutorialData);
+    smallTutorialBuffer.open(QIODevice::WriteOnly);
+    writeLargeTutorial(&smallTutorialBuffer, 1024 * 1024);
+
+    QBuffer largeTutorialBuffer(&mLargeTutorialData);
+    largeTutorialBuffer.open(QIODevice::WriteOnly);
+    writeLargeTutorial(&largeTutorialBuffer, 10 * 1024 * 1024);
+}
+
+void TutorialWriterBenchmark::benchmarkWriteTutorialToDevice_data() {
+    addDataRows();
+}
+
+void TutorialWriterBenchmark::benchmarkWriteTutorialToDevice() {
+    QFETCH(QByteArray, data);
+
+    QBuffer inputBuffer(&data);
+    inputBuffer.open(QIODevice::ReadOnly);
+    Tutorial* tutorial = TutorialReader().readTutorial(&inputBuffer);
+
+    QBENCHMARK {
+        QByteArray output;
+        QBuffer outputBuffer(&output);
+        outputBuffer.open(QIODevice::WriteOnly);
+        QVERIFY(TutorialWriter().writeTutorial(tutorial, &outputBuffer));
+    }
+
+    delete tutorial;
+}
+
+void TutorialWriterBenchmark::benchmarkRoundTrip_data() {
+    addDataRows();
+}
+
+void TutorialWriterBenchmark::benchmarkRoundTrip() {
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        QBuffer inputBuffer(&data);
+        inputBuffer.open(QIODevice::ReadOnly);
+        Tutorial* tutorial = TutorialReader().readTutorial(&inputBuffer);
+
+        QByteArray output;
+        QBuffer outputBuffer(&output);
+        outputBuffer.open(QIODevice::WriteOnly);
+        TutorialWriter().writeTutorial(tutorial, &outputBuffer);
+
+        delete tutorial;
+    }
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void TutorialWriterBenchmark::addDataRows() {
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("1 MB") << mSmallTutorialData;
+    QTest::newRow("10 MB") << mLargeTutorialData;
+}
+
+QTEST_MAIN(TutorialWriterBenchmark)
+
+#include "TutorialWriterBenchmark.moc"
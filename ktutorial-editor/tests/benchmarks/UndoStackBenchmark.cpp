@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QUndoStack>
+
+#include "../commands/StepCommands.h"
+#include "../commands/TextChangeCommand.h"
+#include "../data/Step.h"
+
+#include "ResidentMemory.h"
+
+/**
+ * Benchmarks the memory used by the undo stack during a long edition session
+ * of the custom setup code of a step: 2000 edits that add a line to a 64 KB
+ * custom code, undone at the end.
+ * The edits are done either consecutively (and thus merged) or interleaved
+ * with edits of the step text (so each edit is kept in its own command).
+ */
+class UndoStackBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void benchmarkEditionSession_data();
+    void benchmarkEditionSession();
+
+};
+
+void UndoStackBenchmark::benchmarkEditionSession_data() {
+    QTest::addColumn<bool>("interleaved");
+
+    QTest::newRow("consecutive edits") << false;
+    QTest::newRow("interleaved edits") << true;
+}
+
+void UndoStackBenchmark::benchmarkEditionSession() {
+    QFETCH(bool, interleaved);
+
+    QString customCode;
+    while (customCode.size() < 64 * 1024) {
+        customCode += QString("var value%1 = someObject.someMethod(\"some "
+                              "<argument>\", %1);\n").arg(customCode.size());
+    }
+
+    QString initialCustomCode = customCode;
+
+    Step step;
+    step.setCustomSetupCode(customCode);
+    StepCommands commands(&step);
+    QUndoStack stack;
+
+    qint64 residentMemoryBefore = residentMemory();
+
+    for (int i=0; i<2000; ++i) {
+        customCode.insert((i * 7919) % customCode.size(),
+                          QString("someObject.someOtherMethod(%1);\n").arg(i));
+        stack.push(commands.setCustomSetupCode(customCode));
+
+        if (interleaved) {
+            stack.push(commands.setText(QString("The text %1").arg(i)));
+        }
+
+        if ((i + 1) % 500 == 0) {
+            qint64 undoMemory = 0;
+            for (int j=0; j<stack.count(); ++j) {
+                undoMemory += TextChangeCommand::memoryUsage(stack.command(j));
+            }
+
+            qDebug() << "Edits:" << i + 1 << "Commands:" << stack.count()
+                     << "Undo memory (bytes):" << undoMemory
+                     << "Resident memory growth (bytes):"
+                     << residentMemory() - residentMemoryBefore;
+        }
+    }
+
+    while (stack.canUndo()) {
+        stack.undo();
+    }
+
+    QCOMPARE(step.customSetupCode(), initialCustomCode);
+}
+
+QTEST_MAIN(UndoStackBenchmark)
+
+#include "UndoStackBenchmark.moc"
@@ -21,6 +21,7 @@
 #include "StepCommands.h"
 
 #include <QUndoCommand>
+#include <QUndoStack>
 
 #include <KLocalizedString>
 
@@ -37,6 +38,8 @@ private slots:
 
     void testSetTextRedo();
     void testSetTextUndo();
+    void testSetTextMergedWithSetText();
+    void testSetTextNotMergedWithSetCustomSetupCode();
 
     void testSetCustomSetupCodeRedo();
     void testSetCustomSetupCodeUndo();
@@ -114,6 +117,43 @@ void StepCommandsTest::testSetTextUndo() {
     QCOMPARE(step.text(), QString("The old text"));
 }
 
+void StepCommandsTest::testSetTextMergedWithSetText() {
+    Step step;
+    StepCommands commands(&step);
+    QUndoStack stack;
+
+    step.setText("The old text");
+
+    stack.push(commands.setText("The new text"));
+    stack.push(commands.setText("The newer text"));
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.command(0)->text(), i18nc("@action", "Set step text"));
+    QCOMPARE(step.text(), QString("The newer text"));
+
+    stack.undo();
+
+    QCOMPARE(step.text(), QString("The old text"));
+}
+
+void StepCommandsTest::testSetTextNotMergedWithSetCustomSetupCode() {
+    Step step;
+    StepCommands commands(&step);
+    QUndoStack stack;
+
+    step.setText("The old text");
+
+    stack.push(commands.setText("The new text"));
+    stack.push(commands.setCustomSetupCode("The custom setup code"));
+
+    QCOMPARE(stack.count(), 2);
+
+    stack.undo();
+
+    QCOMPARE(step.text(), QString("The new text"));
+    QCOMPARE(step.customSetupCode(), QString(""));
+}
+
 void StepCommandsTest::testSetCustomSetupCodeRedo() {
     Step step;
     StepCommands commands(&step);
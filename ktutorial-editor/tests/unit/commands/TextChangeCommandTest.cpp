@@ -0,0 +1,270 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "TextChangeCommand.h"
+
+#include <QUndoStack>
+
+#include "../data/Step.h"
+
+class TextChangeCommandTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void testConstructor();
+
+    void testRedo();
+    void testRedoAfterUndo();
+
+    void testUndo();
+    void testUndoAfterSeveralChanges();
+
+    void testMergeWith();
+    void testMergeWithSeveralCommands();
+    void testMergeWithCommandWithDifferentObject();
+    void testMergeWithCommandWithDifferentId();
+    void testMergeWithCommandWrappedInParent();
+
+    void testMemoryUsage();
+    void testMemoryUsageWithChildren();
+
+};
+
+class StepTextCommand: public TextChangeCommand {
+public:
+
+    Step* mStep;
+
+    StepTextCommand(Step* step, const QString& text, QUndoCommand* parent = 0,
+                    Id id = StepTextChange):
+            TextChangeCommand(id, parent),
+        mStep(step) {
+        setNewValue(text);
+    }
+
+protected:
+
+    virtual const QObject* object() const {
+        return mStep;
+    }
+
+    virtual QString value() const {
+        return mStep->text();
+    }
+
+    virtual void setValue(const QString& value) {
+        mStep->setText(value);
+    }
+
+};
+
+void TextChangeCommandTest::testConstructor() {
+    Step step;
+    StepTextCommand command(&step, "The text", 0,
+                            TextChangeCommand::StepCustomSetupCodeChange);
+
+    QCOMPARE(command.id(), (int)TextChangeCommand::StepCustomSetupCodeChange);
+    QCOMPARE(step.text(), QString(""));
+}
+
+void TextChangeCommandTest::testRedo() {
+    Step step;
+    step.setText("The old text");
+    StepTextCommand command(&step, "The new text");
+
+    command.redo();
+
+    QCOMPARE(step.text(), QString("The new text"));
+}
+
+void TextChangeCommandTest::testRedoAfterUndo() {
+    Step step;
+    step.setText("Some text with an old part in the middle");
+    StepTextCommand command(&step, "Some text with a new part in the middle");
+
+    command.redo();
+    command.undo();
+    command.redo();
+
+    QCOMPARE(step.text(), QString("Some text with a new part in the middle"));
+}
+
+void TextChangeCommandTest::testUndo() {
+    Step step;
+    step.setText("The old text");
+    StepTextCommand command(&step, "The new text");
+
+    command.redo();
+    command.undo();
+
+    QCOMPARE(step.text(), QString("The old text"));
+}
+
+void TextChangeCommandTest::testUndoAfterSeveralChanges() {
+    Step step;
+    step.setText("aaa");
+    StepTextCommand command1(&step, "aaaa");
+    StepTextCommand command2(&step, "abaa");
+    StepTextCommand command3(&step, "");
+    StepTextCommand command4(&step, "b");
+
+    command1.redo();
+    command2.redo();
+    command3.redo();
+    command4.redo();
+
+    command4.undo();
+    QCOMPARE(step.text(), QString(""));
+    command3.undo();
+    QCOMPARE(step.text(), QString("abaa"));
+    command2.undo();
+    QCOMPARE(step.text(), QString("aaaa"));
+    command1.undo();
+    QCOMPARE(step.text(), QString("aaa"));
+
+    command1.redo();
+    command2.redo();
+    command3.redo();
+    command4.redo();
+    QCOMPARE(step.text(), QString("b"));
+}
+
+void TextChangeCommandTest::testMergeWith() {
+    Step step;
+    step.setText("The text");
+    QUndoStack stack;
+
+    stack.push(new StepTextCommand(&step, "The new text"));
+    stack.push(new StepTextCommand(&step, "The newer text"));
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(step.text(), QString("The newer text"));
+
+    stack.undo();
+    QCOMPARE(step.text(), QString("The text"));
+
+    stack.redo();
+    QCOMPARE(step.text(), QString("The newer text"));
+}
+
+void TextChangeCommandTest::testMergeWithSeveralCommands() {
+    Step step;
+    step.setText("The text");
+    QUndoStack stack;
+
+    stack.push(new StepTextCommand(&step, "The text."));
+    stack.push(new StepTextCommand(&step, "A text."));
+    stack.push(new StepTextCommand(&step, "A different text."));
+
+    QCOMPARE(stack.count(), 1);
+
+    stack.undo();
+    QCOMPARE(step.text(), QString("The text"));
+
+    stack.redo();
+    QCOMPARE(step.text(), QString("A different text."));
+}
+
+void TextChangeCommandTest::testMergeWithCommandWithDifferentObject() {
+    Step step1;
+    step1.setText("The text");
+    Step step2;
+    step2.setText("Another text");
+    QUndoStack stack;
+
+    stack.push(new StepTextCommand(&step1, "The new text"));
+    stack.push(new StepTextCommand(&step2, "Another new text"));
+
+    QCOMPARE(stack.count(), 2);
+
+    stack.undo();
+    QCOMPARE(step1.text(), QString("The new text"));
+    QCOMPARE(step2.text(), QString("Another text"));
+}
+
+void TextChangeCommandTest::testMergeWithCommandWithDifferentId() {
+    Step step;
+    step.setText("The text");
+    QUndoStack stack;
+
+    stack.push(new StepTextCommand(&step, "The new text"));
+    stack.push(new StepTextCommand(&step, "The newer text", 0,
+                                   TextChangeCommand::StepIdChange));
+
+    QCOMPARE(stack.count(), 2);
+
+    stack.undo();
+    QCOMPARE(step.text(), QString("The new text"));
+}
+
+void TextChangeCommandTest::testMergeWithCommandWrappedInParent() {
+    Step step;
+    step.setText("The text");
+
+    StepTextCommand command(&step, "The new text");
+    command.redo();
+
+    QUndoCommand parent;
+    new StepTextCommand(&step, "The newer text", &parent);
+    parent.redo();
+
+    QVERIFY(command.mergeWith(&parent));
+
+    command.undo();
+    QCOMPARE(step.text(), QString("The text"));
+}
+
+void TextChangeCommandTest::testMemoryUsage() {
+    QString longText;
+    for (int i=0; i<1000; ++i) {
+        longText += QString("var value%1 = someObject.someMethod(%1);\n")
+                                                                    .arg(i);
+    }
+
+    Step step;
+    step.setText(longText);
+
+    QString newText = longText;
+    newText.insert(longText.size() / 2, "someObject.someOtherMethod();\n");
+    StepTextCommand command(&step, newText);
+
+    int memoryUsageBeforeRedo = TextChangeCommand::memoryUsage(&command);
+    QVERIFY(memoryUsageBeforeRedo >= newText.size() * (int)sizeof(QChar));
+
+    command.redo();
+
+    int memoryUsageAfterRedo = TextChangeCommand::memoryUsage(&command);
+    QVERIFY(memoryUsageAfterRedo < 1024);
+}
+
+void TextChangeCommandTest::testMemoryUsageWithChildren() {
+    Step step;
+    QUndoCommand parent;
+    parent.setText("The parent");
+    StepTextCommand* child = new StepTextCommand(&step, "The text", &parent);
+
+    QVERIFY(TextChangeCommand::memoryUsage(&parent) >
+            TextChangeCommand::memoryUsage(child));
+}
+
+QTEST_MAIN(TextChangeCommandTest)
+
+#include "TextChangeCommandTest.moc"
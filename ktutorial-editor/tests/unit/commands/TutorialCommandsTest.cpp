@@ -21,6 +21,7 @@
 #include "TutorialCommands.h"
 
 #include <QUndoCommand>
+#include <QUndoStack>
 
 #include <KLocalizedString>
 
@@ -43,6 +44,7 @@ private slots:
 
     void testSetCustomSetupCodeRedo();
     void testSetCustomSetupCodeUndo();
+    void testSetCustomSetupCodeMergedWithSetCustomSetupCode();
 
     void testSetCustomTearDownCodeRedo();
     void testSetCustomTearDownCodeUndo();
@@ -180,6 +182,26 @@ void TutorialCommandsTest::testSetCustomSetupCodeUndo() {
     QCOMPARE(tutorial.customSetupCode(), QString("The old custom setup code"));
 }
 
+void TutorialCommandsTest::
+                        testSetCustomSetupCodeMergedWithSetCustomSetupCode() {
+    Tutorial tutorial;
+    TutorialCommands commands(&tutorial);
+    QUndoStack stack;
+
+    tutorial.setCustomSetupCode("The old custom setup code");
+
+    stack.push(commands.setCustomSetupCode("The new custom setup code"));
+    stack.push(commands.setCustomSetupCode("The newer custom setup code"));
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(tutorial.customSetupCode(),
+             QString("The newer custom setup code"));
+
+    stack.undo();
+
+    QCOMPARE(tutorial.customSetupCode(), QString("The old custom setup code"));
+}
+
 void TutorialCommandsTest::testSetCustomTearDownCodeRedo() {
     Tutorial tutorial;
     TutorialCommands commands(&tutorial);
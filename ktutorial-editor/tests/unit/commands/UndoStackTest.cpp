@@ -0,0 +1,389 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include <QTest>
+
+#include "UndoStack.h"
+
+#include <QSignalSpy>
+#include <QUndoCommand>
+
+#include "StepCommands.h"
+#include "TextChangeCommand.h"
+#include "../data/Step.h"
+
+class UndoStackTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void init();
+
+    void testConstructor();
+
+    void testPush();
+    void testPushMergeableCommand();
+    void testPushMergeableCommandInCleanState();
+    void testPushAfterUndo();
+
+    void testUndo();
+    void testUndoWithoutCommands();
+
+    void testRedo();
+    void testRedoWithoutCommands();
+
+    void testClear();
+
+    void testSetClean();
+
+    void testMemoryUsage();
+
+    void testPushExceedingMemoryBudget();
+    void testPushExceedingMemoryBudgetWithSingleCommand();
+    void testPushExceedingMemoryBudgetDiscardingCleanState();
+
+    void testSetMemoryBudget();
+
+private:
+
+    int mRedoCount;
+    int mUndoCount;
+
+    QUndoCommand* newCommand(const QString& text);
+
+};
+
+class MockCommand: public QUndoCommand {
+public:
+
+    int* mRedoCount;
+    int* mUndoCount;
+
+    MockCommand(const QString& text, int* redoCount, int* undoCount):
+            QUndoCommand(text),
+        mRedoCount(redoCount),
+        mUndoCount(undoCount) {
+    }
+
+    virtual void redo() {
+        (*mRedoCount)++;
+    }
+
+    virtual void undo() {
+        (*mUndoCount)++;
+    }
+
+};
+
+void UndoStackTest::init() {
+    mRedoCount = 0;
+    mUndoCount = 0;
+}
+
+void UndoStackTest::testConstructor() {
+    QObject parent;
+    UndoStack* stack = new UndoStack(&parent);
+
+    QCOMPARE(stack->parent(), &parent);
+    QCOMPARE(stack->count(), 0);
+    QCOMPARE(stack->index(), 0);
+    QVERIFY(stack->isClean());
+    QVERIFY(!stack->canUndo());
+    QVERIFY(!stack->canRedo());
+    QCOMPARE(stack->memoryUsage(), (qint64)0);
+    QCOMPARE(stack->memoryBudget(), (qint64)0);
+}
+
+void UndoStackTest::testPush() {
+    UndoStack stack;
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+    QSignalSpy cleanChangedSpy(&stack, SIGNAL(cleanChanged(bool)));
+    QSignalSpy canUndoChangedSpy(&stack, SIGNAL(canUndoChanged(bool)));
+
+    QUndoCommand* command = newCommand("The command");
+    stack.push(command);
+
+    QCOMPARE(mRedoCount, 1);
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    QCOMPARE(stack.command(0), (const QUndoCommand*)command);
+    QCOMPARE(stack.undoText(), QString("The command"));
+    QVERIFY(!stack.isClean());
+    QCOMPARE(indexChangedSpy.count(), 1);
+    QCOMPARE(indexChangedSpy.at(0).at(0).toInt(), 1);
+    QCOMPARE(cleanChangedSpy.count(), 1);
+    QCOMPARE(cleanChangedSpy.at(0).at(0).toBool(), false);
+    QCOMPARE(canUndoChangedSpy.count(), 1);
+    QCOMPARE(canUndoChangedSpy.at(0).at(0).toBool(), true);
+}
+
+void UndoStackTest::testPushMergeableCommand() {
+    Step step;
+    StepCommands commands(&step);
+    UndoStack stack;
+
+    stack.push(commands.setText("First text"));
+    stack.push(commands.setText("Second text"));
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    QCOMPARE(step.text(), QString("Second text"));
+
+    stack.undo();
+
+    QCOMPARE(step.text(), QString(""));
+}
+
+void UndoStackTest::testPushMergeableCommandInCleanState() {
+    Step step;
+    StepCommands commands(&step);
+    UndoStack stack;
+
+    stack.push(commands.setText("First text"));
+    stack.setClean();
+    stack.push(commands.setText("Second text"));
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 2);
+
+    stack.undo();
+
+    QVERIFY(stack.isClean());
+    QCOMPARE(step.text(), QString("First text"));
+}
+
+void UndoStackTest::testPushAfterUndo() {
+    UndoStack stack;
+    stack.push(newCommand("First command"));
+    stack.push(newCommand("Second command"));
+    stack.setClean();
+    stack.undo();
+
+    stack.push(newCommand("Third command"));
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 2);
+    QCOMPARE(stack.command(1)->text(), QString("Third command"));
+    QVERIFY(!stack.canRedo());
+    QCOMPARE(stack.memoryUsage(),
+             (qint64)(TextChangeCommand::memoryUsage(stack.command(0)) +
+                      TextChangeCommand::memoryUsage(stack.command(1))));
+
+    //The clean state was removed along with the second command
+    stack.undo();
+
+    QVERIFY(!stack.isClean());
+}
+
+void UndoStackTest::testUndo() {
+    UndoStack stack;
+    stack.push(newCommand("The command"));
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+    QSignalSpy cleanChangedSpy(&stack, SIGNAL(cleanChanged(bool)));
+    QSignalSpy canRedoChangedSpy(&stack, SIGNAL(canRedoChanged(bool)));
+
+    stack.undo();
+
+    QCOMPARE(mUndoCount, 1);
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 0);
+    QCOMPARE(stack.redoText(), QString("The command"));
+    QVERIFY(stack.isClean());
+    QCOMPARE(indexChangedSpy.count(), 1);
+    QCOMPARE(indexChangedSpy.at(0).at(0).toInt(), 0);
+    QCOMPARE(cleanChangedSpy.count(), 1);
+    QCOMPARE(cleanChangedSpy.at(0).at(0).toBool(), true);
+    QCOMPARE(canRedoChangedSpy.count(), 1);
+    QCOMPARE(canRedoChangedSpy.at(0).at(0).toBool(), true);
+}
+
+void UndoStackTest::testUndoWithoutCommands() {
+    UndoStack stack;
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+
+    stack.undo();
+
+    QCOMPARE(stack.index(), 0);
+    QCOMPARE(indexChangedSpy.count(), 0);
+}
+
+void UndoStackTest::testRedo() {
+    UndoStack stack;
+    stack.push(newCommand("The command"));
+    stack.undo();
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+
+    stack.redo();
+
+    QCOMPARE(mRedoCount, 2);
+    QCOMPARE(stack.index(), 1);
+    QVERIFY(!stack.canRedo());
+    QVERIFY(!stack.isClean());
+    QCOMPARE(indexChangedSpy.count(), 1);
+    QCOMPARE(indexChangedSpy.at(0).at(0).toInt(), 1);
+}
+
+void UndoStackTest::testRedoWithoutCommands() {
+    UndoStack stack;
+    stack.push(newCommand("The command"));
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+
+    stack.redo();
+
+    QCOMPARE(mRedoCount, 1);
+    QCOMPARE(stack.index(), 1);
+    QCOMPARE(indexChangedSpy.count(), 0);
+}
+
+void UndoStackTest::testClear() {
+    UndoStack stack;
+    stack.push(newCommand("First command"));
+    stack.push(newCommand("Second command"));
+    QSignalSpy cleanChangedSpy(&stack, SIGNAL(cleanChanged(bool)));
+
+    stack.clear();
+
+    QCOMPARE(stack.count(), 0);
+    QCOMPARE(stack.index(), 0);
+    QCOMPARE(stack.memoryUsage(), (qint64)0);
+    QVERIFY(stack.isClean());
+    QCOMPARE(mUndoCount, 0);
+    QCOMPARE(cleanChangedSpy.count(), 1);
+    QCOMPARE(cleanChangedSpy.at(0).at(0).toBool(), true);
+}
+
+void UndoStackTest::testSetClean() {
+    UndoStack stack;
+    stack.push(newCommand("First command"));
+    QSignalSpy cleanChangedSpy(&stack, SIGNAL(cleanChanged(bool)));
+
+    stack.setClean();
+
+    QVERIFY(stack.isClean());
+    QCOMPARE(cleanChangedSpy.count(), 1);
+    QCOMPARE(cleanChangedSpy.at(0).at(0).toBool(), true);
+
+    stack.undo();
+
+    QVERIFY(!stack.isClean());
+}
+
+void UndoStackTest::testMemoryUsage() {
+    Step step;
+    StepCommands commands(&step);
+    UndoStack stack;
+
+    stack.push(commands.setText("The text"));
+    stack.push(commands.setCustomSetupCode("The setup code"));
+    stack.push(commands.setText("The new text"));
+
+    qint64 expectedUsage = 0;
+    for (int i=0; i<stack.count(); ++i) {
+        expectedUsage += TextChangeCommand::memoryUsage(stack.command(i));
+    }
+    QCOMPARE(stack.memoryUsage(), expectedUsage);
+
+    stack.undo();
+    stack.undo();
+
+    expectedUsage = 0;
+    for (int i=0; i<stack.count(); ++i) {
+        expectedUsage += TextChangeCommand::memoryUsage(stack.command(i));
+    }
+    QCOMPARE(stack.memoryUsage(), expectedUsage);
+}
+
+void UndoStackTest::testPushExceedingMemoryBudget() {
+    UndoStack stack;
+    QUndoCommand* command = newCommand("First command");
+    int commandUsage = TextChangeCommand::memoryUsage(command);
+    delete command;
+    stack.setMemoryBudget(2 * commandUsage + 1);
+
+    stack.push(newCommand("First command"));
+    stack.push(newCommand("Other command"));
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+
+    stack.push(newCommand("Third command"));
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 2);
+    QCOMPARE(stack.command(0)->text(), QString("Other command"));
+    QCOMPARE(stack.command(1)->text(), QString("Third command"));
+    QCOMPARE(stack.memoryUsage(), (qint64)(2 * commandUsage));
+    QCOMPARE(indexChangedSpy.count(), 1);
+    QCOMPARE(indexChangedSpy.at(0).at(0).toInt(), 2);
+    QCOMPARE(mUndoCount, 0);
+}
+
+void UndoStackTest::testPushExceedingMemoryBudgetWithSingleCommand() {
+    UndoStack stack;
+    stack.setMemoryBudget(1);
+
+    stack.push(newCommand("First command"));
+    stack.push(newCommand("Second command"));
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    QCOMPARE(stack.command(0)->text(), QString("Second command"));
+    QVERIFY(stack.canUndo());
+}
+
+void UndoStackTest::testPushExceedingMemoryBudgetDiscardingCleanState() {
+    UndoStack stack;
+    stack.setMemoryBudget(1);
+
+    //The stack is clean before pushing the first command
+    stack.push(newCommand("First command"));
+    stack.push(newCommand("Second command"));
+    stack.undo();
+
+    //The bottom of the stack is now the state after the first command
+    QCOMPARE(stack.index(), 0);
+    QVERIFY(!stack.isClean());
+
+    stack.setClean();
+
+    QVERIFY(stack.isClean());
+}
+
+void UndoStackTest::testSetMemoryBudget() {
+    UndoStack stack;
+    stack.push(newCommand("First command"));
+    stack.push(newCommand("Second command"));
+    stack.push(newCommand("Third command"));
+    QSignalSpy indexChangedSpy(&stack, SIGNAL(indexChanged(int)));
+
+    stack.setMemoryBudget(1);
+
+    QCOMPARE(stack.memoryBudget(), (qint64)1);
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    QCOMPARE(stack.command(0)->text(), QString("Third command"));
+    QCOMPARE(indexChangedSpy.count(), 1);
+    QCOMPARE(indexChangedSpy.at(0).at(0).toInt(), 1);
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+QUndoCommand* UndoStackTest::newCommand(const QString& text) {
+    return new MockCommand(text, &mRedoCount, &mUndoCount);
+}
+
+QTEST_MAIN(UndoStackTest)
+
+#include "UndoStackTest.moc"
@@ -45,12 +45,16 @@ private slots:
 
     void testSetCustomCode();
 
+    void testFieldChanged();
+
 private:
 
     int mReactionStarType;
 
     void assertDataChanged(const QSignalSpy& spy, int index,
                            Reaction* reaction) const;
+    void assertFieldChanged(const QSignalSpy& spy, int index,
+                            Reaction* reaction, Reaction::Field field) const;
 
 };
 
@@ -161,6 +165,39 @@ void ReactionTest::testSetCustomCode() {
     assertDataChanged(dataChangedSpy, 0, &reaction);
 }
 
+//Reaction::Field must be declared as a metatype to be used in qvariant_cast
+Q_DECLARE_METATYPE(Reaction::Field);
+
+void ReactionTest::testFieldChanged() {
+    Reaction reaction;
+    WaitFor* waitFor = new MockWaitFor();
+
+    //Reaction::Field must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Reaction::Field>("Reaction::Field");
+    QSignalSpy fieldChangedSpy(&reaction,
+                               SIGNAL(fieldChanged(Reaction*,Reaction::Field)));
+
+    reaction.setTriggerType(Reaction::ConditionMet);
+    reaction.setOptionName("The option name");
+    reaction.setWaitFor(waitFor);
+    reaction.setResponseType(Reaction::CustomCode);
+    reaction.setNextStepId("The step id");
+    reaction.setCustomCode("The custom code");
+
+    QCOMPARE(fieldChangedSpy.count(), 6);
+    assertFieldChanged(fieldChangedSpy, 0, &reaction,
+                       Reaction::TriggerTypeField);
+    assertFieldChanged(fieldChangedSpy, 1, &reaction,
+                       Reaction::OptionNameField);
+    assertFieldChanged(fieldChangedSpy, 2, &reaction, Reaction::WaitForField);
+    assertFieldChanged(fieldChangedSpy, 3, &reaction,
+                       Reaction::ResponseTypeField);
+    assertFieldChanged(fieldChangedSpy, 4, &reaction,
+                       Reaction::NextStepIdField);
+    assertFieldChanged(fieldChangedSpy, 5, &reaction,
+                       Reaction::CustomCodeField);
+}
+
 /////////////////////////////////// Helpers ////////////////////////////////////
 
 //Reaction* must be declared as a metatype to be used in qvariant_cast
@@ -175,6 +212,17 @@ void ReactionTest::assertDataChanged(const QSignalSpy& spy, int index,
     QCOMPARE(qvariant_cast<Reaction*>(argument), reaction);
 }
 
+void ReactionTest::assertFieldChanged(const QSignalSpy& spy, int index,
+                                      Reaction* reaction,
+                                      Reaction::Field field) const {
+    QCOMPARE(spy.at(index).count(), 2);
+
+    QVariant argument = spy.at(index).at(0);
+    QCOMPARE(qvariant_cast<Reaction*>(argument), reaction);
+    argument = spy.at(index).at(1);
+    QCOMPARE(qvariant_cast<Reaction::Field>(argument), field);
+}
+
 QTEST_MAIN(ReactionTest)
 
 #include "ReactionTest.moc"
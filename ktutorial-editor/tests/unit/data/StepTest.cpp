@@ -41,6 +41,8 @@ private slots:
 
     void testSetCustomTearDownCode();
 
+    void testFieldChanged();
+
     void testAddReaction();
     void testAddReactionAtIndex();
     void testRemoveReaction();
@@ -53,6 +55,8 @@ private:
                                    Reaction* reaction, int reactionIndex) const;
     void assertReactionRemovedSignal(const QSignalSpy& spy, int index,
                                      Reaction* reaction) const;
+    void assertFieldChanged(const QSignalSpy& spy, int index,
+                            Step* step, Step::Field field) const;
 
 };
 
@@ -135,6 +139,31 @@ void StepTest::testSetCustomTearDownCode() {
     QCOMPARE(qvariant_cast<Step*>(argument), &step);
 }
 
+//Step::Field must be declared as a metatype to be used in qvariant_cast
+Q_DECLARE_METATYPE(Step::Field);
+
+void StepTest::testFieldChanged() {
+    Step step;
+
+    //Step::Field must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Step*>("Step*");
+    qRegisterMetaType<Step::Field>("Step::Field");
+    QSignalSpy fieldChangedSpy(&step,
+                               SIGNAL(fieldChanged(Step*,Step::Field)));
+
+    step.setId("The id");
+    step.setText("The text");
+    step.setCustomSetupCode("The setup code");
+    step.setCustomTearDownCode("The tear down code");
+
+    QCOMPARE(fieldChangedSpy.count(), 4);
+    assertFieldChanged(fieldChangedSpy, 0, &step, Step::IdField);
+    assertFieldChanged(fieldChangedSpy, 1, &step, Step::TextField);
+    assertFieldChanged(fieldChangedSpy, 2, &step, Step::CustomSetupCodeField);
+    assertFieldChanged(fieldChangedSpy, 3, &step,
+                       Step::CustomTearDownCodeField);
+}
+
 void StepTest::testAddReaction() {
     Step step;
     Reaction* reaction1 = new Reaction();
@@ -238,6 +267,17 @@ void StepTest::assertReactionRemovedSignal(const QSignalSpy& spy, int index,
     QCOMPARE(qvariant_cast<Reaction*>(argument), reaction);
 }
 
+void StepTest::assertFieldChanged(const QSignalSpy& spy, int index,
+                                  Step* step,
+                                  Step::Field field) const {
+    QCOMPARE(spy.at(index).count(), 2);
+
+    QVariant argument = spy.at(index).at(0);
+    QCOMPARE(qvariant_cast<Step*>(argument), step);
+    argument = spy.at(index).at(1);
+    QCOMPARE(qvariant_cast<Step::Field>(argument), field);
+}
+
 QTEST_MAIN(StepTest)
 
 #include "StepTest.moc"
@@ -47,6 +47,8 @@ private slots:
 
     void testSetCustomTearDownCode();
 
+    void testFieldChanged();
+
     void testAddStep();
     void testAddStepAtIndex();
     void testRemoveStep();
@@ -58,6 +60,8 @@ private:
     void assertStepAddedSignal(const QSignalSpy& spy, int index, Step* step,
                                int stepIndex);
     void assertStepRemovedSignal(const QSignalSpy& spy, int index, Step* step);
+    void assertFieldChanged(const QSignalSpy& spy, int index,
+                            Tutorial* tutorial, Tutorial::Field field);
 
 };
 
@@ -180,6 +184,36 @@ void TutorialTest::testSetCustomTearDownCode() {
 //Step* must be declared as a metatype to be used in qvariant_cast
 Q_DECLARE_METATYPE(Step*);
 
+//Tutorial::Field must be declared as a metatype to be used in qvariant_cast
+Q_DECLARE_METATYPE(Tutorial::Field);
+
+void TutorialTest::testFieldChanged() {
+    Tutorial tutorial;
+
+    //Tutorial::Field must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    qRegisterMetaType<Tutorial::Field>("Tutorial::Field");
+    QSignalSpy fieldChangedSpy(&tutorial,
+                               SIGNAL(fieldChanged(Tutorial*,Tutorial::Field)));
+
+    tutorial.setName("The name");
+    tutorial.setDescription("The description");
+    tutorial.setLicenseText("The license text");
+    tutorial.setCustomSetupCode("The setup code");
+    tutorial.setCustomTearDownCode("The tear down code");
+
+    QCOMPARE(fieldChangedSpy.count(), 5);
+    assertFieldChanged(fieldChangedSpy, 0, &tutorial, Tutorial::NameField);
+    assertFieldChanged(fieldChangedSpy, 1, &tutorial,
+                       Tutorial::DescriptionField);
+    assertFieldChanged(fieldChangedSpy, 2, &tutorial,
+                       Tutorial::LicenseTextField);
+    assertFieldChanged(fieldChangedSpy, 3, &tutorial,
+                       Tutorial::CustomSetupCodeField);
+    assertFieldChanged(fieldChangedSpy, 4, &tutorial,
+                       Tutorial::CustomTearDownCodeField);
+}
+
 void TutorialTest::testAddStep() {
     Tutorial tutorial;
     Step* step1 = new Step();
@@ -279,6 +313,17 @@ void TutorialTest::assertStepRemovedSignal(const QSignalSpy& spy, int index,
     QCOMPARE(qvariant_cast<Step*>(argument), step);
 }
 
+void TutorialTest::assertFieldChanged(const QSignalSpy& spy, int index,
+                                      Tutorial* tutorial,
+                                      Tutorial::Field field) {
+    QCOMPARE(spy.at(index).count(), 2);
+
+    QVariant argument = spy.at(index).at(0);
+    QCOMPARE(qvariant_cast<Tutorial*>(argument), tutorial);
+    argument = spy.at(index).at(1);
+    QCOMPARE(qvariant_cast<Tutorial::Field>(argument), field);
+}
+
 QTEST_MAIN(TutorialTest)
 
 #include "TutorialTest.moc"
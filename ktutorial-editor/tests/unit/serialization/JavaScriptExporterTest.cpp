@@ -19,7 +19,9 @@
 
 #include <QTest>
 
+#define private public
 #include "JavaScriptExporter.h"
+#undef private
 
 #include "../data/Reaction.h"
 #include "../data/Step.h"
@@ -76,6 +78,9 @@ private slots:
     void testStepWithoutId();
     void testStepWithSeveralReactions();
 
+    void testExportStep();
+    void testExportStepAfterExportingTutorial();
+
     void testReactionOptionNextStep();
     void testReactionOptionNextStepWithEscapeSequences();
     void testReactionOptionNextStepWithoutOptionNameOrStepId();
@@ -114,6 +119,24 @@ private slots:
     void testWaitForNotWithInvalidNegatedWaitFor();
     void testWaitForNotWithoutNegatedWaitFor();
 
+    void testExportAgainWithoutChanges();
+    void testExportAgainAfterChangingStep();
+    void testExportAgainAfterAddingReaction();
+    void testExportAgainAfterRemovingReaction();
+    void testExportAgainAfterChangingReaction();
+    void testExportAgainAfterChangingWaitFor();
+    void testExportAgainAfterChangingChildWaitFor();
+    void testExportAgainAfterChangingNegatedWaitFor();
+    void testExportAgainAfterRemovingStep();
+    void testExportAgainAfterDeletingStep();
+
+private:
+
+    Step* newStepWithReaction(const QString& id) const;
+
+    void assertExportedAgain(JavaScriptExporter* exporter,
+                             const Tutorial* tutorial) const;
+
 };
 
 void JavaScriptExporterTest::testTutorialLicense() {
@@ -565,6 +588,53 @@ STEP_WITH_ID_THE_ID_AND_EMPTY_TEXT_END_CODE;
     QCOMPARE(exportedTutorial, expected);
 }
 
+void JavaScriptExporterTest::testExportStep() {
+    Step step;
+    step.setId("The id");
+    step.setText("The text");
+
+    JavaScriptExporter exporter;
+    QString exportedStep = exporter.exportStep(&step);
+
+    QString expected =
+"t = Kross.module(\"kdetranslation\");\n"
+"\n"
+"//Step The id\n"
+"theIdStep = ktutorial.newStep(\"The id\");\n"
+"theIdStep.setText(t.i18nc(\"@info/plain\", \"The text\"));\n"
+"\n"
+"tutorial.addStep(theIdStep);\n"
+"\n";
+
+    QCOMPARE(exportedStep, expected);
+}
+
+void JavaScriptExporterTest::testExportStepAfterExportingTutorial() {
+    Tutorial tutorial;
+    Step* step = new Step();
+    step->setId("The id");
+    step->setText("The text");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    step->setText("The new text");
+    QString exportedStep = exporter.exportStep(step);
+
+    QString expected =
+"t = Kross.module(\"kdetranslation\");\n"
+"\n"
+"//Step The id\n"
+"theIdStep = ktutorial.newStep(\"The id\");\n"
+"theIdStep.setText(t.i18nc(\"@info/plain\", \"The new text\"));\n"
+"\n"
+"tutorial.addStep(theIdStep);\n"
+"\n";
+
+    QCOMPARE(exportedStep, expected);
+}
+
 void JavaScriptExporterTest::testReactionOptionNextStep() {
     Tutorial tutorial;
     Step* step = new Step();
@@ -2014,6 +2084,204 @@ STEP_WITH_ID_THE_ID_AND_EMPTY_TEXT_END_CODE;
     QCOMPARE(exportedTutorial, expected);
 }
 
+void JavaScriptExporterTest::testExportAgainWithoutChanges() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    QString exportedTutorial = exporter.exportTutorial(&tutorial);
+
+    QVERIFY(exporter.mStepCodes.contains(step));
+    QCOMPARE(exporter.exportTutorial(&tutorial), exportedTutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterChangingStep() {
+    Tutorial tutorial;
+    Step* step1 = newStepWithReaction("The id1");
+    tutorial.addStep(step1);
+    Step* step2 = newStepWithReaction("The id2");
+    tutorial.addStep(step2);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    step1->setText("The new text");
+
+    QVERIFY(!exporter.mStepCodes.contains(step1));
+    QVERIFY(exporter.mStepCodes.contains(step2));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterAddingReaction() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    Reaction* reaction = new Reaction();
+    reaction->setTriggerType(Reaction::OptionSelected);
+    reaction->setOptionName("The option name");
+    reaction->setResponseType(Reaction::NextStep);
+    reaction->setNextStepId("Another step");
+    step->addReaction(reaction);
+
+    QVERIFY(!exporter.mStepCodes.contains(step));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterRemovingReaction() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    Reaction* reaction = step->reactions()[0];
+    step->removeReaction(reaction);
+    delete reaction;
+
+    QVERIFY(!exporter.mStepCodes.contains(step));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterChangingReaction() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    step->reactions()[0]->setNextStepId("Yet another step");
+
+    QVERIFY(!exporter.mStepCodes.contains(step));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterChangingWaitFor() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    WaitForSignal* waitForSignal =
+                static_cast<WaitForSignal*>(step->reactions()[0]->waitFor());
+    waitForSignal->setSignalName("theNewSignalName()");
+
+    QVERIFY(!exporter.mStepCodes.contains(step));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterChangingChildWaitFor() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    Reaction* reaction = step->reactions()[0];
+    WaitFor* waitForSignal = reaction->waitFor();
+    WaitForComposed* waitForComposed = new WaitForComposed();
+    reaction->setWaitFor(waitForComposed);
+    waitForComposed->addWaitFor(waitForSignal);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    static_cast<WaitForSignal*>(waitForSignal)->setEmitterName(
+                                                        "The new emitter name");
+
+    QVERIFY(!exporter.mStepCodes.contains(step));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterChangingNegatedWaitFor() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    Reaction* reaction = step->reactions()[0];
+    WaitFor* waitForSignal = reaction->waitFor();
+    WaitForNot* waitForNot = new WaitForNot();
+    reaction->setWaitFor(waitForNot);
+    waitForNot->setNegatedWaitFor(waitForSignal);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    static_cast<WaitForSignal*>(waitForSignal)->setEmitterName(
+                                                        "The new emitter name");
+
+    QVERIFY(!exporter.mStepCodes.contains(step));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterRemovingStep() {
+    Tutorial tutorial;
+    Step* step1 = newStepWithReaction("The id1");
+    tutorial.addStep(step1);
+    Step* step2 = newStepWithReaction("The id2");
+    tutorial.addStep(step2);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    tutorial.removeStep(step1);
+    delete step1;
+
+    QVERIFY(!exporter.mStepCodes.contains(step1));
+    QVERIFY(exporter.mStepCodes.contains(step2));
+    assertExportedAgain(&exporter, &tutorial);
+}
+
+void JavaScriptExporterTest::testExportAgainAfterDeletingStep() {
+    Tutorial tutorial;
+    Step* step = newStepWithReaction("The id");
+    tutorial.addStep(step);
+
+    JavaScriptExporter exporter;
+    exporter.exportTutorial(&tutorial);
+
+    tutorial.removeStep(step);
+    delete step;
+
+    QVERIFY(exporter.mStepCodes.isEmpty());
+    QVERIFY(exporter.mTrackedObjects.isEmpty());
+    QVERIFY(exporter.mTrackedObjectsOfStep.isEmpty());
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+Step* JavaScriptExporterTest::newStepWithReaction(const QString& id) const {
+    Step* step = new Step();
+    step->setId(id);
+    step->setText("The text");
+
+    WaitForSignal* waitForSignal = new WaitForSignal();
+    waitForSignal->setEmitterName("The emitter name");
+    waitForSignal->setSignalName("theSignalName()");
+
+    Reaction* reaction = new Reaction();
+    reaction->setTriggerType(Reaction::ConditionMet);
+    reaction->setWaitFor(waitForSignal);
+    reaction->setResponseType(Reaction::NextStep);
+    reaction->setNextStepId("Another step");
+    step->addReaction(reaction);
+
+    return step;
+}
+
+void JavaScriptExporterTest::assertExportedAgain(
+                                            JavaScriptExporter* exporter,
+                                            const Tutorial* tutorial) const {
+    QCOMPARE(exporter->exportTutorial(tutorial),
+             JavaScriptExporter().exportTutorial(tutorial));
+}
+
 QTEST_MAIN(JavaScriptExporterTest)
 
 #include "JavaScriptExporterTest.moc"
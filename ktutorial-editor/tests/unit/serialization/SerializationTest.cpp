@@ -52,11 +52,15 @@ private slots:
 
     void testLoadFromUnreadableUrl();
     void testLoadFromDirectory();
+    void testLoadFromDirectoryWithoutTrailingSlash();
+    void testLoadFromNotExistingUrl();
+    void testLoadEmptyFile();
     void testLoadNotAnXmlFile();
     void testLoadXmlNotWellFormed();
     void testLoadXmlWithoutRootTutorialElement();
 
     void testSaveToExistingUrl();
+    void testSaveNonAsciiText();
     void testSaveToUnwritableUrl();
     void testSaveToDirectory();
 
@@ -119,6 +123,30 @@ void SerializationTest::testLoadFromDirectory() {
     EXPECT_EXCEPTION(Serialization().loadTutorial(url), IOException);
 }
 
+void SerializationTest::testLoadFromDirectoryWithoutTrailingSlash() {
+    KUrl url = KGlobal::dirs()->saveLocation("tmp");
+    url.adjustPath(KUrl::RemoveTrailingSlash);
+
+    EXPECT_EXCEPTION(Serialization().loadTutorial(url), IOException);
+}
+
+void SerializationTest::testLoadFromNotExistingUrl() {
+    KUrl url = KGlobal::dirs()->saveLocation("tmp") +
+               "/SerializationTestNotExisting.xml";
+
+    EXPECT_EXCEPTION(Serialization().loadTutorial(url), IOException);
+}
+
+void SerializationTest::testLoadEmptyFile() {
+    KUrl url = KGlobal::dirs()->saveLocation("tmp") + "/SerializationTest.xml";
+    mFile = new QFile(url.toLocalFile());
+    mFile->open(QIODevice::WriteOnly | QIODevice::Text);
+    writeFile(mFile, "");
+
+    EXPECT_EXCEPTION(Serialization().loadTutorial(url),
+                     DeserializationException);
+}
+
 void SerializationTest::testLoadNotAnXmlFile() {
     KUrl url = KGlobal::dirs()->saveLocation("tmp") + "/SerializationTest.txt";
     mFile = new QFile(url.toLocalFile());
@@ -174,6 +202,27 @@ void SerializationTest::testSaveToExistingUrl() {
     QCOMPARE(actualContents, expectedContents);
 }
 
+void SerializationTest::testSaveNonAsciiText() {
+    Tutorial tutorial;
+    tutorial.setName(QString::fromUtf8("Espa\xc3\xb1ol"));
+
+    KUrl url = KGlobal::dirs()->saveLocation("tmp") + "/SerializationTest.xml";
+    mFile = new QFile(url.toLocalFile());
+
+    Serialization().saveTutorial(&tutorial, url);
+
+    QVERIFY(mFile->exists());
+    QVERIFY(mFile->open(QIODevice::ReadOnly));
+
+    QByteArray actualContents = mFile->readAll();
+    mFile->close();
+    QByteArray expectedContents =
+"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+"<tutorial name=\"Espa\xc3\xb1ol\"/>\n";
+
+    QCOMPARE(actualContents, expectedContents);
+}
+
 void SerializationTest::testSaveToUnwritableUrl() {
     Tutorial tutorial;
     tutorial.setName("The name");
@@ -19,6 +19,8 @@
 
 #include <QTest>
 
+#include <QBuffer>
+
 #include "TutorialReader.h"
 
 #include <KLocalizedString>
@@ -79,6 +81,7 @@ private slots:
     void testTutorial();
     void testTutorialEmpty();
     void testTutorialWithSeveralSteps();
+    void testTutorialFromDevice();
 
     void testStep();
     void testStepEmpty();
@@ -103,6 +106,7 @@ private slots:
     void testWaitForNotWithoutNegatedWaitFor();
 
     void testXmlNotWellFormed();
+    void testXmlNotWellFormedAfterRootElement();
     void testXmlWithoutRootTutorialElement();
     void testXmlWithGarbageElementsAndAttributes();
 
@@ -195,6 +199,33 @@ TUTORIAL_ELEMENTS
     QCOMPARE(step->text(), QString("The text2"));
 }
 
+void TutorialReaderTest::testTutorialFromDevice() {
+    QString data = QString::fromUtf8(
+"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+"<tutorial name=\"The &quot;name&quot;, with \xC3\xB1 and \xE2\x82\xAC\">\n"
+"    <description>The description,\nwith &lt; and &gt;\n</description>\n"
+"    <step id=\"The id\">\n"
+"        <text>The text</text>\n"
+"    </step>\n"
+"</tutorial>\n");
+
+    QByteArray encodedData = data.toUtf8();
+    QBuffer buffer(&encodedData);
+    buffer.open(QIODevice::ReadOnly);
+
+    TutorialReader reader;
+    QScopedPointer<Tutorial> tutorial(reader.readTutorial(&buffer));
+
+    QVERIFY(tutorial);
+    QCOMPARE(tutorial->name(),
+             QString::fromUtf8("The \"name\", with \xC3\xB1 and \xE2\x82\xAC"));
+    QCOMPARE(tutorial->description(),
+             QString("The description,\nwith < and >\n"));
+    QCOMPARE(tutorial->steps().count(), 1);
+    QCOMPARE(tutorial->steps()[0]->id(), QString("The id"));
+    QCOMPARE(tutorial->steps()[0]->text(), QString("The text"));
+}
+
 void TutorialReaderTest::testStep() {
     QString data =
 STEP_PARENT_START
@@ -610,6 +641,25 @@ HEADER_XML
         QFAIL("Expected DeserializationException not thrown");
     } catch (DeserializationException e) {
         QVERIFY(e.message().contains(i18n("XML document is not well formed")));
+        QVERIFY(e.message().contains(", line 4, column "));
+    }
+}
+
+void TutorialReaderTest::testXmlNotWellFormedAfterRootElement() {
+    QString data =
+HEADER_XML
+"<tutorial>\n"
+"</tutorial>\n"
+"<tutorial>\n"
+"</tutorial>\n";
+
+    TutorialReader reader;
+    try {
+        QScopedPointer<Tutorial> tutorial(reader.readTutorial(data));
+        QFAIL("Expected DeserializationException not thrown");
+    } catch (DeserializationException e) {
+        QVERIFY(e.message().contains(i18n("XML document is not well formed")));
+        QVERIFY(e.message().contains(", line 4, column "));
     }
 }
 
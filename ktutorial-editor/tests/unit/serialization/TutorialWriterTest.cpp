@@ -19,6 +19,8 @@
 
 #include <QTest>
 
+#include <QBuffer>
+
 #include "TutorialWriter.h"
 
 #include "../data/Reaction.h"
@@ -69,6 +71,38 @@ REACTION_PARENT_START \
 "        </reaction>\n" \
 REACTION_PARENT_END
 
+class FailingDevice: public QIODevice {
+public:
+
+    FailingDevice(qint64 maxSize): QIODevice(),
+        mMaxSize(maxSize) {
+    }
+
+protected:
+
+    virtual qint64 readData(char* data, qint64 maxSize) {
+        Q_UNUSED(data);
+        Q_UNUSED(maxSize);
+        return -1;
+    }
+
+    virtual qint64 writeData(const char* data, qint64 maxSize) {
+        Q_UNUSED(data);
+        if (maxSize > mMaxSize) {
+            setErrorString("No space left on device");
+            return -1;
+        }
+
+        mMaxSize -= maxSize;
+        return maxSize;
+    }
+
+private:
+
+    qint64 mMaxSize;
+
+};
+
 class TutorialWriterTest: public QObject {
 Q_OBJECT
 
@@ -77,6 +111,9 @@ private slots:
     void testTutorial();
     void testTutorialEmpty();
     void testTutorialWithSeveralSteps();
+    void testTutorialToDevice();
+    void testTutorialToDeviceNotWritable();
+    void testTutorialToDeviceFailingWhileWriting();
 
     void testStep();
     void testStepEmpty();
@@ -174,6 +211,58 @@ TUTORIAL_ELEMENTS
     QCOMPARE(savedTutorial, expected);
 }
 
+void TutorialWriterTest::testTutorialToDevice() {
+    Tutorial tutorial;
+    tutorial.setName(QString::fromUtf8("Espa\xc3\xb1ol"));
+    tutorial.setDescription("The description,\nwith < and >\n");
+
+    Step* step = new Step();
+    step->setId("The id");
+    step->setText("The text");
+    tutorial.addStep(step);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    TutorialWriter saver;
+    QVERIFY(saver.writeTutorial(&tutorial, &buffer));
+
+    QByteArray expected =
+HEADER_XML
+"<tutorial name=\"Espa\xc3\xb1ol\">\n"
+"    <description>The description,\nwith &lt; and &gt;\n</description>\n"
+"    <step id=\"The id\">\n"
+"        <text>The text</text>\n"
+"    </step>\n"
+"</tutorial>\n";
+
+    QCOMPARE(buffer.data(), expected);
+    QCOMPARE(QString::fromUtf8(buffer.data()), saver.writeTutorial(&tutorial));
+}
+
+void TutorialWriterTest::testTutorialToDeviceNotWritable() {
+    Tutorial tutorial;
+    tutorial.setName("The name");
+
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadOnly);
+
+    TutorialWriter saver;
+    QVERIFY(!saver.writeTutorial(&tutorial, &buffer));
+}
+
+void TutorialWriterTest::testTutorialToDeviceFailingWhileWriting() {
+    Tutorial tutorial;
+    tutorial.setName("The name");
+    tutorial.setDescription("The description");
+
+    FailingDevice device(64);
+    device.open(QIODevice::WriteOnly);
+
+    TutorialWriter saver;
+    QVERIFY(!saver.writeTutorial(&tutorial, &device));
+}
+
 void TutorialWriterTest::testStep() {
     Tutorial tutorial;
 
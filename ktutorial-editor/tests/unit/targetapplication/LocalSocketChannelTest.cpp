@@ -0,0 +1,278 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "LocalSocketChannel.h"
+
+#include <QSignalSpy>
+#include <QTime>
+
+#include "RemoteClassStubs.h"
+
+#define EXPECT_EXCEPTION(statement, exception) \
+do {\
+    try {\
+        statement;\
+        QFAIL("Expected " #exception " not thrown");\
+    } catch (exception e) {\
+    } catch (Exception e) {\
+        QFAIL("Expected " #exception " not thrown");\
+    }\
+} while (0)
+
+class LocalSocketChannelTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void testConnectToServer();
+    void testConnectToServerWithUnknownServer();
+    void testConnectToServerWithWrongToken();
+
+    void testObjectName();
+    void testObjectNameWhenServerIsNotAvailable();
+    void testObjectNameWithErrorReply();
+    void testObjectNameWithoutReply();
+
+    void testClassName();
+
+    void testChildObjectIds();
+
+    void testSuperClass();
+
+    void testPropertyList();
+
+    void testSignalList();
+
+    void testClassHierarchy();
+
+    void testSubscribeToEvents();
+    void testSubscribeToEventsWhenNotConnected();
+
+    void testEventReceivedWhileWaitingForReply();
+
+private:
+
+    StubLocalSocketServerThread* mServerThread;
+
+};
+
+void LocalSocketChannelTest::init() {
+    mServerThread = new StubLocalSocketServerThread(
+                                            "ktutorial-LocalSocketChannelTest",
+                                            "The token");
+    mServerThread->startAndWaitForListening();
+}
+
+void LocalSocketChannelTest::cleanup() {
+    mServerThread->stopAndWait();
+    delete mServerThread;
+}
+
+void LocalSocketChannelTest::testConnectToServer() {
+    LocalSocketChannel channel;
+
+    QVERIFY(!channel.isConnected());
+    QVERIFY(channel.connectToServer(mServerThread->mServerName, "The token"));
+    QVERIFY(channel.isConnected());
+}
+
+void LocalSocketChannelTest::testConnectToServerWithUnknownServer() {
+    LocalSocketChannel channel;
+
+    QVERIFY(!channel.connectToServer("ktutorial-unknownServerName",
+                                     "The token"));
+    QVERIFY(!channel.isConnected());
+}
+
+void LocalSocketChannelTest::testConnectToServerWithWrongToken() {
+    LocalSocketChannel channel;
+
+    QVERIFY(!channel.connectToServer(mServerThread->mServerName,
+                                     "The wrong token"));
+    QVERIFY(!channel.isConnected());
+}
+
+void LocalSocketChannelTest::testObjectName() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QCOMPARE(channel.objectName(42), QString("The object name 42"));
+    QCOMPARE(channel.objectName(500), QString("Duplicated object"));
+}
+
+void LocalSocketChannelTest::testObjectNameWhenServerIsNotAvailable() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    mServerThread->stopAndWait();
+
+    EXPECT_EXCEPTION(channel.objectName(42), DBusException);
+}
+
+void LocalSocketChannelTest::testObjectNameWithErrorReply() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    EXPECT_EXCEPTION(channel.objectName(-1), DBusException);
+
+    //The connection is still usable
+    QVERIFY(channel.isConnected());
+    QCOMPARE(channel.objectName(42), QString("The object name 42"));
+}
+
+void LocalSocketChannelTest::testObjectNameWithoutReply() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QSignalSpy disconnectedSpy(&channel, SIGNAL(disconnected()));
+
+    QTime time;
+    time.start();
+    EXPECT_EXCEPTION(channel.objectName(1000), DBusException);
+
+    //The call does not wait as long as a D-Bus call
+    QVERIFY(time.elapsed() < 10000);
+
+    //A late reply would be mistaken for the reply to the next call
+    QVERIFY(!channel.isConnected());
+    QCOMPARE(disconnectedSpy.count(), 1);
+}
+
+void LocalSocketChannelTest::testClassName() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QCOMPARE(channel.className(42), QString("The class name 42"));
+}
+
+void LocalSocketChannelTest::testChildObjectIds() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QList<int> childObjectIds = channel.childObjectIds(42);
+    QCOMPARE(childObjectIds.count(), 9);
+    QCOMPARE(childObjectIds[0], 420);
+    QCOMPARE(childObjectIds[1], 421);
+    QCOMPARE(childObjectIds[2], 422);
+    QCOMPARE(childObjectIds[3], 423);
+    QCOMPARE(childObjectIds[4], 5);
+    QCOMPARE(childObjectIds[5], 6);
+    QCOMPARE(childObjectIds[6], 7);
+    QCOMPARE(childObjectIds[7], 8);
+    QCOMPARE(childObjectIds[8], 9);
+}
+
+void LocalSocketChannelTest::testSuperClass() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QCOMPARE(channel.superClass("ChildClass"), QString("Class"));
+    QCOMPARE(channel.superClass("Class"), QString(""));
+}
+
+void LocalSocketChannelTest::testPropertyList() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QStringList propertyList = channel.propertyList("Class");
+    QCOMPARE(propertyList.count(), 3);
+    QCOMPARE(propertyList[0], QString("ClassProperty0"));
+    QCOMPARE(propertyList[1], QString("ClassProperty1"));
+    QCOMPARE(propertyList[2], QString("ClassProperty2"));
+}
+
+void LocalSocketChannelTest::testSignalList() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QStringList signalList = channel.signalList("Class");
+    QCOMPARE(signalList.count(), 3);
+    QCOMPARE(signalList[0], QString("ClassSignal0()"));
+    QCOMPARE(signalList[1], QString("ClassSignal1()"));
+    QCOMPARE(signalList[2], QString("ClassSignal2()"));
+}
+
+void LocalSocketChannelTest::testClassHierarchy() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QVariantMap classHierarchy = channel.classHierarchy();
+    QCOMPARE(classHierarchy.count(), 2);
+
+    QVariantMap classData = classHierarchy.value("ChildClass").toMap();
+    QCOMPARE(classData.value("superClass").toString(), QString("Class"));
+    QStringList propertyList = classData.value("propertyList").toStringList();
+    QCOMPARE(propertyList.count(), 3);
+    QCOMPARE(propertyList[0], QString("ChildClassProperty0"));
+    QVERIFY(classHierarchy.contains("Class"));
+}
+
+void LocalSocketChannelTest::testSubscribeToEvents() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QSignalSpy eventReceivedSpy(&channel, SIGNAL(eventReceived(int,QString)));
+
+    channel.subscribeToEvents();
+
+    //The stub server sends a "Subscribed" event when the client subscribes
+    QTest::qWait(200);
+
+    QCOMPARE(eventReceivedSpy.count(), 1);
+    QVariant argument = eventReceivedSpy.at(0).at(0);
+    QCOMPARE(argument.type(), QVariant::Int);
+    QCOMPARE(argument.toInt(), 42);
+    argument = eventReceivedSpy.at(0).at(1);
+    QCOMPARE(argument.type(), QVariant::String);
+    QCOMPARE(argument.toString(), QString("Subscribed"));
+}
+
+void LocalSocketChannelTest::testSubscribeToEventsWhenNotConnected() {
+    LocalSocketChannel channel;
+
+    EXPECT_EXCEPTION(channel.subscribeToEvents(), DBusException);
+}
+
+void LocalSocketChannelTest::testEventReceivedWhileWaitingForReply() {
+    LocalSocketChannel channel;
+    channel.connectToServer(mServerThread->mServerName, "The token");
+
+    QSignalSpy eventReceivedSpy(&channel, SIGNAL(eventReceived(int,QString)));
+
+    //The event is sent before the reply, as the requests are handled in order
+    channel.subscribeToEvents();
+    QCOMPARE(channel.objectName(42), QString("The object name 42"));
+
+    //The event is not emitted in the middle of the call
+    QCOMPARE(eventReceivedSpy.count(), 0);
+
+    QTest::qWait(200);
+
+    QCOMPARE(eventReceivedSpy.count(), 1);
+    QCOMPARE(eventReceivedSpy.at(0).at(0).toInt(), 42);
+    QCOMPARE(eventReceivedSpy.at(0).at(1).toString(), QString("Subscribed"));
+}
+
+QTEST_MAIN(LocalSocketChannelTest)
+
+#include "LocalSocketChannelTest.moc"
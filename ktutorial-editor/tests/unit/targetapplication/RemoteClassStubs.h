@@ -21,8 +21,15 @@
 #define REMOTECLASSSTUBS_H
 
 #include <QApplication>
+#include <QColor>
 #include <QObject>
+#include <QSemaphore>
+#include <QSharedMemory>
+#include <QThread>
+#include <QUuid>
 #include <QtDBus/QtDBus>
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
 
 class StubEventSpy: public QObject {
 Q_OBJECT
@@ -36,10 +43,16 @@ public:
         emit eventReceived(objectId, eventType);
     }
 
+    void emitObjectDestroyed(int objectId) {
+        emit objectDestroyed(objectId);
+    }
+
 signals:
 
     void eventReceived(int objectId, const QString& eventType);
 
+    void objectDestroyed(int objectId);
+
 };
 
 class StubClassRegisterAdaptor: public QDBusAbstractAdaptor {
@@ -47,7 +60,10 @@ Q_OBJECT
 Q_CLASSINFO("D-Bus Interface", "org.kde.ktutorial.ClassRegister")
 public:
 
-    StubClassRegisterAdaptor(QObject* parent): QDBusAbstractAdaptor(parent) {
+    int mClassHierarchyCount;
+
+    StubClassRegisterAdaptor(QObject* parent): QDBusAbstractAdaptor(parent),
+        mClassHierarchyCount(0) {
     }
 
 public slots:
@@ -77,6 +93,23 @@ public slots:
 
         return signalList;
     }
+
+    QVariantMap classHierarchy() {
+        mClassHierarchyCount++;
+
+        QVariantMap classHierarchy;
+        QStringList classNames;
+        classNames << "Class" << "ChildClass";
+        foreach (const QString& className, classNames) {
+            QVariantMap classData;
+            classData.insert("superClass", superClass(className));
+            classData.insert("propertyList", propertyList(className));
+            classData.insert("signalList", signalList(className));
+            classHierarchy.insert(className, classData);
+        }
+
+        return classHierarchy;
+    }
 };
 
 /**
@@ -228,25 +261,250 @@ public:
 
 };
 
+/**
+ * Local socket server that answers the requests using the same data as the
+ * StubObjectRegister.
+ * When a client subscribes to the events, an event "Subscribed" is sent for
+ * the object with id 42. The requests for the object with id -1 are answered
+ * with an error, and the requests for the object with id 1000 are never
+ * answered.
+ */
+class StubLocalSocketServer: public QObject {
+Q_OBJECT
+public:
+
+    StubLocalSocketServer(const QString& token, QObject* parent = 0):
+            QObject(parent),
+        mRequestCount(0),
+        mToken(token) {
+        mServer = new QLocalServer(this);
+        connect(mServer, SIGNAL(newConnection()),
+                this, SLOT(handleNewConnection()));
+
+        StubObjectRegister* objectRegister = new StubObjectRegister(this);
+        mClassRegister =
+                objectRegister->findChild<StubClassRegisterAdaptor*>();
+        mObjectRegister =
+                objectRegister->findChild<StubObjectRegisterAdaptor*>();
+    }
+
+    bool listen(const QString& name) {
+        QLocalServer::removeServer(name);
+        return mServer->listen(name);
+    }
+
+    QString serverName() const {
+        return mServer->fullServerName();
+    }
+
+    int mRequestCount;
+
+private:
+
+    QLocalServer* mServer;
+    QString mToken;
+    StubClassRegisterAdaptor* mClassRegister;
+    StubObjectRegisterAdaptor* mObjectRegister;
+
+    void writeMessage(QLocalSocket* socket, const QByteArray& message) {
+        QDataStream out(socket);
+        out.setVersion(QDataStream::Qt_4_6);
+        out << message;
+    }
+
+    void handleRequest(QLocalSocket* socket, const QByteArray& request) {
+        mRequestCount++;
+
+        QDataStream in(request);
+        in.setVersion(QDataStream::Qt_4_6);
+        quint8 requestType;
+        in >> requestType;
+
+        QByteArray message;
+        QDataStream out(&message, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_4_6);
+
+        //Authenticate
+        if (requestType == 8) {
+            QString token;
+            in >> token;
+            if (token != mToken) {
+                socket->abort();
+                return;
+            }
+
+            out << (quint8)1 << true;
+            writeMessage(socket, message);
+            return;
+        }
+
+        //SubscribeToEvents
+        if (requestType == 7) {
+            out << (quint8)2 << (qint32)42 << QString("Subscribed");
+            writeMessage(socket, message);
+            return;
+        }
+
+        //Reply
+        out << (quint8)1;
+
+        qint32 objectId;
+        QString className;
+        if (requestType <= 3) {
+            in >> objectId;
+        } else if (requestType <= 6) {
+            in >> className;
+        }
+
+        if (requestType <= 3 && objectId == 1000) {
+            return;
+        }
+
+        if (requestType <= 3 && objectId == -1) {
+            QByteArray error;
+            QDataStream errorStream(&error, QIODevice::WriteOnly);
+            errorStream.setVersion(QDataStream::Qt_4_6);
+            errorStream << (quint8)4 << QString("Unknown object");
+            writeMessage(socket, error);
+            return;
+        }
+
+        if (requestType == 9) {
+            out << mClassRegister->classHierarchy();
+        } else if (requestType == 1) {
+            out << mObjectRegister->objectName(objectId);
+        } else if (requestType == 2) {
+            out << mObjectRegister->className(objectId);
+        } else if (requestType == 3) {
+            QList<qint32> childObjectIds;
+            foreach (int id, mObjectRegister->childObjectIds(objectId)) {
+                childObjectIds.append(id);
+            }
+            out << childObjectIds;
+        } else if (requestType == 4) {
+            out << mClassRegister->superClass(className);
+        } else if (requestType == 5) {
+            out << mClassRegister->propertyList(className);
+        } else {
+            out << mClassRegister->signalList(className);
+        }
+
+        writeMessage(socket, message);
+    }
+
+private slots:
+
+    void handleNewConnection() {
+        while (mServer->hasPendingConnections()) {
+            QLocalSocket* socket = mServer->nextPendingConnection();
+            connect(socket, SIGNAL(readyRead()),
+                    this, SLOT(handleReadyRead()));
+            connect(socket, SIGNAL(disconnected()),
+                    socket, SLOT(deleteLater()));
+        }
+    }
+
+    void handleReadyRead() {
+        QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+
+        while (socket->bytesAvailable() >= (qint64)sizeof(quint32)) {
+            QByteArray sizeData = socket->peek(sizeof(quint32));
+            QDataStream sizeStream(sizeData);
+            quint32 size;
+            sizeStream >> size;
+
+            if (socket->bytesAvailable() < (qint64)(sizeof(quint32) + size)) {
+                return;
+            }
+
+            QDataStream in(socket);
+            in.setVersion(QDataStream::Qt_4_6);
+            QByteArray request;
+            in >> request;
+            handleRequest(socket, request);
+        }
+    }
+
+};
+
+/**
+ * Thread to run a StubLocalSocketServer.
+ * The calls made through a LocalSocketChannel block until the reply is
+ * received, so the server can not be run in the same thread as the client.
+ */
+class StubLocalSocketServerThread: public QThread {
+Q_OBJECT
+public:
+
+    QString mServerName;
+
+    StubLocalSocketServerThread(const QString& name, const QString& token,
+                                QObject* parent = 0):
+            QThread(parent),
+        mName(name),
+        mToken(token) {
+    }
+
+    void startAndWaitForListening() {
+        start();
+        mListening.acquire();
+    }
+
+    void stopAndWait() {
+        quit();
+        wait();
+    }
+
+protected:
+
+    virtual void run() {
+        StubLocalSocketServer server(mToken);
+        server.listen(mName);
+        mServerName = server.serverName();
+        mListening.release();
+
+        exec();
+    }
+
+private:
+
+    QString mName;
+    QString mToken;
+    QSemaphore mListening;
+
+};
+
 class StubEditorSupport: public QObject {
 Q_OBJECT
 Q_CLASSINFO("D-Bus Interface", "org.kde.ktutorial.EditorSupport")
+Q_PROPERTY(QString localServerName READ localServerName)
 public:
 
     StubEventSpy* mEventSpy;
+    QString mLocalServerName;
     QList<int> mHighlightRemoteWidgetIds;
     QList<int> mStopHighlightingRemoteWidgetIds;
+    QList<int> mGrabWidgetRemoteWidgetIds;
+    QSharedMemory mThumbnailMemory;
     int mEnableEventSpyCount;
     int mDisableEventSpyCount;
     QList<QString> mTestScriptedTutorialFilenames;
     QList<QString> mTestScriptedTutorialStepIds;
+    QStringList mUpdatedStepIds;
+    QStringList mUpdatedStepScripts;
 
     StubEditorSupport(QObject* parent = 0): QObject(parent),
         mEventSpy(0),
+        mThumbnailMemory("ktutorial-stub-thumbnail-" +
+                         QUuid::createUuid().toString().mid(1, 36)),
         mEnableEventSpyCount(0),
         mDisableEventSpyCount(0) {
     }
 
+    QString localServerName() const {
+        return mLocalServerName;
+    }
+
 public slots:
 
     int mainWindowObjectId() const {
@@ -306,6 +564,37 @@ public slots:
         mStopHighlightingRemoteWidgetIds.append(objectId);
     }
 
+    //Only the main window and its first children are widgets; their
+    //thumbnail is a green image of, at most, 40x10 pixels
+    QVariantMap grabWidget(int objectId, int maxWidth, int maxHeight) {
+        mGrabWidgetRemoteWidgetIds.append(objectId);
+
+        if (objectId != 42 && (objectId < 420 || objectId > 423)) {
+            return QVariantMap();
+        }
+
+        int width = qMin(maxWidth, 40);
+        int height = qMin(maxHeight, 10);
+
+        if (!mThumbnailMemory.isAttached() &&
+                !mThumbnailMemory.create(40 * 10 * 4)) {
+            return QVariantMap();
+        }
+
+        mThumbnailMemory.lock();
+        QRgb* pixels = static_cast<QRgb*>(mThumbnailMemory.data());
+        for (int i=0; i<width * height; ++i) {
+            pixels[i] = qRgb(0, 255, 0);
+        }
+        mThumbnailMemory.unlock();
+
+        QVariantMap thumbnail;
+        thumbnail.insert("key", mThumbnailMemory.key());
+        thumbnail.insert("width", width);
+        thumbnail.insert("height", height);
+        return thumbnail;
+    }
+
     void enableEventSpy() {
         mEnableEventSpyCount++;
 
@@ -329,6 +618,14 @@ public slots:
         }
     }
 
+    bool updateTestScriptedTutorialSteps(const QStringList& stepIds,
+                                         const QStringList& stepScripts) {
+        mUpdatedStepIds += stepIds;
+        mUpdatedStepScripts += stepScripts;
+
+        return !mTestScriptedTutorialFilenames.isEmpty();
+    }
+
 };
 
 #endif
@@ -23,8 +23,12 @@
 
 #include <QtDBus/QtDBus>
 
+#include "LocalSocketChannel.h"
 #include "RemoteClassStubs.h"
+
+#define private public
 #include "RemoteObjectMapper.h"
+#undef private
 
 #define EXPECT_EXCEPTION(statement, exception) \
 do {\
@@ -56,6 +60,12 @@ private slots:
     void testSignalList();
     void testSignalListWhenRemoteClassIsNotAvailable();
 
+    void testDataFromClassHierarchy();
+    void testDataForClassNotInClassHierarchy();
+    void testClassHierarchyRequestedOnce();
+    void testClassHierarchyRequestedAgainForMissingClass();
+    void testClassHierarchyThroughLocalSocketChannel();
+
 private:
 
     StubObjectRegister* mObjectRegister;
@@ -84,20 +94,20 @@ void RemoteClassTest::cleanup() {
 }
 
 void RemoteClassTest::testClassName() {
-    RemoteClass remoteClass(mService, mMapper, "The class name");
+    RemoteClass remoteClass(mMapper, "The class name");
 
     QCOMPARE(remoteClass.className(), QString("The class name"));
 }
 
 void RemoteClassTest::testSuperClass() {
-    RemoteClass remoteClass(mService, mMapper, "ChildClass");
+    RemoteClass remoteClass(mMapper, "ChildClass");
 
     QCOMPARE(remoteClass.superClass()->className(), QString("Class"));
     QCOMPARE(remoteClass.superClass()->superClass(), (RemoteClass*)0);
 }
 
 void RemoteClassTest::testSuperClassWhenRemoteClassIsNotAvailable() {
-    RemoteClass remoteClass(mService, mMapper, "Class");
+    RemoteClass remoteClass(mMapper, "Class");
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
@@ -105,7 +115,7 @@ void RemoteClassTest::testSuperClassWhenRemoteClassIsNotAvailable() {
 }
 
 void RemoteClassTest::testPropertyList() {
-    RemoteClass remoteClass(mService, mMapper, "Class");
+    RemoteClass remoteClass(mMapper, "Class");
 
     QStringList propertyList = remoteClass.propertyList();
     QCOMPARE(propertyList.count(), 3);
@@ -115,7 +125,7 @@ void RemoteClassTest::testPropertyList() {
 }
 
 void RemoteClassTest::testPropertyListWhenRemoteClassIsNotAvailable() {
-    RemoteClass remoteClass(mService, mMapper, "Class");
+    RemoteClass remoteClass(mMapper, "Class");
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
@@ -123,7 +133,7 @@ void RemoteClassTest::testPropertyListWhenRemoteClassIsNotAvailable() {
 }
 
 void RemoteClassTest::testSignalList() {
-    RemoteClass remoteClass(mService, mMapper, "Class");
+    RemoteClass remoteClass(mMapper, "Class");
 
     QStringList signalList = remoteClass.signalList();
     QCOMPARE(signalList.count(), 3);
@@ -133,13 +143,113 @@ void RemoteClassTest::testSignalList() {
 }
 
 void RemoteClassTest::testSignalListWhenRemoteClassIsNotAvailable() {
-    RemoteClass remoteClass(mService, mMapper, "Class");
+    RemoteClass remoteClass(mMapper, "Class");
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
     EXPECT_EXCEPTION(remoteClass.signalList(), DBusException);
 }
 
+void RemoteClassTest::testDataFromClassHierarchy() {
+    RemoteClass* remoteClass = mMapper->remoteClass("ChildClass");
+
+    QCOMPARE(remoteClass->propertyList().count(), 3);
+    QCOMPARE(remoteClass->propertyList()[0], QString("ChildClassProperty0"));
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
+
+    //The data of the super class is got from the class hierarchy received
+    //with the first call, so no more DBus calls are needed
+    RemoteClass* superClass = remoteClass->superClass();
+    QCOMPARE(superClass->className(), QString("Class"));
+    QCOMPARE(superClass->superClass(), (RemoteClass*)0);
+
+    QStringList signalList = superClass->signalList();
+    QCOMPARE(signalList.count(), 3);
+    QCOMPARE(signalList[0], QString("ClassSignal0()"));
+    QCOMPARE(signalList[1], QString("ClassSignal1()"));
+    QCOMPARE(signalList[2], QString("ClassSignal2()"));
+}
+
+void RemoteClassTest::testDataForClassNotInClassHierarchy() {
+    RemoteClass remoteClass(mMapper, "ChildChildClass");
+
+    QCOMPARE(remoteClass.superClass()->className(), QString("ChildClass"));
+
+    QStringList propertyList = remoteClass.propertyList();
+    QCOMPARE(propertyList.count(), 3);
+    QCOMPARE(propertyList[0], QString("ChildChildClassProperty0"));
+    QCOMPARE(propertyList[1], QString("ChildChildClassProperty1"));
+    QCOMPARE(propertyList[2], QString("ChildChildClassProperty2"));
+}
+
+void RemoteClassTest::testClassHierarchyRequestedOnce() {
+    StubClassRegisterAdaptor* classRegister =
+                    mObjectRegister->findChild<StubClassRegisterAdaptor*>();
+
+    RemoteClass* remoteClass = mMapper->remoteClass("ChildChildClass");
+    QCOMPARE(remoteClass->propertyList()[0],
+             QString("ChildChildClassProperty0"));
+
+    RemoteClass* otherRemoteClass =
+                            mMapper->remoteClass("ChildChildChildClass");
+    QCOMPARE(otherRemoteClass->propertyList()[0],
+             QString("ChildChildChildClassProperty0"));
+
+    QCOMPARE(remoteClass->superClass()->propertyList()[0],
+             QString("ChildClassProperty0"));
+    QCOMPARE(classRegister->mClassHierarchyCount, 1);
+}
+
+void RemoteClassTest::testClassHierarchyRequestedAgainForMissingClass() {
+    StubClassRegisterAdaptor* classRegister =
+                    mObjectRegister->findChild<StubClassRegisterAdaptor*>();
+
+    QCOMPARE(mMapper->remoteClass("ChildClass")->propertyList()[0],
+             QString("ChildClassProperty0"));
+    QCOMPARE(classRegister->mClassHierarchyCount, 1);
+
+    //Pretend that the class hierarchy was requested long ago
+    mMapper->mClassHierarchyRequestTime = QTime::currentTime().addMSecs(-2000);
+
+    RemoteClass* remoteClass = mMapper->remoteClass("ChildChildClass");
+    QCOMPARE(remoteClass->propertyList()[0],
+             QString("ChildChildClassProperty0"));
+    QCOMPARE(classRegister->mClassHierarchyCount, 2);
+
+    //The class hierarchy was just requested again
+    QCOMPARE(remoteClass->signalList()[0],
+             QString("ChildChildClassSignal0()"));
+    QCOMPARE(classRegister->mClassHierarchyCount, 2);
+
+    //Classes already received do not cause a new request
+    mMapper->mClassHierarchyRequestTime = QTime::currentTime().addMSecs(-2000);
+
+    QCOMPARE(mMapper->remoteClass("Class")->propertyList()[0],
+             QString("ClassProperty0"));
+    QCOMPARE(classRegister->mClassHierarchyCount, 2);
+}
+
+void RemoteClassTest::testClassHierarchyThroughLocalSocketChannel() {
+    StubLocalSocketServerThread serverThread("ktutorial-RemoteClassTest",
+                                             "The token");
+    serverThread.startAndWaitForListening();
+
+    LocalSocketChannel* channel = new LocalSocketChannel();
+    QVERIFY(channel->connectToServer(serverThread.mServerName, "The token"));
+    mMapper->setLocalSocketChannel(channel);
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
+
+    RemoteClass* remoteClass = mMapper->remoteClass("ChildClass");
+    QCOMPARE(remoteClass->propertyList()[0], QString("ChildClassProperty0"));
+    QCOMPARE(remoteClass->superClass()->className(), QString("Class"));
+
+    mMapper->setLocalSocketChannel(0);
+
+    serverThread.stopAndWait();
+}
+
 QTEST_MAIN(RemoteClassTest)
 
 #include "RemoteClassTest.moc"
@@ -24,6 +24,7 @@
 #include <QSignalSpy>
 #include <QtDBus/QtDBus>
 
+#include "LocalSocketChannel.h"
 #include "RemoteClassStubs.h"
 #include "RemoteEventSpy.h"
 #include "RemoteObject.h"
@@ -48,6 +49,12 @@ private slots:
     void init();
     void cleanup();
 
+    void testLocalServerName();
+    void testLocalServerNameWithoutLocalServer();
+
+    void testUseLocalSocketChannel();
+    void testUseLocalSocketChannelWithoutLocalServer();
+
     void testMainWindowSpy();
     void testMainWindowTwice();
     void testMainWindowWhenRemoteEditorSupportIsNotAvailable();
@@ -61,6 +68,10 @@ private slots:
     void testStopHighlighting();
     void testStopHighlightingWhenRemoteEditorSupportIsNotAvailable();
 
+    void testGrabWidget();
+    void testGrabWidgetWithNotWidgetObject();
+    void testGrabWidgetWhenRemoteEditorSupportIsNotAvailable();
+
     void testEnableEventSpy();
     void testEnableEventSpyTwice();
     void testEnableEventSpyWhenRemoteEditorSupportIsNotAvailable();
@@ -75,6 +86,10 @@ private slots:
     void testTestScriptedTutorialWhenRemoteEditorSupportIsNotAvailable();
     void testTestScriptedTutorialWithStepIdWhenRemoteEditorSupportIsNotAvailable();
 
+    void testUpdateTestScriptedTutorialSteps();
+    void testUpdateTestScriptedTutorialStepsWithoutTestedTutorial();
+    void testUpdateTestScriptedTutorialStepsWhenRemoteEditorSupportIsNotAvailable();
+
 private:
 
     StubEditorSupport* mEditorSupport;
@@ -86,8 +101,8 @@ void RemoteEditorSupportTest::init() {
     QVERIFY(QDBusConnection::sessionBus().isConnected());
 
     mEditorSupport = new StubEditorSupport();
-    QDBusConnection::sessionBus().registerObject("/ktutorial",
-                            mEditorSupport, QDBusConnection::ExportAllSlots);
+    QDBusConnection::sessionBus().registerObject("/ktutorial", mEditorSupport,
+        QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties);
 
     mObjectRegister = new StubObjectRegister();
     QDBusConnection::sessionBus().registerObject("/ktutorial/ObjectRegister",
@@ -102,6 +117,58 @@ void RemoteEditorSupportTest::cleanup() {
     delete mObjectRegister;
 }
 
+void RemoteEditorSupportTest::testLocalServerName() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    mEditorSupport->mLocalServerName = "The local server name";
+
+    QCOMPARE(remoteEditorSupport.localServerName(),
+             QString("The local server name"));
+}
+
+void RemoteEditorSupportTest::testLocalServerNameWithoutLocalServer() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial");
+
+    QCOMPARE(remoteEditorSupport.localServerName(), QString(""));
+}
+
+void RemoteEditorSupportTest::testUseLocalSocketChannel() {
+    StubLocalSocketServerThread serverThread(
+                                        "ktutorial-RemoteEditorSupportTest",
+                                        "The token");
+    serverThread.startAndWaitForListening();
+
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    mEditorSupport->mLocalServerName = serverThread.mServerName;
+
+    QVERIFY(remoteEditorSupport.useLocalSocketChannel("The token"));
+    QVERIFY(mapper.localSocketChannel());
+    QVERIFY(mapper.localSocketChannel()->isConnected());
+
+    RemoteObject* mainWindow = remoteEditorSupport.mainWindow();
+    QCOMPARE(mainWindow->name(), QString("The object name 42"));
+
+    serverThread.stopAndWait();
+}
+
+void RemoteEditorSupportTest::testUseLocalSocketChannelWithoutLocalServer() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    QVERIFY(!remoteEditorSupport.useLocalSocketChannel("The token"));
+    QVERIFY(!mapper.localSocketChannel());
+}
+
 void RemoteEditorSupportTest::testMainWindowSpy() {
     RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
     RemoteEditorSupport remoteEditorSupport(
@@ -215,6 +282,53 @@ void RemoteEditorSupportTest::
                      DBusException);
 }
 
+void RemoteEditorSupportTest::testGrabWidget() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    RemoteObject* mainWindow = remoteEditorSupport.mainWindow();
+
+    QImage thumbnail = remoteEditorSupport.grabWidget(mainWindow,
+                                                      QSize(20, 20));
+
+    QCOMPARE(mEditorSupport->mGrabWidgetRemoteWidgetIds.count(), 1);
+    QCOMPARE(mEditorSupport->mGrabWidgetRemoteWidgetIds[0],
+             mainWindow->objectId());
+    QCOMPARE(thumbnail.size(), QSize(20, 10));
+    QCOMPARE(thumbnail.pixel(0, 0), qRgb(0, 255, 0));
+    QCOMPARE(thumbnail.pixel(19, 9), qRgb(0, 255, 0));
+}
+
+void RemoteEditorSupportTest::testGrabWidgetWithNotWidgetObject() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    RemoteObject* remoteObject = mapper.remoteObject(23);
+
+    QImage thumbnail = remoteEditorSupport.grabWidget(remoteObject,
+                                                      QSize(20, 20));
+
+    QCOMPARE(mEditorSupport->mGrabWidgetRemoteWidgetIds.count(), 1);
+    QCOMPARE(mEditorSupport->mGrabWidgetRemoteWidgetIds[0], 23);
+    QVERIFY(thumbnail.isNull());
+}
+
+void RemoteEditorSupportTest::
+                    testGrabWidgetWhenRemoteEditorSupportIsNotAvailable() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    RemoteObject* mainWindow = remoteEditorSupport.mainWindow();
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial");
+
+    EXPECT_EXCEPTION(remoteEditorSupport.grabWidget(mainWindow, QSize(20, 20)),
+                     DBusException);
+}
+
 //RemoteObject* must be declared as a metatype to be used in qvariant_cast
 Q_DECLARE_METATYPE(RemoteObject*);
 
@@ -413,6 +527,54 @@ void RemoteEditorSupportTest::
                      DBusException);
 }
 
+void RemoteEditorSupportTest::testUpdateTestScriptedTutorialSteps() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    remoteEditorSupport.testScriptedTutorial("/some/file");
+
+    QStringList stepIds;
+    stepIds << "some step id" << "another step id";
+    QStringList stepScripts;
+    stepScripts << "some step script" << "another step script";
+
+    QVERIFY(remoteEditorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                                stepScripts));
+
+    QCOMPARE(mEditorSupport->mUpdatedStepIds, stepIds);
+    QCOMPARE(mEditorSupport->mUpdatedStepScripts, stepScripts);
+}
+
+void RemoteEditorSupportTest::
+                    testUpdateTestScriptedTutorialStepsWithoutTestedTutorial() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    QStringList stepIds;
+    stepIds << "some step id";
+    QStringList stepScripts;
+    stepScripts << "some step script";
+
+    QVERIFY(!remoteEditorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                                 stepScripts));
+}
+
+void RemoteEditorSupportTest::
+    testUpdateTestScriptedTutorialStepsWhenRemoteEditorSupportIsNotAvailable() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEditorSupport remoteEditorSupport(
+                        QDBusConnection::sessionBus().baseService(), &mapper);
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial");
+
+    EXPECT_EXCEPTION(remoteEditorSupport.updateTestScriptedTutorialSteps(
+                                            QStringList() << "some step id",
+                                            QStringList() << "some script"),
+                     DBusException);
+}
+
 QTEST_MAIN(RemoteEditorSupportTest)
 
 #include "RemoteEditorSupportTest.moc"
@@ -20,6 +20,7 @@
 
 #include "RemoteEventSpy.h"
 
+#include <QPointer>
 #include <QSignalSpy>
 #include <QtDBus/QtDBus>
 
@@ -37,6 +38,8 @@ private slots:
 
     void testEventReceived();
 
+    void testObjectDestroyed();
+
 private:
 
     StubEventSpy* mEventSpy;
@@ -93,6 +96,37 @@ void RemoteEventSpyTest::testEventReceived() {
     QCOMPARE(argument.toString(), QString("Close"));
 }
 
+void RemoteEventSpyTest::testObjectDestroyed() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+    RemoteEventSpy remoteEventSpy(QDBusConnection::sessionBus().baseService(),
+                                  &mapper);
+
+    QPointer<RemoteObject> remoteObject = mapper.remoteObject(42);
+    QPointer<RemoteObject> otherRemoteObject = mapper.remoteObject(23);
+    RemoteObject* destroyedRemoteObject = remoteObject;
+
+    //RemoteObject* must be registered in order to be used with QSignalSpy
+    int remoteObjectStarType =
+                            qRegisterMetaType<RemoteObject*>("RemoteObject*");
+    QSignalSpy aboutToBeDestroyedSpy(&remoteEventSpy,
+                        SIGNAL(remoteObjectAboutToBeDestroyed(RemoteObject*)));
+
+    mEventSpy->emitObjectDestroyed(42);
+
+    //Give D-Bus time to deliver the signal
+    QTest::qWait(100);
+
+    QCOMPARE(aboutToBeDestroyedSpy.count(), 1);
+    QVariant argument = aboutToBeDestroyedSpy.at(0).at(0);
+    QCOMPARE(argument.userType(), remoteObjectStarType);
+    QCOMPARE(qvariant_cast<RemoteObject*>(argument), destroyedRemoteObject);
+    QVERIFY(!remoteObject);
+    QVERIFY(otherRemoteObject);
+    QCOMPARE(mapper.remoteObject(23), otherRemoteObject.data());
+    QVERIFY(mapper.remoteObject(42));
+    QCOMPARE(mapper.remoteObject(42)->name(), QString("The object name 42"));
+}
+
 QTEST_MAIN(RemoteEventSpyTest)
 
 #include "RemoteEventSpyTest.moc"
@@ -20,6 +20,7 @@
 
 #include "RemoteObjectMapper.h"
 
+#include <QPointer>
 #include <QtDBus/QtDBus>
 
 #include "RemoteClass.h"
@@ -39,6 +40,12 @@ private slots:
     void testRemoteObjectTwice();
     void testRemoteNullObject();
 
+    void testRemoveRemoteObject();
+    void testRemoveRemoteObjectNotMapped();
+
+    void testTakeRemoteObject();
+    void testTakeRemoteObjectNotMapped();
+
     void testRemoteClass();
     void testRemoteClassSeveralIds();
     void testRemoteClassTwice();
@@ -109,6 +116,55 @@ void RemoteObjectMapperTest::testRemoteNullObject() {
     QVERIFY(!remoteObject);
 }
 
+void RemoteObjectMapperTest::testRemoveRemoteObject() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+
+    QPointer<RemoteObject> remoteObject = mapper.remoteObject(42);
+    QPointer<RemoteObject> otherRemoteObject = mapper.remoteObject(23);
+
+    mapper.removeRemoteObject(42);
+
+    QVERIFY(!remoteObject);
+    QVERIFY(otherRemoteObject);
+    QCOMPARE(mapper.remoteObject(23), otherRemoteObject.data());
+
+    RemoteObject* newRemoteObject = mapper.remoteObject(42);
+
+    QVERIFY(newRemoteObject);
+    QCOMPARE(newRemoteObject->name(), QString("The object name 42"));
+}
+
+void RemoteObjectMapperTest::testRemoveRemoteObjectNotMapped() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+
+    QPointer<RemoteObject> remoteObject = mapper.remoteObject(42);
+
+    mapper.removeRemoteObject(23);
+
+    QVERIFY(remoteObject);
+    QCOMPARE(mapper.remoteObject(42), remoteObject.data());
+}
+
+void RemoteObjectMapperTest::testTakeRemoteObject() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+
+    RemoteObject* remoteObject = mapper.remoteObject(42);
+
+    QCOMPARE(mapper.takeRemoteObject(42), remoteObject);
+    QVERIFY(mapper.remoteObject(42) != remoteObject);
+
+    delete remoteObject;
+}
+
+void RemoteObjectMapperTest::testTakeRemoteObjectNotMapped() {
+    RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
+
+    QPointer<RemoteObject> remoteObject = mapper.remoteObject(42);
+
+    QCOMPARE(mapper.takeRemoteObject(23), (RemoteObject*)0);
+    QCOMPARE(mapper.remoteObject(42), remoteObject.data());
+}
+
 void RemoteObjectMapperTest::testRemoteClass() {
     RemoteObjectMapper mapper(QDBusConnection::sessionBus().baseService());
 
@@ -24,6 +24,7 @@
 #include <QtDBus/QtDBus>
 
 #include "RemoteClass.h"
+#include "LocalSocketChannel.h"
 #include "RemoteClassStubs.h"
 #include "RemoteObjectMapper.h"
 
@@ -57,6 +58,11 @@ private slots:
     void testChildren();
     void testChildrenWhenRemoteObjectIsNotAvailable();
 
+    void testNameWithLocalSocketChannel();
+    void testRemoteClassWithLocalSocketChannel();
+    void testChildrenWithLocalSocketChannel();
+    void testNameWithLocalSocketChannelWithoutReply();
+
 private:
 
     StubObjectRegister* mObjectRegister;
@@ -85,19 +91,19 @@ void RemoteObjectTest::cleanup() {
 }
 
 void RemoteObjectTest::testObjectId() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QCOMPARE(remoteObject.objectId(), 42);
 }
 
 void RemoteObjectTest::testName() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QCOMPARE(remoteObject.name(), QString("The object name 42"));
 }
 
 void RemoteObjectTest::testNameWhenRemoteObjectIsNotAvailable() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
@@ -105,14 +111,14 @@ void RemoteObjectTest::testNameWhenRemoteObjectIsNotAvailable() {
 }
 
 void RemoteObjectTest::testRemoteClass() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QCOMPARE(remoteObject.remoteClass()->className(),
              QString("The class name 42"));
 }
 
 void RemoteObjectTest::testRemoteClassWhenRemoteObjectIsNotAvailable() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
@@ -120,7 +126,7 @@ void RemoteObjectTest::testRemoteClassWhenRemoteObjectIsNotAvailable() {
 }
 
 void RemoteObjectTest::testChildren() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QList<RemoteObject*> children = remoteObject.children();
     QCOMPARE(children.count(), 9);
@@ -136,13 +142,97 @@ void RemoteObjectTest::testChildren() {
 }
 
 void RemoteObjectTest::testChildrenWhenRemoteObjectIsNotAvailable() {
-    RemoteObject remoteObject(mService, mMapper, 42);
+    RemoteObject remoteObject(mMapper, 42);
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
     EXPECT_EXCEPTION(remoteObject.children(), DBusException);
 }
 
+void RemoteObjectTest::testNameWithLocalSocketChannel() {
+    StubLocalSocketServerThread serverThread("ktutorial-RemoteObjectTest",
+                                             "The token");
+    serverThread.startAndWaitForListening();
+
+    LocalSocketChannel* channel = new LocalSocketChannel();
+    channel->connectToServer(serverThread.mServerName, "The token");
+    mMapper->setLocalSocketChannel(channel);
+
+    RemoteObject remoteObject(mMapper, 42);
+
+    //D-Bus is not used
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
+
+    QCOMPARE(remoteObject.name(), QString("The object name 42"));
+
+    serverThread.stopAndWait();
+}
+
+void RemoteObjectTest::testRemoteClassWithLocalSocketChannel() {
+    StubLocalSocketServerThread serverThread("ktutorial-RemoteObjectTest",
+                                             "The token");
+    serverThread.startAndWaitForListening();
+
+    LocalSocketChannel* channel = new LocalSocketChannel();
+    channel->connectToServer(serverThread.mServerName, "The token");
+    mMapper->setLocalSocketChannel(channel);
+
+    RemoteObject remoteObject(mMapper, 42);
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
+
+    QCOMPARE(remoteObject.remoteClass()->className(),
+             QString("The class name 42"));
+
+    serverThread.stopAndWait();
+}
+
+void RemoteObjectTest::testChildrenWithLocalSocketChannel() {
+    StubLocalSocketServerThread serverThread("ktutorial-RemoteObjectTest",
+                                             "The token");
+    serverThread.startAndWaitForListening();
+
+    LocalSocketChannel* channel = new LocalSocketChannel();
+    channel->connectToServer(serverThread.mServerName, "The token");
+    mMapper->setLocalSocketChannel(channel);
+
+    RemoteObject remoteObject(mMapper, 42);
+
+    QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
+
+    QList<RemoteObject*> children = remoteObject.children();
+    QCOMPARE(children.count(), 9);
+    QCOMPARE(children[0]->objectId(), 420);
+    QCOMPARE(children[1]->objectId(), 421);
+    QCOMPARE(children[2]->objectId(), 422);
+    QCOMPARE(children[3]->objectId(), 423);
+    QCOMPARE(children[4]->objectId(), 5);
+    QCOMPARE(children[5]->objectId(), 6);
+    QCOMPARE(children[6]->objectId(), 7);
+    QCOMPARE(children[7]->objectId(), 8);
+    QCOMPARE(children[8]->objectId(), 9);
+
+    serverThread.stopAndWait();
+}
+
+void RemoteObjectTest::testNameWithLocalSocketChannelWithoutReply() {
+    StubLocalSocketServerThread serverThread("ktutorial-RemoteObjectTest",
+                                             "The token");
+    serverThread.startAndWaitForListening();
+
+    LocalSocketChannel* channel = new LocalSocketChannel();
+    channel->connectToServer(serverThread.mServerName, "The token");
+    mMapper->setLocalSocketChannel(channel);
+
+    RemoteObject remoteObject(mMapper, 1000);
+
+    //D-Bus is used once the call through the channel times out
+    QCOMPARE(remoteObject.name(), QString("The object name 1000"));
+    QVERIFY(!mMapper->localSocketChannel());
+
+    serverThread.stopAndWait();
+}
+
 QTEST_MAIN(RemoteObjectTest)
 
 #include "RemoteObjectTest.moc"
@@ -30,13 +30,29 @@ int main (int argc, char *argv[]) {
     KMainWindow* window = new KMainWindow();
     window->show();
 
+    QString pid = QString::number(QCoreApplication::applicationPid());
+    StubLocalSocketServer* localSocketServer =
+            new StubLocalSocketServer(qgetenv("KTUTORIAL_EDITOR_TOKEN"));
+    localSocketServer->listen("ktutorial-" + pid);
+
     StubEditorSupport* editorSupport = new StubEditorSupport();
-    QDBusConnection::sessionBus().registerObject("/ktutorial",
-                            editorSupport, QDBusConnection::ExportAllSlots);
+    editorSupport->mLocalServerName = localSocketServer->serverName();
+    QDBusConnection::sessionBus().registerObject("/ktutorial", editorSupport,
+        QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties);
 
     StubObjectRegister* objectRegister = new StubObjectRegister();
     QDBusConnection::sessionBus().registerObject("/ktutorial/ObjectRegister",
                             objectRegister, QDBusConnection::ExportAdaptors);
 
+    QString editorService = qgetenv("KTUTORIAL_EDITOR_SERVICE");
+    if (!editorService.isEmpty()) {
+        QDBusMessage message = QDBusMessage::createMethodCall(editorService,
+                                    "/ktutorial/TargetApplication",
+                                    "org.kde.ktutorial.TargetApplication",
+                                    "editorSupportRegistered");
+        message << QString(qgetenv("KTUTORIAL_EDITOR_TOKEN"));
+        QDBusConnection::sessionBus().send(message);
+    }
+
     return app.exec();
 }
@@ -26,6 +26,7 @@
 #undef protected
 
 #include <QApplication>
+#include <QDBusConnection>
 #include <QSignalSpy>
 
 #include <KProcess>
@@ -49,6 +50,7 @@ private slots:
     void testSetTargetApplicationFilePathRelative();
 
     void testStart();
+    void testStartPassesRendezvousToken();
     void testStartApplicationWithDelayedRegister();
     void testStartAlreadyStarted();
     void testStartAfterSettingAgainTargetApplicationFilePath();
@@ -129,6 +131,26 @@ void TargetApplicationTest::testStart() {
              QString("The object name 42"));
 }
 
+void TargetApplicationTest::testStartPassesRendezvousToken() {
+    TargetApplication targetApplication;
+    targetApplication.setTargetApplicationFilePath(mTargetApplicationStubPath);
+
+    QSignalSpy startedSpy(&targetApplication, SIGNAL(started()));
+    targetApplication.start();
+
+    QStringList environment = targetApplication.mProcess->environment();
+    QVERIFY(environment.contains("KTUTORIAL_EDITOR_SERVICE=" +
+                                QDBusConnection::sessionBus().baseService()));
+    QVERIFY(!targetApplication.mRendezvousToken.isEmpty());
+    QVERIFY(environment.contains("KTUTORIAL_EDITOR_TOKEN=" +
+                                 targetApplication.mRendezvousToken));
+
+    //The stub calls back the editor with the token
+    QVERIFY(waitForSignalCount(&startedSpy, 1, 10000));
+    QCOMPARE(targetApplication.mServiceName,
+             targetApplication.remoteEditorSupport()->service());
+}
+
 void TargetApplicationTest::testStartApplicationWithDelayedRegister() {
     TargetApplication targetApplication;
     targetApplication.setTargetApplicationFilePath(
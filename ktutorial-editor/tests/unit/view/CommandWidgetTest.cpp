@@ -22,6 +22,9 @@
 
 #include <QUndoCommand>
 
+#include "../commands/TextChangeCommand.h"
+#include "../commands/UndoStack.h"
+
 class CommandWidgetTest: public QObject {
 Q_OBJECT
 
@@ -32,9 +35,13 @@ private slots:
     void testSaveChangesNoParentAndStack();
     void testSaveChangesNoParentAndStackWithSingleCommand();
     void testSaveChangesNoParentAndStackWithNoCommands();
+    void testSaveChangesNoParentAndStackWithMergeableCommand();
+    void testSaveChangesNoParentAndStackWithSeveralMergeableCommands();
     void testSaveChangesParentAndStack();
     void testSaveChangesParentAndStackWithNoCommands();
 
+    void testMemoryUsageOfSavedChangesWithSingleCommand();
+
 };
 
 class MockCommandWidget;
@@ -51,6 +58,8 @@ public:
         mIndex(index) {
     }
 
+    virtual int id() const;
+    virtual bool mergeWith(const QUndoCommand* other);
     virtual void redo();
 
 };
@@ -66,12 +75,14 @@ public:
     int mCommand3RedoCallCount;
 
     int mNumberOfCommands;
+    int mCommandId;
 
     MockCommandWidget(QWidget* parent = 0): CommandWidget(parent),
         mCommand1RedoCallCount(0),
         mCommand2RedoCallCount(0),
         mCommand3RedoCallCount(0),
-        mNumberOfCommands(3) {
+        mNumberOfCommands(3),
+        mCommandId(-1) {
         setWindowTitle("The window title");
     }
 
@@ -106,6 +117,15 @@ protected:
 //parent the call count must be stored somewhere out of the commands themselves.
 //The method must be defined here to avoid the compiler complaining about an
 //incomplete type due to using the widget.
+int MockCommand::id() const {
+    return mWidget->mCommandId;
+}
+
+bool MockCommand::mergeWith(const QUndoCommand* other) {
+    Q_UNUSED(other);
+    return true;
+}
+
 void MockCommand::redo() {
     if (mIndex == 0) {
         mWidget->mCommand1RedoCallCount++;
@@ -143,7 +163,7 @@ void CommandWidgetTest::testSaveChangesParentAndNoStack() {
 
 void CommandWidgetTest::testSaveChangesNoParentAndStack() {
     MockCommandWidget widget;
-    QUndoStack stack;
+    UndoStack stack;
 
     widget.setUndoStack(&stack);
     widget.saveChanges();
@@ -163,7 +183,7 @@ void CommandWidgetTest::testSaveChangesNoParentAndStack() {
 void CommandWidgetTest::testSaveChangesNoParentAndStackWithSingleCommand() {
     MockCommandWidget widget;
     widget.mNumberOfCommands = 1;
-    QUndoStack stack;
+    UndoStack stack;
 
     widget.setUndoStack(&stack);
     widget.saveChanges();
@@ -179,7 +199,7 @@ void CommandWidgetTest::testSaveChangesNoParentAndStackWithSingleCommand() {
 void CommandWidgetTest::testSaveChangesNoParentAndStackWithNoCommands() {
     MockCommandWidget widget;
     widget.mNumberOfCommands = 0;
-    QUndoStack stack;
+    UndoStack stack;
 
     widget.setUndoStack(&stack);
     widget.saveChanges();
@@ -187,9 +207,44 @@ void CommandWidgetTest::testSaveChangesNoParentAndStackWithNoCommands() {
     QCOMPARE(stack.count(), 0);
 }
 
+void CommandWidgetTest::testSaveChangesNoParentAndStackWithMergeableCommand() {
+    MockCommandWidget widget;
+    widget.mNumberOfCommands = 1;
+    widget.mCommandId = 42;
+    UndoStack stack;
+
+    widget.setUndoStack(&stack);
+    widget.saveChanges();
+    widget.saveChanges();
+
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(stack.index(), 1);
+    const QUndoCommand* parent = stack.command(0);
+    QCOMPARE(parent->id(), 42);
+    QCOMPARE(parent->text(), QString("First command"));
+    QCOMPARE(parent->childCount(), 1);
+    QCOMPARE(widget.mCommand1RedoCallCount, 2);
+}
+
+void CommandWidgetTest::
+                testSaveChangesNoParentAndStackWithSeveralMergeableCommands() {
+    MockCommandWidget widget;
+    widget.mCommandId = 42;
+    UndoStack stack;
+
+    widget.setUndoStack(&stack);
+    widget.saveChanges();
+    widget.saveChanges();
+
+    QCOMPARE(stack.count(), 2);
+    QCOMPARE(stack.index(), 2);
+    QCOMPARE(stack.command(0)->id(), -1);
+    QCOMPARE(stack.command(1)->id(), -1);
+}
+
 void CommandWidgetTest::testSaveChangesParentAndStack() {
     MockCommandWidget widget;
-    QUndoStack stack;
+    UndoStack stack;
     QUndoCommand* parent = new QUndoCommand();
     parent->setText("Parent command");
 
@@ -212,7 +267,7 @@ void CommandWidgetTest::testSaveChangesParentAndStack() {
 void CommandWidgetTest::testSaveChangesParentAndStackWithNoCommands() {
     MockCommandWidget widget;
     widget.mNumberOfCommands = 0;
-    QUndoStack stack;
+    UndoStack stack;
     QUndoCommand* parent = new QUndoCommand();
     parent->setText("Parent command");
 
@@ -228,6 +283,27 @@ void CommandWidgetTest::testSaveChangesParentAndStackWithNoCommands() {
 
 /////////////////////////////////// Helpers ////////////////////////////////////
 
+void CommandWidgetTest::testMemoryUsageOfSavedChangesWithSingleCommand() {
+    UndoStack stack;
+    MockCommandWidget widget;
+    widget.setUndoStack(&stack);
+    widget.mNumberOfCommands = 1;
+    //The parent command returns the id of its only child, which is the id of
+    //a TextChangeCommand although neither of them is one
+    widget.mCommandId = TextChangeCommand::StepTextChange;
+
+    widget.saveChanges();
+
+    QCOMPARE(stack.count(), 1);
+
+    //The memory usage summed by UndoStack::memoryUsage()
+    int expectedUsage = 2 * sizeof(QUndoCommand) +
+                        2 * QString("First command").size() * sizeof(QChar);
+    QCOMPARE(TextChangeCommand::memoryUsage(stack.command(0)),
+             expectedUsage);
+    QCOMPARE(stack.memoryUsage(), (qint64)expectedUsage);
+}
+
 QTEST_MAIN(CommandWidgetTest)
 
 #include "CommandWidgetTest.moc"
@@ -55,6 +55,7 @@ private slots:
     void testReactionSetCustomCode();
     void testReactionSetCustomCodeChange();
     void testReactionSetCustomCodeEmpty();
+    void testReactionSetCustomCodeDoesNotUpdateTriggerItem();
 
     void testReactionSetTriggerTypeToOptionSelected();
     void testReactionSetTriggerTypeToConditionMet();
@@ -370,6 +371,28 @@ void ReactionTreeItemTest::testReactionSetCustomCodeEmpty() {
     assertDataChanged(dataChangedSpy, 0, item.child(1)->child(0));
 }
 
+void ReactionTreeItemTest::testReactionSetCustomCodeDoesNotUpdateTriggerItem() {
+    WaitForSignal* waitFor = new WaitForSignal();
+    waitFor->setEmitterName("The emitter");
+    waitFor->setSignalName("theSignal()");
+
+    Reaction reaction;
+    reaction.setTriggerType(Reaction::ConditionMet);
+    reaction.setWaitFor(waitFor);
+    reaction.setResponseType(Reaction::CustomCode);
+    reaction.setCustomCode("The custom code");
+
+    ReactionTreeItem item(&reaction);
+
+    TreeItem* conditionItem = item.child(0);
+
+    reaction.setCustomCode("The new custom code");
+
+    QCOMPARE(item.childCount(), 2);
+    QCOMPARE(item.child(0), conditionItem);
+    assertCustomCode(item.child(1), "The new custom code");
+}
+
 void ReactionTreeItemTest::testReactionSetTriggerTypeToOptionSelected() {
     Reaction reaction;
     reaction.setTriggerType(Reaction::ConditionMet);
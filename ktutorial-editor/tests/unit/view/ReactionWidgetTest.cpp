@@ -24,7 +24,6 @@
 #include <QRadioButton>
 #include <QTimer>
 #include <QTreeView>
-#include <QUndoStack>
 
 #include <KComboBox>
 #include <KDialog>
@@ -33,6 +32,7 @@
 #include <KTextEdit>
 
 #include "WaitForWidget.h"
+#include "../commands/UndoStack.h"
 #include "../data/Reaction.h"
 #include "../data/Step.h"
 #include "../data/Tutorial.h"
@@ -295,7 +295,7 @@ void ReactionWidgetTest::testSaveChangesNoOldWaitForAndNoNewWaitFor() {
 
     ReactionWidget widget(&reaction);
 
-    QUndoStack undoStack;
+    UndoStack undoStack;
     widget.setUndoStack(&undoStack);
 
     widget.saveChanges();
@@ -311,7 +311,7 @@ void ReactionWidgetTest::testSaveChangesEqualWaitFor() {
 
     ReactionWidget widget(&reaction);
 
-    QUndoStack undoStack;
+    UndoStack undoStack;
     widget.setUndoStack(&undoStack);
 
     addWaitForSignal(&widget);
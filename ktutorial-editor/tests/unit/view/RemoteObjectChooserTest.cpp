@@ -27,6 +27,7 @@
 #undef protected
 
 #include <QCheckBox>
+#include <QLabel>
 #include <QPushButton>
 #include <QSignalSpy>
 #include <QTreeView>
@@ -42,6 +43,7 @@
 
 #include "TargetApplicationView.h"
 #include "../targetapplication/RemoteEditorSupport.h"
+#include "../targetapplication/RemoteEventSpy.h"
 #include "../targetapplication/RemoteObject.h"
 
 class RemoteObjectChooserTest: public QObject {
@@ -72,7 +74,11 @@ private slots:
 
     void testSelectRemoteObject();
 
+    void testPreviewRemoteObject();
+    void testPreviewRemoteObjectNotWidget();
+
     void testOkButton();
+    void testOkButtonAfterSelectedRemoteObjectIsDestroyed();
     void testCancelButton();
 
 private:
@@ -98,6 +104,7 @@ private:
     QCheckBox* showOnlyWidgetsCheckBox(RemoteObjectChooser* widget) const;
 
     QTreeView* remoteObjectsTreeView(RemoteObjectChooser* widget) const;
+    QLabel* previewLabel(RemoteObjectChooser* widget) const;
 
     QPushButton* okButton(RemoteObjectChooser* widget) const;
     QPushButton* cancelButton(RemoteObjectChooser* widget) const;
@@ -437,7 +444,7 @@ void RemoteObjectChooserTest::testSelectRemoteObject() {
     QVERIFY(TargetApplication::self()->remoteEditorSupport());
     RemoteObject* mainWindow =
                 TargetApplication::self()->remoteEditorSupport()->mainWindow();
-    QCOMPARE(chooser->mCurrentRemoteObject, mainWindow->children()[1]);
+    QCOMPARE(chooser->mCurrentRemoteObject.data(), mainWindow->children()[1]);
     QVERIFY(okButton(chooser)->isEnabled());
     QVERIFY(cancelButton(chooser)->isEnabled());
 
@@ -445,7 +452,7 @@ void RemoteObjectChooserTest::testSelectRemoteObject() {
     remoteObjectsTreeView(chooser)->selectionModel()->
                             select(index, QItemSelectionModel::SelectCurrent);
 
-    QCOMPARE(chooser->mCurrentRemoteObject, mainWindow->children()[0]);
+    QCOMPARE(chooser->mCurrentRemoteObject.data(), mainWindow->children()[0]);
     QVERIFY(okButton(chooser)->isEnabled());
     QVERIFY(cancelButton(chooser)->isEnabled());
 
@@ -453,11 +460,83 @@ void RemoteObjectChooserTest::testSelectRemoteObject() {
     remoteObjectsTreeView(chooser)->selectionModel()->
                             select(index, QItemSelectionModel::SelectCurrent);
 
-    QCOMPARE(chooser->mCurrentRemoteObject, (RemoteObject*)0);
+    QCOMPARE(chooser->mCurrentRemoteObject.data(), (RemoteObject*)0);
     QVERIFY(!okButton(chooser)->isEnabled());
     QVERIFY(cancelButton(chooser)->isEnabled());
 }
 
+void RemoteObjectChooserTest::testPreviewRemoteObject() {
+    TargetApplication::self()->setTargetApplicationFilePath(mPath);
+
+    QWidget window(0, Qt::Window);
+    //Queue closing the information message box
+    closeInformationMessageBox(10000);
+    RemoteObjectChooser* chooser = new RemoteObjectChooser(&window);
+    chooser->show();
+
+    QVERIFY(waitForTargetApplicationToStart(10000));
+
+    QVERIFY(remoteObjectsTreeView(chooser)->model());
+    QModelIndex index = remoteObjectsTreeView(chooser)->model()->index(0, 0);
+    chooser->handleItemEntered(index);
+
+    QVERIFY(TargetApplication::self()->remoteEditorSupport());
+    RemoteObject* mainWindow =
+                TargetApplication::self()->remoteEditorSupport()->mainWindow();
+    RemoteObject* remoteObject = mainWindow->children()[0];
+    QCOMPARE(chooser->mHoveredRemoteObject.data(), remoteObject);
+    QVERIFY(!chooser->mPreviews.contains(remoteObject->objectId()));
+
+    //Wait for the delayed preview request
+    QTest::qWait(500);
+
+    QVERIFY(chooser->mPreviews.contains(remoteObject->objectId()));
+    QCOMPARE(chooser->mPreviews.value(remoteObject->objectId()).size(),
+             QSize(40, 10));
+    QVERIFY(previewLabel(chooser)->isVisible());
+    QVERIFY(previewLabel(chooser)->pixmap());
+    QCOMPARE(previewLabel(chooser)->pixmap()->size(), QSize(40, 10));
+
+    chooser->clearPreview();
+
+    QVERIFY(!chooser->mHoveredRemoteObject);
+    QVERIFY(!previewLabel(chooser)->isVisible());
+
+    //Cached previews are shown without waiting
+    chooser->handleItemEntered(index);
+
+    QVERIFY(previewLabel(chooser)->isVisible());
+    QVERIFY(!chooser->mPreviewTimer->isActive());
+}
+
+void RemoteObjectChooserTest::testPreviewRemoteObjectNotWidget() {
+    TargetApplication::self()->setTargetApplicationFilePath(mPath);
+
+    QWidget window(0, Qt::Window);
+    //Queue closing the information message box
+    closeInformationMessageBox(10000);
+    RemoteObjectChooser* chooser = new RemoteObjectChooser(&window);
+    chooser->show();
+
+    QVERIFY(waitForTargetApplicationToStart(10000));
+
+    QVERIFY(remoteObjectsTreeView(chooser)->model());
+    QModelIndex index = remoteObjectsTreeView(chooser)->model()->index(4, 0);
+    chooser->handleItemEntered(index);
+
+    //Wait for the delayed preview request
+    QTest::qWait(500);
+
+    QVERIFY(TargetApplication::self()->remoteEditorSupport());
+    RemoteObject* mainWindow =
+                TargetApplication::self()->remoteEditorSupport()->mainWindow();
+    RemoteObject* remoteObject = mainWindow->children()[4];
+    QVERIFY(chooser->mPreviews.contains(remoteObject->objectId()));
+    QVERIFY(chooser->mPreviews.value(remoteObject->objectId()).isNull());
+    QVERIFY(previewLabel(chooser)->isVisible());
+    QVERIFY(!previewLabel(chooser)->text().isEmpty());
+}
+
 //RemoteObject* must be declared as a metatype to be used in qvariant_cast
 Q_DECLARE_METATYPE(RemoteObject*);
 
@@ -505,6 +584,62 @@ void RemoteObjectChooserTest::testOkButton() {
     QCOMPARE(qvariant_cast<RemoteObject*>(argument), mainWindow->children()[1]);
 }
 
+void RemoteObjectChooserTest::
+                        testOkButtonAfterSelectedRemoteObjectIsDestroyed() {
+    TargetApplication::self()->setTargetApplicationFilePath(mPath);
+
+    QWidget window(0, Qt::Window);
+    window.show();
+    QWidget* dialog = new QWidget(&window, Qt::Dialog);
+    dialog->show();
+
+    //Queue closing the information message box
+    closeInformationMessageBox(10000);
+    QPointer<RemoteObjectChooser> chooser = new RemoteObjectChooser(dialog);
+    chooser->show();
+
+    QVERIFY(waitForTargetApplicationToStart(10000));
+
+    QVERIFY(remoteObjectsTreeView(chooser)->model());
+    QModelIndex index = remoteObjectsTreeView(chooser)->model()->index(1, 0);
+    remoteObjectsTreeView(chooser)->selectionModel()->
+                            select(index, QItemSelectionModel::SelectCurrent);
+
+    QVERIFY(TargetApplication::self()->remoteEditorSupport());
+    RemoteObject* mainWindow =
+                TargetApplication::self()->remoteEditorSupport()->mainWindow();
+    int objectId = mainWindow->children()[1]->objectId();
+    QCOMPARE(chooser->mCurrentRemoteObject.data(), mainWindow->children()[1]);
+
+    //Simulate the notification of the destruction of the remote object
+    RemoteEventSpy* remoteEventSpy =
+        TargetApplication::self()->remoteEditorSupport()->enableEventSpy();
+    QMetaObject::invokeMethod(remoteEventSpy, "handleObjectDestroyed",
+                              Q_ARG(int, objectId));
+    TargetApplication::self()->remoteEditorSupport()->disableEventSpy();
+
+    QVERIFY(!chooser->mCurrentRemoteObject);
+
+    //RemoteObject* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<RemoteObject*>("RemoteObject*");
+    QSignalSpy remoteObjectChosenSpy(chooser,
+                                     SIGNAL(remoteObjectChosen(RemoteObject*)));
+
+    okButton(chooser)->click();
+
+    QVERIFY(chooser);
+    QVERIFY(!okButton(chooser)->isEnabled());
+    QCOMPARE(remoteObjectChosenSpy.count(), 0);
+
+    //Closing the chooser must not use the destroyed RemoteObject
+    cancelButton(chooser)->click();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(chooser, QEvent::DeferredDelete);
+
+    QVERIFY(!chooser);
+}
+
 void RemoteObjectChooserTest::testCancelButton() {
     TargetApplication::self()->setTargetApplicationFilePath(mPath);
 
@@ -853,6 +988,11 @@ QTreeView* RemoteObjectChooserTest::remoteObjectsTreeView(
     return widget->findChild<QTreeView*>("remoteObjectsTreeView");
 }
 
+QLabel* RemoteObjectChooserTest::previewLabel(
+                                            RemoteObjectChooser* widget) const {
+    return widget->findChild<QLabel*>("previewLabel");
+}
+
 QPushButton* RemoteObjectChooserTest::okButton(
                                             RemoteObjectChooser* widget) const {
     return widget->findChild<QPushButton*>("okButton");
@@ -136,7 +136,7 @@ void RemoteObjectTreeItemTest::cleanup() {
 }
 
 void RemoteObjectTreeItemTest::testConstructor() {
-    RemoteObject remoteObject(mService, mMapper, 108);
+    RemoteObject remoteObject(mMapper, 108);
 
     StubTreeItem parent;
     RemoteObjectTreeItem item(&remoteObject, &parent);
@@ -150,7 +150,7 @@ void RemoteObjectTreeItemTest::testConstructor() {
 }
 
 void RemoteObjectTreeItemTest::testConstructorFullRemoteObject() {
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
 
     StubTreeItem parent;
     RemoteObjectTreeItem item(&remoteObject, &parent);
@@ -197,7 +197,7 @@ void RemoteObjectTreeItemTest::testConstructorFullRemoteObject() {
 }
 
 void RemoteObjectTreeItemTest::testConstructorWhenRemoteObjectIsNotAvailable() {
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
 
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/ObjectRegister");
 
@@ -212,12 +212,12 @@ void RemoteObjectTreeItemTest::testConstructorWhenRemoteObjectIsNotAvailable() {
 }
 
 void RemoteObjectTreeItemTest::testRemoteObjectAddChild() {
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     //The child is not really added to the remoteObject. The tree item is misled
     //to think that
-    RemoteObject fakeChild(mService, mMapper, 16);
+    RemoteObject fakeChild(mMapper, 16);
     item.addChildRemoteObject(&fakeChild);
 
     QCOMPARE(item.childCount(), 5);
@@ -244,7 +244,7 @@ void RemoteObjectTreeItemTest::testRemoteObjectAddChild() {
 }
 
 void RemoteObjectTreeItemTest::testRemoteObjectRemoveChild() {
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     //The child is not really removed from the remoteObject. The tree item is
@@ -267,7 +267,7 @@ void RemoteObjectTreeItemTest::testRemoteObjectRemoveChild() {
 void RemoteObjectTreeItemTest::testUpdateSingleChildAdded() {
     mObjectRegister->mNumberOfChildren = 2;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     mObjectRegister->mNumberOfChildren = 3;
@@ -293,7 +293,7 @@ void RemoteObjectTreeItemTest::testUpdateSingleChildAdded() {
 void RemoteObjectTreeItemTest::testUpdateSeveralChildrenAdded() {
     mObjectRegister->mNumberOfChildren = 1;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     mObjectRegister->mNumberOfChildren = 4;
@@ -328,7 +328,7 @@ void RemoteObjectTreeItemTest::testUpdateSeveralChildrenAdded() {
 void RemoteObjectTreeItemTest::testUpdateSingleChildRemoved() {
     mObjectRegister->mNumberOfChildren = 2;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     mObjectRegister->mFilterEvenChildren = true;
@@ -348,7 +348,7 @@ void RemoteObjectTreeItemTest::testUpdateSingleChildRemoved() {
 void RemoteObjectTreeItemTest::testUpdateSeveralChildrenRemoved() {
     mObjectRegister->mNumberOfChildren = 5;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     mObjectRegister->mFilterEvenChildren = true;
@@ -374,7 +374,7 @@ void RemoteObjectTreeItemTest::testUpdateSeveralChildrenRemoved() {
 void RemoteObjectTreeItemTest::testUpdateSeveralChildrenAddedAndRemoved() {
     mObjectRegister->mNumberOfChildren = 5;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
 
     mObjectRegister->mNumberOfChildren = 9;
@@ -413,7 +413,7 @@ void RemoteObjectTreeItemTest::testUpdateSeveralChildrenAddedAndRemoved() {
 void RemoteObjectTreeItemTest::testSetUpdater() {
     mObjectRegister->mNumberOfChildren = 2;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
 
     RemoteObjectTreeItem item(&remoteObject);
     RemoteObjectTreeItemUpdater updater;
@@ -439,7 +439,7 @@ void RemoteObjectTreeItemTest::testSetUpdater() {
 void RemoteObjectTreeItemTest::testSetUpdaterBeforeUpdating() {
     mObjectRegister->mNumberOfChildren = 0;
 
-    RemoteObject remoteObject(mService, mMapper, 4);
+    RemoteObject remoteObject(mMapper, 4);
     RemoteObjectTreeItem item(&remoteObject);
     RemoteObjectTreeItemUpdater updater;
     item.setUpdater(&updater);
@@ -47,6 +47,19 @@ private slots:
 
     void testParseTwice();
 
+    void testLocateCursor();
+
+    void testUpdateAddingTag();
+    void testUpdateRemovingTag();
+    void testUpdateChangingTag();
+    void testUpdateInSeveralLines();
+    void testUpdateTagSpanningSeveralLines();
+    void testUpdateNotMatchingLastParsedText();
+
+private:
+
+    void assertParsed(SemanticMarkupParser& parser, const QString& text) const;
+
 };
 
 void SemanticMarkupParserTest::testNoTags() {
@@ -510,6 +523,193 @@ void SemanticMarkupParserTest::testParseTwice() {
     QCOMPARE(parser.openElementsAtCursor().count(), 1);
 }
 
+void SemanticMarkupParserTest::testLocateCursor() {
+    SemanticMarkupParser parser;
+
+    QString text("Before <element> After");
+
+    parser.setCursorIndex(4);
+    parser.parse(text);
+
+    QVERIFY(!parser.isCursorInsideTag());
+    QVERIFY(parser.openElementsAtCursor().isEmpty());
+
+    parser.setCursorIndex(12);
+    parser.locateCursor();
+
+    QVERIFY(parser.isCursorInsideTag());
+    QVERIFY(parser.openElementsAtCursor().isEmpty());
+
+    parser.setCursorIndex(20);
+    parser.locateCursor();
+
+    QVERIFY(!parser.isCursorInsideTag());
+    QCOMPARE(parser.openElementsAtCursor().count(), 1);
+    QCOMPARE(parser.openElementsAtCursor()[0].mName, QString("element"));
+}
+
+void SemanticMarkupParserTest::testUpdateAddingTag() {
+    SemanticMarkupParser parser;
+
+    QString text("Before <para>Some text</para> After");
+    parser.parse(text);
+
+    text.insert(13, "<emphasis>");
+    parser.update(text, 13, 0, 10);
+
+    assertParsed(parser, text);
+
+    parser.setCursorIndex(30);
+    parser.locateCursor();
+
+    QVERIFY(!parser.isCursorInsideTag());
+    QCOMPARE(parser.openElementsAtCursor().count(), 2);
+    QCOMPARE(parser.openElementsAtCursor()[0].mName, QString("emphasis"));
+    QCOMPARE(parser.openElementsAtCursor()[0].mIndex, 13);
+    QCOMPARE(parser.openElementsAtCursor()[1].mName, QString("para"));
+    QCOMPARE(parser.openElementsAtCursor()[1].mIndex, 7);
+    QVERIFY(!parser.isElementClosed(parser.openElementsAtCursor()[0]));
+    QVERIFY(parser.isElementClosed(parser.openElementsAtCursor()[1]));
+}
+
+void SemanticMarkupParserTest::testUpdateRemovingTag() {
+    SemanticMarkupParser parser;
+
+    QString text("Before <para>Some <emphasis>text</emphasis></para> After");
+    parser.parse(text);
+
+    text.remove(43, 7);
+    parser.update(text, 43, 7, 0);
+
+    assertParsed(parser, text);
+
+    parser.setCursorIndex(46);
+    parser.locateCursor();
+
+    QVERIFY(!parser.isCursorInsideTag());
+    QCOMPARE(parser.openElementsAtCursor().count(), 1);
+    QCOMPARE(parser.openElementsAtCursor()[0].mName, QString("para"));
+    QVERIFY(!parser.isElementClosed(parser.openElementsAtCursor()[0]));
+}
+
+void SemanticMarkupParserTest::testUpdateChangingTag() {
+    SemanticMarkupParser parser;
+
+    QString text("Before <para>Some text</para> After");
+    parser.parse(text);
+
+    text.replace(8, 4, "list");
+    parser.update(text, 8, 4, 4);
+
+    assertParsed(parser, text);
+
+    parser.setCursorIndex(15);
+    parser.locateCursor();
+
+    QVERIFY(!parser.isCursorInsideTag());
+    QCOMPARE(parser.openElementsAtCursor().count(), 1);
+    QCOMPARE(parser.openElementsAtCursor()[0].mName, QString("list"));
+    QVERIFY(!parser.isElementClosed(parser.openElementsAtCursor()[0]));
+}
+
+void SemanticMarkupParserTest::testUpdateInSeveralLines() {
+    SemanticMarkupParser parser;
+
+    QString text("<para>First line\n"
+                 "<emphasis>Second line</emphasis>\n"
+                 "Third line</para>\n"
+                 "<para>Fourth line</para>");
+    parser.parse(text);
+
+    text.replace(17, 43, "<filename>Second\nThird</filename> line");
+    parser.update(text, 17, 43, 38);
+
+    assertParsed(parser, text);
+
+    text.insert(0, "<list>\n<item>");
+    parser.update(text, 0, 0, 13);
+
+    assertParsed(parser, text);
+
+    text.remove(text.length() - 7, 7);
+    parser.update(text, text.length(), 7, 0);
+
+    assertParsed(parser, text);
+}
+
+void SemanticMarkupParserTest::testUpdateTagSpanningSeveralLines() {
+    SemanticMarkupParser parser;
+
+    QString text("Before <emphasis\nstrong=\"true\"\nText");
+    parser.parse(text);
+
+    text.insert(30, ">");
+    parser.update(text, 30, 0, 1);
+
+    assertParsed(parser, text);
+
+    parser.setCursorIndex(text.length());
+    parser.locateCursor();
+
+    QVERIFY(!parser.isCursorInsideTag());
+    QCOMPARE(parser.openElementsAtCursor().count(), 1);
+    QCOMPARE(parser.openElementsAtCursor()[0].mName, QString("emphasis"));
+    QCOMPARE(parser.openElementsAtCursor()[0].mAttributes,
+             QString("strong=\"true\""));
+    QCOMPARE(parser.openElementsAtCursor()[0].mIndex, 7);
+
+    text.remove(30, 1);
+    parser.update(text, 30, 1, 0);
+
+    assertParsed(parser, text);
+
+    parser.setCursorIndex(text.length());
+    parser.locateCursor();
+
+    QVERIFY(parser.openElementsAtCursor().isEmpty());
+}
+
+void SemanticMarkupParserTest::testUpdateNotMatchingLastParsedText() {
+    SemanticMarkupParser parser;
+
+    parser.parse("Some text");
+
+    QString text("Before <para>Some text</para> After");
+    parser.update(text, 0, 0, 1);
+
+    assertParsed(parser, text);
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void SemanticMarkupParserTest::assertParsed(SemanticMarkupParser& parser,
+                                            const QString& text) const {
+    for (int i=0; i<=text.length(); ++i) {
+        SemanticMarkupParser expectedParser;
+        expectedParser.setCursorIndex(i);
+        expectedParser.parse(text);
+
+        parser.setCursorIndex(i);
+        parser.locateCursor();
+
+        QCOMPARE(parser.isCursorInsideTag(),
+                 expectedParser.isCursorInsideTag());
+
+        QList<StartTag> openElements = parser.openElementsAtCursor();
+        QList<StartTag> expectedOpenElements =
+                                        expectedParser.openElementsAtCursor();
+        QCOMPARE(openElements.count(), expectedOpenElements.count());
+        for (int j=0; j<openElements.count(); ++j) {
+            QCOMPARE(openElements[j].mName, expectedOpenElements[j].mName);
+            QCOMPARE(openElements[j].mAttributes,
+                     expectedOpenElements[j].mAttributes);
+            QCOMPARE(openElements[j].mIndex, expectedOpenElements[j].mIndex);
+            QCOMPARE(parser.isElementClosed(openElements[j]),
+                     expectedParser.isElementClosed(openElements[j]));
+        }
+    }
+}
+
 QTEST_MAIN(SemanticMarkupParserTest)
 
 #include "SemanticMarkupParserTest.moc"
@@ -49,6 +49,7 @@ private slots:
     void testStepSetCustomSetupCode();
     void testStepSetCustomSetupCodeChange();
     void testStepSetCustomSetupCodeEmpty();
+    void testStepSetCustomSetupCodeDoesNotUpdateOtherItems();
 
     void testStepSetCustomTearDownCode();
     void testStepSetCustomTearDownCodeChange();
@@ -270,6 +271,30 @@ void StepTreeItemTest::testStepSetCustomSetupCodeEmpty() {
     assertEmptyText(item.child(0));
 }
 
+void StepTreeItemTest::testStepSetCustomSetupCodeDoesNotUpdateOtherItems() {
+    Step step;
+    step.setId("The id");
+    step.setText("The text");
+    step.setCustomSetupCode("The setup code");
+
+    StepTreeItem item(&step);
+
+    QSignalSpy itemDataChangedSpy(&item, SIGNAL(dataChanged(TreeItem*)));
+    QSignalSpy textDataChangedSpy(item.child(0),
+                                  SIGNAL(dataChanged(TreeItem*)));
+    QSignalSpy setupDataChangedSpy(item.child(1)->child(0),
+                                   SIGNAL(dataChanged(TreeItem*)));
+
+    step.setCustomSetupCode("The setup code changed");
+
+    QCOMPARE(item.childCount(), 2);
+    assertText(item.child(0), "The text");
+    assertCustomSetupCode(item.child(1), "The setup code changed");
+    QCOMPARE(itemDataChangedSpy.count(), 0);
+    QCOMPARE(textDataChangedSpy.count(), 0);
+    QCOMPARE(setupDataChangedSpy.count(), 1);
+}
+
 void StepTreeItemTest::testStepSetCustomTearDownCode() {
     Step step;
     StepTreeItem item(&step);
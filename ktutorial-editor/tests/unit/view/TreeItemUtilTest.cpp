@@ -39,6 +39,10 @@ private slots:
     void testRemoveNestedItem();
     void testRemoveNestedItemAlreadyRemoved();
 
+    void testUpdateNestedItemNotAdded();
+    void testUpdateNestedItemAlreadyAdded();
+    void testUpdateNestedItemWithEmptyText();
+
 };
 
 class StubTreeItem: public TreeItem {
@@ -186,6 +190,56 @@ void TreeItemUtilTest::testRemoveNestedItemAlreadyRemoved() {
     QCOMPARE(parent.child(0), lastItem);
 }
 
+void TreeItemUtilTest::testUpdateNestedItemNotAdded() {
+    StubTreeItem parent;
+    TreeItem* lastItem = new TextTreeItem(&parent);
+    parent.appendChild(lastItem);
+
+    TextTreeItem* item = 0;
+
+    TreeItemUtil::updateNestedItem(&parent, item, 0, "Parent text", "Text");
+
+    QVERIFY(item);
+    QCOMPARE(item->text(), QString("Text"));
+    QCOMPARE(parent.childCount(), 2);
+    QCOMPARE(item->parent(), parent.child(0));
+    QCOMPARE(parent.child(0)->text(), QString("Parent text"));
+    QCOMPARE(parent.child(1), lastItem);
+}
+
+void TreeItemUtilTest::testUpdateNestedItemAlreadyAdded() {
+    StubTreeItem parent;
+    TreeItem* lastItem = new TextTreeItem(&parent);
+    parent.appendChild(lastItem);
+
+    TextTreeItem* item = 0;
+
+    TreeItemUtil::updateNestedItem(&parent, item, 0, "Parent text", "Text");
+    TextTreeItem* addedItem = item;
+    TreeItemUtil::updateNestedItem(&parent, item, 0, "Parent text2", "Text2");
+
+    QCOMPARE(item, addedItem);
+    QCOMPARE(item->text(), QString("Text2"));
+    QCOMPARE(parent.childCount(), 2);
+    QCOMPARE(parent.child(0)->text(), QString("Parent text"));
+    QCOMPARE(parent.child(1), lastItem);
+}
+
+void TreeItemUtilTest::testUpdateNestedItemWithEmptyText() {
+    StubTreeItem parent;
+    TreeItem* lastItem = new TextTreeItem(&parent);
+    parent.appendChild(lastItem);
+
+    TextTreeItem* item = 0;
+
+    TreeItemUtil::updateNestedItem(&parent, item, 0, "Parent text", "Text");
+    TreeItemUtil::updateNestedItem(&parent, item, 0, "Parent text", "");
+
+    QVERIFY(!item);
+    QCOMPARE(parent.childCount(), 1);
+    QCOMPARE(parent.child(0), lastItem);
+}
+
 QTEST_MAIN(TreeItemUtilTest)
 
 #include "TreeItemUtilTest.moc"
@@ -53,6 +53,7 @@ private slots:
     void testTutorialSetCustomSetupCode();
     void testTutorialSetCustomSetupCodeChange();
     void testTutorialSetCustomSetupCodeEmpty();
+    void testTutorialSetCustomSetupCodeDoesNotUpdateOtherItems();
 
     void testTutorialSetCustomTearDownCode();
     void testTutorialSetCustomTearDownCodeChange();
@@ -344,6 +345,35 @@ void TutorialTreeItemTest::testTutorialSetCustomSetupCodeEmpty() {
     assertEmptyDescription(item.child(1));
 }
 
+void TutorialTreeItemTest::
+                    testTutorialSetCustomSetupCodeDoesNotUpdateOtherItems() {
+    Tutorial tutorial;
+    tutorial.setName("The name");
+    tutorial.setLicenseText("The license text");
+    tutorial.setCustomSetupCode("The setup code");
+
+    TutorialTreeItem item(&tutorial);
+
+    QSignalSpy itemDataChangedSpy(&item, SIGNAL(dataChanged(TreeItem*)));
+    QSignalSpy nameDataChangedSpy(item.child(0),
+                                  SIGNAL(dataChanged(TreeItem*)));
+    QSignalSpy licenseDataChangedSpy(item.child(2)->child(0),
+                                     SIGNAL(dataChanged(TreeItem*)));
+    QSignalSpy setupDataChangedSpy(item.child(3)->child(0),
+                                   SIGNAL(dataChanged(TreeItem*)));
+
+    tutorial.setCustomSetupCode("The setup code changed");
+
+    QCOMPARE(item.childCount(), 4);
+    assertName(item.child(0), "The name");
+    assertLicenseText(item.child(2), "The license text");
+    assertCustomSetupCode(item.child(3), "The setup code changed");
+    QCOMPARE(itemDataChangedSpy.count(), 0);
+    QCOMPARE(nameDataChangedSpy.count(), 0);
+    QCOMPARE(licenseDataChangedSpy.count(), 0);
+    QCOMPARE(setupDataChangedSpy.count(), 1);
+}
+
 void TutorialTreeItemTest::testTutorialSetCustomTearDownCode() {
     Tutorial tutorial;
     TutorialTreeItem item(&tutorial);
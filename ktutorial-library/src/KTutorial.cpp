@@ -21,10 +21,14 @@
 #include "KTutorial.h"
 #include "KTutorial_p.h"
 
+#include <QTimer>
+
 #include <KDebug>
 
+#include "Tracer.h"
 #include "TutorialManager.h"
 #include "customization/DefaultKdeCustomization.h"
+#include "scripting/DeferredTutorialLoader.h"
 #include "scripting/ScriptingModule.h"
 #include "scripting/ScriptManager.h"
 
@@ -33,6 +37,7 @@
 #endif
 
 using ktutorial::customization::DefaultKdeCustomization;
+using ktutorial::scripting::DeferredTutorialLoader;
 using ktutorial::scripting::ScriptingModule;
 using ktutorial::scripting::ScriptManager;
 
@@ -64,6 +69,10 @@ bool KTutorial::registerWaitForMetaObject(const QMetaObject& waitForMetaObject,
                                                               typeName);
 }
 
+void KTutorial::setDeferredTutorialLoading(bool deferred) {
+    d->mDeferredTutorialLoading = deferred;
+}
+
 void KTutorial::setup(KXmlGuiWindow* window) {
     DefaultKdeCustomization* defaultKdeCustomization =
                                             new DefaultKdeCustomization(window);
@@ -71,12 +80,27 @@ void KTutorial::setup(KXmlGuiWindow* window) {
 }
 
 void KTutorial::setup(KTutorialCustomization* ktutorialCustomization) {
+    if (!qgetenv("KTUTORIAL_TRACE").isEmpty()) {
+        Tracer::self()->setEnabled(true);
+    }
+
     d->mCustomization = ktutorialCustomization;
     d->mCustomization->setParent(this);
 
     d->mCustomization->setup(d->mTutorialmanager);
 
-    ScriptManager().loadTutorials(d->mTutorialmanager);
+    d->mTutorialmanager->setObjectFinder(d->mObjectFinder,
+                                         mainApplicationWindow());
+
+    if (d->mDeferredTutorialLoading) {
+        DeferredTutorialLoader* deferredTutorialLoader =
+                        new DeferredTutorialLoader(d->mTutorialmanager, this);
+        connect(deferredTutorialLoader, SIGNAL(finished()),
+                deferredTutorialLoader, SLOT(deleteLater()));
+        QTimer::singleShot(0, deferredTutorialLoader, SLOT(start()));
+    } else {
+        ScriptManager().loadTutorials(d->mTutorialmanager);
+    }
 
 #ifdef QT_QTDBUS_FOUND
     editorsupport::EditorSupport* editorSupport =
@@ -106,6 +130,15 @@ KTutorial::KTutorial():
     d->mTutorialmanager->setParent(this);
     d->mObjectFinder = new ObjectFinder(this);
     d->mCustomization = 0;
+    d->mDeferredTutorialLoading = false;
+}
+
+bool KTutorial::registerWaitForFactory(WaitFor* (*waitForFactory)(),
+                                       const QMetaObject& waitForMetaObject,
+                                       const QString& typeName) {
+    return ScriptingModule::self()->registerWaitForFactory(waitForFactory,
+                                                           waitForMetaObject,
+                                                           typeName);
 }
 
 ObjectFinder* KTutorial::objectFinder() const {
@@ -27,6 +27,7 @@
 #include "ktutorial_export.h"
 
 #include "ObjectFinder.h"
+#include "WaitFor.h"
 
 class KXmlGuiWindow;
 
@@ -53,9 +54,16 @@ namespace ktutorial {
  * 
  * The setup method will be the first one to be called, but when custom WaitFor
  * objects are used in scripts. In that case, all the needed WaitFor classes
- * must be registered using registerWaitForMetaObject(const QMetaObject&) before
- * calling setup(KXmlGuiWindow*), as that method creates and registers all the
- * valid scripted tutorials.
+ * must be registered using registerWaitFor<T>(const QString&) (or
+ * registerWaitForMetaObject(const QMetaObject&) if the class is not known at
+ * compile time) before calling setup(KXmlGuiWindow*), as that method creates
+ * and registers all the valid scripted tutorials.
+ *
+ * Loading the scripted tutorials may take some time if there are lots of them.
+ * If setDeferredTutorialLoading(bool) is enabled before calling the setup
+ * method, the setup method returns without loading the scripted tutorials, and
+ * they are loaded once the event loop of the application runs, one at a time
+ * when the event loop is idle.
  *
  * Once KTutorial is set up, Tutorials embedded in the application can be added.
  * Just use KTutorial::registerTutorial(Tutorial*) so it is registered in the
@@ -103,6 +111,43 @@ public:
     bool registerWaitForMetaObject(const QMetaObject& waitForMetaObject,
                                    const QString& typeName = QString());
 
+    /**
+     * Registers the WaitFor type T to create instances of it in scripted
+     * tutorials.
+     * Any WaitFor class has to be registered before calling
+     * setup(KXmlGuiWindow*).
+     *
+     * This method should be preferred over
+     * registerWaitForMetaObject(const QMetaObject&, const QString&) whenever
+     * the type is known at compile time, as the new instances are created
+     * faster.
+     *
+     * @param typeName A specific name to be used for the type.
+     * @return True if the type was successfully registered, false otherwise.
+     * @see ScriptingModule::registerWaitFor<T>(const QString&)
+     */
+    template <typename T>
+    bool registerWaitFor(const QString& typeName = QString()) {
+        return registerWaitForFactory(&WaitFor::create<T>,
+                                      T::staticMetaObject, typeName);
+    }
+
+    /**
+     * Sets whether the loading of the scripted tutorials is deferred or not.
+     * By default, the scripted tutorials are loaded when KTutorial is set up,
+     * which delays the setup until all of them are loaded. When the loading is
+     * deferred, the scripted tutorials are loaded once the event loop of the
+     * application runs, without blocking it, and they are shown in the tutorial
+     * manager as soon as each one is loaded.
+     *
+     * It must be called before setting up KTutorial.
+     *
+     * @param deferred True to defer the loading of the scripted tutorials,
+     *        false otherwise.
+     * @see TutorialManager::tutorialRegistered(const TutorialInformation*)
+     */
+    void setDeferredTutorialLoading(bool deferred);
+
     /**
      * Sets up everything for KTutorial to work with the default customization.
      * If no customization is needed, this is usually the first method that must
@@ -120,6 +165,9 @@ public:
      * Sets up everything for KTutorial to work with the given customization.
      * After setting up the customization, it loads the scripted tutorials from
      * the application standard directories.
+     *
+     * If the environment variable "KTUTORIAL_TRACE" is defined, the Tracer is
+     * enabled.
      * 
      * @param ktutorialCustomization The customization to use.
      */
@@ -214,6 +262,19 @@ private:
      */
     KTutorial();
 
+    /**
+     * Registers a WaitFor type created by the given factory function.
+     *
+     * @param waitForFactory The function to create new instances with.
+     * @param waitForMetaObject The QMetaObject of the created instances.
+     * @param typeName A specific name to be used for the type.
+     * @return True if the type was successfully registered, false otherwise.
+     * @see ScriptingModule::registerWaitForFactory
+     */
+    bool registerWaitForFactory(WaitFor* (*waitForFactory)(),
+                                const QMetaObject& waitForMetaObject,
+                                const QString& typeName);
+
     /**
      * Returns the ObjectFinder to use.
      *
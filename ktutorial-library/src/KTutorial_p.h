@@ -42,6 +42,11 @@ public:
      */
     KTutorialCustomization* mCustomization;
 
+    /**
+     * Whether the scripted tutorials are loaded in the background or not.
+     */
+    bool mDeferredTutorialLoading;
+
 };
 
 }
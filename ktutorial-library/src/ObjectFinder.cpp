@@ -18,20 +18,193 @@
 #include "ObjectFinder.h"
 #include "ObjectFinder_p.h"
 
+#include <QEvent>
+
 namespace ktutorial {
 
 //public:
 
 ObjectFinder::ObjectFinder(QObject* parent /*= 0*/): QObject(parent),
     d(new ObjectFinderPrivate()) {
+    d->mRecordingLookups = false;
 }
 
 ObjectFinder::~ObjectFinder() {
+    clearPrefetchedObjects();
     delete d;
 }
 
+void ObjectFinder::prefetchObject(const QString& name,
+                                  const QObject* baseObject,
+                                  const QMetaObject* metaObject) {
+    if (cachedObject(name, baseObject, metaObject)) {
+        return;
+    }
+
+    ScopedTrace trace("ObjectFinder::prefetchObject", name);
+
+    QList<QObject*> candidateObjects;
+    findObjects<QObject*>(name, baseObject, candidateObjects);
+
+    QMutableListIterator<QObject*> it(candidateObjects);
+    while (it.hasNext()) {
+        if (!metaObject->cast(it.next())) {
+            it.remove();
+        }
+    }
+
+    if (candidateObjects.isEmpty()) {
+        return;
+    }
+
+    QObject* object = candidateObjects.first();
+    if (candidateObjects.count() > 1) {
+        object = getBestMatch(name, candidateObjects);
+    }
+
+    //A previous object prefetched with the same key is no longer valid, or it
+    //was prefetched as a different type
+    QString key = prefetchedObjectKey(name, baseObject);
+    removePrefetchedObject(key);
+
+    ObjectFinderPrivate::PrefetchedObject prefetchedObject;
+    prefetchedObject.mObject = object;
+    prefetchedObject.mMetaObject = metaObject;
+
+    //A new child of the base object or of any object in the path to the
+    //prefetched object could be a better match, so the base object is watched
+    //too
+    QObject* ancestor = object;
+    while (ancestor) {
+        if (!d->mKeysByWatchedObject.contains(ancestor)) {
+            ancestor->installEventFilter(this);
+            connect(ancestor, SIGNAL(destroyed(QObject*)),
+                    this, SLOT(handleWatchedObjectDestroyed(QObject*)));
+        }
+
+        d->mKeysByWatchedObject.insert(ancestor, key);
+        prefetchedObject.mWatchedObjects.append(ancestor);
+
+        if (ancestor == baseObject) {
+            break;
+        }
+        ancestor = ancestor->parent();
+    }
+
+    d->mPrefetchedObjects.insert(key, prefetchedObject);
+}
+
+void ObjectFinder::clearPrefetchedObjects() {
+    foreach (const QString& key, d->mPrefetchedObjects.keys()) {
+        removePrefetchedObject(key);
+    }
+}
+
+void ObjectFinder::startRecordingLookups() {
+    d->mRecordingLookups = true;
+    d->mRecordedLookups.clear();
+}
+
+QList<ObjectFinder::Lookup> ObjectFinder::stopRecordingLookups() {
+    d->mRecordingLookups = false;
+
+    QList<Lookup> recordedLookups = d->mRecordedLookups;
+    d->mRecordedLookups.clear();
+    return recordedLookups;
+}
+
+//protected:
+
+bool ObjectFinder::eventFilter(QObject* watched, QEvent* event) {
+    if (event->type() == QEvent::ParentChange ||
+            event->type() == QEvent::ChildAdded) {
+        removePrefetchedObjectsWatching(watched);
+    }
+
+    return false;
+}
+
 //private:
 
+void ObjectFinder::recordLookup(const QString& name, const QObject* baseObject,
+                                const QMetaObject* metaObject) const {
+    if (!d->mRecordingLookups) {
+        return;
+    }
+
+    Lookup lookup;
+    lookup.mName = name;
+    lookup.mBaseObject = const_cast<QObject*>(baseObject);
+    lookup.mMetaObject = metaObject;
+    d->mRecordedLookups.append(lookup);
+}
+
+QObject* ObjectFinder::cachedObject(const QString& name,
+                                    const QObject* baseObject,
+                                    const QMetaObject* metaObject) const {
+    if (d->mPrefetchedObjects.isEmpty() || !baseObject) {
+        return 0;
+    }
+
+    //The object is no longer prefetched if it, or any of its ancestors up to
+    //the base object, was destroyed or reparented, but renaming it is not
+    //watched
+    QHash<QString, ObjectFinderPrivate::PrefetchedObject>::const_iterator it =
+                d->mPrefetchedObjects.constFind(
+                                    prefetchedObjectKey(name, baseObject));
+    if (it == d->mPrefetchedObjects.constEnd()) {
+        return 0;
+    }
+
+    QObject* object = it->mObject;
+    if (!object || object->objectName() !=
+                                    name.mid(name.lastIndexOf('/') + 1)) {
+        return 0;
+    }
+
+    //The best match among the objects of the prefetched type is the best match
+    //among the objects of a subclass only if it is an instance of the subclass
+    const QMetaObject* prefetchedMetaObject = metaObject;
+    while (prefetchedMetaObject && prefetchedMetaObject != it->mMetaObject) {
+        prefetchedMetaObject = prefetchedMetaObject->superClass();
+    }
+
+    if (!prefetchedMetaObject || !metaObject->cast(object)) {
+        return 0;
+    }
+
+    return object;
+}
+
+QString ObjectFinder::prefetchedObjectKey(const QString& name,
+                                          const QObject* baseObject) const {
+    return QString::number(reinterpret_cast<quintptr>(baseObject)) + ':' + name;
+}
+
+void ObjectFinder::removePrefetchedObject(const QString& key) {
+    if (!d->mPrefetchedObjects.contains(key)) {
+        return;
+    }
+
+    ObjectFinderPrivate::PrefetchedObject prefetchedObject =
+                                            d->mPrefetchedObjects.take(key);
+    foreach (QObject* watchedObject, prefetchedObject.mWatchedObjects) {
+        d->mKeysByWatchedObject.remove(watchedObject, key);
+        if (!d->mKeysByWatchedObject.contains(watchedObject)) {
+            watchedObject->removeEventFilter(this);
+            disconnect(watchedObject, SIGNAL(destroyed(QObject*)),
+                       this, SLOT(handleWatchedObjectDestroyed(QObject*)));
+        }
+    }
+}
+
+void ObjectFinder::removePrefetchedObjectsWatching(QObject* watchedObject) {
+    QList<QString> keys = d->mKeysByWatchedObject.values(watchedObject);
+    foreach (const QString& key, keys) {
+        removePrefetchedObject(key);
+    }
+}
+
 QList<QObject*> ObjectFinder::getBestMatches(const QString& name,
                                 QList< QList<QObject*> > objectPaths) const {
     if (name.isEmpty() || objectPaths.isEmpty()) {
@@ -172,4 +345,10 @@ QList< QList<QObject*> > ObjectFinder::filterNestedChildren(const QString& name,
     return filteredPaths;
 }
 
+//private slots:
+
+void ObjectFinder::handleWatchedObjectDestroyed(QObject* object) {
+    removePrefetchedObjectsWatching(object);
+}
+
 }
@@ -19,9 +19,11 @@
 #define KTUTORIAL_OBJECTFINDER_H
 
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 #include <QtCore/QRegExp>
 
 #include "ktutorial_export.h"
+#include "Tracer.h"
 
 namespace ktutorial {
 
@@ -29,10 +31,51 @@ namespace ktutorial {
  * Helper class to find objects.
  * This class is not intended to be used directly. Instead, use
  * KTutorial::findObject(const QString&).
+ *
+ * Finding an object walks the object tree below the base object, which may be
+ * noticeable in big applications. Objects that are known to be needed soon can
+ * be resolved in advance with prefetchObject, for example, while the event
+ * loop is idle; findObject then returns the prefetched object without walking
+ * the tree again. A prefetched object is discarded when it, any of its
+ * ancestors up to the base object or the base object itself is destroyed,
+ * changes its parent or gets a new child, as the new child could be a better
+ * match for the name. Objects added to other branches of the tree below the
+ * base object are not watched, though.
+ *
+ * An object prefetched as some type is also returned when it is looked up as
+ * a subclass of that type, provided that the object is an instance of the
+ * subclass: the best match among all the objects of a type is also the best
+ * match among the objects of any subclass it belongs to.
+ *
+ * The lookups made between startRecordingLookups() and stopRecordingLookups()
+ * are recorded, so they can be prefetched the next time they are needed.
  */
 class KTUTORIAL_EXPORT ObjectFinder: public QObject {
 Q_OBJECT
 public:
+
+    /**
+     * A lookup made with findObject.
+     */
+    class Lookup {
+    public:
+
+        /**
+         * The name of the object looked up.
+         */
+        QString mName;
+
+        /**
+         * The base object the object was looked up from.
+         */
+        QPointer<QObject> mBaseObject;
+
+        /**
+         * The meta object of the type the object was looked up as.
+         */
+        const QMetaObject* mMetaObject;
+
+    };
     
     /**
      * Creates a new ObjectFinder with the given parent.
@@ -60,6 +103,19 @@ public:
      */
     template <typename T>
     T findObject(const QString& name, const QObject* baseObject) const {
+        ScopedTrace trace("ObjectFinder::findObject", name);
+
+        //Same approach used by qobject_cast to get the meta object of T
+        const QMetaObject* metaObject =
+                                    &reinterpret_cast<T>(0)->staticMetaObject;
+        recordLookup(name, baseObject, metaObject);
+
+        QObject* prefetchedObject = cachedObject(name, baseObject,
+                                                 metaObject);
+        if (prefetchedObject) {
+            return static_cast<T>(prefetchedObject);
+        }
+
         QList<T> candidateObjects;
         findObjects<T>(name, baseObject, candidateObjects);
         
@@ -74,10 +130,107 @@ public:
         return getBestMatch(name, candidateObjects);
     }
 
+    /**
+     * Finds the object with the specified name and type and keeps it, so the
+     * next call to findObject with the same arguments does not need to walk
+     * the object tree.
+     * If there is no such object nothing is kept.
+     *
+     * @param name The name of the object to find.
+     * @param baseObject The base object to search from.
+     * @param metaObject The meta object of the type of the object.
+     */
+    void prefetchObject(const QString& name, const QObject* baseObject,
+                        const QMetaObject* metaObject);
+
+    /**
+     * Discards all the prefetched objects.
+     */
+    void clearPrefetchedObjects();
+
+    /**
+     * Starts recording the lookups made with findObject.
+     * Any lookup recorded before and not taken yet is discarded.
+     */
+    void startRecordingLookups();
+
+    /**
+     * Stops recording the lookups and returns those made since
+     * startRecordingLookups() was called.
+     *
+     * @return The lookups made while recording.
+     */
+    QList<Lookup> stopRecordingLookups();
+
+protected:
+
+    /**
+     * Discards the prefetched objects that depend on the watched object when
+     * it changes its parent or gets a new child.
+     *
+     * @param watched The object that received the event.
+     * @param event The event received.
+     * @return False, to let events be handled as necessary.
+     */
+    virtual bool eventFilter(QObject* watched, QEvent* event);
+
 private:
 
     class ObjectFinderPrivate* d;
 
+    /**
+     * Records the lookup with the given arguments, if lookups are being
+     * recorded.
+     *
+     * @param name The name of the object looked up.
+     * @param baseObject The base object the object was looked up from.
+     * @param metaObject The meta object of the type of the object.
+     */
+    void recordLookup(const QString& name, const QObject* baseObject,
+                      const QMetaObject* metaObject) const;
+
+    /**
+     * Returns the key the object for the given arguments is prefetched with.
+     * The type of the object is not part of the key.
+     *
+     * @param name The name of the object.
+     * @param baseObject The base object the object is found from.
+     * @return The key for the prefetched object.
+     */
+    QString prefetchedObjectKey(const QString& name,
+                                const QObject* baseObject) const;
+
+    /**
+     * Discards the prefetched object with the given key.
+     * The objects watched for that prefetched object and not needed by any
+     * other are no longer watched.
+     *
+     * @param key The key of the prefetched object.
+     */
+    void removePrefetchedObject(const QString& key);
+
+    /**
+     * Discards all the prefetched objects that depend on the given object.
+     *
+     * @param watchedObject The object watched.
+     */
+    void removePrefetchedObjectsWatching(QObject* watchedObject);
+
+    /**
+     * Returns the prefetched object for the given arguments, if any.
+     * The prefetched object is only returned if it was not destroyed, if it is
+     * still a descendant of the base object and if its name was not changed.
+     * Moreover, it must have been prefetched as the given type or as a super
+     * class of it, and it must be an instance of the given type.
+     *
+     * @param name The name of the object to get.
+     * @param baseObject The base object the object was prefetched from.
+     * @param metaObject The meta object of the type of the object.
+     * @return The prefetched object, or null if there is none.
+     */
+    QObject* cachedObject(const QString& name, const QObject* baseObject,
+                          const QMetaObject* metaObject) const;
+
     /**
      * Adds to the foundObjects list the objects with the specified name that
      * are descendant of the given ancestor, if any.
@@ -244,6 +397,15 @@ private:
     QList< QList<QObject*> > filterNestedChildren(const QString& name,
                             const QList< QList<QObject*> >& objectPaths) const;
 
+private Q_SLOTS:
+
+    /**
+     * Discards all the prefetched objects that depend on the destroyed object.
+     *
+     * @param object The destroyed object.
+     */
+    void handleWatchedObjectDestroyed(QObject* object);
+
 };
 
 }
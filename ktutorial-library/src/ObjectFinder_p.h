@@ -18,11 +18,61 @@
 #ifndef KTUTORIAL_OBJECTFINDER_P_H
 #define KTUTORIAL_OBJECTFINDER_P_H
 
+#include <QHash>
+#include <QPointer>
+
+#include "ObjectFinder.h"
+
 namespace ktutorial {
 
 class ObjectFinderPrivate {
 public:
 
+    /**
+     * A prefetched object.
+     */
+    class PrefetchedObject {
+    public:
+
+        /**
+         * The object found.
+         */
+        QPointer<QObject> mObject;
+
+        /**
+         * The meta object of the type the object was prefetched as.
+         */
+        const QMetaObject* mMetaObject;
+
+        /**
+         * The object found, its ancestors up to the base object and the base
+         * object itself.
+         */
+        QList<QObject*> mWatchedObjects;
+
+    };
+
+    /**
+     * The prefetched objects, indexed by the base object and the name they
+     * were prefetched for.
+     */
+    QHash<QString, PrefetchedObject> mPrefetchedObjects;
+
+    /**
+     * The keys of the prefetched objects that depend on each watched object.
+     */
+    QMultiHash<QObject*, QString> mKeysByWatchedObject;
+
+    /**
+     * Whether the lookups are being recorded or not.
+     */
+    bool mRecordingLookups;
+
+    /**
+     * The lookups recorded.
+     */
+    QList<ObjectFinder::Lookup> mRecordedLookups;
+
 };
 
 }
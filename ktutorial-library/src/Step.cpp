@@ -24,6 +24,7 @@
 #include <KDebug>
 
 #include "Option.h"
+#include "Tracer.h"
 #include "WaitFor.h"
 #include "WaitForSignal.h"
 
@@ -54,6 +55,28 @@ QList<Option*> Step::options() const {
     return d->mOptions;
 }
 
+QStringList Step::nextStepIds() const {
+    QStringList nextStepIds;
+    foreach (WaitFor* waitFor, d->mWaitsFor) {
+        if (d->mNextStepForWaitFor.contains(waitFor) &&
+                !nextStepIds.contains(d->mNextStepForWaitFor.value(waitFor))) {
+            nextStepIds.append(d->mNextStepForWaitFor.value(waitFor));
+        }
+    }
+
+    return nextStepIds;
+}
+
+QStringList Step::prefetchedObjectNames() const {
+    return d->mPrefetchedObjectNames;
+}
+
+void Step::addPrefetchedObjectName(const QString& objectName) {
+    if (!d->mPrefetchedObjectNames.contains(objectName)) {
+        d->mPrefetchedObjectNames.append(objectName);
+    }
+}
+
 QString Step::text() const {
     return d->mText;
 }
@@ -198,12 +221,22 @@ void Step::disconnectWaitFor(WaitFor* waitFor) {
 //private:
 
 void Step::setupWrapper() {
+    if (Tracer::isEnabled()) {
+        Tracer::self()->setCurrentStepId(d->mId);
+    }
+    ScopedTrace trace("Step::setup", d->mId);
+
     d->mDeleteAddedObjectsInTearDown = true;
     setup();
     d->mDeleteAddedObjectsInTearDown = false;
 }
 
 void Step::tearDownWrapper() {
+    if (Tracer::isEnabled()) {
+        Tracer::self()->setCurrentStepId(d->mId);
+    }
+    ScopedTrace trace("Step::tearDown", d->mId);
+
     tearDown();
 
     foreach (Option* option, d->mOptionsToBeDeletedInTearDown) {
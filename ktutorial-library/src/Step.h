@@ -23,6 +23,7 @@
 #define KTUTORIAL_STEP_H
 
 #include <QtCore/QObject>
+#include <QtCore/QStringList>
 
 #include "ktutorial_export.h"
 
@@ -162,6 +163,42 @@ public:
      */
     QList<Option*> options() const;
 
+    /**
+     * Returns the identifiers of the steps that this Step can change to.
+     * Those are the steps associated with the WaitFors and Options added with
+     * addWaitFor(WaitFor*, const QString&) and addOption(Option*, const
+     * QString&). The steps changed to from a slot can not be known.
+     *
+     * @return The identifiers of the steps that this Step can change to.
+     */
+    QStringList nextStepIds() const;
+
+    /**
+     * Returns the names of the objects that this Step is expected to look up
+     * when it is set up.
+     *
+     * @return The names of the objects that this Step looks up.
+     * @see addPrefetchedObjectName(const QString&)
+     */
+    QStringList prefetchedObjectNames() const;
+
+    /**
+     * Adds the name of an object that this Step looks up when it is set up.
+     * When a step that can change to this Step is activated, the objects with
+     * the added names are found in advance while the application is idle, so
+     * KTutorial::findObject(const QString&) does not need to search them again
+     * when this Step is activated. The objects are found from the main window
+     * of the application as QObjects, like scripts do.
+     *
+     * Declaring the names is just a hint to speed up the change to this Step;
+     * the objects are found as usual if they were not prefetched.
+     *
+     * This method can be invoked from a script.
+     *
+     * @param objectName The name of the object.
+     */
+    Q_INVOKABLE void addPrefetchedObjectName(const QString& objectName);
+
     /**
      * Returns the text to be shown to the user.
      *
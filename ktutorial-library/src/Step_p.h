@@ -20,6 +20,7 @@
 
 #include <QHash>
 #include <QList>
+#include <QStringList>
 
 namespace ktutorial {
 
@@ -81,6 +82,11 @@ public:
      */
     QHash<WaitFor*, QString> mNextStepForWaitFor;
 
+    /**
+     * The names of the objects looked up when this Step is set up.
+     */
+    QStringList mPrefetchedObjectNames;
+
 };
 
 }
@@ -0,0 +1,191 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include "Tracer.h"
+#include "Tracer_p.h"
+
+#include <QCoreApplication>
+#include <QFile>
+
+namespace ktutorial {
+
+/**
+ * The number of spans kept by default.
+ */
+const int DEFAULT_CAPACITY = 4096;
+
+/**
+ * Returns the given string as a JSON string, including the quotes.
+ *
+ * @param string The string to quote.
+ * @return The quoted and escaped string.
+ */
+static QByteArray jsonString(const QString& string) {
+    QByteArray json = "\"";
+    foreach (QChar character, string) {
+        ushort code = character.unicode();
+        if (character == '"') {
+            json += "\\\"";
+        } else if (character == '\\') {
+            json += "\\\\";
+        } else if (code < 0x20) {
+            json += "\\u" + QByteArray::number(code, 16).rightJustified(4, '0');
+        } else {
+            json += QString(character).toUtf8();
+        }
+    }
+    json += "\"";
+
+    return json;
+}
+
+//public:
+
+Tracer* Tracer::self() {
+    if (sSelf == 0) {
+        sSelf = new Tracer(QCoreApplication::instance());
+    }
+
+    return sSelf;
+}
+
+Tracer::~Tracer() {
+    if (sSelf == this) {
+        sSelf = 0;
+    }
+
+    delete d;
+}
+
+void Tracer::setEnabled(bool enabled) {
+    sEnabled = enabled;
+}
+
+int Tracer::capacity() const {
+    return d->mSpans.size();
+}
+
+void Tracer::setCapacity(int capacity) {
+    Q_ASSERT(capacity > 0);
+
+    d->mSpans = QVector<Span>(capacity);
+    d->mNextIndex = 0;
+    d->mCount = 0;
+}
+
+QString Tracer::currentStepId() const {
+    return d->mCurrentStepId;
+}
+
+void Tracer::setCurrentStepId(const QString& stepId) {
+    d->mCurrentStepId = stepId;
+}
+
+qint64 Tracer::timestamp() const {
+#if QT_VERSION >= 0x040800
+    return d->mTimer.nsecsElapsed() / 1000;
+#else
+    return (qint64)d->mTimer.elapsed() * 1000;
+#endif
+}
+
+void Tracer::addSpan(const QString& name, const QString& detail, qint64 start,
+                     qint64 duration) {
+    Span& span = d->mSpans[d->mNextIndex];
+    span.mName = name;
+    span.mDetail = detail;
+    span.mStepId = d->mCurrentStepId;
+    span.mStart = start;
+    span.mDuration = duration;
+
+    d->mNextIndex = (d->mNextIndex + 1) % d->mSpans.size();
+    if (d->mCount < d->mSpans.size()) {
+        d->mCount++;
+    }
+
+    emit spanAdded(name, detail, d->mCurrentStepId, start, duration);
+}
+
+QList<Tracer::Span> Tracer::spans() const {
+    QList<Span> spans;
+
+    int index = d->mNextIndex - d->mCount;
+    if (index < 0) {
+        index += d->mSpans.size();
+    }
+
+    for (int i=0; i<d->mCount; ++i) {
+        spans.append(d->mSpans[(index + i) % d->mSpans.size()]);
+    }
+
+    return spans;
+}
+
+void Tracer::clear() {
+    setCapacity(capacity());
+}
+
+QByteArray Tracer::chromeTrace() const {
+    QByteArray processId =
+                    QByteArray::number(QCoreApplication::applicationPid());
+
+    QByteArray trace = "{\"traceEvents\":[";
+
+    bool first = true;
+    foreach (const Span& span, spans()) {
+        if (!first) {
+            trace += ",";
+        }
+        first = false;
+
+        trace += "\n{\"name\":" + jsonString(span.mName);
+        trace += ",\"cat\":\"ktutorial\",\"ph\":\"X\"";
+        trace += ",\"ts\":" + QByteArray::number(span.mStart);
+        trace += ",\"dur\":" + QByteArray::number(span.mDuration);
+        trace += ",\"pid\":" + processId + ",\"tid\":1";
+        trace += ",\"args\":{\"step\":" + jsonString(span.mStepId);
+        trace += ",\"detail\":" + jsonString(span.mDetail) + "}}";
+    }
+
+    trace += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return trace;
+}
+
+bool Tracer::exportChromeTrace(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    return file.write(chromeTrace()) != -1;
+}
+
+//private:
+
+Tracer* Tracer::sSelf = 0;
+
+bool Tracer::sEnabled = false;
+
+Tracer::Tracer(QObject* parent): QObject(parent),
+    d(new TracerPrivate()) {
+    setCapacity(DEFAULT_CAPACITY);
+    d->mTimer.start();
+}
+
+}
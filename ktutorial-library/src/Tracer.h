@@ -0,0 +1,308 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef KTUTORIAL_TRACER_H
+#define KTUTORIAL_TRACER_H
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+
+#include "ktutorial_export.h"
+
+namespace ktutorial {
+
+/**
+ * Records timestamped spans of the work done while a tutorial runs.
+ * The tracer is used to know where the time goes during a tutorial: changing
+ * to a step, setting up and tearing down a step, finding objects, calling
+ * script functions and showing a step in the StepWidget are all recorded as
+ * spans. Each span has a name, an optional detail (like the name of the object
+ * looked for), the id of the step it belongs to, a start time and a duration,
+ * both in microseconds since the tracer was created.
+ *
+ * The spans are stored in a ring buffer with a fixed capacity, so once it is
+ * full the oldest spans are overwritten by the new ones. They can be exported
+ * at any moment in the Chrome trace event format (which can be loaded, for
+ * example, in chrome://tracing) using chromeTrace() or
+ * exportChromeTrace(const QString&). Besides being stored, each span is also
+ * notified through the spanAdded signal.
+ *
+ * Tracing is disabled by default, and checking whether it is enabled is just
+ * reading a static flag, so the instrumented code has almost no overhead when
+ * it is disabled. It can be enabled with setEnabled(bool) or, when KTutorial is
+ * set up, defining the environment variable "KTUTORIAL_TRACE".
+ *
+ * The work to trace is usually wrapped in a ScopedTrace, which records a span
+ * from its construction to its destruction.
+ *
+ * Tracer uses a Singleton design pattern, and it is meant to be used only from
+ * the GUI thread. The instance is created the first time it is needed, and it
+ * is destroyed along with the application. The instrumented code only gets
+ * the instance while tracing is enabled, so the ring buffer is not allocated
+ * in applications that never enable tracing.
+ */
+class KTUTORIAL_EXPORT Tracer: public QObject {
+Q_OBJECT
+public:
+
+    /**
+     * A recorded span.
+     */
+    class Span {
+    public:
+
+        /**
+         * The name of the span.
+         */
+        QString mName;
+
+        /**
+         * Additional information about the span, if any.
+         */
+        QString mDetail;
+
+        /**
+         * The id of the step that was current when the span was recorded, if
+         * any.
+         */
+        QString mStepId;
+
+        /**
+         * The start of the span, in microseconds.
+         */
+        qint64 mStart;
+
+        /**
+         * The duration of the span, in microseconds.
+         */
+        qint64 mDuration;
+
+    };
+
+    /**
+     * Returns the only instance of this class.
+     * The instance is created if needed, as a child of the application.
+     *
+     * @return The only instance of this class.
+     */
+    static Tracer* self();
+
+    /**
+     * Returns whether tracing is enabled or not.
+     *
+     * @return True if tracing is enabled, false otherwise.
+     */
+    static bool isEnabled() {
+        return sEnabled;
+    }
+
+    /**
+     * Destroys this Tracer.
+     */
+    virtual ~Tracer();
+
+    /**
+     * Enables or disables tracing.
+     * The already recorded spans are kept when tracing is disabled.
+     *
+     * @param enabled True to enable tracing, false to disable it.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Returns the maximum number of spans kept.
+     *
+     * @return The maximum number of spans kept.
+     */
+    int capacity() const;
+
+    /**
+     * Sets the maximum number of spans kept.
+     * The recorded spans are cleared.
+     *
+     * @param capacity The maximum number of spans kept.
+     */
+    void setCapacity(int capacity);
+
+    /**
+     * Returns the id of the step that the recorded spans belong to.
+     *
+     * @return The id of the current step.
+     */
+    QString currentStepId() const;
+
+    /**
+     * Sets the id of the step that the recorded spans belong to.
+     *
+     * @param stepId The id of the current step.
+     */
+    void setCurrentStepId(const QString& stepId);
+
+    /**
+     * Returns the microseconds elapsed since this Tracer was created.
+     *
+     * @return The current timestamp, in microseconds.
+     */
+    qint64 timestamp() const;
+
+    /**
+     * Records a new span that belongs to the current step.
+     * If the ring buffer is full, the oldest span is overwritten.
+     *
+     * @param name The name of the span.
+     * @param detail Additional information about the span.
+     * @param start The start of the span, in microseconds.
+     * @param duration The duration of the span, in microseconds.
+     */
+    void addSpan(const QString& name, const QString& detail, qint64 start,
+                 qint64 duration);
+
+    /**
+     * Returns the recorded spans, from the oldest to the newest.
+     *
+     * @return The recorded spans.
+     */
+    QList<Span> spans() const;
+
+    /**
+     * Removes all the recorded spans.
+     */
+    void clear();
+
+    /**
+     * Returns the recorded spans in the Chrome trace event format.
+     * Each span is a complete event ("ph" is "X"), and the id of its step and
+     * its detail are stored in the arguments of the event.
+     *
+     * @return The JSON document with the recorded spans.
+     */
+    QByteArray chromeTrace() const;
+
+    /**
+     * Writes the recorded spans, in the Chrome trace event format, to the file
+     * with the given name.
+     *
+     * @param fileName The name of the file to write the spans to.
+     * @return True if the file was written, false otherwise.
+     * @see chromeTrace()
+     */
+    bool exportChromeTrace(const QString& fileName) const;
+
+Q_SIGNALS:
+
+    /**
+     * Emitted when a span is recorded.
+     *
+     * @param name The name of the span.
+     * @param detail Additional information about the span.
+     * @param stepId The id of the step the span belongs to.
+     * @param start The start of the span, in microseconds.
+     * @param duration The duration of the span, in microseconds.
+     */
+    void spanAdded(const QString& name, const QString& detail,
+                   const QString& stepId, qint64 start, qint64 duration);
+
+private:
+
+    /**
+     * The instance of this class.
+     */
+    static Tracer* sSelf;
+
+    /**
+     * Whether tracing is enabled or not.
+     */
+    static bool sEnabled;
+
+    class TracerPrivate* d;
+
+    /**
+     * Creates a new Tracer with the given parent.
+     * Private to avoid classes other than self to create instances.
+     *
+     * @param parent The parent QObject.
+     */
+    explicit Tracer(QObject* parent);
+
+};
+
+/**
+ * Records a span in the Tracer from its construction to its destruction.
+ * It is meant to be created in the stack at the beginning of the block to
+ * trace:
+ * @code
+ * ScopedTrace trace("Step::setup", id());
+ * @endcode
+ *
+ * If tracing is not enabled when the ScopedTrace is created, nothing is
+ * recorded.
+ */
+class KTUTORIAL_EXPORT ScopedTrace {
+public:
+
+    /**
+     * Creates a new ScopedTrace and starts the span.
+     *
+     * @param name The name of the span.
+     * @param detail Additional information about the span.
+     */
+    explicit ScopedTrace(const char* name, const QString& detail = QString()):
+        mName(name),
+        mStart(-1) {
+        if (Tracer::isEnabled()) {
+            mDetail = detail;
+            mStart = Tracer::self()->timestamp();
+        }
+    }
+
+    /**
+     * Destroys this ScopedTrace and records the span, if tracing was enabled
+     * when it was created.
+     */
+    ~ScopedTrace() {
+        if (mStart >= 0 && Tracer::isEnabled()) {
+            Tracer* tracer = Tracer::self();
+            tracer->addSpan(mName, mDetail, mStart,
+                            tracer->timestamp() - mStart);
+        }
+    }
+
+private:
+
+    /**
+     * The name of the span.
+     */
+    const char* mName;
+
+    /**
+     * Additional information about the span.
+     */
+    QString mDetail;
+
+    /**
+     * The start of the span, or -1 if tracing was not enabled.
+     */
+    qint64 mStart;
+
+    Q_DISABLE_COPY(ScopedTrace)
+
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef KTUTORIAL_TRACER_P_H
+#define KTUTORIAL_TRACER_P_H
+
+#include <QVector>
+
+//QElapsedTimer is not available before Qt 4.7
+#if QT_VERSION >= 0x040700
+#include <QElapsedTimer>
+#else
+#include <QTime>
+#endif
+
+namespace ktutorial {
+
+class TracerPrivate {
+public:
+
+    /**
+     * The ring buffer with the recorded spans.
+     */
+    QVector<Tracer::Span> mSpans;
+
+    /**
+     * The index in the ring buffer where the next span will be stored.
+     */
+    int mNextIndex;
+
+    /**
+     * The number of spans stored in the ring buffer.
+     */
+    int mCount;
+
+    /**
+     * The id of the step that the recorded spans belong to.
+     */
+    QString mCurrentStepId;
+
+    /**
+     * The timer to get the timestamps from.
+     */
+#if QT_VERSION >= 0x040700
+    QElapsedTimer mTimer;
+#else
+    QTime mTimer;
+#endif
+
+};
+
+}
+
+#endif
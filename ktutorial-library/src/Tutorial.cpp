@@ -22,9 +22,14 @@
 #include "Tutorial.h"
 #include "Tutorial_p.h"
 
+#include <QRegExp>
+#include <QWidget>
+
 #include <KDebug>
 
+#include "ObjectFinder.h"
 #include "Step.h"
+#include "Tracer.h"
 #include "TutorialInformation.h"
 
 namespace ktutorial {
@@ -39,6 +44,11 @@ Tutorial::Tutorial(TutorialInformation* tutorialInformation): QObject(),
     d(new TutorialPrivate()) {
     d->mTutorialInformation = tutorialInformation;
     d->mCurrentStep = 0;
+
+    d->mPrefetchTimer = new QTimer(this);
+    d->mPrefetchTimer->setInterval(0);
+    connect(d->mPrefetchTimer, SIGNAL(timeout()),
+            this, SLOT(prefetchNextObject()));
 }
 
 Tutorial::~Tutorial() {
@@ -106,6 +116,21 @@ void Tutorial::nextStep(Step* step) {
     }
 }
 
+void Tutorial::setObjectFinder(ObjectFinder* objectFinder,
+                               QObject* baseObject) {
+    d->mBaseObject = baseObject;
+
+    if (d->mObjectFinder == objectFinder) {
+        return;
+    }
+
+    d->mPrefetchTimer->stop();
+    d->mPendingLookups.clear();
+    d->mLookupsByStep.clear();
+
+    d->mObjectFinder = objectFinder;
+}
+
 //public slots:
 
 void Tutorial::finish() {
@@ -114,6 +139,16 @@ void Tutorial::finish() {
         d->mCurrentStep = 0;
     }
 
+    d->mPrefetchTimer->stop();
+    d->mPendingLookups.clear();
+    if (d->mObjectFinder) {
+        d->mObjectFinder->clearPrefetchedObjects();
+    }
+
+    if (Tracer::isEnabled()) {
+        Tracer::self()->setCurrentStepId(QString());
+    }
+
     tearDown();
 
     emit finished(this);
@@ -132,6 +167,26 @@ void Tutorial::setup() {
 void Tutorial::tearDown() {
 }
 
+Step* Tutorial::step(const QString& id) const {
+    return d->mSteps.value(id);
+}
+
+Step* Tutorial::currentStep() const {
+    return d->mCurrentStep;
+}
+
+Step* Tutorial::takeStep(const QString& id) {
+    Step* step = d->mSteps.take(id);
+    if (!step) {
+        return 0;
+    }
+
+    disconnect(step, SIGNAL(nextStepRequested(QString)),
+               this, SLOT(nextStep(QString)));
+
+    return step;
+}
+
 //private:
 
 void Tutorial::changeToStep(Step* step) {
@@ -142,16 +197,99 @@ void Tutorial::changeToStep(Step* step) {
         return;
     }
 
+    ScopedTrace trace("Tutorial::changeToStep", step->id());
+
     if (d->mCurrentStep != 0) {
         d->mCurrentStep->setActive(false);
     }
 
     kDebug(debugArea()) << "Next step:" << step->id();
 
+    d->mPrefetchTimer->stop();
+    d->mPendingLookups.clear();
+
     d->mCurrentStep = step;
+
+    if (d->mObjectFinder) {
+        d->mObjectFinder->startRecordingLookups();
+    }
+
     d->mCurrentStep->setActive(true);
 
+    if (d->mObjectFinder) {
+        d->mLookupsByStep.insert(step->id(),
+                                 d->mObjectFinder->stopRecordingLookups());
+    }
+
+    schedulePrefetch();
+
     emit stepActivated(step);
 }
 
+void Tutorial::schedulePrefetch() {
+    if (!d->mObjectFinder) {
+        return;
+    }
+
+    foreach (const QString& nextStepId, d->mCurrentStep->nextStepIds()) {
+        if (d->mSteps.contains(nextStepId)) {
+            addPendingLookups(d->mSteps.value(nextStepId));
+        }
+    }
+
+    if (!d->mPendingLookups.isEmpty()) {
+        d->mPrefetchTimer->start();
+    }
+}
+
+void Tutorial::addPendingLookups(const Step* step) {
+    if (d->mLookupsByStep.contains(step->id())) {
+        d->mPendingLookups.append(d->mLookupsByStep.value(step->id()));
+        return;
+    }
+
+    if (!d->mBaseObject) {
+        return;
+    }
+
+    ObjectFinder::Lookup lookup;
+    lookup.mBaseObject = d->mBaseObject;
+
+    lookup.mMetaObject = &QObject::staticMetaObject;
+    foreach (const QString& objectName, step->prefetchedObjectNames()) {
+        lookup.mName = objectName;
+        d->mPendingLookups.append(lookup);
+    }
+
+    //Same links handled by view::StepTextWidget
+    lookup.mMetaObject = &QWidget::staticMetaObject;
+    QRegExp widgetLinkPattern("[\"']widget:([^\"']+)[\"']");
+    int position = 0;
+    while ((position = widgetLinkPattern.indexIn(step->text(), position))
+                                                                    != -1) {
+        lookup.mName = widgetLinkPattern.cap(1);
+        d->mPendingLookups.append(lookup);
+        position += widgetLinkPattern.matchedLength();
+    }
+}
+
+//private slots:
+
+void Tutorial::prefetchNextObject() {
+    if (d->mPendingLookups.isEmpty() || !d->mObjectFinder) {
+        d->mPrefetchTimer->stop();
+        return;
+    }
+
+    ObjectFinder::Lookup lookup = d->mPendingLookups.takeFirst();
+    if (lookup.mBaseObject) {
+        d->mObjectFinder->prefetchObject(lookup.mName, lookup.mBaseObject,
+                                         lookup.mMetaObject);
+    }
+
+    if (d->mPendingLookups.isEmpty()) {
+        d->mPrefetchTimer->stop();
+    }
+}
+
 }
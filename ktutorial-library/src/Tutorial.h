@@ -27,6 +27,7 @@
 #include "ktutorial_export.h"
 
 namespace ktutorial {
+class ObjectFinder;
 class Step;
 class TutorialInformation;
 }
@@ -128,6 +129,28 @@ public:
      */
     void nextStep(Step* step);
 
+    /**
+     * Sets the ObjectFinder used to prefetch the objects of the next steps.
+     * When a Step is activated, the objects looked up by the steps that can
+     * follow it (as told by Step::nextStepIds()) are prefetched while the event
+     * loop is idle, so changing to them does not need to walk the object tree
+     * again.
+     *
+     * The objects looked up by a Step are those it looked up in its setup the
+     * last time it was activated. If it was not activated yet, they are the
+     * objects declared with Step::addPrefetchedObjectName(const QString&) and
+     * the widgets linked to from its text, which are found from the given base
+     * object.
+     *
+     * By default there is no ObjectFinder, so nothing is prefetched.
+     *
+     * This method is used internally. Do not call this method yourself.
+     *
+     * @param objectFinder The ObjectFinder to use.
+     * @param baseObject The base object to find the declared objects from.
+     */
+    void setObjectFinder(ObjectFinder* objectFinder, QObject* baseObject);
+
 public Q_SLOTS:
 
     /**
@@ -199,6 +222,33 @@ protected:
      */
     virtual void tearDown();
 
+    /**
+     * Returns the step with the given id.
+     *
+     * @param id The id of the step.
+     * @return The step with the given id, or null if there is none.
+     */
+    Step* step(const QString& id) const;
+
+    /**
+     * Returns the currently active step.
+     *
+     * @return The currently active step, or null if there is none.
+     */
+    Step* currentStep() const;
+
+    /**
+     * Removes the step with the given id from this Tutorial and returns it.
+     * The step is neither deactivated (even if it is the current step) nor
+     * deleted; it is still owned by this Tutorial, but changing to it is no
+     * longer possible until it is added again. It is meant to be used by
+     * Tutorial subclasses that replace steps while the tutorial is running.
+     *
+     * @param id The id of the step to remove.
+     * @return The removed step, or null if there was no step with that id.
+     */
+    Step* takeStep(const QString& id);
+
 private:
 
     class TutorialPrivate* d;
@@ -212,6 +262,31 @@ private:
      */
     void changeToStep(Step* step);
 
+    /**
+     * Schedules the prefetching of the objects looked up by the steps that can
+     * follow the current one.
+     */
+    void schedulePrefetch();
+
+    /**
+     * Adds the lookups expected to be made by the given Step to the pending
+     * lookups.
+     * If the Step was already activated, those are the lookups made in its
+     * setup the last time. Otherwise, those are the lookups for its declared
+     * objects and for the widgets linked to from its text.
+     *
+     * @param step The Step to add its lookups.
+     */
+    void addPendingLookups(const Step* step);
+
+private Q_SLOTS:
+
+    /**
+     * Prefetches the next pending object lookup.
+     * The prefetch timer is stopped once there are no more pending lookups.
+     */
+    void prefetchNextObject();
+
 };
 
 }
@@ -47,11 +47,21 @@ QString TutorialInformation::description() const {
 }
 
 void TutorialInformation::setName(const QString& name) {
+    if (d->mName == name) {
+        return;
+    }
+
     d->mName = name;
+    emit changed();
 }
 
 void TutorialInformation::setDescription(const QString& description) {
+    if (d->mDescription == description) {
+        return;
+    }
+
     d->mDescription = description;
+    emit changed();
 }
 
 }
@@ -76,6 +76,8 @@ public:
 
     /**
      * Sets the name of the tutorial.
+     * If the name changes, changed() is emitted.
+     *
      * This method can be invoked from a script.
      *
      * @param name The name to set.
@@ -84,12 +86,23 @@ public:
 
     /**
      * Sets the description of the tutorial.
+     * If the description changes, changed() is emitted.
+     *
      * This method can be invoked from a script.
      *
      * @param description The description to set.
      */
     Q_INVOKABLE void setDescription(const QString& description);
 
+Q_SIGNALS:
+
+    /**
+     * This signal is emitted when the name or the description change.
+     * For example, when a scripted tutorial which execution was deferred sets
+     * them once executed.
+     */
+    void changed();
+
 private:
 
     class TutorialInformationPrivate* d;
@@ -21,6 +21,8 @@
 #include "TutorialManager.h"
 #include "TutorialManager_p.h"
 
+#include <QtAlgorithms>
+
 #include <KDebug>
 
 #include "Tutorial.h"
@@ -32,10 +34,16 @@ extern int debugArea();
 
 namespace ktutorial {
 
+static bool lessThanId(const TutorialInformation* tutorialInformation1,
+                       const TutorialInformation* tutorialInformation2) {
+    return tutorialInformation1->id() < tutorialInformation2->id();
+}
+
 //public:
 
 TutorialManager::TutorialManager(): QObject(),
     d(new TutorialManagerPrivate()) {
+    d->mObjectFinder = 0;
 }
 
 TutorialManager::~TutorialManager() {
@@ -53,16 +61,62 @@ bool TutorialManager::registerTutorial(Tutorial* tutorial) {
 
     tutorial->setParent(this);
 
-    d->mTutorialInformations.insert(tutorial->tutorialInformation()->id(),
-                                    tutorial->tutorialInformation());
-    d->mTutorials.insert(tutorial->tutorialInformation(), tutorial);
+    const TutorialInformation* tutorialInformation =
+                                                tutorial->tutorialInformation();
+    QList<const TutorialInformation*>::iterator position =
+                        qLowerBound(d->mSortedTutorialInformations.begin(),
+                                    d->mSortedTutorialInformations.end(),
+                                    tutorialInformation, lessThanId);
+    int index = position - d->mSortedTutorialInformations.begin();
+
+    emit tutorialAboutToBeRegistered(tutorialInformation, index);
+
+    d->mTutorialInformations.insert(tutorialInformation->id(),
+                                    tutorialInformation);
+    d->mSortedTutorialInformations.insert(index, tutorialInformation);
+    d->mTutorials.insert(tutorialInformation, tutorial);
+
+    connect(tutorialInformation, SIGNAL(changed()),
+            this, SLOT(handleTutorialInformationChanged()));
+
+    emit tutorialRegistered(tutorialInformation);
 
     return true;
 }
 
+Tutorial* TutorialManager::unregisterTutorial(const QString& id) {
+    if (!d->mTutorialInformations.contains(id)) {
+        kWarning(debugArea()) << "Tutorial with id" << id << "is not registered";
+        return 0;
+    }
+
+    const TutorialInformation* tutorialInformation =
+                                            d->mTutorialInformations.value(id);
+    QList<const TutorialInformation*>::iterator position =
+                        qBinaryFind(d->mSortedTutorialInformations.begin(),
+                                    d->mSortedTutorialInformations.end(),
+                                    tutorialInformation, lessThanId);
+    int index = position - d->mSortedTutorialInformations.begin();
+
+    emit tutorialAboutToBeUnregistered(tutorialInformation, index);
+
+    disconnect(tutorialInformation, SIGNAL(changed()),
+               this, SLOT(handleTutorialInformationChanged()));
+
+    Tutorial* tutorial = d->mTutorials.take(tutorialInformation);
+    d->mSortedTutorialInformations.removeAt(index);
+    d->mTutorialInformations.remove(id);
+
+    tutorial->setParent(0);
+
+    emit tutorialUnregistered(tutorialInformation);
+
+    return tutorial;
+}
+
 QList<const TutorialInformation*> TutorialManager::tutorialInformations()
                                                                         const {
-    return d->mTutorialInformations.values();
+    return d->mSortedTutorialInformations;
 }
 
 void TutorialManager::start(const QString& id) {
@@ -79,9 +133,16 @@ void TutorialManager::start(const QString& id) {
 
     emit started(tutorial);
 
+    tutorial->setObjectFinder(d->mObjectFinder, d->mBaseObject);
     tutorial->start();
 }
 
+void TutorialManager::setObjectFinder(ObjectFinder* objectFinder,
+                                      QObject* baseObject) {
+    d->mObjectFinder = objectFinder;
+    d->mBaseObject = baseObject;
+}
+
 //private slots:
 
 void TutorialManager::finish() {
@@ -89,4 +150,16 @@ void TutorialManager::finish() {
     emit finished();
 }
 
+void TutorialManager::handleTutorialInformationChanged() {
+    const TutorialInformation* tutorialInformation =
+                        static_cast<const TutorialInformation*>(sender());
+    QList<const TutorialInformation*>::iterator position =
+                        qBinaryFind(d->mSortedTutorialInformations.begin(),
+                                    d->mSortedTutorialInformations.end(),
+                                    tutorialInformation, lessThanId);
+    int index = position - d->mSortedTutorialInformations.begin();
+
+    emit tutorialInformationChanged(tutorialInformation, index);
+}
+
 }
@@ -26,6 +26,7 @@
 #include "ktutorial_export.h"
 
 namespace ktutorial {
+class ObjectFinder;
 class Tutorial;
 class TutorialInformation;
 }
@@ -63,13 +64,36 @@ public:
      * The Tutorial is reparented to this TutorialManager, and thus deleted when
      * this manager is deleted.
      *
+     * When the Tutorial is registered, tutorialAboutToBeRegistered(const
+     * TutorialInformation*, int) and tutorialRegistered(const
+     * TutorialInformation*) are emitted.
+     *
      * @param tutorial The tutorial to register.
      * @return True if the tutorial was registered, false otherwise.
      */
     bool registerTutorial(Tutorial* tutorial);
 
+    /**
+     * Unregisters the Tutorial with the given id from this TutorialManager.
+     * The Tutorial is no longer a child of this TutorialManager, so it must be
+     * deleted by the caller. A Tutorial that is being executed must not be
+     * unregistered.
+     *
+     * When the Tutorial is unregistered, tutorialAboutToBeUnregistered(const
+     * TutorialInformation*, int) and tutorialUnregistered(const
+     * TutorialInformation*) are emitted.
+     *
+     * @param id The id of the tutorial to unregister.
+     * @return The unregistered tutorial, or a null pointer if there was no
+     *         tutorial with that id.
+     */
+    Tutorial* unregisterTutorial(const QString& id);
+
     /**
      * Returns a list with the information of all the registered tutorials.
+     * The list is sorted by the id of the tutorials and it is kept up to date
+     * as tutorials are registered and unregistered. As QList is implicitly
+     * shared, its elements are not copied when it is returned.
      *
      * @return A list with the information of all the registered tutorials.
      */
@@ -88,8 +112,73 @@ public:
      */
     void start(const QString& id);
 
+    /**
+     * Sets the ObjectFinder used by the tutorials to prefetch the objects of
+     * their next steps, and the base object to find them from.
+     * It is set in each tutorial before starting it.
+     *
+     * @param objectFinder The ObjectFinder to use.
+     * @param baseObject The base object to find the objects from.
+     * @see Tutorial::setObjectFinder(ObjectFinder*, QObject*)
+     */
+    void setObjectFinder(ObjectFinder* objectFinder, QObject* baseObject);
+
 Q_SIGNALS:
 
+    /**
+     * This signal is emitted when a tutorial is about to be registered.
+     * The tutorial is not in the list of tutorial informations yet, but it will
+     * be inserted at the given index once registered.
+     *
+     * @param tutorialInformation The information of the tutorial to register.
+     * @param index The index in tutorialInformations() of the tutorial.
+     */
+    void tutorialAboutToBeRegistered(
+                                const TutorialInformation* tutorialInformation,
+                                int index);
+
+    /**
+     * This signal is emitted when a tutorial is registered.
+     * Tutorials may be registered after the tutorial manager UI was shown (for
+     * example, if the scripted tutorials are loaded in the background), so the
+     * UI should connect to this signal to show them when they become
+     * available.
+     *
+     * @param tutorialInformation The information of the registered tutorial.
+     */
+    void tutorialRegistered(const TutorialInformation* tutorialInformation);
+
+    /**
+     * This signal is emitted when a tutorial is about to be unregistered.
+     * The tutorial is still in the list of tutorial informations, at the given
+     * index.
+     *
+     * @param tutorialInformation The information of the tutorial to
+     *        unregister.
+     * @param index The index in tutorialInformations() of the tutorial.
+     */
+    void tutorialAboutToBeUnregistered(
+                                const TutorialInformation* tutorialInformation,
+                                int index);
+
+    /**
+     * This signal is emitted when a tutorial is unregistered.
+     *
+     * @param tutorialInformation The information of the unregistered tutorial.
+     */
+    void tutorialUnregistered(const TutorialInformation* tutorialInformation);
+
+    /**
+     * This signal is emitted when the name or the description of a registered
+     * tutorial change.
+     *
+     * @param tutorialInformation The information of the changed tutorial.
+     * @param index The index in tutorialInformations() of the tutorial.
+     */
+    void tutorialInformationChanged(
+                                const TutorialInformation* tutorialInformation,
+                                int index);
+
     /**
      * This signal is emitted when the given tutorial is about to be started.
      */
@@ -114,6 +203,12 @@ private Q_SLOTS:
      */
     void finish();
 
+    /**
+     * Emits tutorialInformationChanged(const TutorialInformation*, int) for
+     * the TutorialInformation that sent the signal.
+     */
+    void handleTutorialInformationChanged();
+
 };
 
 }
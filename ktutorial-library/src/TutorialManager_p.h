@@ -18,7 +18,9 @@
 #ifndef KTUTORIAL_TUTORIALMANAGER_P_H
 #define KTUTORIAL_TUTORIALMANAGER_P_H
 
+#include <QList>
 #include <QMap>
+#include <QPointer>
 
 namespace ktutorial {
 
@@ -30,11 +32,29 @@ public:
      */
     QMap<QString, const TutorialInformation*> mTutorialInformations;
 
+    /**
+     * The information of the registered tutorials sorted by their id.
+     * It contains the same elements as the values of mTutorialInformations,
+     * but it is kept as a list so it can be accessed by index without copying
+     * it.
+     */
+    QList<const TutorialInformation*> mSortedTutorialInformations;
+
     /**
      * A map with all the registered tutorials, indexed by TutorialInformations.
      */
     QMap<const TutorialInformation*, Tutorial*> mTutorials;
 
+    /**
+     * The ObjectFinder used by the tutorials to prefetch objects.
+     */
+    ObjectFinder* mObjectFinder;
+
+    /**
+     * The base object to find the prefetched objects from.
+     */
+    QPointer<QObject> mBaseObject;
+
 };
 
 }
@@ -18,7 +18,12 @@
 #ifndef KTUTORIAL_TUTORIAL_P_H
 #define KTUTORIAL_TUTORIAL_P_H
 
+#include <QHash>
 #include <QMap>
+#include <QPointer>
+#include <QTimer>
+
+#include "ObjectFinder.h"
 
 namespace ktutorial {
 
@@ -45,6 +50,33 @@ public:
      */
     QList<Step*> mQueuedSteps;
 
+    /**
+     * The ObjectFinder to prefetch the objects of the next steps with.
+     */
+    QPointer<ObjectFinder> mObjectFinder;
+
+    /**
+     * The base object to find the objects declared by the steps from.
+     */
+    QPointer<QObject> mBaseObject;
+
+    /**
+     * The lookups made by each step the last time it was set up, indexed by
+     * the identifier of the step.
+     */
+    QHash<QString, QList<ObjectFinder::Lookup> > mLookupsByStep;
+
+    /**
+     * The lookups of the next steps that were not prefetched yet.
+     */
+    QList<ObjectFinder::Lookup> mPendingLookups;
+
+    /**
+     * Zero interval timer to prefetch the pending lookups when the event loop
+     * is idle.
+     */
+    QTimer* mPrefetchTimer;
+
 };
 
 }
@@ -80,6 +80,21 @@ public:
      */
     virtual void setActive(bool active);
 
+    /**
+     * Creates a new WaitFor of type T.
+     * It is the factory used when a WaitFor type is registered to create
+     * instances of it in scripted tutorials. The returned T* is implicitly
+     * converted to WaitFor*, so it will not compile if T does not inherit from
+     * WaitFor.
+     *
+     * @return The new WaitFor.
+     * @see KTutorial::registerWaitFor<T>(const QString&)
+     */
+    template <typename T>
+    static WaitFor* create() {
+        return new T();
+    }
+
 Q_SIGNALS:
 
     /**
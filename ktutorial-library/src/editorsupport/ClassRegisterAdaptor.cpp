@@ -19,8 +19,6 @@
 
 #include "ClassRegisterAdaptor.h"
 
-#include <QMetaClassInfo>
-
 #include "ObjectRegister.h"
 
 namespace ktutorial {
@@ -50,70 +48,25 @@ QString ClassRegisterAdaptor::superClass(const QString& className) const {
 }
 
 QStringList ClassRegisterAdaptor::propertyList(const QString& className) const {
-    const QMetaObject* metaObject =
-                            mObjectRegister->metaObjectForClassName(className);
-    if (!metaObject) {
-        return QStringList();
-    }
-
-    QStringList propertyList;
-    for (int i=0; i<metaObject->propertyCount(); ++i) {
-        QMetaProperty property = metaObject->property(i);
-        if (isPropertyDefinedInClass(property, metaObject)) {
-            propertyList.append(property.name());
-        }
-    }
-
-    return propertyList;
+    return mObjectRegister->propertyListForClassName(className);
 }
 
 QStringList ClassRegisterAdaptor::signalList(const QString& className) const {
-    const QMetaObject* metaObject =
-                            mObjectRegister->metaObjectForClassName(className);
-    if (!metaObject) {
-        return QStringList();
-    }
-
-    QStringList signalList;
-    for (int i=0; i<metaObject->methodCount(); ++i) {
-        QMetaMethod method = metaObject->method(i);
-        if (isSignalDefinedInClass(method, metaObject)) {
-            signalList.append(method.signature());
-        }
-    }
-
-    return signalList;
+    return mObjectRegister->signalListForClassName(className);
 }
 
-//private:
-
-bool ClassRegisterAdaptor::isPropertyDefinedInClass(
-                                        const QMetaProperty& metaProperty,
-                                        const QMetaObject* metaObject) const {
-    const QMetaObject* superClass = metaObject;
-    while ((superClass = superClass->superClass())) {
-        if (superClass->indexOfProperty(metaProperty.name()) != -1) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
-bool ClassRegisterAdaptor::isSignalDefinedInClass(const QMetaMethod& metaMethod,
-                                          const QMetaObject* metaObject) const {
-    if (metaMethod.methodType() != QMetaMethod::Signal) {
-        return false;
-    }
-
-    const QMetaObject* superClass = metaObject;
-    while ((superClass = superClass->superClass())) {
-        if (superClass->indexOfSignal(metaMethod.signature()) != -1) {
-            return false;
-        }
+QVariantMap ClassRegisterAdaptor::classHierarchy() const {
+    QVariantMap classHierarchy;
+    QStringList classNames = mObjectRegister->registeredClassNames();
+    foreach (const QString& className, classNames) {
+        QVariantMap classData;
+        classData.insert("superClass", superClass(className));
+        classData.insert("propertyList", propertyList(className));
+        classData.insert("signalList", signalList(className));
+        classHierarchy.insert(className, classData);
     }
 
-    return true;
+    return classHierarchy;
 }
 
 }
@@ -22,6 +22,7 @@
 
 #include <QDBusAbstractAdaptor>
 #include <QStringList>
+#include <QVariantMap>
 
 namespace ktutorial {
 namespace editorsupport {
@@ -86,40 +87,28 @@ public Q_SLOTS:
      */
     QStringList signalList(const QString& className) const;
 
-private:
-
-    /**
-     * The ObjectRegister to adapt.
-     */
-    ObjectRegister* mObjectRegister;
-
     /**
-     * Checks whether the given meta property is a property defined in the given
-     * meta object.
-     * If the property is inherited in the given meta object instead of defined
-     * in it, false is also returned.
+     * Returns the super class, properties and signals of all the registered
+     * classes.
+     * The returned map contains an entry for each registered class, with the
+     * class name as the key. The value of each entry is also a map, with
+     * "superClass", "propertyList" and "signalList" as keys; their values are
+     * the same returned by superClass(QString), propertyList(QString) and
+     * signalList(QString) for that class.
      *
-     * @param metaProperty The meta property to check.
-     * @param metaObject The meta object to check the meta property with.
-     * @return True if the meta property is a property defined in the meta
-     *         object, false otherwise.
+     * It is meant to be used to get the information of all the classes in just
+     * one call, instead of a call for each class and type of information.
+     *
+     * @return The information of all the registered classes.
      */
-    bool isPropertyDefinedInClass(const QMetaProperty& metaProperty,
-                                  const QMetaObject* metaObject) const;
+    QVariantMap classHierarchy() const;
+
+private:
 
     /**
-     * Checks whether the given meta method is a signal defined in the given
-     * meta object.
-     * If the signal is inherited in the given meta object instead of defined in
-     * it, false is also returned.
-     *
-     * @param metaMethod The meta method to check.
-     * @param metaObject The meta object to check the meta method with.
-     * @return True if the meta method is a signal defined in the meta object,
-     *         false otherwise.
+     * The ObjectRegister to adapt.
      */
-    bool isSignalDefinedInClass(const QMetaMethod& metaMethod,
-                                const QMetaObject* metaObject) const;
+    ObjectRegister* mObjectRegister;
 
 };
 
@@ -19,6 +19,11 @@
 
 #include "EditorSupport.h"
 
+#include <QCoreApplication>
+#include <QFile>
+#include <QPixmap>
+#include <QSharedMemory>
+#include <QUuid>
 #include <QWidget>
 #include <QtDBus/QtDBus>
 
@@ -28,9 +33,11 @@
 #include "EditorSupportAdaptor.h"
 #include "EventSpy.h"
 #include "EventSpyAdaptor.h"
+#include "LocalSocketServer.h"
 #include "ObjectRegister.h"
 #include "ObjectRegisterAdaptor.h"
 #include "../ObjectFinder.h"
+#include "../Tracer.h"
 #include "../extendedinformation/WidgetHighlighterManager.h"
 #include "../scripting/ScriptedTutorial.h"
 
@@ -49,7 +56,12 @@ namespace editorsupport {
 EditorSupport::EditorSupport(QObject* parent /*= 0*/): QObject(parent),
     mObjectRegister(0),
     mEventSpy(0),
-    mObjectFinder(0) {
+    mLocalSocketServer(0),
+    mObjectFinder(0),
+    mTestTutorial(0),
+    mTestTutorialStepsUpdated(false),
+    mFinishedTestTutorial(0),
+    mThumbnailMemory(0) {
 }
 
 void EditorSupport::setObjectFinder(ObjectFinder* objectFinder) {
@@ -69,11 +81,40 @@ void EditorSupport::setup(QObject* window) {
     QDBusConnection::sessionBus().registerObject("/ktutorial", this);
 
     mObjectRegister = new ObjectRegister(this);
-    new ClassRegisterAdaptor(mObjectRegister);
-    new ObjectRegisterAdaptor(mObjectRegister);
+    ClassRegisterAdaptor* classRegisterAdaptor =
+                                    new ClassRegisterAdaptor(mObjectRegister);
+    ObjectRegisterAdaptor* objectRegisterAdaptor =
+                                    new ObjectRegisterAdaptor(mObjectRegister);
 
     QDBusConnection::sessionBus().registerObject("/ktutorial/ObjectRegister",
                                                  mObjectRegister);
+
+    //Without a token from the editor the clients could not be authenticated
+    QString token = qgetenv("KTUTORIAL_EDITOR_TOKEN");
+    if (!token.isEmpty()) {
+        mLocalSocketServer = new LocalSocketServer(objectRegisterAdaptor,
+                                                   classRegisterAdaptor,
+                                                   token, this);
+
+        //The name is unguessable, so no stale server can be using it
+        QString serverName = "ktutorial-" +
+                    QString::number(QCoreApplication::applicationPid()) + '-' +
+                    QUuid::createUuid().toString().mid(1, 36);
+        if (!mLocalSocketServer->listen(serverName)) {
+            kWarning(debugArea()) << "Cannot start the local socket server!"
+                                  << "Only D-Bus will be used";
+        }
+    }
+
+    notifyEditor();
+}
+
+QString EditorSupport::localServerName() const {
+    if (!mLocalSocketServer) {
+        return "";
+    }
+
+    return mLocalSocketServer->serverName();
 }
 
 int EditorSupport::mainWindowObjectId() {
@@ -107,10 +148,75 @@ void EditorSupport::stopHighlighting(int objectId) {
     WidgetHighlighterManager::self()->stopHighlighting(widget);
 }
 
+QSize EditorSupport::grabWidget(int objectId, const QSize& maxSize,
+                                QString* key) {
+    key->clear();
+
+    QObject* object = mObjectRegister->objectForId(objectId);
+    QWidget* widget = qobject_cast<QWidget*>(object);
+    if (!widget || maxSize.isEmpty()) {
+        return QSize();
+    }
+
+    QImage thumbnail = QPixmap::grabWidget(widget).toImage();
+    if (thumbnail.isNull()) {
+        return QSize();
+    }
+
+    if (thumbnail.width() > maxSize.width() ||
+            thumbnail.height() > maxSize.height()) {
+        thumbnail = thumbnail.scaled(maxSize, Qt::KeepAspectRatio,
+                                     Qt::SmoothTransformation);
+    }
+    thumbnail = thumbnail.convertToFormat(QImage::Format_ARGB32);
+
+    int lineSize = thumbnail.width() * 4;
+    int thumbnailSize = lineSize * thumbnail.height();
+
+    if (!mThumbnailMemory) {
+        mThumbnailMemory = new QSharedMemory(this);
+    }
+
+    if (mThumbnailMemory->isAttached() &&
+            mThumbnailMemory->size() < thumbnailSize) {
+        mThumbnailMemory->detach();
+    }
+
+    //Each thumbnail usually has a different size, so the segment is created
+    //with some room to spare to avoid growing it for every small increment.
+    //Every segment gets a new random key; an existing segment is never
+    //attached to, as it could have been created by anyone
+    if (!mThumbnailMemory->isAttached()) {
+        mThumbnailMemory->setKey("ktutorial-thumbnail-" +
+                                 QUuid::createUuid().toString().mid(1, 36));
+        if (!mThumbnailMemory->create(qMax(thumbnailSize, 64 * 1024))) {
+            kWarning(debugArea()) << "Cannot create the shared memory for"
+                                  << "the thumbnails:"
+                                  << mThumbnailMemory->errorString();
+            return QSize();
+        }
+    }
+
+    mThumbnailMemory->lock();
+    char* data = static_cast<char*>(mThumbnailMemory->data());
+    for (int y=0; y<thumbnail.height(); ++y) {
+        qMemCopy(data + y * lineSize, thumbnail.scanLine(y), lineSize);
+    }
+    mThumbnailMemory->unlock();
+
+    *key = mThumbnailMemory->key();
+
+    return thumbnail.size();
+}
+
 void EditorSupport::enableEventSpy() {
-    mEventSpy = new EventSpy(this);
+    mEventSpy = new EventSpy(this, EventSpy::ApplicationFilter);
     mEventSpy->addObjectToSpy(mWindow);
-    new EventSpyAdaptor(mEventSpy, mObjectRegister);
+    EventSpyAdaptor* eventSpyAdaptor = new EventSpyAdaptor(mEventSpy,
+                                                           mObjectRegister);
+    if (mLocalSocketServer) {
+        mLocalSocketServer->setEventSpyAdaptor(eventSpyAdaptor);
+    }
 
     QDBusConnection::sessionBus().registerObject("/ktutorial/EventSpy",
                                                  mEventSpy);
@@ -119,26 +225,82 @@ void EditorSupport::enableEventSpy() {
 void EditorSupport::disableEventSpy() {
     QDBusConnection::sessionBus().unregisterObject("/ktutorial/EventSpy");
 
+    if (mLocalSocketServer) {
+        mLocalSocketServer->setEventSpyAdaptor(0);
+    }
+
     delete mEventSpy;
     mEventSpy = 0;
 }
 
+void EditorSupport::enableTracing(bool streamSpans) {
+    Tracer* tracer = Tracer::self();
+
+    disconnect(tracer, 0, this, 0);
+    if (streamSpans) {
+        connect(tracer,
+                SIGNAL(spanAdded(QString,QString,QString,qint64,qint64)),
+                this,
+                SLOT(notifySpanAdded(QString,QString,QString,qint64,qint64)));
+    }
+
+    tracer->setEnabled(true);
+}
+
+void EditorSupport::disableTracing() {
+    Tracer::self()->setEnabled(false);
+    disconnect(Tracer::self(), 0, this, 0);
+}
+
+QString EditorSupport::chromeTrace() const {
+    return QString::fromUtf8(Tracer::self()->chromeTrace());
+}
+
 void EditorSupport::testScriptedTutorial(const QString& filename,
                                          const QString& stepId) {
-    ScriptedTutorial* scriptedTutorial = new ScriptedTutorial(filename);
+    QByteArray code;
+    QFile file(filename);
+    if (file.open(QIODevice::ReadOnly)) {
+        code = file.readAll();
+    }
 
-    if (!scriptedTutorial->isValid()) {
-        kWarning(debugArea()) << "Cannot test the scripted tutorial stored in"
-                              << filename << ": the script is invalid";
-        delete scriptedTutorial;
-        return;
+    ScriptedTutorial* scriptedTutorial = 0;
+    if (mFinishedTestTutorial && !code.isEmpty() &&
+            code == mFinishedTestTutorialCode &&
+            mFinishedTestTutorial->tutorialInformation()->id() == filename) {
+        //The script was already executed; starting the tutorial again is
+        //enough to test it
+        scriptedTutorial = mFinishedTestTutorial;
+        mFinishedTestTutorial = 0;
+        mFinishedTestTutorialCode.clear();
+    } else {
+        if (mFinishedTestTutorial) {
+            mFinishedTestTutorial->deleteLater();
+            mFinishedTestTutorial = 0;
+            mFinishedTestTutorialCode.clear();
+        }
+
+        scriptedTutorial = new ScriptedTutorial(filename);
+
+        if (!scriptedTutorial->isValid()) {
+            kWarning(debugArea()) << "Cannot test the scripted tutorial stored"
+                                  << "in" << filename << ": the script is"
+                                  << "invalid";
+            delete scriptedTutorial;
+            return;
+        }
+
+        connect(scriptedTutorial, SIGNAL(finished(Tutorial*)),
+                this, SLOT(keepFinishedTestTutorial(Tutorial*)));
     }
 
-    connect(scriptedTutorial, SIGNAL(finished(Tutorial*)),
-            this, SLOT(deleteFinishedTestTutorial(Tutorial*)));
+    mTestTutorial = scriptedTutorial;
+    mTestTutorialCode = code;
+    mTestTutorialStepsUpdated = false;
 
     emit started(scriptedTutorial);
 
+    scriptedTutorial->setObjectFinder(mObjectFinder, mWindow);
     scriptedTutorial->start();
 
     if (!stepId.isEmpty()) {
@@ -146,10 +308,93 @@ void EditorSupport::testScriptedTutorial(const QString& filename,
     }
 }
 
+bool EditorSupport::updateTestScriptedTutorialSteps(
+                                            const QStringList& stepIds,
+                                            const QStringList& stepScripts) {
+    if (!mTestTutorial) {
+        kWarning(debugArea()) << "Cannot update the steps of the tested"
+                              << "tutorial: no tutorial is being tested";
+        return false;
+    }
+
+    if (stepIds.count() != stepScripts.count()) {
+        kWarning(debugArea()) << "Cannot update the steps of the tested"
+                              << "tutorial: there are" << stepIds.count()
+                              << "step ids but" << stepScripts.count()
+                              << "step scripts";
+        return false;
+    }
+
+    mTestTutorialStepsUpdated = true;
+
+    bool updated = true;
+    for (int i=0; i<stepIds.count(); ++i) {
+        if (!mTestTutorial->updateStep(stepIds[i], stepScripts[i])) {
+            kWarning(debugArea()) << "Cannot update the step" << stepIds[i]
+                                  << "of the tested tutorial";
+            updated = false;
+        }
+    }
+
+    return updated;
+}
+
 //private:
 
-void EditorSupport::deleteFinishedTestTutorial(Tutorial* tutorial) {
-    tutorial->deleteLater();
+void EditorSupport::notifyEditor() {
+    QString editorService = qgetenv("KTUTORIAL_EDITOR_SERVICE");
+    if (editorService.isEmpty()) {
+        return;
+    }
+
+    QString token = qgetenv("KTUTORIAL_EDITOR_TOKEN");
+
+    //Applications started from this one must not notify the editor
+    qputenv("KTUTORIAL_EDITOR_SERVICE", QByteArray());
+    qputenv("KTUTORIAL_EDITOR_TOKEN", QByteArray());
+
+    QDBusMessage message = QDBusMessage::createMethodCall(editorService,
+                                    "/ktutorial/TargetApplication",
+                                    "org.kde.ktutorial.TargetApplication",
+                                    "editorSupportRegistered");
+    message << token;
+
+    //No reply is needed, so the call does not block the application
+    if (!QDBusConnection::sessionBus().send(message)) {
+        kWarning(debugArea()) << "Cannot notify KTutorial editor that the"
+                              << "editor support is registered";
+    }
+}
+
+//private slots:
+
+void EditorSupport::keepFinishedTestTutorial(Tutorial* tutorial) {
+    if (tutorial != mTestTutorial || mTestTutorialStepsUpdated ||
+            mTestTutorialCode.isEmpty()) {
+        if (tutorial == mTestTutorial) {
+            mTestTutorial = 0;
+        }
+
+        tutorial->deleteLater();
+        return;
+    }
+
+    if (mFinishedTestTutorial) {
+        mFinishedTestTutorial->deleteLater();
+    }
+
+    mFinishedTestTutorial = mTestTutorial;
+    mFinishedTestTutorial->setParent(this);
+    mFinishedTestTutorialCode = mTestTutorialCode;
+
+    mTestTutorial = 0;
+    mTestTutorialCode.clear();
+}
+
+void EditorSupport::notifySpanAdded(const QString& name, const QString& detail,
+                                    const QString& stepId, qint64 start,
+                                    qint64 duration) {
+    emit spanTraced(name, detail, stepId, start, duration);
 }
 
 
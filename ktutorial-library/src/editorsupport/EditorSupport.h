@@ -20,17 +20,29 @@
 #ifndef KTUTORIAL_EDITORSUPPORT_EDITORSUPPORT_H
 #define KTUTORIAL_EDITORSUPPORT_EDITORSUPPORT_H
 
+#include <QByteArray>
 #include <QObject>
+#include <QSize>
+#include <QStringList>
+
+class QSharedMemory;
 
 namespace ktutorial {
 class ObjectFinder;
 class Tutorial;
 }
 
+namespace ktutorial {
+namespace scripting {
+class ScriptedTutorial;
+}
+}
+
 namespace ktutorial {
 namespace editorsupport {
 class EventSpy;
 class EventSupportAdaptor;
+class LocalSocketServer;
 class ObjectRegister;
 }
 }
@@ -49,9 +61,13 @@ namespace editorsupport {
  * The main object sets up the D-Bus objects and provides a way to enable and
  * disable the EventSpy (as notifying all the events sent by an application
  * through D-Bus is very costly, the EventSpy should be enabled only when
- * needed), highlight and stop the highlighting of widgets, test a scripted
- * tutorial (starting the tutorial stored in the given filename and, optionally,
- * from the given step id), and find objects.
+ * needed), highlight and stop the highlighting of widgets, grab thumbnails of
+ * widgets (through shared memory, to avoid sending the images through D-Bus),
+ * test a scripted tutorial (starting the tutorial stored in the given filename
+ * and, optionally, from the given step id), update the steps of the tested
+ * tutorial while it is running, and find objects. It also enables and disables
+ * the Tracer, exports the recorded spans and, optionally, streams each span to
+ * KTutorial editor as it is recorded.
  *
  * The object register assigns an id to QObjects to be identified by the remote
  * KTutorial editor. Using that id, KTutorial editor can request further
@@ -72,6 +88,19 @@ namespace editorsupport {
  * interfaces. Finally, when it is enabled, the EventSpy is registered at
  * "/ktutorial/EVentSpy" path and provides the "org.kde.ktutorial.EventSpy"
  * interface.
+ *
+ * Besides D-Bus, the object register, the class register and the event spy are
+ * also exposed through a local socket, which has a much lower latency. The name
+ * of the local socket server is advertised in the "localServerName" property of
+ * the main object, so KTutorial editor can discover it through D-Bus and then
+ * use the local socket instead. The name of the server is random, and the
+ * clients must authenticate with the token provided by KTutorial editor when
+ * it started the application, so the local socket server is only started if
+ * the application was started from KTutorial editor. See LocalSocketServer for
+ * the protocol used.
+ *
+ * When the application is started from KTutorial editor, the editor is notified
+ * once all the D-Bus objects are registered.
  */
 class EditorSupport: public QObject {
 Q_OBJECT
@@ -99,6 +128,15 @@ public:
      */
     void setup(QObject* window);
 
+    /**
+     * Returns the full name of the local socket server.
+     * If the local socket server could not be started, or the application was
+     * not started from KTutorial editor, an empty string is returned.
+     *
+     * @return The full name of the local socket server.
+     */
+    QString localServerName() const;
+
     /**
      * Returns the object id of the application main window.
      *
@@ -131,8 +169,36 @@ public:
      */
     void stopHighlighting(int objectId);
 
+    /**
+     * Renders a thumbnail of the widget associated to the given id into a
+     * shared memory segment.
+     * The thumbnail is scaled down, keeping its aspect ratio, to fit in the
+     * given maximum size; it is never scaled up. It is stored in the segment
+     * as 32 bit ARGB pixels, without padding between the lines, so only the
+     * key of the segment and the size of the thumbnail have to be sent to
+     * KTutorial editor instead of the image itself.
+     *
+     * The segment is reused for every thumbnail, so its contents must be read
+     * before grabbing another widget. When it has to be grown a new segment is
+     * created instead, with a new random key; a segment that already exists
+     * is never reused, as it could belong to another user. The key is
+     * returned along with the size, so it always refers to the segment that
+     * contains the thumbnail.
+     *
+     * If the id is not associated to a widget, or the thumbnail could not be
+     * stored, an invalid size and an empty key are returned.
+     *
+     * @param objectId The id of the widget to grab.
+     * @param maxSize The maximum size of the thumbnail.
+     * @param key The key of the shared memory segment with the thumbnail.
+     * @return The size of the thumbnail.
+     */
+    QSize grabWidget(int objectId, const QSize& maxSize, QString* key);
+
     /**
      * Enables the EventSpy.
+     * The EventSpy uses a single event filter in the application, so enabling
+     * it does not depend on the number of objects in the window.
      */
     void enableEventSpy();
 
@@ -141,17 +207,68 @@ public:
      */
     void disableEventSpy();
 
+    /**
+     * Enables the Tracer.
+     * If the spans are streamed, spanTraced is emitted for every span recorded
+     * by the Tracer, so KTutorial editor can follow them while the tutorial is
+     * running. Otherwise, the recorded spans can be got at any time with
+     * chromeTrace().
+     *
+     * @param streamSpans True to emit spanTraced for every span, false
+     *        otherwise.
+     */
+    void enableTracing(bool streamSpans);
+
+    /**
+     * Disables the Tracer.
+     * The spans recorded so far are kept.
+     */
+    void disableTracing();
+
+    /**
+     * Returns the spans recorded by the Tracer in the Chrome trace event
+     * format.
+     *
+     * @return The JSON document with the recorded spans.
+     * @see Tracer::chromeTrace()
+     */
+    QString chromeTrace() const;
+
     /**
      * Starts the scripted tutorial stored in the given filename.
      * If a step id is given, the tutorial is changed to that step after
      * starting.
      *
+     * The last tested tutorial is kept after finishing. If the script in the
+     * file did not change since then, and the steps of the tutorial were not
+     * updated while it was tested, that tutorial is started again instead of
+     * executing the whole script once more.
+     *
      * @param filename The name of the file to read the scripted tutorial from.
      * @param stepId The id of the step to change to, if any.
      */
     void testScriptedTutorial(const QString& filename,
                               const QString& stepId = QString());
 
+    /**
+     * Replaces the steps of the scripted tutorial being tested.
+     * Each step is replaced with the step created by the script at the same
+     * position in the list of step scripts. The script must create the step and
+     * add it to the tutorial, like the code for each step in the script of the
+     * tutorial does.
+     *
+     * The current step is kept, unless it is one of the replaced steps; in that
+     * case, the tutorial changes to the new version of the step.
+     *
+     * @param stepIds The ids of the steps to replace.
+     * @param stepScripts The scripts that create and add the new steps.
+     * @return True if all the steps were replaced, false if there is no tested
+     *         tutorial running or some step could not be replaced.
+     * @see scripting::ScriptedTutorial::updateStep(QString, QString)
+     */
+    bool updateTestScriptedTutorialSteps(const QStringList& stepIds,
+                                         const QStringList& stepScripts);
+
 Q_SIGNALS:
 
     /**
@@ -161,6 +278,20 @@ Q_SIGNALS:
      */
     void started(Tutorial* tutorial);
 
+    /**
+     * This signal is emitted when the Tracer records a span, if the spans are
+     * streamed.
+     *
+     * @param name The name of the span.
+     * @param detail Additional information about the span.
+     * @param stepId The id of the step the span belongs to.
+     * @param start The start of the span, in microseconds.
+     * @param duration The duration of the span, in microseconds.
+     * @see enableTracing(bool)
+     */
+    void spanTraced(const QString& name, const QString& detail,
+                    const QString& stepId, qlonglong start, qlonglong duration);
+
 private:
 
     /**
@@ -173,6 +304,11 @@ private:
      */
     EventSpy* mEventSpy;
 
+    /**
+     * The local socket server.
+     */
+    LocalSocketServer* mLocalSocketServer;
+
     /**
      * The object to spy its events and the events of its children.
      */
@@ -183,14 +319,71 @@ private:
      */
     ObjectFinder* mObjectFinder;
 
+    /**
+     * The scripted tutorial being tested, if any.
+     */
+    scripting::ScriptedTutorial* mTestTutorial;
+
+    /**
+     * The code of the script of the tutorial being tested.
+     */
+    QByteArray mTestTutorialCode;
+
+    /**
+     * Whether the steps of the tutorial being tested were updated or not.
+     */
+    bool mTestTutorialStepsUpdated;
+
+    /**
+     * The last tested tutorial, kept after finishing to be started again if
+     * the same script is tested again.
+     */
+    scripting::ScriptedTutorial* mFinishedTestTutorial;
+
+    /**
+     * The code of the script of the last tested tutorial.
+     */
+    QByteArray mFinishedTestTutorialCode;
+
+    /**
+     * The shared memory segment to store the thumbnails in, if any.
+     */
+    QSharedMemory* mThumbnailMemory;
+
+    /**
+     * Notifies KTutorial editor that the editor support has been registered,
+     * if the application was started from KTutorial editor.
+     * KTutorial editor provides its D-Bus service and a token to identify the
+     * application in the "KTUTORIAL_EDITOR_SERVICE" and
+     * "KTUTORIAL_EDITOR_TOKEN" environment variables, so it does not need to
+     * poll the application to know when the editor support is available.
+     */
+    void notifyEditor();
+
 private Q_SLOTS:
 
     /**
-     * Deletes the test tutorial when it is finished.
+     * Keeps the test tutorial when it is finished, so it can be started again.
+     * The previously kept tutorial is deleted. If the steps of the finished
+     * tutorial were updated it no longer matches its script, so it is deleted
+     * instead of kept.
+     *
+     * @param tutorial The finished tutorial.
+     */
+    void keepFinishedTestTutorial(Tutorial* tutorial);
+
+    /**
+     * Emits spanTraced with the given span.
      *
-     * @param tutorial The tutorial to delete.
+     * @param name The name of the span.
+     * @param detail Additional information about the span.
+     * @param stepId The id of the step the span belongs to.
+     * @param start The start of the span, in microseconds.
+     * @param duration The duration of the span, in microseconds.
      */
-    void deleteFinishedTestTutorial(Tutorial* tutorial);
+    void notifySpanAdded(const QString& name, const QString& detail,
+                         const QString& stepId, qint64 start,
+                         qint64 duration);
 
 };
 
@@ -32,6 +32,14 @@ namespace editorsupport {
 EditorSupportAdaptor::EditorSupportAdaptor(EditorSupport* editorSupport):
         QDBusAbstractAdaptor(editorSupport),
     mEditorSupport(editorSupport) {
+    connect(editorSupport,
+            SIGNAL(spanTraced(QString,QString,QString,qlonglong,qlonglong)),
+            this,
+            SIGNAL(spanTraced(QString,QString,QString,qlonglong,qlonglong)));
+}
+
+QString EditorSupportAdaptor::localServerName() const {
+    return mEditorSupport->localServerName();
 }
 
 //public slots:
@@ -52,6 +60,23 @@ void EditorSupportAdaptor::stopHighlighting(int objectId) {
     mEditorSupport->stopHighlighting(objectId);
 }
 
+QVariantMap EditorSupportAdaptor::grabWidget(int objectId, int maxWidth,
+                                             int maxHeight) {
+    QString key;
+    QSize size = mEditorSupport->grabWidget(objectId,
+                                            QSize(maxWidth, maxHeight), &key);
+    if (!size.isValid()) {
+        return QVariantMap();
+    }
+
+    QVariantMap thumbnail;
+    thumbnail.insert("key", key);
+    thumbnail.insert("width", size.width());
+    thumbnail.insert("height", size.height());
+
+    return thumbnail;
+}
+
 void EditorSupportAdaptor::enableEventSpy() {
     mEditorSupport->enableEventSpy();
 }
@@ -60,10 +85,29 @@ void EditorSupportAdaptor::disableEventSpy() {
     mEditorSupport->disableEventSpy();
 }
 
+void EditorSupportAdaptor::enableTracing(bool streamSpans) {
+    mEditorSupport->enableTracing(streamSpans);
+}
+
+void EditorSupportAdaptor::disableTracing() {
+    mEditorSupport->disableTracing();
+}
+
+QString EditorSupportAdaptor::chromeTrace() const {
+    return mEditorSupport->chromeTrace();
+}
+
 void EditorSupportAdaptor::testScriptedTutorial(const QString& filename,
                                                 const QString& stepId) {
     mEditorSupport->testScriptedTutorial(filename, stepId);
 }
 
+bool EditorSupportAdaptor::updateTestScriptedTutorialSteps(
+                                            const QStringList& stepIds,
+                                            const QStringList& stepScripts) {
+    return mEditorSupport->updateTestScriptedTutorialSteps(stepIds,
+                                                           stepScripts);
+}
+
 }
 }
@@ -21,6 +21,8 @@
 #define KTUTORIAL_EDITORSUPPORT_EDITORSUPPORTADAPTOR_H
 
 #include <QDBusAbstractAdaptor>
+#include <QStringList>
+#include <QVariantMap>
 
 namespace ktutorial {
 namespace editorsupport {
@@ -40,6 +42,7 @@ namespace editorsupport {
 class EditorSupportAdaptor: public QDBusAbstractAdaptor {
 Q_OBJECT
 Q_CLASSINFO("D-Bus Interface", "org.kde.ktutorial.EditorSupport")
+Q_PROPERTY(QString localServerName READ localServerName)
 public:
 
     /**
@@ -49,6 +52,14 @@ public:
      */
     explicit EditorSupportAdaptor(EditorSupport* editorSupport);
 
+    /**
+     * Returns the full name of the local socket server.
+     *
+     * @return The full name of the local socket server, or an empty string if
+     *         there is none.
+     */
+    QString localServerName() const;
+
 public Q_SLOTS:
 
     /**
@@ -83,6 +94,21 @@ public Q_SLOTS:
      */
     void stopHighlighting(int objectId);
 
+    /**
+     * Renders a thumbnail of the widget associated to the given id into a
+     * shared memory segment.
+     * The returned map contains the key of the shared memory segment ("key")
+     * and the size of the thumbnail ("width" and "height"). If the thumbnail
+     * could not be rendered, an empty map is returned.
+     *
+     * @param objectId The id of the widget to grab.
+     * @param maxWidth The maximum width of the thumbnail.
+     * @param maxHeight The maximum height of the thumbnail.
+     * @return The key of the shared memory and the size of the thumbnail.
+     * @see EditorSupport::grabWidget(int, QSize, QString*)
+     */
+    QVariantMap grabWidget(int objectId, int maxWidth, int maxHeight);
+
     /**
      * Enables the EventSpy.
      */
@@ -93,6 +119,41 @@ public Q_SLOTS:
      */
     void disableEventSpy();
 
+    /**
+     * Enables the Tracer.
+     *
+     * @param streamSpans True to emit spanTraced for every recorded span, false
+     *        otherwise.
+     */
+    void enableTracing(bool streamSpans);
+
+    /**
+     * Disables the Tracer.
+     */
+    void disableTracing();
+
+    /**
+     * Returns the spans recorded by the Tracer in the Chrome trace event
+     * format.
+     *
+     * @return The JSON document with the recorded spans.
+     */
+    QString chromeTrace() const;
+
+Q_SIGNALS:
+
+    /**
+     * Emitted when the Tracer records a span, if the spans are streamed.
+     *
+     * @param name The name of the span.
+     * @param detail Additional information about the span.
+     * @param stepId The id of the step the span belongs to.
+     * @param start The start of the span, in microseconds.
+     * @param duration The duration of the span, in microseconds.
+     */
+    void spanTraced(const QString& name, const QString& detail,
+                    const QString& stepId, qlonglong start, qlonglong duration);
+
     /**
      * Starts the scripted tutorial stored in the given filename.
      * If a step id is given, the tutorial is changed to that step after
@@ -104,6 +165,16 @@ public Q_SLOTS:
     void testScriptedTutorial(const QString& filename,
                               const QString& stepId = QString());
 
+    /**
+     * Replaces the steps of the scripted tutorial being tested.
+     *
+     * @param stepIds The ids of the steps to replace.
+     * @param stepScripts The scripts that create and add the new steps.
+     * @return True if all the steps were replaced, false otherwise.
+     */
+    bool updateTestScriptedTutorialSteps(const QStringList& stepIds,
+                                         const QStringList& stepScripts);
+
 private:
 
     /**
@@ -18,6 +18,7 @@
 
 #include "EventSpy.h"
 
+#include <QCoreApplication>
 #include <QEvent>
 
 namespace ktutorial {
@@ -25,10 +26,45 @@ namespace editorsupport {
 
 //public:
 
-EventSpy::EventSpy(QObject* parent /*= 0*/): QObject(parent) {
+EventSpy::EventSpy(QObject* parent /*= 0*/,
+                   FilterMode filterMode /*= ObjectFilters*/): QObject(parent),
+    mFilterMode(filterMode),
+    mCacheGeneration(0),
+    mSpiedValidSince(0),
+    mNotSpiedValidSince(0) {
+}
+
+EventSpy::~EventSpy() {
+    if (mFilterMode == ApplicationFilter && QCoreApplication::instance()) {
+        QCoreApplication::instance()->removeEventFilter(this);
+    }
+}
+
+EventSpy::FilterMode EventSpy::filterMode() const {
+    return mFilterMode;
 }
 
 void EventSpy::addObjectToSpy(QObject* object) {
+    if (mFilterMode == ApplicationFilter) {
+        if (mSpiedObjects.contains(object)) {
+            return;
+        }
+
+        if (mSpiedObjects.isEmpty()) {
+            QCoreApplication::instance()->installEventFilter(this);
+        }
+
+        mSpiedObjects.insert(object);
+        connect(object, SIGNAL(destroyed(QObject*)),
+                this, SLOT(removeObjectToSpy(QObject*)));
+
+        //Only the objects that were not spied may have become spied. The stale
+        //entries are not removed now, but computed again when looked up
+        mCacheGeneration++;
+        mNotSpiedValidSince = mCacheGeneration;
+        return;
+    }
+
     object->installEventFilter(this);
 
     foreach (QObject* child, object->children()) {
@@ -39,6 +75,21 @@ void EventSpy::addObjectToSpy(QObject* object) {
 //protected:
 
 bool EventSpy::eventFilter(QObject* object, QEvent* event) {
+    if (mFilterMode == ApplicationFilter) {
+        if (event->type() == QEvent::ChildAdded ||
+                event->type() == QEvent::ChildRemoved) {
+            invalidateCache(static_cast<QChildEvent*>(event)->child());
+        } else if (event->type() == QEvent::ParentChange) {
+            invalidateCache(object);
+        }
+
+        if (isSpied(object)) {
+            emit eventReceived(object, event);
+        }
+
+        return false;
+    }
+
     emit eventReceived(object, event);
 
     if (event->type() == QEvent::ChildAdded) {
@@ -48,5 +99,70 @@ bool EventSpy::eventFilter(QObject* object, QEvent* event) {
     return false;
 }
 
+//private:
+
+bool EventSpy::isSpied(QObject* object) {
+    if (mSpiedObjects.contains(object)) {
+        return true;
+    }
+
+    QObject* parent = object->parent();
+    if (!parent) {
+        return false;
+    }
+
+    QHash<QObject*, CacheEntry>::const_iterator it =
+                                        mSpiedObjectCache.constFind(object);
+    if (it != mSpiedObjectCache.constEnd()) {
+        int validSince = it->mSpied? mSpiedValidSince: mNotSpiedValidSince;
+        if (it->mGeneration >= validSince) {
+            return it->mSpied;
+        }
+    } else {
+        //Children destroyed by their parent do not send a ChildRemoved event,
+        //so the entry is removed when the object itself is destroyed
+        connect(object, SIGNAL(destroyed(QObject*)),
+                this, SLOT(removeFromCache(QObject*)), Qt::UniqueConnection);
+    }
+
+    CacheEntry entry;
+    entry.mSpied = isSpied(parent);
+    entry.mGeneration = mCacheGeneration;
+    mSpiedObjectCache.insert(object, entry);
+
+    return entry.mSpied;
+}
+
+void EventSpy::invalidateCache(QObject* object) {
+    mSpiedObjectCache.remove(object);
+
+    //If a descendant is cached, all its ancestors up to the object are cached
+    //too, unless one of them is spied (and then the descendant is still spied)
+    foreach (QObject* child, object->children()) {
+        if (mSpiedObjectCache.contains(child)) {
+            invalidateCache(child);
+        }
+    }
+}
+
+//private slots:
+
+void EventSpy::removeObjectToSpy(QObject* object) {
+    mSpiedObjects.remove(object);
+
+    //Any cached entry may have become stale
+    mCacheGeneration++;
+    mSpiedValidSince = mCacheGeneration;
+    mNotSpiedValidSince = mCacheGeneration;
+
+    if (mSpiedObjects.isEmpty()) {
+        QCoreApplication::instance()->removeEventFilter(this);
+    }
+}
+
+void EventSpy::removeFromCache(QObject* object) {
+    mSpiedObjectCache.remove(object);
+}
+
 }
 }
@@ -19,7 +19,9 @@
 #ifndef KTUTORIAL_EDITORSUPPORT_EVENTSPY_H
 #define KTUTORIAL_EDITORSUPPORT_EVENTSPY_H
 
+#include <QHash>
 #include <QObject>
+#include <QSet>
 
 namespace ktutorial {
 namespace editorsupport {
@@ -29,20 +31,68 @@ namespace editorsupport {
  * EventSpy emitts a signal whenever an event is received in any of the spied
  * objects or its children (recursively). Even children added to a spied object
  * after it was added are spied.
+ *
+ * The events can be spied in two different ways. In ObjectFilters mode, an
+ * event filter is installed in each spied object and all its descendants. In
+ * ApplicationFilter mode, a single event filter is installed in the
+ * application, and only the events received by the spied objects or their
+ * descendants are notified. Whether an object is a descendant of a spied object
+ * or not is cached. When an object is added to or removed from a parent, only
+ * the cached entries of that object and its descendants are invalidated, and
+ * the entry of an object is removed when the object is destroyed. Adding or
+ * removing a spied object in ApplicationFilter mode just marks the affected
+ * entries as stale, so it depends neither on the number of descendants nor on
+ * the number of cached entries. Destroying the EventSpy leaves no event filter
+ * installed behind.
  */
 class EventSpy: public QObject {
 Q_OBJECT
 public:
 
     /**
-     * Creates a new EventSpy with the given parent.
+     * The way the events are spied.
+     */
+    enum FilterMode {
+
+        /**
+         * An event filter is installed in each spied object and in all its
+         * descendants.
+         */
+        ObjectFilters,
+
+        /**
+         * A single event filter is installed in the application.
+         */
+        ApplicationFilter
+
+    };
+
+    /**
+     * Creates a new EventSpy with the given parent and filter mode.
      *
      * @param parent The parent QObject.
+     * @param filterMode The way the events are spied.
+     */
+    explicit EventSpy(QObject* parent = 0,
+                      FilterMode filterMode = ObjectFilters);
+
+    /**
+     * Destroys this EventSpy.
+     * In ApplicationFilter mode, the event filter is removed from the
+     * application.
      */
-    explicit EventSpy(QObject* parent = 0);
+    virtual ~EventSpy();
+
+    /**
+     * Returns the way the events are spied.
+     *
+     * @return The filter mode.
+     */
+    FilterMode filterMode() const;
 
     /**
      * Add object and all its children to spy.
+     * Adding an object already spied has no effect.
      *
      * @param object The object to spy.
      */
@@ -71,6 +121,94 @@ protected:
      */
     virtual bool eventFilter(QObject* object, QEvent* event);
 
+private:
+
+    /**
+     * The way the events are spied.
+     */
+    FilterMode mFilterMode;
+
+    /**
+     * The objects added to spy in ApplicationFilter mode.
+     */
+    QSet<QObject*> mSpiedObjects;
+
+    /**
+     * A cached result of isSpied(QObject*).
+     */
+    struct CacheEntry {
+
+        /**
+         * Whether the object is a descendant of a spied object or not.
+         */
+        bool mSpied;
+
+        /**
+         * The cache generation when the entry was computed.
+         */
+        int mGeneration;
+
+    };
+
+    /**
+     * Whether an object is a descendant of a spied object or not, in
+     * ApplicationFilter mode.
+     * Only objects with a parent are cached.
+     */
+    QHash<QObject*, CacheEntry> mSpiedObjectCache;
+
+    /**
+     * The current cache generation.
+     * It is increased whenever a spied object is added or removed.
+     */
+    int mCacheGeneration;
+
+    /**
+     * The first generation in which the cached spied entries are valid.
+     */
+    int mSpiedValidSince;
+
+    /**
+     * The first generation in which the cached not spied entries are valid.
+     */
+    int mNotSpiedValidSince;
+
+    /**
+     * Returns whether the given object is a spied object or a descendant of a
+     * spied object.
+     * The result is cached for the object and its ancestors.
+     *
+     * @param object The object to check.
+     * @return True if the object is spied, false otherwise.
+     */
+    bool isSpied(QObject* object);
+
+    /**
+     * Removes the cached entries of the given object and its descendants.
+     * The object does not need to be fully constructed, nor fully destroyed.
+     *
+     * @param object The object whose ancestor chain changed.
+     */
+    void invalidateCache(QObject* object);
+
+private Q_SLOTS:
+
+    /**
+     * Stops spying an object when it is destroyed in ApplicationFilter mode.
+     * If there are no more spied objects, the event filter is removed from the
+     * application.
+     *
+     * @param object The destroyed object.
+     */
+    void removeObjectToSpy(QObject* object);
+
+    /**
+     * Removes the cached entry of a destroyed object.
+     *
+     * @param object The destroyed object.
+     */
+    void removeFromCache(QObject* object);
+
 };
 
 }
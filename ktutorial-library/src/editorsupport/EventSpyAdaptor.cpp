@@ -35,6 +35,8 @@ EventSpyAdaptor::EventSpyAdaptor(EventSpy* eventSpy,
     mObjectRegister(objectRegister) {
     connect(eventSpy, SIGNAL(eventReceived(QObject*,QEvent*)),
             this, SLOT(handleEventReceived(QObject*,QEvent*)));
+    connect(objectRegister, SIGNAL(objectDestroyed(int)),
+            this, SIGNAL(objectDestroyed(int)));
 }
 
 //private:
@@ -47,6 +49,15 @@ void EventSpyAdaptor::handleEventReceived(QObject* object, QEvent* event) {
     QString eventType = eventTypeEnumerator.valueToKey(event->type());
 
     emit eventReceived(id, eventType);
+
+    if (event->type() != QEvent::ChildRemoved) {
+        return;
+    }
+
+    //objectDestroyed(int) is emitted by the register for the child and, later,
+    //for its destroyed descendants
+    QObject* child = static_cast<QChildEvent*>(event)->child();
+    mObjectRegister->releaseIdForDestroyedObject(child);
 }
 
 }
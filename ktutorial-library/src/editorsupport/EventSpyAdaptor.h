@@ -61,6 +61,19 @@ Q_SIGNALS:
      */
     void eventReceived(int objectId, const QString& eventType);
 
+    /**
+     * Emitted when the ObjectRegister releases the id of a destroyed object.
+     * When a registered object that was a child of any of the spied objects or
+     * their children is destroyed, it is emitted right away for that object,
+     * and once the control returns to the event loop for its registered
+     * descendants. The ids of other destroyed objects are reported when the
+     * ObjectRegister finds them. The id of the destroyed object is released,
+     * so it will not be used again.
+     *
+     * @param objectId The id of the destroyed object.
+     */
+    void objectDestroyed(int objectId);
+
 private:
 
     /**
@@ -73,6 +86,8 @@ private Q_SLOTS:
     /**
      * Adapts the eventReceived(QObject*, QEvent*) sent by the EventSpy to be
      * sent as eventReceived(int, QString).
+     * When the event is a ChildRemoved event for a destroyed child, its id is
+     * released, so objectDestroyed(int) is emitted too.
      *
      * @param object The object that received the event.
      * @param event The event received.
@@ -0,0 +1,287 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include "LocalSocketServer.h"
+
+#include <QDataStream>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QStringList>
+
+#include "ClassRegisterAdaptor.h"
+#include "EventSpyAdaptor.h"
+#include "ObjectRegisterAdaptor.h"
+
+/**
+ * The maximum size, in bytes, of the first message of a client.
+ * The authentication request is just the request type and the token, so the
+ * messages bigger than this are rejected before checking the token.
+ */
+const quint32 MAX_AUTHENTICATION_SIZE = 1024;
+
+/**
+ * The maximum size, in bytes, of the messages of an authenticated client.
+ * The requests contain, at most, a class name.
+ */
+const quint32 MAX_REQUEST_SIZE = 64 * 1024;
+
+namespace ktutorial {
+namespace editorsupport {
+
+//public:
+
+LocalSocketServer::LocalSocketServer(
+                            ObjectRegisterAdaptor* objectRegisterAdaptor,
+                            ClassRegisterAdaptor* classRegisterAdaptor,
+                            const QString& token,
+                            QObject* parent /*= 0*/): QObject(parent),
+    mObjectRegisterAdaptor(objectRegisterAdaptor),
+    mClassRegisterAdaptor(classRegisterAdaptor),
+    mEventSpyAdaptor(0),
+    mToken(token) {
+    mServer = new QLocalServer(this);
+    connect(mServer, SIGNAL(newConnection()),
+            this, SLOT(handleNewConnection()));
+}
+
+bool LocalSocketServer::listen(const QString& name) {
+    return mServer->listen(name);
+}
+
+QString LocalSocketServer::serverName() const {
+    if (!mServer->isListening()) {
+        return "";
+    }
+
+    return mServer->fullServerName();
+}
+
+void LocalSocketServer::setEventSpyAdaptor(EventSpyAdaptor* eventSpyAdaptor) {
+    if (mEventSpyAdaptor) {
+        disconnect(mEventSpyAdaptor, 0, this, 0);
+    }
+
+    mEventSpyAdaptor = eventSpyAdaptor;
+
+    if (mEventSpyAdaptor) {
+        connect(mEventSpyAdaptor, SIGNAL(eventReceived(int,QString)),
+                this, SLOT(handleEventReceived(int,QString)));
+        connect(mEventSpyAdaptor, SIGNAL(objectDestroyed(int)),
+                this, SLOT(handleObjectDestroyed(int)));
+    }
+}
+
+//private:
+
+void LocalSocketServer::handleAuthentication(QLocalSocket* socket,
+                                             const QByteArray& request) {
+    QDataStream in(request);
+    in.setVersion(QDataStream::Qt_4_6);
+
+    quint8 requestType;
+    QString token;
+    in >> requestType >> token;
+
+    if (requestType != AuthenticateRequest || mToken.isEmpty() ||
+            token != mToken) {
+        socket->abort();
+        return;
+    }
+
+    mAuthenticatedSockets.append(socket);
+
+    QByteArray reply;
+    QDataStream out(&reply, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ReplyMessage << true;
+
+    writeMessage(socket, reply);
+}
+
+void LocalSocketServer::handleRequest(QLocalSocket* socket,
+                                      const QByteArray& request) {
+    QDataStream in(request);
+    in.setVersion(QDataStream::Qt_4_6);
+
+    quint8 requestType;
+    in >> requestType;
+
+    if (requestType == SubscribeToEventsRequest) {
+        if (!mSubscribedSockets.contains(socket)) {
+            mSubscribedSockets.append(socket);
+        }
+        return;
+    }
+
+    QByteArray reply;
+    QDataStream out(&reply, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ReplyMessage;
+
+    if (requestType == ObjectNameRequest ||
+            requestType == ClassNameRequest ||
+            requestType == ChildObjectIdsRequest) {
+        qint32 objectId;
+        in >> objectId;
+
+        if (requestType == ObjectNameRequest) {
+            out << mObjectRegisterAdaptor->objectName(objectId);
+        } else if (requestType == ClassNameRequest) {
+            out << mObjectRegisterAdaptor->className(objectId);
+        } else {
+            QList<qint32> childObjectIds;
+            foreach (int id, mObjectRegisterAdaptor->childObjectIds(objectId)) {
+                childObjectIds.append(id);
+            }
+            out << childObjectIds;
+        }
+    } else if (requestType == SuperClassRequest ||
+            requestType == PropertyListRequest ||
+            requestType == SignalListRequest) {
+        QString className;
+        in >> className;
+
+        if (requestType == SuperClassRequest) {
+            out << mClassRegisterAdaptor->superClass(className);
+        } else if (requestType == PropertyListRequest) {
+            out << mClassRegisterAdaptor->propertyList(className);
+        } else {
+            out << mClassRegisterAdaptor->signalList(className);
+        }
+    } else if (requestType == ClassHierarchyRequest) {
+        out << mClassRegisterAdaptor->classHierarchy();
+    } else {
+        //Unknown requests are answered with an error to keep the replies in
+        //the same order as the requests
+        QByteArray error;
+        QDataStream errorStream(&error, QIODevice::WriteOnly);
+        errorStream.setVersion(QDataStream::Qt_4_6);
+        errorStream << (quint8)ErrorMessage
+                    << QString("Unknown request: %1").arg(requestType);
+
+        writeMessage(socket, error);
+        return;
+    }
+
+    writeMessage(socket, reply);
+}
+
+void LocalSocketServer::writeMessage(QLocalSocket* socket,
+                                     const QByteArray& message) {
+    QDataStream out(socket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << message;
+}
+
+//private slots:
+
+void LocalSocketServer::handleNewConnection() {
+    while (mServer->hasPendingConnections()) {
+        QLocalSocket* socket = mServer->nextPendingConnection();
+        connect(socket, SIGNAL(readyRead()), this, SLOT(handleReadyRead()));
+        connect(socket, SIGNAL(disconnected()),
+                this, SLOT(handleDisconnected()));
+    }
+}
+
+void LocalSocketServer::handleReadyRead() {
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    Q_ASSERT(socket);
+
+    QDataStream in(socket);
+    in.setVersion(QDataStream::Qt_4_6);
+
+    //Only complete messages are read; the rest is kept in the socket buffer
+    //until more data is received
+    while (socket->bytesAvailable() >= (qint64)sizeof(quint32)) {
+        QByteArray sizeData = socket->peek(sizeof(quint32));
+        QDataStream sizeStream(sizeData);
+        quint32 size;
+        sizeStream >> size;
+
+        //The length is checked before waiting for the rest of the message, so
+        //a client can not make the server buffer an arbitrary amount of data.
+        //A null QByteArray (0xFFFFFFFF) is never sent by a valid client
+        bool authenticated = mAuthenticatedSockets.contains(socket);
+        quint32 maximumSize = authenticated? MAX_REQUEST_SIZE:
+                                             MAX_AUTHENTICATION_SIZE;
+        if (size > maximumSize) {
+            socket->abort();
+            return;
+        }
+
+        if (socket->bytesAvailable() < (qint64)(sizeof(quint32) + size)) {
+            return;
+        }
+
+        QByteArray request;
+        in >> request;
+
+        if (!authenticated) {
+            handleAuthentication(socket, request);
+            if (!mAuthenticatedSockets.contains(socket)) {
+                return;
+            }
+        } else {
+            handleRequest(socket, request);
+        }
+    }
+}
+
+void LocalSocketServer::handleDisconnected() {
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    Q_ASSERT(socket);
+
+    mAuthenticatedSockets.removeAll(socket);
+    mSubscribedSockets.removeAll(socket);
+    socket->deleteLater();
+}
+
+void LocalSocketServer::handleEventReceived(int objectId,
+                                            const QString& eventType) {
+    if (mSubscribedSockets.isEmpty()) {
+        return;
+    }
+
+    QByteArray event;
+    QDataStream out(&event, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)EventReceivedMessage << (qint32)objectId << eventType;
+
+    foreach (QLocalSocket* socket, mSubscribedSockets) {
+        writeMessage(socket, event);
+    }
+}
+
+void LocalSocketServer::handleObjectDestroyed(int objectId) {
+    if (mSubscribedSockets.isEmpty()) {
+        return;
+    }
+
+    QByteArray message;
+    QDataStream out(&message, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)ObjectDestroyedMessage << (qint32)objectId;
+
+    foreach (QLocalSocket* socket, mSubscribedSockets) {
+        writeMessage(socket, message);
+    }
+}
+
+}
+}
@@ -0,0 +1,247 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef KTUTORIAL_EDITORSUPPORT_LOCALSOCKETSERVER_H
+#define KTUTORIAL_EDITORSUPPORT_LOCALSOCKETSERVER_H
+
+#include <QList>
+#include <QObject>
+#include <QString>
+
+class QLocalServer;
+class QLocalSocket;
+
+namespace ktutorial {
+namespace editorsupport {
+class ClassRegisterAdaptor;
+class EventSpyAdaptor;
+class ObjectRegisterAdaptor;
+}
+}
+
+namespace ktutorial {
+namespace editorsupport {
+
+/**
+ * Local socket server to expose the ObjectRegister, the ClassRegister and the
+ * EventSpy without going through the D-Bus session bus.
+ * The data provided is the same provided by the D-Bus adaptors, but the
+ * messages are sent directly to the client (KTutorial editor) using a compact
+ * binary protocol, so they do not pay for D-Bus marshalling and the hop
+ * through the bus daemon. D-Bus is still used to discover the server, as its
+ * name is advertised by EditorSupport through a D-Bus property.
+ *
+ * Anyone in the system able to connect to the server could inspect the
+ * application, so the server name should be unguessable and each client has
+ * to authenticate before any other request is served. The first message of a
+ * client must be an AuthenticateRequest with the token given to the server;
+ * otherwise, the client is disconnected. Clients that send a message bigger
+ * than the maximum size are disconnected too, as soon as the length of the
+ * message is received. The maximum size of the authentication request is much
+ * smaller than the maximum size of the other requests.
+ *
+ * Every message, in both directions, is a QByteArray serialized with
+ * QDataStream (so it is prefixed by its length as a 32 bit integer). The
+ * message starts with a byte that identifies the request or the message type,
+ * followed by its arguments or values, also serialized with QDataStream:
+ * -Requests: the Request value followed by the object id (a 32 bit integer)
+ *  for ObjectName, ClassName and ChildObjectIds, the class name (a QString)
+ *  for SuperClass, PropertyList and SignalList, or the token (a QString) for
+ *  Authenticate. SubscribeToEvents and ClassHierarchy have no arguments.
+ * -Replies: ReplyMessage followed by the returned value (a QString, a
+ *  QList<qint32>, a QStringList, a QVariantMap for ClassHierarchy, or true for
+ *  Authenticate), or ErrorMessage followed by a description of the error (a
+ *  QString) for unknown requests. Requests are answered in the same order
+ *  they are received. SubscribeToEvents has no reply.
+ * -Events: EventReceivedMessage followed by the object id and the event type
+ *  (a QString), or ObjectDestroyedMessage followed by the id of the destroyed
+ *  object. They are sent only to the clients subscribed to the events, and
+ *  only while the EventSpy is enabled.
+ *
+ * @see EditorSupport
+ */
+class LocalSocketServer: public QObject {
+Q_OBJECT
+public:
+
+    /**
+     * The requests that can be sent to the server.
+     */
+    enum Request {
+        ObjectNameRequest = 1,
+        ClassNameRequest = 2,
+        ChildObjectIdsRequest = 3,
+        SuperClassRequest = 4,
+        PropertyListRequest = 5,
+        SignalListRequest = 6,
+        SubscribeToEventsRequest = 7,
+        AuthenticateRequest = 8,
+        ClassHierarchyRequest = 9
+    };
+
+    /**
+     * The messages that can be sent by the server.
+     */
+    enum Message {
+        ReplyMessage = 1,
+        EventReceivedMessage = 2,
+        ObjectDestroyedMessage = 3,
+        ErrorMessage = 4
+    };
+
+    /**
+     * Creates a new LocalSocketServer for the given adaptors.
+     * The clients have to authenticate with the given token.
+     *
+     * @param objectRegisterAdaptor The adaptor to answer the object requests.
+     * @param classRegisterAdaptor The adaptor to answer the class requests.
+     * @param token The token the clients have to authenticate with.
+     * @param parent The parent QObject.
+     */
+    LocalSocketServer(ObjectRegisterAdaptor* objectRegisterAdaptor,
+                      ClassRegisterAdaptor* classRegisterAdaptor,
+                      const QString& token, QObject* parent = 0);
+
+    /**
+     * Starts listening for clients with the given server name.
+     * If there is already a server with that name, listening fails. The
+     * existing server is never removed, as it may belong to another process.
+     *
+     * @param name The name of the server.
+     * @return True if the server is listening, false otherwise.
+     */
+    bool listen(const QString& name);
+
+    /**
+     * Returns the full name of the server the clients have to connect to.
+     * If the server is not listening, an empty string is returned.
+     *
+     * @return The full name of the server.
+     */
+    QString serverName() const;
+
+    /**
+     * Sets the adaptor of the EventSpy to send its events to the subscribed
+     * clients.
+     * A null pointer stops sending events.
+     *
+     * @param eventSpyAdaptor The adaptor of the EventSpy.
+     */
+    void setEventSpyAdaptor(EventSpyAdaptor* eventSpyAdaptor);
+
+private:
+
+    /**
+     * The local server.
+     */
+    QLocalServer* mServer;
+
+    /**
+     * The adaptor to answer the object requests.
+     */
+    ObjectRegisterAdaptor* mObjectRegisterAdaptor;
+
+    /**
+     * The adaptor to answer the class requests.
+     */
+    ClassRegisterAdaptor* mClassRegisterAdaptor;
+
+    /**
+     * The adaptor of the EventSpy, if any.
+     */
+    EventSpyAdaptor* mEventSpyAdaptor;
+
+    /**
+     * The token the clients have to authenticate with.
+     */
+    QString mToken;
+
+    /**
+     * The clients that sent the right token.
+     */
+    QList<QLocalSocket*> mAuthenticatedSockets;
+
+    /**
+     * The clients subscribed to the events.
+     */
+    QList<QLocalSocket*> mSubscribedSockets;
+
+    /**
+     * Checks the authentication request sent by a client.
+     * If the request is not an AuthenticateRequest with the right token, the
+     * client is disconnected.
+     *
+     * @param socket The client that sent the request.
+     * @param request The request.
+     */
+    void handleAuthentication(QLocalSocket* socket, const QByteArray& request);
+
+    /**
+     * Answers the given request from the given client.
+     *
+     * @param socket The client that sent the request.
+     * @param request The request.
+     */
+    void handleRequest(QLocalSocket* socket, const QByteArray& request);
+
+    /**
+     * Writes the given message to the given client, prefixed by its length.
+     *
+     * @param socket The client to write the message to.
+     * @param message The message to write.
+     */
+    void writeMessage(QLocalSocket* socket, const QByteArray& message);
+
+private Q_SLOTS:
+
+    /**
+     * Sets up the new clients.
+     */
+    void handleNewConnection();
+
+    /**
+     * Reads and answers all the complete requests sent by the client.
+     */
+    void handleReadyRead();
+
+    /**
+     * Forgets the disconnected client.
+     */
+    void handleDisconnected();
+
+    /**
+     * Sends the event to the subscribed clients.
+     *
+     * @param objectId The id of the object that received the event.
+     * @param eventType The type of the event.
+     */
+    void handleEventReceived(int objectId, const QString& eventType);
+
+    /**
+     * Sends the object destruction to the subscribed clients.
+     *
+     * @param objectId The id of the destroyed object.
+     */
+    void handleObjectDestroyed(int objectId);
+
+};
+
+}
+}
+
+#endif
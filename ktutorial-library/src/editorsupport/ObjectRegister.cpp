@@ -19,13 +19,16 @@
 
 #include "ObjectRegister.h"
 
+#include <QMetaProperty>
+
 namespace ktutorial {
 namespace editorsupport {
 
 //public:
 
 ObjectRegister::ObjectRegister(QObject* parent /*= 0*/): QObject(parent),
-    mNextId(1) {
+    mSweepThreshold(64),
+    mSweepScheduled(false) {
 }
 
 int ObjectRegister::idForObject(QObject* object) {
@@ -34,54 +37,215 @@ int ObjectRegister::idForObject(QObject* object) {
     }
 
     int id = mRegisteredIds.value(object);
+    if (id) {
+        Slot* slot = slotForId(id);
+        if (slot && slot->mObject.data() == object) {
+            return id;
+        }
+
+        //The registered object was destroyed and a new object was created at
+        //the same address
+        if (slot) {
+            freeSlot(id & IndexMask);
+            emit objectDestroyed(id);
+        }
+    }
 
+    id = allocateSlot(object);
     if (!id) {
-        id = mNextId;
-        mRegisteredObjects.insert(id, object);
-        mRegisteredIds.insert(object, id);
-        connect(object, SIGNAL(destroyed(QObject*)),
-                this, SLOT(deregister(QObject*)));
-        mNextId++;
-
-        registerMetaObject(object->metaObject());
+        mRegisteredIds.remove(object);
+        return 0;
     }
 
+    mRegisteredIds.insert(object, id);
+
+    registerMetaObject(object->metaObject());
+
     return id;
 }
 
 QObject* ObjectRegister::objectForId(int objectId) {
-    return mRegisteredObjects.value(objectId);
+    Slot* slot = slotForId(objectId);
+    if (!slot) {
+        return 0;
+    }
+
+    return slot->mObject.data();
+}
+
+int ObjectRegister::releaseIdForDestroyedObject(QObject* object) {
+    int id = mRegisteredIds.value(object);
+    if (!id) {
+        return 0;
+    }
+
+    Slot* slot = slotForId(id);
+    if (slot && !slot->mObject.isNull()) {
+        return 0;
+    }
+
+    //QObject destructor clears the weak pointers before notifying the parent
+    //that the child was removed, so a null pointer means that the object is
+    //being destroyed
+    if (slot) {
+        freeSlot(id & IndexMask);
+    }
+    mRegisteredIds.remove(object);
+
+    //The registered descendants of the object, if any, were destroyed too
+    if (!mSweepScheduled) {
+        mSweepScheduled = true;
+        QMetaObject::invokeMethod(this, "sweepDestroyedObjects",
+                                  Qt::QueuedConnection);
+    }
+
+    emit objectDestroyed(id);
+
+    return id;
 }
 
 const QMetaObject* ObjectRegister::metaObjectForClassName(
                                             const QString& className) const {
-    return mRegisteredMetaObjects.value(className);
+    return mRegisteredClasses.value(className).mMetaObject;
+}
+
+QStringList ObjectRegister::propertyListForClassName(
+                                            const QString& className) const {
+    return mRegisteredClasses.value(className).mPropertyList;
+}
+
+QStringList ObjectRegister::signalListForClassName(
+                                            const QString& className) const {
+    return mRegisteredClasses.value(className).mSignalList;
+}
+
+QStringList ObjectRegister::registeredClassNames() const {
+    return mRegisteredClasses.keys();
 }
 
 void ObjectRegister::clear() {
+    foreach (int id, mRegisteredIds) {
+        freeSlot(id & IndexMask);
+    }
+
     mRegisteredIds.clear();
-    mRegisteredObjects.clear();
-    mRegisteredMetaObjects.clear();
+    mRegisteredClasses.clear();
 }
 
 void ObjectRegister::registerMetaObject(const QMetaObject* metaObject) {
-    if (mRegisteredMetaObjects.contains(metaObject->className())) {
+    if (mRegisteredClasses.contains(metaObject->className())) {
         return;
     }
 
-    mRegisteredMetaObjects.insert(metaObject->className(), metaObject);
+    //Only the members after the offsets are defined in the class, although
+    //they could redefine a member of a super class
+    const QMetaObject* superClass = metaObject->superClass();
+
+    RegisteredClass registeredClass;
+    registeredClass.mMetaObject = metaObject;
+
+    for (int i = metaObject->propertyOffset();
+            i < metaObject->propertyCount(); ++i) {
+        QMetaProperty property = metaObject->property(i);
+        if (!superClass || superClass->indexOfProperty(property.name()) == -1) {
+            registeredClass.mPropertyList.append(property.name());
+        }
+    }
+
+    for (int i = metaObject->methodOffset();
+            i < metaObject->methodCount(); ++i) {
+        QMetaMethod method = metaObject->method(i);
+        if (method.methodType() == QMetaMethod::Signal &&
+                (!superClass ||
+                 superClass->indexOfSignal(method.signature()) == -1)) {
+            registeredClass.mSignalList.append(method.signature());
+        }
+    }
+
+    mRegisteredClasses.insert(metaObject->className(), registeredClass);
 
     if (metaObject->superClass()) {
         registerMetaObject(metaObject->superClass());
     }
 }
 
+//private:
+
+ObjectRegister::Slot* ObjectRegister::slotForId(int objectId) {
+    int index = objectId & IndexMask;
+    int generation = objectId >> IndexBits;
+
+    if (objectId <= 0 || index >= mSlots.count() ||
+            mSlots[index].mGeneration != generation) {
+        return 0;
+    }
+
+    return &mSlots[index];
+}
+
+int ObjectRegister::allocateSlot(QObject* object) {
+    if (mFreeSlots.isEmpty() &&
+            mSlots.count() - mFreeSlots.count() >= mSweepThreshold) {
+        sweepDestroyedObjects();
+        mSweepThreshold = qMax(mSweepThreshold, 2 * mRegisteredIds.count());
+    }
+
+    int index;
+    if (!mFreeSlots.isEmpty()) {
+        index = mFreeSlots.last();
+        mFreeSlots.pop_back();
+    } else if (mSlots.count() >= IndexMask) {
+        return 0;
+    } else {
+        Slot slot;
+        slot.mGeneration = 1;
+        mSlots.append(slot);
+        index = mSlots.count() - 1;
+    }
+
+    mSlots[index].mObject = object;
+
+    return (mSlots[index].mGeneration << IndexBits) | index;
+}
+
+void ObjectRegister::freeSlot(int index) {
+    Slot& slot = mSlots[index];
+    slot.mObject.clear();
+    slot.mGeneration++;
+
+    //Reusing the slot would wrap the generation around, and the new ids would
+    //be the same as the old ones
+    if (slot.mGeneration > MaximumGeneration) {
+        return;
+    }
+
+    mFreeSlots.append(index);
+}
+
 //private slots:
 
-void ObjectRegister::deregister(QObject* object) {
-    int id = mRegisteredIds.value(object);
-    mRegisteredIds.remove(object);
-    mRegisteredObjects.remove(id);
+void ObjectRegister::sweepDestroyedObjects() {
+    mSweepScheduled = false;
+
+    QList<int> destroyedIds;
+
+    QMutableHashIterator<QObject*, int> it(mRegisteredIds);
+    while (it.hasNext()) {
+        it.next();
+
+        int index = it.value() & IndexMask;
+        if (mSlots[index].mObject.isNull()) {
+            destroyedIds.append(it.value());
+            freeSlot(index);
+            it.remove();
+        }
+    }
+
+    //Emitted once the register is consistent again, as the receivers could
+    //register new objects
+    foreach (int id, destroyedIds) {
+        emit objectDestroyed(id);
+    }
 }
 
 }
@@ -22,6 +22,9 @@
 
 #include <QHash>
 #include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <QWeakPointer>
 
 namespace ktutorial {
 namespace editorsupport {
@@ -35,10 +38,25 @@ namespace editorsupport {
  *
  * When an object is registered, its QMetaObject and the QMetaObject of all its
  * super classes are also registered. The QMetaObject can be got using the class
- * name since then until the register is cleared.
+ * name since then until the register is cleared. The properties and signals
+ * defined in each class (but not inherited from its super classes) are also
+ * computed once, when the class is registered.
  *
  * Its purpose is assign QObjects an id to allow the remote KTutorial editor to
  * refer to the objects in the target application.
+ *
+ * The objects are stored in a table of slots. Each id encodes the index of the
+ * slot and the generation of the slot when the object was registered; when an
+ * object is destroyed its slot is eventually reused with a new generation, so
+ * the ids of destroyed objects are detected as stale just comparing the
+ * generation, even if the slot was reused. Once the generation of a slot
+ * reaches its maximum value the slot is retired instead of reused, so an id is
+ * never assigned twice. If there are no free slots left, the objects can not be
+ * registered, and their id is 0 like the id of the null object. Destroyed
+ * objects are tracked with weak pointers, which are checked lazily, instead of
+ * with a connection to the destroyed(QObject*) signal of each registered
+ * object. Whenever the id of a destroyed object is released,
+ * objectDestroyed(int) is emitted.
  */
 class ObjectRegister: public QObject {
 Q_OBJECT
@@ -53,6 +71,8 @@ public:
 
     /**
      * Returns the id assigned to the object.
+     * If the object is not registered yet and there are no free slots left, 0
+     * is returned.
      *
      * @param object The object to get its id.
      * @return The id assigned to the object.
@@ -67,6 +87,22 @@ public:
      */
     QObject* objectForId(int objectId);
 
+    /**
+     * Releases the id of the given object if it was registered and it is being
+     * (or it was already) destroyed.
+     * The released id is never returned again, not even for other objects
+     * created later at the same address.
+     *
+     * The descendants of a destroyed object are destroyed without notifying
+     * their parent, so once the control returns to the event loop the ids of
+     * all the destroyed objects are released too.
+     *
+     * @param object The object to release its id.
+     * @return The released id, or 0 if the object was not registered or it was
+     *         not destroyed.
+     */
+    int releaseIdForDestroyedObject(QObject* object);
+
     /**
      * Returns the meta object with the given class name.
      *
@@ -75,6 +111,33 @@ public:
      */
     const QMetaObject* metaObjectForClassName(const QString& className) const;
 
+    /**
+     * Returns the properties defined in the class with the given name.
+     * Properties inherited from the super classes are not included. If the
+     * class is not registered, an empty list is returned.
+     *
+     * @param className The class name to get its properties.
+     * @return The properties defined in the class.
+     */
+    QStringList propertyListForClassName(const QString& className) const;
+
+    /**
+     * Returns the signals defined in the class with the given name.
+     * Signals inherited from the super classes are not included. If the class
+     * is not registered, an empty list is returned.
+     *
+     * @param className The class name to get its signals.
+     * @return The signals defined in the class.
+     */
+    QStringList signalListForClassName(const QString& className) const;
+
+    /**
+     * Returns the names of all the registered classes.
+     *
+     * @return The names of the registered classes.
+     */
+    QStringList registeredClassNames() const;
+
     /**
      * Removes all the entries in this ObjectRegister.
      */
@@ -87,36 +150,146 @@ public:
      */
     void registerMetaObject(const QMetaObject* metaObject);
 
+Q_SIGNALS:
+
+    /**
+     * Emitted when the id of a destroyed object is released.
+     *
+     * @param objectId The id of the destroyed object.
+     */
+    void objectDestroyed(int objectId);
+
 private:
 
     /**
-     * The next id to assign.
+     * An entry of the slot table.
      */
-    int mNextId;
+    struct Slot {
+
+        /**
+         * The object registered in the slot, if any.
+         */
+        QWeakPointer<QObject> mObject;
+
+        /**
+         * The generation of the slot, increased each time the slot is freed.
+         * A slot whose generation is beyond the maximum is retired.
+         */
+        int mGeneration;
+
+    };
+
+    /**
+     * The data of a registered class.
+     */
+    struct RegisteredClass {
+
+        /**
+         * The meta object of the class.
+         */
+        const QMetaObject* mMetaObject;
+
+        /**
+         * The names of the properties defined in the class.
+         */
+        QStringList mPropertyList;
+
+        /**
+         * The signatures of the signals defined in the class.
+         */
+        QStringList mSignalList;
+
+        /**
+         * Creates a new RegisteredClass.
+         */
+        RegisteredClass():
+            mMetaObject(0) {
+        }
+
+    };
+
+    /**
+     * The number of bits of an id used for the index of the slot.
+     * The rest of the bits are used for the generation of the slot.
+     */
+    static const int IndexBits = 20;
+
+    /**
+     * The mask to get the index of the slot from an id.
+     */
+    static const int IndexMask = (1 << IndexBits) - 1;
+
+    /**
+     * The maximum generation of a slot before it is retired.
+     */
+    static const int MaximumGeneration = (1 << (31 - IndexBits)) - 1;
+
+    /**
+     * The slot table.
+     */
+    QVector<Slot> mSlots;
+
+    /**
+     * The indexes of the slots that can be reused.
+     */
+    QVector<int> mFreeSlots;
+
+    /**
+     * The number of used slots that triggers looking for destroyed objects
+     * before growing the slot table.
+     */
+    int mSweepThreshold;
+
+    /**
+     * Whether sweepDestroyedObjects() was queued to be called or not.
+     */
+    bool mSweepScheduled;
 
     /**
      * The registered ids mapped by associated object.
+     * The entries of destroyed objects are removed lazily.
      */
     QHash<QObject*, int> mRegisteredIds;
 
     /**
-     * The registered objects mapped by id.
+     * The registered classes mapped by their class name.
      */
-    QHash<int, QObject*> mRegisteredObjects;
+    QHash<QString, RegisteredClass> mRegisteredClasses;
 
     /**
-     * The registered meta objects mapped by their class name.
+     * Returns the slot referred to by the given id, if it is not stale.
+     *
+     * @param objectId The id of the slot.
+     * @return The slot, or a null pointer if the id is stale or invalid.
      */
-    QHash<QString, const QMetaObject*> mRegisteredMetaObjects;
+    Slot* slotForId(int objectId);
 
-private Q_SLOTS:
+    /**
+     * Returns a new id for the given object, reusing a free slot if possible.
+     * If there are no free slots and the slot table can not grow, 0 is
+     * returned.
+     *
+     * @param object The object to store in the slot.
+     * @return The id for the object, or 0 if there are no slots left.
+     */
+    int allocateSlot(QObject* object);
 
     /**
-     * Deregisters an object automatically when it is destroyed.
+     * Frees the slot at the given index, increasing its generation.
+     * If the generation goes beyond the maximum, the slot is retired instead
+     * of made available again.
      *
-     * @param object The object to deregister.
+     * @param index The index of the slot.
+     */
+    void freeSlot(int index);
+
+private Q_SLOTS:
+
+    /**
+     * Frees the slots of the objects that were destroyed.
+     * objectDestroyed(int) is emitted for each of them.
      */
-    void deregister(QObject* object);
+    void sweepDestroyedObjects();
 
 };
 
@@ -0,0 +1,81 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include "DeferredTutorialLoader.h"
+
+#include <QTimer>
+#include <QtConcurrentRun>
+
+namespace ktutorial {
+namespace scripting {
+
+//public:
+
+DeferredTutorialLoader::DeferredTutorialLoader(TutorialManager* tutorialManager,
+                                               QObject* parent /*= 0*/):
+        QObject(parent),
+    mTutorialManager(tutorialManager) {
+    Q_ASSERT(tutorialManager);
+
+    connect(&mFutureWatcher, SIGNAL(finished()),
+            this, SLOT(handleTutorialScriptsFound()));
+}
+
+DeferredTutorialLoader::~DeferredTutorialLoader() {
+    mFutureWatcher.waitForFinished();
+}
+
+//public slots:
+
+void DeferredTutorialLoader::start() {
+    //KStandardDirs and KConfig are not thread safe, so the directories and the
+    //index are resolved in the GUI thread; the worker thread gets plain data
+    QStringList directories = mScriptManager.tutorialDirectories();
+    if (!directories.isEmpty()) {
+        mScriptManager.openIndex();
+    }
+
+    mFutureWatcher.setFuture(QtConcurrent::run(&ScriptManager::findScriptFiles,
+                                               directories));
+}
+
+//private slots:
+
+void DeferredTutorialLoader::handleTutorialScriptsFound() {
+    mPendingScriptFiles = mFutureWatcher.result();
+
+    QTimer::singleShot(0, this, SLOT(loadNextTutorial()));
+}
+
+void DeferredTutorialLoader::loadNextTutorial() {
+    if (mPendingScriptFiles.isEmpty()) {
+        mScriptManager.saveIndex();
+        emit finished();
+        return;
+    }
+
+    TutorialScript tutorialScript;
+    if (mScriptManager.examineScriptFile(mPendingScriptFiles.takeFirst(),
+                                         &tutorialScript)) {
+        mScriptManager.loadTutorialScript(mTutorialManager, tutorialScript);
+    }
+
+    QTimer::singleShot(0, this, SLOT(loadNextTutorial()));
+}
+
+}
+}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#ifndef KTUTORIAL_SCRIPTING_DEFERREDTUTORIALLOADER_H
+#define KTUTORIAL_SCRIPTING_DEFERREDTUTORIALLOADER_H
+
+#include <QFutureWatcher>
+#include <QObject>
+
+#include "ScriptManager.h"
+
+namespace ktutorial {
+class TutorialManager;
+}
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * Loads the scripted tutorials without blocking the GUI thread.
+ * When the DeferredTutorialLoader is started, the tutorial directories are
+ * resolved and the TutorialIndex opened in the GUI thread, and then the
+ * directories are listed in a worker thread. Once the script files are found,
+ * each of them is examined and its tutorial loaded in the GUI thread, one
+ * script file each time the event loop is idle, so the application can handle
+ * its events (like painting the main window) between them.
+ *
+ * Only the directory listing is done in the worker thread. The scripts are
+ * not parsed there: reading the index and the side-car files, and executing
+ * the scripts without a side-car file, use KDE and Kross services that are not
+ * thread safe, so they are done in the GUI thread, one script file at a time.
+ *
+ * The tutorials are registered in the TutorialManager as soon as they are
+ * loaded, so TutorialManager::tutorialRegistered(const TutorialInformation*)
+ * signal can be used to know when a new tutorial is available. When all the
+ * tutorials were loaded, finished() signal is emitted.
+ *
+ * @see ScriptManager
+ */
+class DeferredTutorialLoader: public QObject {
+Q_OBJECT
+public:
+
+    /**
+     * Creates a new DeferredTutorialLoader.
+     *
+     * @param tutorialManager The TutorialManager to load the tutorials into.
+     * @param parent The parent object.
+     */
+    explicit DeferredTutorialLoader(TutorialManager* tutorialManager,
+                                    QObject* parent = 0);
+
+    /**
+     * Destroys this DeferredTutorialLoader.
+     * If the script files are still being found, it waits for the worker
+     * thread to end.
+     */
+    virtual ~DeferredTutorialLoader();
+
+public Q_SLOTS:
+
+    /**
+     * Starts loading the tutorials.
+     */
+    void start();
+
+Q_SIGNALS:
+
+    /**
+     * Emitted when all the tutorials were loaded.
+     */
+    void finished();
+
+private:
+
+    /**
+     * The TutorialManager to load the tutorials into.
+     */
+    TutorialManager* mTutorialManager;
+
+    /**
+     * The ScriptManager that finds and loads the tutorials.
+     */
+    ScriptManager mScriptManager;
+
+    /**
+     * The watcher for the worker thread that finds the script files.
+     */
+    QFutureWatcher<QStringList> mFutureWatcher;
+
+    /**
+     * The names of the script files found but not loaded yet.
+     */
+    QStringList mPendingScriptFiles;
+
+private Q_SLOTS:
+
+    /**
+     * Schedules the loading of the script files found.
+     */
+    void handleTutorialScriptsFound();
+
+    /**
+     * Examines the next pending script file and loads its tutorial, if any,
+     * and schedules the script file after it.
+     * When there are no more pending script files, the index is saved and
+     * finished() is emitted.
+     */
+    void loadNextTutorial();
+
+};
+
+}
+}
+
+#endif
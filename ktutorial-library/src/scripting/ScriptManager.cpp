@@ -20,11 +20,17 @@
 #include "ScriptManager.h"
 
 #include <QDir>
+#include <QFile>
 
+#include <KComponentData>
 #include <KDebug>
+#include <KDesktopFile>
 #include <KStandardDirs>
+#include <kross/core/manager.h>
 
 #include "ScriptedTutorial.h"
+#include "TutorialIndex.h"
+#include "../TutorialInformation.h"
 #include "../TutorialManager.h"
 
 namespace ktutorial {
@@ -36,43 +42,181 @@ namespace scripting {
 
 //public:
 
-ScriptManager::ScriptManager() {
+ScriptManager::ScriptManager():
+    mTutorialIndex(0) {
 }
 
 ScriptManager::~ScriptManager() {
+    delete mTutorialIndex;
 }
 
 void ScriptManager::loadTutorials(TutorialManager* tutorialManager) {
     Q_ASSERT(tutorialManager);
 
+    QList<TutorialScript> tutorialScripts = findTutorialScripts();
+    for (int i=0; i<tutorialScripts.count(); ++i) {
+        loadTutorialScript(tutorialManager, tutorialScripts[i]);
+    }
+
+    saveIndex();
+}
+
+QList<TutorialScript> ScriptManager::findTutorialScripts() {
+    QList<TutorialScript> tutorialScripts;
+
+    QStringList directories = tutorialDirectories();
+    if (directories.count() == 0) {
+        return tutorialScripts;
+    }
+
+    openIndex();
+
+    QStringList fileNames = findScriptFiles(directories);
+    for (int i=0; i<fileNames.count(); ++i) {
+        TutorialScript tutorialScript;
+        if (examineScriptFile(fileNames[i], &tutorialScript)) {
+            tutorialScripts.append(tutorialScript);
+        }
+    }
+
+    return tutorialScripts;
+}
+
+QStringList ScriptManager::tutorialDirectories() const {
+    QStringList directories;
+
     QStringList baseDirectories = KGlobal::dirs()->resourceDirs("appdata");
     if (baseDirectories.count() == 0) {
         kWarning(debugArea()) << "No directories found for \"appdata\""
                               << "resource. Tutorials can't be loaded";
-        return;
+        return directories;
     }
 
     for (int i=0; i<baseDirectories.count(); ++i) {
-        loadTutorialsFromDirectory(tutorialManager,
-                                   baseDirectories[i] + "tutorials/");
+        directories.append(baseDirectories[i] + "tutorials/");
     }
+
+    return directories;
 }
 
-//private:
+void ScriptManager::openIndex() {
+    delete mTutorialIndex;
+    mTutorialIndex = new TutorialIndex(indexFileName());
+}
+
+QStringList ScriptManager::findScriptFiles(const QStringList& directories) {
+    QStringList fileNames;
 
-void ScriptManager::loadTutorialsFromDirectory(TutorialManager* tutorialManager,
-                                               const QString& directory) {
-    QStringList entries = QDir(directory).entryList();
-    for (int i=0; i<entries.count(); ++i) {
-        QString fileName = directory + entries[i];
-        ScriptedTutorial* scriptedTutorial = new ScriptedTutorial(fileName);
-
-        if (scriptedTutorial->isValid()) {
-            tutorialManager->registerTutorial(scriptedTutorial);
-        } else {
-            delete scriptedTutorial;
+    for (int i=0; i<directories.count(); ++i) {
+        QStringList entries = QDir(directories[i]).entryList(QDir::Files);
+        for (int j=0; j<entries.count(); ++j) {
+            QString fileName = directories[i] + entries[j];
+            if (!KDesktopFile::isDesktopFile(fileName)) {
+                fileNames.append(fileName);
+            }
         }
     }
+
+    return fileNames;
+}
+
+bool ScriptManager::examineScriptFile(const QString& fileName,
+                                      TutorialScript* tutorialScript) {
+    Q_ASSERT(tutorialScript);
+
+    tutorialScript->mFileName = fileName;
+
+    if (mTutorialIndex && mTutorialIndex->isUpToDate(fileName)) {
+        if (!mTutorialIndex->isValid(fileName)) {
+            return false;
+        }
+
+        tutorialScript->mInterpreter = mTutorialIndex->interpreter(fileName);
+        tutorialScript->mDeferred = true;
+        tutorialScript->mName = mTutorialIndex->name(fileName);
+        tutorialScript->mDescription = mTutorialIndex->description(fileName);
+        tutorialScript->mIndexed = true;
+        return true;
+    }
+
+    tutorialScript->mInterpreter =
+                    Kross::Manager::self().interpreternameForFile(fileName);
+    if (tutorialScript->mInterpreter.isEmpty()) {
+        if (mTutorialIndex) {
+            mTutorialIndex->insert(fileName, tutorialScript->mInterpreter, 0);
+        }
+
+        return false;
+    }
+
+    readSideCarFile(tutorialScript);
+    return true;
+}
+
+void ScriptManager::loadTutorialScript(TutorialManager* tutorialManager,
+                                       const TutorialScript& tutorialScript) {
+    Q_ASSERT(tutorialManager);
+
+    ScriptedTutorial* scriptedTutorial;
+    if (tutorialScript.mDeferred) {
+        scriptedTutorial = new ScriptedTutorial(tutorialScript.mFileName,
+                                            ScriptedTutorial::ExecuteOnStart);
+        scriptedTutorial->tutorialInformation()->setName(tutorialScript.mName);
+        scriptedTutorial->tutorialInformation()->setDescription(
+                                                tutorialScript.mDescription);
+    } else {
+        scriptedTutorial = new ScriptedTutorial(tutorialScript.mFileName);
+    }
+
+    if (mTutorialIndex && !tutorialScript.mIndexed) {
+        mTutorialIndex->insert(tutorialScript.mFileName,
+                               tutorialScript.mInterpreter,
+                               scriptedTutorial->isValid()?
+                               scriptedTutorial->tutorialInformation(): 0);
+    }
+
+    if (scriptedTutorial->isValid()) {
+        tutorialManager->registerTutorial(scriptedTutorial);
+    } else {
+        delete scriptedTutorial;
+    }
+}
+
+void ScriptManager::saveIndex() {
+    if (!mTutorialIndex) {
+        return;
+    }
+
+    mTutorialIndex->removeUnusedEntries();
+    mTutorialIndex->save();
+
+    delete mTutorialIndex;
+    mTutorialIndex = 0;
+}
+
+//private:
+
+QString ScriptManager::indexFileName() const {
+    return KStandardDirs::locateLocal("cache", "ktutorial/" +
+                    KGlobal::mainComponent().componentName() + "-tutorials");
+}
+
+void ScriptManager::readSideCarFile(TutorialScript* tutorialScript) const {
+    QString sideCarFileName = tutorialScript->mFileName + ".desktop";
+    if (!QFile::exists(sideCarFileName)) {
+        return;
+    }
+
+    KDesktopFile sideCarFile(sideCarFileName);
+    if (sideCarFile.readName().isEmpty()) {
+        kWarning(debugArea()) << "No name found in" << sideCarFileName
+                              << "; the script will be executed right away";
+        return;
+    }
+
+    tutorialScript->mDeferred = true;
+    tutorialScript->mName = sideCarFile.readName();
+    tutorialScript->mDescription = sideCarFile.readComment();
 }
 
 }
@@ -20,7 +20,8 @@
 #ifndef KTUTORIAL_SCRIPTING_SCRIPTMANAGER_H
 #define KTUTORIAL_SCRIPTING_SCRIPTMANAGER_H
 
-class QString;
+#include <QList>
+#include <QStringList>
 
 namespace ktutorial {
 class TutorialManager;
@@ -28,6 +29,60 @@ class TutorialManager;
 
 namespace ktutorial {
 namespace scripting {
+class ScriptedTutorial;
+class TutorialIndex;
+}
+}
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * Information about a script file that may contain a tutorial.
+ * It is gathered by ScriptManager::examineScriptFile(const QString&,
+ * TutorialScript*) without executing the script.
+ */
+class TutorialScript {
+public:
+
+    TutorialScript():
+        mDeferred(false),
+        mIndexed(false) {
+    }
+
+    /**
+     * The name of the script file.
+     */
+    QString mFileName;
+
+    /**
+     * The name of the interpreter for the script file.
+     */
+    QString mInterpreter;
+
+    /**
+     * Whether the name and description of the tutorial are already known and,
+     * thus, the execution of the script can be deferred until the tutorial is
+     * started.
+     */
+    bool mDeferred;
+
+    /**
+     * The name of the tutorial, if already known.
+     */
+    QString mName;
+
+    /**
+     * The description of the tutorial, if already known.
+     */
+    QString mDescription;
+
+    /**
+     * Whether the information was got from the TutorialIndex or not.
+     */
+    bool mIndexed;
+
+};
 
 /**
  * Manager for scripted tutorials.
@@ -37,7 +92,36 @@ namespace scripting {
  * tutorials for the current KApplication in a TutorialManager using
  * loadTutorials(TutorialManager*).
  *
+ * Executing the script of a tutorial may be expensive, so scripts can provide
+ * their name and description in a side-car desktop file to avoid it. The
+ * side-car file has the same name as the script with an additional ".desktop"
+ * extension (for example, "tutorial.js.desktop" for "tutorial.js"), and the
+ * name and description of the tutorial are read from "Name" and "Comment" keys
+ * of its "Desktop Entry" group. When there is a side-car file, the script is
+ * not executed until the tutorial is started. Note that, in that case, the
+ * tutorial is listed even if the script contains errors.
+ *
+ * When the tutorials are loaded from the application standard directories, the
+ * information about each script file is stored in a TutorialIndex in the user
+ * cache directory. The next time that the tutorials are loaded only the new and
+ * modified files are examined again; the script of the rest of valid tutorials
+ * is not executed until they are started, and the files that did not contain a
+ * valid tutorial are just skipped.
+ *
+ * Loading the tutorials is split in several phases, which can be also
+ * performed separately: opening the index (openIndex()), finding the script
+ * files in the tutorial directories (findScriptFiles(const QStringList&)),
+ * examining each of them (examineScriptFile(const QString&, TutorialScript*)),
+ * loading it (loadTutorialScript(TutorialManager*, const TutorialScript&)) and
+ * saving the updated index (saveIndex()). Finding the script files only lists
+ * the contents of the directories, so it can be done in a thread other than
+ * the GUI thread. The rest of phases use KDE and Kross services that are not
+ * thread safe, so they must be performed in the GUI thread.
+ * DeferredTutorialLoader uses those phases to load the tutorials without
+ * blocking the application.
+ *
  * @see KStandardDirs
+ * @see KDesktopFile
  */
 class ScriptManager {
 public:
@@ -49,27 +133,122 @@ public:
 
     /**
      * Destroys this ScriptManager.
+     * If the index was not saved, the changes are discarded.
      */
     virtual ~ScriptManager();
 
     /**
      * Loads all the valid scripted tutorials from the application standard
      * directories.
+     * The TutorialIndex for the application is used and updated while loading
+     * the tutorials.
      *
      * @param tutorialManager The TutorialManager to load the tutorials into.
      */
     void loadTutorials(TutorialManager* tutorialManager);
 
+    /**
+     * Finds the script files in the application standard directories.
+     * The TutorialIndex for the application is opened, and the files that are
+     * known to not contain a valid tutorial, or that can not be executed by any
+     * Kross interpreter, are skipped.
+     *
+     * This method must be called from the GUI thread.
+     *
+     * @return The information about the script files found.
+     */
+    QList<TutorialScript> findTutorialScripts();
+
+    /**
+     * Returns the directories where the tutorials of the application are
+     * stored.
+     * That is, the "tutorials" subdirectory of each application standard
+     * directory.
+     *
+     * This method must be called from the GUI thread.
+     *
+     * @return The tutorial directories.
+     */
+    QStringList tutorialDirectories() const;
+
+    /**
+     * Opens the TutorialIndex of the application.
+     * If it was already open, the changes not saved are discarded.
+     *
+     * This method must be called from the GUI thread.
+     */
+    void openIndex();
+
+    /**
+     * Finds the files in the given directories that may be tutorial scripts.
+     * Desktop files (including side-car files) are skipped. Only the file
+     * system is accessed, so this method can be called from a thread other
+     * than the GUI thread.
+     *
+     * @param directories The names of the directories to find the files in.
+     * @return The names of the files found.
+     */
+    static QStringList findScriptFiles(const QStringList& directories);
+
+    /**
+     * Gathers the information about the given script file.
+     * The information is got from the index, if it is open and up to date;
+     * otherwise, the interpreter is looked for and the side-car file read.
+     *
+     * This method must be called from the GUI thread.
+     *
+     * @param fileName The name of the script file.
+     * @param tutorialScript The information to fill.
+     * @return False if the file is known to not contain a valid tutorial or
+     *         can not be executed by any Kross interpreter, true otherwise.
+     */
+    bool examineScriptFile(const QString& fileName,
+                           TutorialScript* tutorialScript);
+
+    /**
+     * Loads the tutorial in the given script file, if valid.
+     * The index is updated with the information of the tutorial, if the
+     * information did not come from the index itself.
+     *
+     * This method must be called from the GUI thread.
+     *
+     * @param tutorialManager The TutorialManager to load the tutorial into.
+     * @param tutorialScript The information about the script file.
+     */
+    void loadTutorialScript(TutorialManager* tutorialManager,
+                            const TutorialScript& tutorialScript);
+
+    /**
+     * Removes the index entries for the script files that were not found and
+     * saves the index.
+     * The index is closed after saving it.
+     */
+    void saveIndex();
+
 private:
 
     /**
-     * Loads all the valid scripted tutorials from the given directory.
+     * The index used to avoid examining again unmodified files, if any.
+     */
+    TutorialIndex* mTutorialIndex;
+
+    /**
+     * Returns the name of the file that stores the TutorialIndex of the
+     * application.
      *
-     * @param tutorialManager The TutorialManager to load the tutorials into.
-     * @param directory The name of the directory to load the tutorials from.
+     * @return The name of the index file.
+     */
+    QString indexFileName() const;
+
+    /**
+     * Reads the name and description of the tutorial from the side-car desktop
+     * file of the script, if any.
+     * If the side-car file exists and provides a name, the execution of the
+     * script is deferred.
+     *
+     * @param tutorialScript The information about the script file to update.
      */
-    void loadTutorialsFromDirectory(TutorialManager* tutorialManager,
-                                    const QString& directory);
+    void readSideCarFile(TutorialScript* tutorialScript) const;
 
 };
 
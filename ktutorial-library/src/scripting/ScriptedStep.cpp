@@ -21,15 +21,77 @@
 
 #include <kross/core/action.h>
 
+#include "../Tracer.h"
 #include "../WaitFor.h"
 
 namespace ktutorial {
 namespace scripting {
 
+/**
+ * Call to a function of a script.
+ * The Kross::Action, the name of the function and the arguments to call it
+ * with are set when the call is created, so calling the function just forwards
+ * them to Kross. The call is used as the receiver of the signal that triggers
+ * it.
+ */
+class ScriptFunctionCall: public QObject {
+Q_OBJECT
+public:
+
+    ScriptFunctionCall(Kross::Action* scriptAction, const QString& functionName,
+                       const QVariantList& arguments, QObject* parent):
+            QObject(parent),
+        mScriptAction(scriptAction),
+        mFunctionName(functionName),
+        mArguments(arguments) {
+    }
+
+public slots:
+
+    void call() {
+        ScopedTrace trace("ScriptFunctionCall::call", mFunctionName);
+        mScriptAction->callFunction(mFunctionName, mArguments);
+    }
+
+private:
+
+    Kross::Action* mScriptAction;
+    QString mFunctionName;
+    QVariantList mArguments;
+
+};
+
+/**
+ * Returns the name of the function referred to by the given slot.
+ * The slot can be just the function name or the function name followed by
+ * parenthesis.
+ *
+ * @param slot The slot to get its function name.
+ * @return The function name.
+ */
+static QString functionName(const QString& slot) {
+    int index = slot.indexOf('(');
+    if (index > -1) {
+        return slot.left(index);
+    }
+
+    return slot;
+}
+
+//public:
+
 ScriptedStep::ScriptedStep(const QString& id): Step(id),
     mScriptAction(0) {
 }
 
+void ScriptedStep::connectSetup(QObject* receiver, const QString& slot) {
+    connectToSignal(SIGNAL(setup(QObject*)), receiver, slot);
+}
+
+void ScriptedStep::connectTearDown(QObject* receiver, const QString& slot) {
+    connectToSignal(SIGNAL(tearDown(QObject*)), receiver, slot);
+}
+
 //protected:
 
 void ScriptedStep::setup() {
@@ -47,41 +109,66 @@ void ScriptedStep::connectWaitFor(WaitFor* waitFor, QObject* receiver,
         return;
     }
 
-    Kross::Action* scriptAction = static_cast<Kross::Action*>(receiver);
+    ScriptFunctionCall* functionCall = newFunctionCall(
+                                    static_cast<Kross::Action*>(receiver),
+                                    slot, QVariantList());
+    mFunctionCalls.insert(waitFor, functionCall);
+
+    connect(waitFor, SIGNAL(waitEnded(WaitFor*)), functionCall, SLOT(call()));
+}
+
+void ScriptedStep::disconnectWaitFor(WaitFor* waitFor) {
+    if (!mFunctionCalls.contains(waitFor)) {
+        Step::disconnectWaitFor(waitFor);
+        return;
+    }
+
+    //Deleting the call also disconnects it from the WaitFor
+    delete mFunctionCalls.take(waitFor);
+}
+
+//private:
+
+ScriptFunctionCall* ScriptedStep::newFunctionCall(
+                                                Kross::Action* scriptAction,
+                                                const QString& slot,
+                                                const QVariantList& arguments) {
     if (mScriptAction == 0) {
         mScriptAction = scriptAction;
     }
     //Check that the previously set Kross::Action is the same as the current one
     Q_ASSERT(mScriptAction == scriptAction);
 
-    QString functionName = slot;
-    int index = functionName.indexOf('(');
-    if (index > -1) {
-        functionName = functionName.left(index);
-    }
-
-    mFunctions.insert(waitFor, functionName);
-
-    connect(waitFor, SIGNAL(waitEnded(WaitFor*)),
-            this, SLOT(executeScriptFunctionFor(WaitFor*)));
+    return new ScriptFunctionCall(scriptAction, functionName(slot), arguments,
+                                  this);
 }
 
-void ScriptedStep::disconnectWaitFor(WaitFor* waitFor) {
-    if (!mFunctions.contains(waitFor)) {
-        Step::disconnectWaitFor(waitFor);
+void ScriptedStep::connectToSignal(const char* signal, QObject* receiver,
+                                   const QString& slot) {
+    if (!qobject_cast<Kross::Action*>(receiver)) {
+        QString slotName = slot;
+        if (!slotName.startsWith('1')) {
+            slotName = QString("1%1").arg(slot);
+        }
+
+        connect(this, signal, receiver, slotName.toLatin1());
         return;
     }
 
-    mFunctions.remove(waitFor);
+    //The function is called with this ScriptedStep as its argument, like it
+    //would be if it were connected to the signal from the script
+    QVariantList arguments;
+    arguments.append(qVariantFromValue(static_cast<QObject*>(this)));
 
-    disconnect(waitFor, SIGNAL(waitEnded(WaitFor*)));
-}
+    ScriptFunctionCall* functionCall = newFunctionCall(
+                                    static_cast<Kross::Action*>(receiver),
+                                    slot, arguments);
 
-//private:
-
-void ScriptedStep::executeScriptFunctionFor(WaitFor* waitFor) {
-    mScriptAction->callFunction(mFunctions.value(waitFor).toLatin1());
+    connect(this, signal, functionCall, SLOT(call()));
 }
 
 }
 }
+
+#include "moc_ScriptedStep.cpp"
+#include "ScriptedStep.moc"
@@ -21,6 +21,7 @@
 #define KTUTORIAL_SCRIPTING_SCRIPTEDSTEP_H
 
 #include <QHash>
+#include <QVariant>
 
 #include "../Step.h"
 
@@ -28,6 +29,12 @@ namespace Kross {
 class Action;
 }
 
+namespace ktutorial {
+namespace scripting {
+class ScriptFunctionCall;
+}
+}
+
 namespace ktutorial {
 namespace scripting {
 
@@ -44,7 +51,11 @@ namespace scripting {
  * performed when a Step is deactivated, do the same with tearDown(QObject*)
  * signal instead. Note that, although the argument in those signals is declared
  * as QObject*, it is in fact the ScriptedStep that emitted the signals. It is a
- * Kross limitation.
+ * Kross limitation. The function can be connected using the connect function
+ * of the script language, or using connectSetup(QObject*, const QString&) and
+ * connectTearDown(QObject*, const QString&) with "self" as the receiver and the
+ * function name as the slot; in that case, the function is resolved once, when
+ * it is connected, instead of each time that the signal is emitted.
  *
  * If a function of the script must be executed when an Option is selected or
  * when the waiting of a WaitFor ends, just use addOption(Option*, QObject*,
@@ -63,6 +74,33 @@ public:
      */
     explicit ScriptedStep(const QString& id);
 
+    /**
+     * Connects the setup(QObject*) signal with the slot in the receiver.
+     * If the receiver is a Kross::Action, the slot must be the name of a
+     * callable function (with or without parenthesis) instead of a true slot.
+     * The name of the function is parsed only once, when it is connected, and
+     * the function is called with this ScriptedStep as its argument.
+     *
+     * This method can be invoked from a script.
+     *
+     * @param receiver The object to connect to.
+     * @param slot The slot to connect to.
+     */
+    Q_INVOKABLE void connectSetup(QObject* receiver, const QString& slot);
+
+    /**
+     * Connects the tearDown(QObject*) signal with the slot in the receiver.
+     * It behaves like connectSetup(QObject*, const QString&). See its
+     * documentation for further details.
+     *
+     * This method can be invoked from a script.
+     *
+     * @param receiver The object to connect to.
+     * @param slot The slot to connect to.
+     * @see connectSetup(QObject*, const QString&)
+     */
+    Q_INVOKABLE void connectTearDown(QObject* receiver, const QString& slot);
+
 signals:
 
     /**
@@ -106,7 +144,10 @@ protected:
      * If the receiver is a Kross::Action, the slot must be the name of a
      * callable function (with or without parenthesis) instead of a true slot.
      * When the WaitFor::waitEnded(WaitFor*) signal is emitted, the function
-     * will be called (thus behaving like a slot).
+     * will be called (thus behaving like a slot). The name of the function is
+     * parsed only once, when the WaitFor is connected, and the signal is
+     * connected directly to an object that calls the function, so no lookup is
+     * needed each time the waiting ends.
      *
      * If the receiver is not a Kross::Action, the parent method is called.
      *
@@ -139,19 +180,37 @@ private:
     Kross::Action* mScriptAction;
 
     /**
-     * Maps the WaitFors with the name of the functions to call when the waiting
-     * ends.
+     * Maps the WaitFors with the calls to the functions to execute when the
+     * waiting ends.
      */
-    QHash<WaitFor*, QString> mFunctions;
+    QHash<WaitFor*, ScriptFunctionCall*> mFunctionCalls;
 
-private slots:
+    /**
+     * Creates a new call to the function named in the given slot.
+     * All the functions called by this ScriptedStep must belong to the same
+     * Kross::Action.
+     *
+     * @param scriptAction The Kross::Action that contains the function.
+     * @param slot The function name, with or without parenthesis.
+     * @param arguments The arguments to call the function with.
+     * @return The new call, owned by this ScriptedStep.
+     */
+    ScriptFunctionCall* newFunctionCall(Kross::Action* scriptAction,
+                                        const QString& slot,
+                                        const QVariantList& arguments);
 
     /**
-     * Calls the function associated with the given WaitFor.
+     * Connects the given signal of this ScriptedStep with the slot in the
+     * receiver.
+     * If the receiver is a Kross::Action, the function is called with this
+     * ScriptedStep as its argument.
      *
-     * @param waitFor The WaitFor.
+     * @param signal The signal to connect, as returned by SIGNAL macro.
+     * @param receiver The object to connect to.
+     * @param slot The slot, or function name, to connect to.
      */
-    void executeScriptFunctionFor(WaitFor* waitFor);
+    void connectToSignal(const char* signal, QObject* receiver,
+                         const QString& slot);
 
 };
 
@@ -20,26 +20,34 @@
 #include "ScriptedTutorial.h"
 
 #include <kross/core/action.h>
+#include <kross/core/manager.h>
 
 #include "ScriptingModule.h"
+#include "../Step.h"
 #include "../TutorialInformation.h"
 
 namespace ktutorial {
 namespace scripting {
 
-ScriptedTutorial::ScriptedTutorial(const QString& filename): 
+ScriptedTutorial::ScriptedTutorial(const QString& filename,
+                    ExecutionMode executionMode /*= ExecuteOnCreation*/): 
     Tutorial(new TutorialInformation(filename)) {
 
     mScriptAction = new Kross::Action(this, filename);
+    mExecuted = false;
 
-    if (mScriptAction->setFile(filename)) {
-        mScriptAction->addObject(this, "tutorial");
-        mScriptAction->addObject(ScriptingModule::self(), "ktutorial");
-        mScriptAction->trigger();
-        mValid = !mScriptAction->hadError();
-    } else {
+    if (!mScriptAction->setFile(filename)) {
         mValid = false;
+        return;
     }
+
+    if (executionMode == ExecuteOnStart) {
+        mValid = !Kross::Manager::self().interpreternameForFile(filename)
+                                                                    .isEmpty();
+        return;
+    }
+
+    executeScript();
 }
 
 ScriptedTutorial::~ScriptedTutorial() {
@@ -53,9 +61,69 @@ bool ScriptedTutorial::isValid() const {
     return mValid;
 }
 
+bool ScriptedTutorial::updateStep(const QString& stepId,
+                                  const QString& stepScript) {
+    //If the script was not executed yet, it would add again the step when
+    //executed
+    if (!mValid || !mExecuted) {
+        return false;
+    }
+
+    //The old step is removed before executing the step script so the new step
+    //can be added
+    Step* oldStep = takeStep(stepId);
+
+    QString filename = tutorialInformation()->id();
+    Kross::Action* stepScriptAction = new Kross::Action(this, filename);
+    stepScriptAction->setInterpreter(
+                    Kross::Manager::self().interpreternameForFile(filename));
+    stepScriptAction->setCode(stepScript.toUtf8());
+    stepScriptAction->addObject(this, "tutorial");
+    stepScriptAction->addObject(ScriptingModule::self(), "ktutorial");
+    stepScriptAction->trigger();
+
+    Step* newStep = step(stepId);
+    if (stepScriptAction->hadError() || !newStep) {
+        //The new step may use functions from the step script, so it must be
+        //deleted before the action
+        delete takeStep(stepId);
+        delete stepScriptAction;
+
+        if (oldStep) {
+            addStep(oldStep);
+        }
+
+        return false;
+    }
+
+    if (oldStep && oldStep == currentStep()) {
+        nextStep(newStep);
+    }
+
+    //The old step may have been created by a previous step script, which must
+    //be kept until the step is deleted. The step is not deleted immediately as
+    //this method may have been called due to something done by the step
+    //itself
+    if (oldStep) {
+        oldStep->deleteLater();
+    }
+
+    Kross::Action* oldStepScriptAction = mStepScriptActions.value(stepId);
+    if (oldStepScriptAction) {
+        oldStepScriptAction->deleteLater();
+    }
+    mStepScriptActions.insert(stepId, stepScriptAction);
+
+    return true;
+}
+
 //protected:
 
 void ScriptedTutorial::setup() {
+    if (!mExecuted && mValid) {
+        executeScript();
+    }
+
     emit setup(this);
 }
 
@@ -63,5 +131,16 @@ void ScriptedTutorial::tearDown() {
     emit tearDown(this);
 }
 
+//private:
+
+void ScriptedTutorial::executeScript() {
+    mExecuted = true;
+
+    mScriptAction->addObject(this, "tutorial");
+    mScriptAction->addObject(ScriptingModule::self(), "ktutorial");
+    mScriptAction->trigger();
+    mValid = !mScriptAction->hadError();
+}
+
 }
 }
@@ -20,6 +20,8 @@
 #ifndef KTUTORIAL_SCRIPTING_SCRIPTEDTUTORIAL_H
 #define KTUTORIAL_SCRIPTING_SCRIPTEDTUTORIAL_H
 
+#include <QHash>
+
 #include "../Tutorial.h"
 
 namespace Kross {
@@ -33,7 +35,11 @@ namespace scripting {
  * Tutorial to be used in scripts.
  * This class acts as a bridge between scripts and tutorials. The tutorial is
  * written in a script, which is interpreted by the ScriptedTutorial through
- * Kross. The script is executed when the ScriptedTutorial is created.
+ * Kross. By default, the script is executed when the ScriptedTutorial is
+ * created. However, the execution can be deferred until the ScriptedTutorial is
+ * started using ExecuteOnStart mode. In that case, the name and description of
+ * the tutorial must be set by whoever created the ScriptedTutorial, as they are
+ * not known until the script is executed.
  *
  * Not every script file is valid, as the filename may be wrong, it could be
  * written in a language not manageable by current Kross environment, or it may
@@ -50,18 +56,40 @@ namespace scripting {
  *
  * You can do the same if something has to be cleaned after the Tutorial
  * finishes using tearDown(QObject*) signal.
+ *
+ * The steps of a running ScriptedTutorial can be replaced using updateStep(),
+ * which executes a script that creates and adds again the step. It is used to
+ * test changes in a tutorial without starting it again.
  */
 class ScriptedTutorial: public Tutorial {
 Q_OBJECT
 public:
 
+    /**
+     * When the script is executed.
+     */
+    enum ExecutionMode {
+        /**
+         * The script is executed when the ScriptedTutorial is created.
+         */
+        ExecuteOnCreation,
+
+        /**
+         * The script is executed when the ScriptedTutorial is set up, that is,
+         * when it is started.
+         */
+        ExecuteOnStart
+    };
+
     /**
      * Creates a new ScriptedTutorial for the given filename.
      * The id of its TutorialInformation is set to the filename.
      *
      * @param filename The name of the file containing the script.
+     * @param executionMode When to execute the script.
      */
-    explicit ScriptedTutorial(const QString& filename);
+    explicit ScriptedTutorial(const QString& filename,
+                              ExecutionMode executionMode = ExecuteOnCreation);
 
     /**
      * Destroys this ScriptedTutorial.
@@ -87,10 +115,36 @@ public:
      * that can be managed by the current Kross environment and the script has
      * no errors. That is, if the script could be executed.
      *
+     * If the execution of the script is deferred until the ScriptedTutorial is
+     * started, only the file and the language are checked until then.
+     *
      * @return True if the file is valid, false otherwise.
      */
     bool isValid() const;
 
+    /**
+     * Replaces the step with the given id with the one created by the given
+     * script.
+     * The script is executed in its own Kross action, with the same objects
+     * exposed as in the tutorial script. It must create a step with the given
+     * id and add it to the tutorial, like the code for each step in the
+     * tutorial script does. If there was no step with that id, the new step is
+     * just added.
+     *
+     * If the replaced step is the current step, the tutorial changes to the new
+     * step. Otherwise, the current step is not modified.
+     *
+     * The step is not replaced if the ScriptedTutorial is not valid or its
+     * script was not executed yet, if the step script has errors or if it does
+     * not add a step with the given id. In that case, the previous step, if
+     * any, is kept.
+     *
+     * @param stepId The id of the step to replace.
+     * @param stepScript The script that creates and adds the new step.
+     * @return True if the step was replaced, false otherwise.
+     */
+    bool updateStep(const QString& stepId, const QString& stepScript);
+
 signals:
 
     /**
@@ -120,6 +174,8 @@ protected:
     /**
      * Emits setup(scripting::ScriptedTutorial*) signal using this
      * ScriptedTutorial as parameter.
+     * If the script was not executed yet (and it seems valid), it is executed
+     * before emitting the signal.
      */
     virtual void setup();
 
@@ -136,11 +192,30 @@ private:
      */
     Kross::Action* mScriptAction;
 
+    /**
+     * The Kross actions that created the steps replaced with updateStep(),
+     * indexed by the step id.
+     * The functions used by a step are defined in the script that created
+     * it, so each action is kept until its step is replaced again.
+     */
+    QHash<QString, Kross::Action*> mStepScriptActions;
+
     /**
      * Whether the script is valid or not.
      */
     bool mValid;
 
+    /**
+     * Whether the script was already executed or not.
+     */
+    bool mExecuted;
+
+    /**
+     * Executes the script, exposing this ScriptedTutorial and the
+     * ScriptingModule to it.
+     */
+    void executeScript();
+
 };
 
 }
@@ -50,23 +50,14 @@ ScriptingModule* ScriptingModule::self() {
 
         //The WaitFor types are registered with an specific name instead of the
         //default one, as the default one includes a leading "ktutorial::".
-        sSelf->registerWaitForMetaObject(WaitForAnd::staticMetaObject,
-                                         "WaitForAnd");
-        sSelf->registerWaitForMetaObject(WaitForEvent::staticMetaObject,
-                                         "WaitForEvent");
-        sSelf->registerWaitForMetaObject(WaitForNot::staticMetaObject,
-                                         "WaitForNot");
-        sSelf->registerWaitForMetaObject(WaitForOr::staticMetaObject,
-                                         "WaitForOr");
-        sSelf->registerWaitForMetaObject(WaitForProperty::staticMetaObject,
-                                         "WaitForProperty");
-        sSelf->registerWaitForMetaObject(WaitForSignal::staticMetaObject,
-                                         "WaitForSignal");
-        sSelf->registerWaitForMetaObject(
-                                    WaitForStepActivation::staticMetaObject,
-                                    "WaitForStepActivation");
-        sSelf->registerWaitForMetaObject(WaitForWindow::staticMetaObject,
-                                         "WaitForWindow");
+        sSelf->registerWaitFor<WaitForAnd>("WaitForAnd");
+        sSelf->registerWaitFor<WaitForEvent>("WaitForEvent");
+        sSelf->registerWaitFor<WaitForNot>("WaitForNot");
+        sSelf->registerWaitFor<WaitForOr>("WaitForOr");
+        sSelf->registerWaitFor<WaitForProperty>("WaitForProperty");
+        sSelf->registerWaitFor<WaitForSignal>("WaitForSignal");
+        sSelf->registerWaitFor<WaitForStepActivation>("WaitForStepActivation");
+        sSelf->registerWaitFor<WaitForWindow>("WaitForWindow");
     }
 
     return sSelf;
@@ -78,10 +69,7 @@ ScriptingModule::~ScriptingModule() {
 bool ScriptingModule::registerWaitForMetaObject(
                             const QMetaObject& waitForMetaObject,
                             const QString& typeName /*= QString()*/) {
-    if (mWaitForMetaObjects.contains(typeName)) {
-        kWarning(debugArea()) << "Can't register"
-                              << QString(waitForMetaObject.className())
-                              << ", as" << typeName << "is already registered";
+    if (!isTypeNameAvailable(waitForMetaObject, typeName)) {
         return false;
     }
 
@@ -106,6 +94,22 @@ bool ScriptingModule::registerWaitForMetaObject(
     return true;
 }
 
+bool ScriptingModule::registerWaitForFactory(WaitForFactory waitForFactory,
+                            const QMetaObject& waitForMetaObject,
+                            const QString& typeName /*= QString()*/) {
+    Q_ASSERT(waitForFactory);
+
+    if (!isTypeNameAvailable(waitForMetaObject, typeName)) {
+        return false;
+    }
+
+    QString key = typeName.isNull()? waitForMetaObject.className(): typeName;
+    mWaitForMetaObjects.insert(key, waitForMetaObject);
+    mWaitForFactories.insert(key, waitForFactory);
+
+    return true;
+}
+
 QObject* ScriptingModule::findObject(const QString& name) {
     return KTutorial::self()->findObject<QObject*>(name);
 }
@@ -119,11 +123,19 @@ QObject* ScriptingModule::newStep(const QString& id) {
 }
 
 QObject* ScriptingModule::newWaitFor(const QString& typeName) {
-    if (!mWaitForMetaObjects.contains(typeName)) {
+    QHash<QString, WaitForFactory>::const_iterator factory =
+                                        mWaitForFactories.constFind(typeName);
+    if (factory != mWaitForFactories.constEnd()) {
+        return factory.value()();
+    }
+
+    QHash<QString, QMetaObject>::const_iterator metaObject =
+                                        mWaitForMetaObjects.constFind(typeName);
+    if (metaObject == mWaitForMetaObjects.constEnd()) {
         return 0;
     }
 
-    QObject* object = mWaitForMetaObjects.find(typeName).value().newInstance();
+    QObject* object = metaObject.value().newInstance();
     return qobject_cast<WaitFor*>(object);
 }
 
@@ -134,6 +146,19 @@ ScriptingModule* ScriptingModule::sSelf = 0;
 ScriptingModule::ScriptingModule() {
 }
 
+bool ScriptingModule::isTypeNameAvailable(const QMetaObject& waitForMetaObject,
+                                          const QString& typeName) const {
+    QString key = typeName.isNull()? waitForMetaObject.className(): typeName;
+    if (mWaitForMetaObjects.contains(key)) {
+        kWarning(debugArea()) << "Can't register"
+                              << QString(waitForMetaObject.className())
+                              << ", as" << key << "is already registered";
+        return false;
+    }
+
+    return true;
+}
+
 bool ScriptingModule::inheritsWaitFor(const QMetaObject& metaObject) const {
     const QMetaObject* currentSuperClass = &metaObject;
     do {
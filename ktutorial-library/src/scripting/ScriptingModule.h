@@ -24,6 +24,8 @@
 #include <QHash>
 #include <QObject>
 
+#include "../WaitFor.h"
+
 class Option;
 class WaitFor;
 
@@ -56,9 +58,11 @@ namespace scripting {
  * New objects of the default KTutorial WaitFor classes can be created with
  * newWaitFor(const QString&) using their name (without any namespace
  * qualifier). Moreover, custom WaitFor classes can be registered with
- * registerWaitForMetaObject(const QMetaObject&, const QString&) and new
- * instances of those classes can be created since that moment, provided they
- * have an invokable public default constructor.
+ * registerWaitFor<T>(const QString&) and new instances of those classes can be
+ * created since that moment. When the class is not known at compile time it
+ * can be registered instead with
+ * registerWaitForMetaObject(const QMetaObject&, const QString&), provided it
+ * has an invokable public default constructor.
  *
  * ScriptingModule is a singleton, so all the scripts can use each registered
  * WaitFor type.
@@ -67,6 +71,11 @@ class ScriptingModule: public QObject {
 Q_OBJECT
 public:
 
+    /**
+     * A function that creates a new WaitFor.
+     */
+    typedef WaitFor* (*WaitForFactory)();
+
     /**
      * Returns the only instance of this class.
      *
@@ -99,6 +108,47 @@ public:
     bool registerWaitForMetaObject(const QMetaObject& waitForMetaObject,
                                    const QString& typeName = QString());
 
+    /**
+     * Registers the WaitFor type T to create instances of it using
+     * newWaitFor(const QString&).
+     * T must inherit from WaitFor and have a public default constructor; unlike
+     * in registerWaitForMetaObject(const QMetaObject&, const QString&), this is
+     * checked at compile time, so the registration will not even compile if T
+     * does not fulfill those requirements. Moreover, the instances are created
+     * calling directly the constructor of T instead of going through the
+     * QMetaObject, which is faster.
+     *
+     * The type name behaves like in
+     * registerWaitForMetaObject(const QMetaObject&, const QString&).
+     *
+     * @param typeName A specific name to be used for the type.
+     * @return True if the type was successfully registered, false otherwise.
+     */
+    template <typename T>
+    bool registerWaitFor(const QString& typeName = QString()) {
+        return registerWaitForFactory(&WaitFor::create<T>,
+                                      T::staticMetaObject, typeName);
+    }
+
+    /**
+     * Registers a WaitFor type created by the given factory function to create
+     * instances of it using newWaitFor(const QString&).
+     * The factory function must return new objects of the class represented by
+     * the given QMetaObject. Usually, you will want to use
+     * registerWaitFor<T>(const QString&) instead of this method.
+     *
+     * The type name behaves like in
+     * registerWaitForMetaObject(const QMetaObject&, const QString&).
+     *
+     * @param waitForFactory The function to create new instances with.
+     * @param waitForMetaObject The QMetaObject of the created instances.
+     * @param typeName A specific name to be used for the type.
+     * @return True if the type was successfully registered, false otherwise.
+     */
+    bool registerWaitForFactory(WaitForFactory waitForFactory,
+                                const QMetaObject& waitForMetaObject,
+                                const QString& typeName = QString());
+
     /**
      * Returns the object with the specified name, if any.
      * This method can be invoked from a script.
@@ -135,7 +185,7 @@ public:
      * Returns a new WaitFor of the given type name.
      * The type can be any of the default WaitFor included in KTutorial
      * (WaitForSignal, WaitForAnd...) or the name of a custom WaitFor type
-     * registered with
+     * registered with registerWaitFor<T>(const QString&) or
      * registerWaitForMetaObject(const QMetaObject&, const QString&).
      * This method can be invoked from a script.
      *
@@ -154,6 +204,13 @@ private:
      */
     QHash<QString, QMetaObject> mWaitForMetaObjects;
 
+    /**
+     * The hash to store the factory functions of the WaitFor types registered
+     * with them.
+     * Types registered only with their QMetaObject do not appear here.
+     */
+    QHash<QString, WaitForFactory> mWaitForFactories;
+
     /**
      * The instance of this class.
      */
@@ -165,6 +222,16 @@ private:
      */
     ScriptingModule();
 
+    /**
+     * Check if the given type name can be used to register a new WaitFor type.
+     *
+     * @param waitForMetaObject The QMetaObject of the type to register.
+     * @param typeName The type name to check.
+     * @return True if the type name is not registered yet, false otherwise.
+     */
+    bool isTypeNameAvailable(const QMetaObject& waitForMetaObject,
+                             const QString& typeName) const;
+
     /**
      * Check if the given QMetaObject is from a WaitFor subclass.
      *
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include "TutorialIndex.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KGlobal>
+#include <KLocale>
+#include <kross/core/manager.h>
+
+#include "../TutorialInformation.h"
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * The version of the index format.
+ * Indexes written with a different version are discarded.
+ */
+static const int sIndexVersion = 1;
+
+/**
+ * The name of the group that stores the information about the index itself.
+ * As the groups of the entries are named after the absolute path of the script
+ * files, there is no collision between them.
+ */
+static const char* sGeneralGroup = "General";
+
+//public:
+
+TutorialIndex::TutorialIndex(const QString& indexFileName):
+    mConfig(new KConfig(indexFileName, KConfig::SimpleConfig)) {
+    KConfigGroup general(mConfig, sGeneralGroup);
+    QString language = KGlobal::locale()->language();
+
+    if (general.readEntry("Version", 0) != sIndexVersion ||
+        general.readEntry("Language", QString()) != language) {
+        clear();
+
+        general = KConfigGroup(mConfig, sGeneralGroup);
+        general.writeEntry("Version", sIndexVersion);
+        general.writeEntry("Language", language);
+    }
+}
+
+TutorialIndex::~TutorialIndex() {
+    mConfig->markAsClean();
+    delete mConfig;
+}
+
+bool TutorialIndex::isUpToDate(const QString& fileName) {
+    if (!mConfig->hasGroup(fileName)) {
+        return false;
+    }
+
+    KConfigGroup entry(mConfig, fileName);
+    QFileInfo fileInfo(fileName);
+
+    if (!fileInfo.exists() ||
+        entry.readEntry("Size", qint64(-1)) != fileInfo.size() ||
+        entry.readEntry("LastModified", uint(0)) !=
+                                        fileInfo.lastModified().toTime_t() ||
+        entry.readEntry("SideCarLastModified", uint(0)) !=
+                                        sideCarLastModified(fileName)) {
+        return false;
+    }
+
+    QString interpreter = entry.readEntry("Interpreter", QString());
+    if (!interpreter.isEmpty() &&
+            !Kross::Manager::self().hasInterpreterInfo(interpreter)) {
+        return false;
+    }
+
+    mUsedEntries.insert(fileName);
+
+    return true;
+}
+
+bool TutorialIndex::isValid(const QString& fileName) const {
+    return KConfigGroup(mConfig, fileName).readEntry("Valid", false);
+}
+
+QString TutorialIndex::interpreter(const QString& fileName) const {
+    return KConfigGroup(mConfig, fileName).readEntry("Interpreter", QString());
+}
+
+QString TutorialIndex::id(const QString& fileName) const {
+    return KConfigGroup(mConfig, fileName).readEntry("Id", QString());
+}
+
+QString TutorialIndex::name(const QString& fileName) const {
+    return KConfigGroup(mConfig, fileName).readEntry("Name", QString());
+}
+
+QString TutorialIndex::description(const QString& fileName) const {
+    return KConfigGroup(mConfig, fileName).readEntry("Description", QString());
+}
+
+void TutorialIndex::insert(const QString& fileName, const QString& interpreter,
+                           const TutorialInformation* tutorialInformation) {
+    mConfig->deleteGroup(fileName);
+
+    KConfigGroup entry(mConfig, fileName);
+    QFileInfo fileInfo(fileName);
+
+    entry.writeEntry("Size", fileInfo.size());
+    entry.writeEntry("LastModified", fileInfo.lastModified().toTime_t());
+    entry.writeEntry("SideCarLastModified", sideCarLastModified(fileName));
+    entry.writeEntry("Interpreter", interpreter);
+    entry.writeEntry("Valid", tutorialInformation != 0);
+
+    if (tutorialInformation) {
+        entry.writeEntry("Id", tutorialInformation->id());
+        entry.writeEntry("Name", tutorialInformation->name());
+        entry.writeEntry("Description", tutorialInformation->description());
+    }
+
+    mUsedEntries.insert(fileName);
+}
+
+void TutorialIndex::removeUnusedEntries() {
+    foreach (const QString& group, mConfig->groupList()) {
+        if (group != sGeneralGroup && !mUsedEntries.contains(group)) {
+            mConfig->deleteGroup(group);
+        }
+    }
+}
+
+void TutorialIndex::save() {
+    mConfig->sync();
+}
+
+//private:
+
+void TutorialIndex::clear() {
+    foreach (const QString& group, mConfig->groupList()) {
+        mConfig->deleteGroup(group);
+    }
+}
+
+uint TutorialIndex::sideCarLastModified(const QString& fileName) const {
+    QFileInfo sideCarFileInfo(fileName + ".desktop");
+    if (!sideCarFileInfo.exists()) {
+        return 0;
+    }
+
+    return sideCarFileInfo.lastModified().toTime_t();
+}
+
+}
+}
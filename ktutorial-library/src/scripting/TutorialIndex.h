@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef KTUTORIAL_SCRIPTING_TUTORIALINDEX_H
+#define KTUTORIAL_SCRIPTING_TUTORIALINDEX_H
+
+#include <QSet>
+#include <QString>
+
+class KConfig;
+
+namespace ktutorial {
+class TutorialInformation;
+}
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * Persistent index of the scripted tutorials found in the application standard
+ * directories.
+ * Loading a scripted tutorial requires executing its script, which may be
+ * expensive. The TutorialIndex stores, for each script file, its size, its last
+ * modification time, the interpreter used to execute it and the id, name and
+ * description of the tutorial (or whether the file did not contain a valid
+ * tutorial). The index is stored in a configuration file, so the information
+ * can be reused the next time the application is started instead of executing
+ * again the scripts that did not change.
+ *
+ * An entry is up to date if the size and the last modification time of the
+ * script file (and of its side-car desktop file, if any) are the same as when
+ * the entry was inserted, and the interpreter is still available. As the name
+ * and description of the tutorials are usually localized, the whole index is
+ * discarded if the language of the application changed.
+ *
+ * The entries that were neither checked with isUpToDate(const QString&) nor
+ * inserted since the index was loaded can be removed with
+ * removeUnusedEntries(). The index is not written to disk until save() is
+ * called.
+ *
+ * @see ScriptManager
+ */
+class TutorialIndex {
+public:
+
+    /**
+     * Creates a new TutorialIndex stored in the given file.
+     * If the file does not exist yet, the index is empty.
+     *
+     * @param indexFileName The name of the file to store the index in.
+     */
+    explicit TutorialIndex(const QString& indexFileName);
+
+    /**
+     * Destroys this TutorialIndex.
+     * Pending changes are not saved.
+     */
+    virtual ~TutorialIndex();
+
+    /**
+     * Returns whether there is an up to date entry for the given file or not.
+     *
+     * @param fileName The name of the script file.
+     * @return True if the entry is up to date, false otherwise.
+     */
+    bool isUpToDate(const QString& fileName);
+
+    /**
+     * Returns whether the indexed file contains a valid tutorial or not.
+     *
+     * @param fileName The name of the script file.
+     * @return True if the file contains a valid tutorial, false otherwise.
+     */
+    bool isValid(const QString& fileName) const;
+
+    /**
+     * Returns the interpreter used to execute the indexed file.
+     *
+     * @param fileName The name of the script file.
+     * @return The interpreter used to execute the file, or an empty string if
+     *         none can execute it.
+     */
+    QString interpreter(const QString& fileName) const;
+
+    /**
+     * Returns the id of the tutorial in the indexed file.
+     *
+     * @param fileName The name of the script file.
+     * @return The id of the tutorial.
+     */
+    QString id(const QString& fileName) const;
+
+    /**
+     * Returns the name of the tutorial in the indexed file.
+     *
+     * @param fileName The name of the script file.
+     * @return The name of the tutorial.
+     */
+    QString name(const QString& fileName) const;
+
+    /**
+     * Returns the description of the tutorial in the indexed file.
+     *
+     * @param fileName The name of the script file.
+     * @return The description of the tutorial.
+     */
+    QString description(const QString& fileName) const;
+
+    /**
+     * Inserts or replaces the entry for the given file.
+     * If the file does not contain a valid tutorial, the TutorialInformation
+     * must be null.
+     *
+     * @param fileName The name of the script file.
+     * @param interpreter The interpreter for the script file.
+     * @param tutorialInformation The information of the tutorial, if valid.
+     */
+    void insert(const QString& fileName, const QString& interpreter,
+                const TutorialInformation* tutorialInformation);
+
+    /**
+     * Removes the entries that were not used since this TutorialIndex was
+     * created.
+     */
+    void removeUnusedEntries();
+
+    /**
+     * Writes the index to its file.
+     */
+    void save();
+
+private:
+
+    /**
+     * The configuration file that stores the index.
+     */
+    KConfig* mConfig;
+
+    /**
+     * The names of the files checked or inserted since the index was loaded.
+     */
+    QSet<QString> mUsedEntries;
+
+    /**
+     * Removes all the entries.
+     */
+    void clear();
+
+    /**
+     * Returns the last modification time, in seconds since the epoch, of the
+     * side-car desktop file of the given script.
+     *
+     * @param fileName The name of the script file.
+     * @return The modification time of the side-car file, or 0 if there is no
+     *         side-car file.
+     */
+    uint sideCarLastModified(const QString& fileName) const;
+
+};
+
+}
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include "WindowOnTopEnforcer.h"
 #include "../Option.h"
 #include "../Step.h"
+#include "../Tracer.h"
 
 namespace ktutorial {
 namespace view {
@@ -75,6 +76,8 @@ void StepWidget::setMainApplicationWindow(QWidget* mainApplicationWindow) {
 //public slots:
 
 void StepWidget::setStep(Step* step) {
+    ScopedTrace trace("StepWidget::setStep", step->id());
+
     ui->textWidget->setText(step->text());
     setOptions(step->options());
 
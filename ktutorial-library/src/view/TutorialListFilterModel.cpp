@@ -0,0 +1,158 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include "TutorialListFilterModel.h"
+
+#include "TutorialListModel.h"
+#include "../TutorialInformation.h"
+
+namespace ktutorial {
+namespace view {
+
+//public:
+
+TutorialListFilterModel::TutorialListFilterModel(
+                                        TutorialListModel* tutorialListModel,
+                                        QObject* parent /*= 0*/):
+        QSortFilterProxyModel(parent),
+    mTutorialListModel(tutorialListModel) {
+    setSourceModel(tutorialListModel);
+    setDynamicSortFilter(true);
+    setSortCaseSensitivity(Qt::CaseInsensitive);
+    sort(0);
+
+    connect(tutorialListModel,
+            SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),
+            this, SLOT(forgetRows(QModelIndex,int,int)));
+    connect(tutorialListModel, SIGNAL(dataChanged(QModelIndex,QModelIndex)),
+            this, SLOT(forgetChangedRows(QModelIndex,QModelIndex)));
+    connect(tutorialListModel, SIGNAL(modelAboutToBeReset()),
+            this, SLOT(forgetAllRows()));
+}
+
+QString TutorialListFilterModel::filterText() const {
+    return mFilterText;
+}
+
+const TutorialInformation*
+TutorialListFilterModel::getTutorialInformationForIndex(
+                                            const QModelIndex& index) const {
+    return mTutorialListModel->getTutorialInformationForIndex(
+                                                        mapToSource(index));
+}
+
+//public slots:
+
+void TutorialListFilterModel::setFilterText(const QString& filterText) {
+    QString foldedFilterText = filterText.toCaseFolded();
+    if (foldedFilterText == mFilterText) {
+        return;
+    }
+
+    //If the new text does not contain the previous one, a tutorial rejected
+    //with the previous text may match the new one
+    if (!foldedFilterText.contains(mFilterText)) {
+        mRejectedTutorials.clear();
+    }
+
+    mFilterText = foldedFilterText;
+
+    invalidateFilter();
+}
+
+//protected:
+
+bool TutorialListFilterModel::filterAcceptsRow(int sourceRow,
+                                const QModelIndex& sourceParent) const {
+    Q_UNUSED(sourceParent);
+
+    if (mFilterText.isEmpty()) {
+        return true;
+    }
+
+    const TutorialInformation* tutorialInformation =
+                    mTutorialListModel->getTutorialInformationForIndex(
+                                    mTutorialListModel->index(sourceRow));
+    if (tutorialInformation == 0) {
+        return false;
+    }
+
+    if (mRejectedTutorials.contains(tutorialInformation)) {
+        return false;
+    }
+
+    if (!searchText(tutorialInformation).contains(mFilterText)) {
+        mRejectedTutorials.insert(tutorialInformation);
+        return false;
+    }
+
+    return true;
+}
+
+//private:
+
+const QString& TutorialListFilterModel::searchText(
+                        const TutorialInformation* tutorialInformation) const {
+    QHash<const TutorialInformation*, QString>::iterator it =
+                                    mSearchTexts.find(tutorialInformation);
+    if (it == mSearchTexts.end()) {
+        QString text = tutorialInformation->name() + '\n' +
+                       tutorialInformation->description();
+        it = mSearchTexts.insert(tutorialInformation, text.toCaseFolded());
+    }
+
+    return it.value();
+}
+
+//private slots:
+
+void TutorialListFilterModel::forgetRows(const QModelIndex& parent, int start,
+                                         int end) {
+    Q_UNUSED(parent);
+
+    for (int row = start; row <= end; ++row) {
+        const TutorialInformation* tutorialInformation =
+                    mTutorialListModel->getTutorialInformationForIndex(
+                                            mTutorialListModel->index(row));
+        mSearchTexts.remove(tutorialInformation);
+        mRejectedTutorials.remove(tutorialInformation);
+    }
+}
+
+void TutorialListFilterModel::forgetChangedRows(const QModelIndex& topLeft,
+                                        const QModelIndex& bottomRight) {
+    forgetRows(QModelIndex(), topLeft.row(), bottomRight.row());
+
+    //Without filter text every tutorial is accepted, so there is nothing to
+    //filter again
+    if (mFilterText.isEmpty()) {
+        return;
+    }
+
+    //The proxy handles the dataChanged signal of the source model before this
+    //slot is called, so the changed rows were filtered with the old text
+    invalidateFilter();
+}
+
+void TutorialListFilterModel::forgetAllRows() {
+    mSearchTexts.clear();
+    mRejectedTutorials.clear();
+}
+
+}
+}
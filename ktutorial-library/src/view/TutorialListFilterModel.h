@@ -0,0 +1,170 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#ifndef KTUTORIAL_VIEW_TUTORIALLISTFILTERMODEL_H
+#define KTUTORIAL_VIEW_TUTORIALLISTFILTERMODEL_H
+
+#include <QHash>
+#include <QSet>
+#include <QSortFilterProxyModel>
+
+namespace ktutorial {
+class TutorialInformation;
+}
+
+namespace ktutorial {
+namespace view {
+class TutorialListModel;
+}
+}
+
+namespace ktutorial {
+namespace view {
+
+/**
+ * Proxy model to filter the tutorials of a TutorialListModel by a text.
+ * Only the tutorials which name or description contains the filter text
+ * (ignoring the case) are shown. The tutorials are sorted by their name,
+ * ignoring the case.
+ *
+ * The filter is incremental: when the new filter text contains the previous
+ * one (for example, when the user types one more character in a search line),
+ * the tutorials that did not match the previous text are known to not match
+ * the new one either, so they are not checked again. Moreover, the text to
+ * search in is computed only once for each tutorial. When the name or the
+ * description of a tutorial change, its cached data is forgotten and, if there
+ * is a filter text, the filter applied again.
+ */
+class TutorialListFilterModel: public QSortFilterProxyModel {
+Q_OBJECT
+public:
+
+    /**
+     * Creates a new TutorialListFilterModel for the given TutorialListModel.
+     *
+     * @param tutorialListModel The source model.
+     * @param parent The parent QObject, defaults to null.
+     */
+    explicit TutorialListFilterModel(TutorialListModel* tutorialListModel,
+                                     QObject* parent = 0);
+
+    /**
+     * Returns the text used to filter the tutorials.
+     *
+     * @return The text used to filter the tutorials.
+     */
+    QString filterText() const;
+
+    /**
+     * Returns the TutorialInformation associated with the specified index.
+     * If the index is invalid, a null pointer is returned.
+     *
+     * @param index The index of this model to get its associated
+     *        TutorialInformation.
+     * @return The TutorialInformation associated with the specified index.
+     */
+    const TutorialInformation* getTutorialInformationForIndex(
+                                                const QModelIndex& index) const;
+
+public Q_SLOTS:
+
+    /**
+     * Sets the text used to filter the tutorials.
+     * An empty text shows all the tutorials.
+     *
+     * @param filterText The text to filter the tutorials with.
+     */
+    void setFilterText(const QString& filterText);
+
+protected:
+
+    /**
+     * Returns whether the tutorial in the given row of the source model
+     * matches the filter text or not.
+     *
+     * @param sourceRow The row in the source model.
+     * @param sourceParent Ignored.
+     * @return True if the tutorial matches the filter text, false otherwise.
+     */
+    virtual bool filterAcceptsRow(int sourceRow,
+                                  const QModelIndex& sourceParent) const;
+
+private:
+
+    /**
+     * The source model.
+     */
+    TutorialListModel* mTutorialListModel;
+
+    /**
+     * The text to filter the tutorials with, already case folded.
+     */
+    QString mFilterText;
+
+    /**
+     * The case folded name and description of each tutorial checked against
+     * the filter.
+     */
+    mutable QHash<const TutorialInformation*, QString> mSearchTexts;
+
+    /**
+     * The tutorials that do not match the current filter text.
+     */
+    mutable QSet<const TutorialInformation*> mRejectedTutorials;
+
+    /**
+     * Returns the case folded name and description of the given tutorial.
+     *
+     * @param tutorialInformation The tutorial to get its text.
+     * @return The case folded text to search the filter in.
+     */
+    const QString& searchText(
+                    const TutorialInformation* tutorialInformation) const;
+
+private Q_SLOTS:
+
+    /**
+     * Forgets the cached data of the tutorials that are about to be removed.
+     *
+     * @param parent Ignored.
+     * @param start The first row to be removed.
+     * @param end The last row to be removed.
+     */
+    void forgetRows(const QModelIndex& parent, int start, int end);
+
+    /**
+     * Forgets the cached data of the tutorials that changed, and filters them
+     * again if there is a filter text.
+     *
+     * @param topLeft The first changed row.
+     * @param bottomRight The last changed row.
+     */
+    void forgetChangedRows(const QModelIndex& topLeft,
+                           const QModelIndex& bottomRight);
+
+    /**
+     * Forgets the cached data of all the tutorials.
+     */
+    void forgetAllRows();
+
+};
+
+}
+}
+
+#endif
@@ -30,6 +30,34 @@ namespace view {
 
 //public:
 
+TutorialListModel::TutorialListModel(const TutorialManager* tutorialManager,
+                                     QObject* parent /*= 0*/):
+        QAbstractListModel(parent),
+    mTutorialManager(tutorialManager) {
+    connect(tutorialManager,
+            SIGNAL(tutorialAboutToBeRegistered(const TutorialInformation*,int)),
+            this,
+            SLOT(handleTutorialAboutToBeRegistered(const TutorialInformation*,
+                                                   int)));
+    connect(tutorialManager,
+            SIGNAL(tutorialRegistered(const TutorialInformation*)),
+            this, SLOT(handleTutorialRegistered()));
+    connect(tutorialManager,
+            SIGNAL(tutorialAboutToBeUnregistered(const TutorialInformation*,
+                                                 int)),
+            this,
+            SLOT(handleTutorialAboutToBeUnregistered(
+                                        const TutorialInformation*, int)));
+    connect(tutorialManager,
+            SIGNAL(tutorialUnregistered(const TutorialInformation*)),
+            this, SLOT(handleTutorialUnregistered()));
+    connect(tutorialManager,
+            SIGNAL(tutorialInformationChanged(const TutorialInformation*,int)),
+            this,
+            SLOT(handleTutorialInformationChanged(const TutorialInformation*,
+                                                  int)));
+}
+
 int TutorialListModel::rowCount(const QModelIndex& /*parent = QModelIndex()*/) const {
     return mTutorialManager->tutorialInformations().count();
 }
@@ -67,11 +95,47 @@ const TutorialInformation* TutorialListModel::getTutorialInformationForIndex(
         return 0;
     }
 
-    if (index.row() >= mTutorialManager->tutorialInformations().count()) {
+    QList<const TutorialInformation*> tutorialInformations =
+                                    mTutorialManager->tutorialInformations();
+    if (index.row() >= tutorialInformations.count()) {
         return 0;
     }
 
-    return mTutorialManager->tutorialInformations()[index.row()];
+    return tutorialInformations.at(index.row());
+}
+
+//private slots:
+
+void TutorialListModel::handleTutorialAboutToBeRegistered(
+                            const TutorialInformation* tutorialInformation,
+                            int index) {
+    Q_UNUSED(tutorialInformation);
+
+    beginInsertRows(QModelIndex(), index, index);
+}
+
+void TutorialListModel::handleTutorialRegistered() {
+    endInsertRows();
+}
+
+void TutorialListModel::handleTutorialAboutToBeUnregistered(
+                            const TutorialInformation* tutorialInformation,
+                            int index) {
+    Q_UNUSED(tutorialInformation);
+
+    beginRemoveRows(QModelIndex(), index, index);
+}
+
+void TutorialListModel::handleTutorialUnregistered() {
+    endRemoveRows();
+}
+
+void TutorialListModel::handleTutorialInformationChanged(
+                            const TutorialInformation* tutorialInformation,
+                            int index) {
+    Q_UNUSED(tutorialInformation);
+
+    emit dataChanged(this->index(index), this->index(index));
 }
 
 }
@@ -39,6 +39,13 @@ namespace view {
  *
  * To know the TutorialInformation associated with an index, use
  * getTutorialInformationForIndex(const QModelIndex&).
+ *
+ * The tutorials registered in the TutorialManager after the model was created
+ * are added to the model as they are registered, and they are removed from the
+ * model when they are unregistered. The data is read directly from the list
+ * kept by the TutorialManager, so the model does not store any copy of it. When
+ * the name or the description of a tutorial change, dataChanged() is emitted
+ * for its row.
  */
 class TutorialListModel: public QAbstractListModel {
 Q_OBJECT
@@ -52,10 +59,7 @@ public:
      * @param parent The parent QObject, defaults to null.
      */
     explicit TutorialListModel(const TutorialManager* tutorialManager,
-                               QObject* parent = 0):
-        QAbstractListModel(parent),
-        mTutorialManager(tutorialManager) {
-    }
+                               QObject* parent = 0);
 
     /**
      * Returns the number of available tutorials.
@@ -106,6 +110,49 @@ private:
      */
     const TutorialManager* mTutorialManager;
 
+private Q_SLOTS:
+
+    /**
+     * Notifies the views that a row is going to be inserted at the given index.
+     *
+     * @param tutorialInformation Ignored.
+     * @param index The index of the tutorial to register.
+     */
+    void handleTutorialAboutToBeRegistered(
+                            const TutorialInformation* tutorialInformation,
+                            int index);
+
+    /**
+     * Notifies the views that the row was inserted.
+     */
+    void handleTutorialRegistered();
+
+    /**
+     * Notifies the views that the row at the given index is going to be
+     * removed.
+     *
+     * @param tutorialInformation Ignored.
+     * @param index The index of the tutorial to unregister.
+     */
+    void handleTutorialAboutToBeUnregistered(
+                            const TutorialInformation* tutorialInformation,
+                            int index);
+
+    /**
+     * Notifies the views that the row was removed.
+     */
+    void handleTutorialUnregistered();
+
+    /**
+     * Notifies the views that the data of the row at the given index changed.
+     *
+     * @param tutorialInformation Ignored.
+     * @param index The index of the changed tutorial.
+     */
+    void handleTutorialInformationChanged(
+                            const TutorialInformation* tutorialInformation,
+                            int index);
+
 };
 
 }
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include "TutorialManagerDialog.h"
+#include "TutorialListFilterModel.h"
 #include "TutorialListModel.h"
 #include "ui_TutorialManagerDialog.h"
 #include "../TutorialInformation.h"
@@ -44,7 +45,12 @@ TutorialManagerDialog::TutorialManagerDialog(TutorialManager* tutorialManager,
     setCaption(i18nc("@title:window", "Tutorial manager"));
     setButtons(KDialog::User1 | KDialog::Close);
 
-    ui->tutorialsList->setModel(new TutorialListModel(tutorialManager, this));
+    TutorialListFilterModel* filterModel = new TutorialListFilterModel(
+                            new TutorialListModel(tutorialManager, this), this);
+    ui->tutorialsList->setModel(filterModel);
+
+    connect(ui->searchLineEdit, SIGNAL(textChanged(QString)),
+            filterModel, SLOT(setFilterText(QString)));
 
     setButtonIcon(User1, KIcon("dialog-ok"));
     setButtonText(User1, i18nc("@action:button Used to start a tutorial", "Start"));
@@ -75,6 +81,9 @@ void TutorialManagerDialog::finish() {
 
 void TutorialManagerDialog::select(const TutorialInformation* tutorialInformation) {
     if (tutorialInformation == 0) {
+        enableButton(User1, false);
+        ui->descriptionLabel->clear();
+        mCurrentTutorialInformation = 0;
         return;
     }
 
@@ -88,7 +97,13 @@ void TutorialManagerDialog::select(const TutorialInformation* tutorialInformatio
 //private slots:
 
 void TutorialManagerDialog::select(const QItemSelection& selected) {
-    const TutorialListModel* model = qobject_cast<const TutorialListModel*>(selected.indexes()[0].model());
+    //The selected tutorial may have been hidden by the search filter
+    if (selected.indexes().isEmpty()) {
+        select(0);
+        return;
+    }
+
+    const TutorialListFilterModel* model = qobject_cast<const TutorialListFilterModel*>(selected.indexes()[0].model());
 
     select(model->getTutorialInformationForIndex(selected.indexes()[0]));
 }
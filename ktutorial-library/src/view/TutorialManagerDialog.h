@@ -41,7 +41,8 @@ namespace view {
  * A dialog to show the available tutorials and start them.
  * The tutorials are shown in a plain list containing their names. When a
  * tutorial is selected, its description is shown in a field designed for this
- * purpose.
+ * purpose. The list can be filtered by typing in a search line; only the
+ * tutorials which name or description contain the typed text are shown.
  *
  * The dialog contains a user defined and a close button. The user defined
  * button is a start button, enabled when a tutorial is selected. Once a
@@ -94,7 +95,8 @@ private:
     /**
      * Selects the tutorial identified by its TutorialInformation.
      * The description of the tutorial is shown in the Description field of this
-     * dialog.
+     * dialog. If the TutorialInformation is null, the current tutorial is
+     * deselected.
      *
      * @param tutorialInformation The TutorialInformation of the selected
      *        tutorial.
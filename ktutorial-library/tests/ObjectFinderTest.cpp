@@ -23,7 +23,11 @@
 
 #include <KXmlGuiWindow>
 
+#define private public
 #include "ObjectFinder.h"
+#undef private
+
+#include "ObjectFinder_p.h"
 
 namespace ktutorial {
 
@@ -57,6 +61,20 @@ private slots:
     void testFindObjectSlashEndedName();
     void testFindObjectSeveralSlashes();
 
+    void testPrefetchObject();
+    void testPrefetchObjectUnknown();
+    void testPrefetchObjectOtherType();
+    void testPrefetchObjectThenChildAdded();
+    void testPrefetchObjectThenBetterMatchAdded();
+    void testPrefetchObjectThenFindSubclass();
+    void testPrefetchObjectThenAncestorReparented();
+    void testPrefetchObjectThenObjectDestroyed();
+    void testPrefetchObjectThenObjectRenamed();
+    void testPrefetchObjectAgain();
+    void testClearPrefetchedObjects();
+
+    void testRecordLookups();
+
 private:
 
     KXmlGuiWindow* mMainWindow;
@@ -441,6 +459,247 @@ void ObjectFinderTest::testFindObjectSeveralSlashes() {
     assertFindObject("Parent1///The object", mObject1_1_1);
 }
 
+void ObjectFinderTest::testPrefetchObject() {
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("Parent1/The object", mMainWindow,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.findObject<QObject*>("Parent1/The object",
+                                               mMainWindow), mObject1_1_1);
+    QCOMPARE(objectFinder.findObject<QObject*>("Parent1/The object",
+                                               mMainWindow), mObject1_1_1);
+}
+
+void ObjectFinderTest::testPrefetchObjectUnknown() {
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("Unknown object", mMainWindow,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.findObject<QObject*>("Unknown object", mMainWindow),
+             (QObject*)0);
+}
+
+void ObjectFinderTest::testPrefetchObjectOtherType() {
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("Grand parent2/Parent1", mMainWindow,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.findObject<QAction*>("Grand parent2/Parent1",
+                                               mMainWindow), (QAction*)0);
+    QCOMPARE(objectFinder.findObject<QObject*>("Grand parent2/Parent1",
+                                               mMainWindow),
+             mObject2_1_1->parent());
+}
+
+void ObjectFinderTest::testPrefetchObjectThenChildAdded() {
+    QObject baseObject;
+    QObject* unnamedObject = new QObject(&baseObject);
+    QObject* nestedObject = new QObject(unnamedObject);
+    nestedObject->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.findObject<QObject*>("The object", &baseObject),
+             nestedObject);
+
+    //Adding objects to the base object or to any object in the path to the
+    //prefetched object discards it, as they could be a better match
+    new QObject(unnamedObject);
+
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+    QVERIFY(objectFinder.d->mPrefetchedObjects.isEmpty());
+    QVERIFY(objectFinder.d->mKeysByWatchedObject.isEmpty());
+
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+    new QObject(&baseObject);
+
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+}
+
+void ObjectFinderTest::testPrefetchObjectThenBetterMatchAdded() {
+    QObject baseObject;
+    QObject* unnamedObject = new QObject(&baseObject);
+    QObject* nestedObject = new QObject(unnamedObject);
+    nestedObject->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    QObject* directChild = new QObject(&baseObject);
+    directChild->setObjectName("The object");
+
+    QCOMPARE(objectFinder.findObject<QObject*>("The object", &baseObject),
+             directChild);
+}
+
+void ObjectFinderTest::testPrefetchObjectThenFindSubclass() {
+    QWidget baseWidget;
+    QObject* object = new QObject(&baseWidget);
+    object->setObjectName("The object");
+    QWidget* widget = new QWidget(&baseWidget);
+    widget->setObjectName("The widget");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseWidget,
+                                &QObject::staticMetaObject);
+    objectFinder.prefetchObject("The widget", &baseWidget,
+                                &QObject::staticMetaObject);
+
+    //An object prefetched as a QObject is returned when looking for a QWidget
+    //only if it is a QWidget
+    QCOMPARE(objectFinder.cachedObject("The object", &baseWidget,
+                                       &QWidget::staticMetaObject),
+             (QObject*)0);
+    QCOMPARE(objectFinder.cachedObject("The widget", &baseWidget,
+                                       &QWidget::staticMetaObject),
+             (QObject*)widget);
+    QCOMPARE(objectFinder.findObject<QWidget*>("The widget", &baseWidget),
+             widget);
+
+    //But an object prefetched as a QWidget is not returned when looking for a
+    //QObject, as a better match that is not a QWidget could exist
+    widget->setObjectName("The other widget");
+    objectFinder.prefetchObject("The other widget", &baseWidget,
+                                &QWidget::staticMetaObject);
+
+    QCOMPARE(objectFinder.cachedObject("The other widget", &baseWidget,
+                                       &QWidget::staticMetaObject),
+             (QObject*)widget);
+    QCOMPARE(objectFinder.cachedObject("The other widget", &baseWidget,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+}
+
+void ObjectFinderTest::testPrefetchObjectThenAncestorReparented() {
+    QObject baseObject;
+    QObject* unnamedObject = new QObject(&baseObject);
+    QObject* nestedObject = new QObject(unnamedObject);
+    nestedObject->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.d->mKeysByWatchedObject.count(), 3);
+
+    QObject otherBaseObject;
+    unnamedObject->setParent(&otherBaseObject);
+
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+    QVERIFY(objectFinder.d->mPrefetchedObjects.isEmpty());
+    QVERIFY(objectFinder.d->mKeysByWatchedObject.isEmpty());
+    QCOMPARE(objectFinder.findObject<QObject*>("The object", &baseObject),
+             (QObject*)0);
+}
+
+void ObjectFinderTest::testPrefetchObjectThenObjectDestroyed() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    delete object;
+
+    QVERIFY(objectFinder.d->mPrefetchedObjects.isEmpty());
+    QVERIFY(objectFinder.d->mKeysByWatchedObject.isEmpty());
+    QCOMPARE(objectFinder.findObject<QObject*>("The object", &baseObject),
+             (QObject*)0);
+}
+
+void ObjectFinderTest::testPrefetchObjectThenObjectRenamed() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    object->setObjectName("Renamed object");
+
+    QCOMPARE(objectFinder.findObject<QObject*>("The object", &baseObject),
+             (QObject*)0);
+    QCOMPARE(objectFinder.findObject<QObject*>("Renamed object", &baseObject),
+             object);
+}
+
+void ObjectFinderTest::testPrefetchObjectAgain() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    object->setObjectName("Renamed object");
+    QObject* newObject = new QObject(&baseObject);
+    newObject->setObjectName("The object");
+
+    objectFinder.prefetchObject("The object", &baseObject,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.d->mPrefetchedObjects.count(), 1);
+    QCOMPARE(objectFinder.d->mKeysByWatchedObject.count(), 2);
+    QVERIFY(objectFinder.d->mKeysByWatchedObject.contains(newObject));
+    QVERIFY(objectFinder.d->mKeysByWatchedObject.contains(&baseObject));
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject),
+             newObject);
+}
+
+void ObjectFinderTest::testClearPrefetchedObjects() {
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject("Parent1/The object", mMainWindow,
+                                &QObject::staticMetaObject);
+    objectFinder.prefetchObject("Grand parent2/Parent1", mMainWindow,
+                                &QObject::staticMetaObject);
+
+    QCOMPARE(objectFinder.d->mPrefetchedObjects.count(), 2);
+
+    objectFinder.clearPrefetchedObjects();
+
+    QVERIFY(objectFinder.d->mPrefetchedObjects.isEmpty());
+    QVERIFY(objectFinder.d->mKeysByWatchedObject.isEmpty());
+    QCOMPARE(objectFinder.cachedObject("Parent1/The object", mMainWindow,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+}
+
+void ObjectFinderTest::testRecordLookups() {
+    ObjectFinder objectFinder;
+    objectFinder.findObject<QObject*>("Parent2/The object", mMainWindow);
+
+    objectFinder.startRecordingLookups();
+    objectFinder.findObject<QObject*>("Parent1/The object", mMainWindow);
+    objectFinder.findObject<QAction*>("The action", mMainWindow);
+    QList<ObjectFinder::Lookup> lookups = objectFinder.stopRecordingLookups();
+
+    objectFinder.findObject<QObject*>("Parent2/The object", mMainWindow);
+
+    QCOMPARE(lookups.count(), 2);
+    QCOMPARE(lookups[0].mName, QString("Parent1/The object"));
+    QCOMPARE(lookups[0].mBaseObject.data(), (QObject*)mMainWindow);
+    QCOMPARE(lookups[0].mMetaObject, &QObject::staticMetaObject);
+    QCOMPARE(lookups[1].mName, QString("The action"));
+    QCOMPARE(lookups[1].mBaseObject.data(), (QObject*)mMainWindow);
+    QCOMPARE(lookups[1].mMetaObject, &QAction::staticMetaObject);
+    QVERIFY(objectFinder.stopRecordingLookups().isEmpty());
+}
+
 /////////////////////////////////Helpers////////////////////////////////////////
 
 void ObjectFinderTest::assertFindObject(const QString& objectName,
@@ -104,6 +104,10 @@ private slots:
     void testRemoveWaitForAssociatedToStepId();
     void testRemoveWaitForSeveralWaitFors();
 
+    void testNextStepIds();
+
+    void testAddPrefetchedObjectName();
+
 };
 
 class InspectedStep: public Step {
@@ -933,6 +937,40 @@ void StepTest::testRemoveWaitForSeveralWaitFors() {
     QCOMPARE(nextStepRequestedSpy.count(), 1);
 }
 
+void StepTest::testNextStepIds() {
+    Step step("doSomethingConstructive");
+
+    step.addWaitFor(new WaitForSignal(this, SIGNAL(dummySignal())),
+                    "batheYourIguanaStep");
+    step.addWaitFor(new WaitForSignal(this, SIGNAL(anotherDummySignal())),
+                    this, SLOT(dummySlot()));
+    step.addOption(new Option("Feed a toucan"), "feedAToucanStep");
+    step.addWaitFor(new WaitForSignal(this, SIGNAL(thirdDummySignal())),
+                    "batheYourIguanaStep");
+
+    //It will be removed and not deleted by parent Step, so it is created in
+    //stack
+    WaitForSignal waitFor(this, SIGNAL(fourthDummySignal()));
+    step.addWaitFor(&waitFor, "feedAPigStep");
+    step.removeWaitFor(&waitFor);
+
+    QStringList nextStepIds = step.nextStepIds();
+    QCOMPARE(nextStepIds.count(), 2);
+    QCOMPARE(nextStepIds[0], QString("batheYourIguanaStep"));
+    QCOMPARE(nextStepIds[1], QString("feedAToucanStep"));
+}
+
+void StepTest::testAddPrefetchedObjectName() {
+    Step step("doSomethingConstructiveStep");
+    step.addPrefetchedObjectName("theIguana");
+    step.addPrefetchedObjectName("theToucan");
+    step.addPrefetchedObjectName("theIguana");
+
+    QCOMPARE(step.prefetchedObjectNames().count(), 2);
+    QCOMPARE(step.prefetchedObjectNames()[0], QString("theIguana"));
+    QCOMPARE(step.prefetchedObjectNames()[1], QString("theToucan"));
+}
+
 /////////////////////////////////// Helpers ////////////////////////////////////
 
 void StepTest::assertStepId(const QSignalSpy& spy, int index,
@@ -0,0 +1,295 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#define private public
+#include "Tracer.h"
+#undef private
+
+#include <QSignalSpy>
+
+#include <KTemporaryFile>
+
+#include "Step.h"
+#include "Tutorial.h"
+#include "TutorialInformation.h"
+
+namespace ktutorial {
+
+class TracerTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void testSelf();
+    void testSelfIsDestroyedWithApplication();
+
+    void testSetEnabled();
+
+    void testSetCapacity();
+
+    void testAddSpan();
+    void testAddSpanWhenFull();
+
+    void testClear();
+
+    void testScopedTrace();
+    void testScopedTraceWhenDisabled();
+
+    void testChromeTrace();
+    void testChromeTraceWithSpecialCharacters();
+
+    void testExportChromeTrace();
+
+    void testStepTransition();
+    void testStepTransitionWhenDisabled();
+
+};
+
+void TracerTest::init() {
+    Tracer::self()->setCapacity(4096);
+    Tracer::self()->setCurrentStepId(QString());
+}
+
+void TracerTest::cleanup() {
+    Tracer::self()->setEnabled(false);
+    Tracer::self()->clear();
+}
+
+void TracerTest::testSelf() {
+    Tracer* tracer = Tracer::self();
+    Tracer* tracer2 = Tracer::self();
+
+    QVERIFY(tracer);
+    QVERIFY(tracer == tracer2);
+    QVERIFY(!Tracer::isEnabled());
+    QCOMPARE(tracer->spans().count(), 0);
+}
+
+void TracerTest::testSelfIsDestroyedWithApplication() {
+    Tracer* tracer = Tracer::self();
+
+    QCOMPARE(tracer->parent(), (QObject*)QCoreApplication::instance());
+
+    delete tracer;
+
+    QVERIFY(!Tracer::sSelf);
+    QVERIFY(Tracer::self());
+}
+
+void TracerTest::testSetEnabled() {
+    Tracer::self()->setEnabled(true);
+
+    QVERIFY(Tracer::isEnabled());
+
+    Tracer::self()->setEnabled(false);
+
+    QVERIFY(!Tracer::isEnabled());
+}
+
+void TracerTest::testSetCapacity() {
+    Tracer* tracer = Tracer::self();
+    tracer->addSpan("The span", "", 0, 1);
+
+    tracer->setCapacity(16);
+
+    QCOMPARE(tracer->capacity(), 16);
+    QCOMPARE(tracer->spans().count(), 0);
+}
+
+void TracerTest::testAddSpan() {
+    Tracer* tracer = Tracer::self();
+    tracer->setCurrentStepId("The step id");
+
+    QSignalSpy spanAddedSpy(tracer,
+                    SIGNAL(spanAdded(QString,QString,QString,qint64,qint64)));
+
+    tracer->addSpan("The span", "The detail", 4, 8);
+    tracer->addSpan("Another span", "", 15, 16);
+
+    QList<Tracer::Span> spans = tracer->spans();
+    QCOMPARE(spans.count(), 2);
+    QCOMPARE(spans[0].mName, QString("The span"));
+    QCOMPARE(spans[0].mDetail, QString("The detail"));
+    QCOMPARE(spans[0].mStepId, QString("The step id"));
+    QCOMPARE(spans[0].mStart, (qint64)4);
+    QCOMPARE(spans[0].mDuration, (qint64)8);
+    QCOMPARE(spans[1].mName, QString("Another span"));
+    QCOMPARE(spans[1].mDetail, QString(""));
+    QCOMPARE(spans[1].mStepId, QString("The step id"));
+    QCOMPARE(spans[1].mStart, (qint64)15);
+    QCOMPARE(spans[1].mDuration, (qint64)16);
+
+    QCOMPARE(spanAddedSpy.count(), 2);
+    QCOMPARE(spanAddedSpy.at(0).at(0).toString(), QString("The span"));
+    QCOMPARE(spanAddedSpy.at(0).at(1).toString(), QString("The detail"));
+    QCOMPARE(spanAddedSpy.at(0).at(2).toString(), QString("The step id"));
+    QCOMPARE(spanAddedSpy.at(0).at(3).toLongLong(), (qint64)4);
+    QCOMPARE(spanAddedSpy.at(0).at(4).toLongLong(), (qint64)8);
+}
+
+void TracerTest::testAddSpanWhenFull() {
+    Tracer* tracer = Tracer::self();
+    tracer->setCapacity(3);
+
+    for (int i=0; i<5; ++i) {
+        tracer->addSpan("Span " + QString::number(i), "", i, 1);
+    }
+
+    QList<Tracer::Span> spans = tracer->spans();
+    QCOMPARE(spans.count(), 3);
+    QCOMPARE(spans[0].mName, QString("Span 2"));
+    QCOMPARE(spans[1].mName, QString("Span 3"));
+    QCOMPARE(spans[2].mName, QString("Span 4"));
+}
+
+void TracerTest::testClear() {
+    Tracer* tracer = Tracer::self();
+    tracer->setCapacity(16);
+    tracer->addSpan("The span", "", 0, 1);
+
+    tracer->clear();
+
+    QCOMPARE(tracer->capacity(), 16);
+    QCOMPARE(tracer->spans().count(), 0);
+}
+
+void TracerTest::testScopedTrace() {
+    Tracer* tracer = Tracer::self();
+    tracer->setEnabled(true);
+
+    qint64 before = tracer->timestamp();
+    {
+        ScopedTrace trace("The span", "The detail");
+        QTest::qWait(10);
+    }
+
+    QList<Tracer::Span> spans = tracer->spans();
+    QCOMPARE(spans.count(), 1);
+    QCOMPARE(spans[0].mName, QString("The span"));
+    QCOMPARE(spans[0].mDetail, QString("The detail"));
+    QVERIFY(spans[0].mStart >= before);
+    QVERIFY(spans[0].mDuration >= 10000);
+}
+
+void TracerTest::testScopedTraceWhenDisabled() {
+    {
+        ScopedTrace trace("The span", "The detail");
+    }
+
+    QCOMPARE(Tracer::self()->spans().count(), 0);
+}
+
+void TracerTest::testChromeTrace() {
+    Tracer* tracer = Tracer::self();
+    tracer->setCurrentStepId("The step id");
+    tracer->addSpan("The span", "The detail", 4, 8);
+    tracer->setCurrentStepId("");
+    tracer->addSpan("Another span", "", 15, 16);
+
+    QByteArray processId =
+                    QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray expected = "{\"traceEvents\":[\n"
+"{\"name\":\"The span\",\"cat\":\"ktutorial\",\"ph\":\"X\",\"ts\":4,\"dur\":8,"
+"\"pid\":" + processId + ",\"tid\":1,"
+"\"args\":{\"step\":\"The step id\",\"detail\":\"The detail\"}},\n"
+"{\"name\":\"Another span\",\"cat\":\"ktutorial\",\"ph\":\"X\",\"ts\":15,"
+"\"dur\":16,\"pid\":" + processId + ",\"tid\":1,"
+"\"args\":{\"step\":\"\",\"detail\":\"\"}}\n"
+"],\"displayTimeUnit\":\"ms\"}\n";
+
+    QCOMPARE(tracer->chromeTrace(), expected);
+}
+
+void TracerTest::testChromeTraceWithSpecialCharacters() {
+    Tracer* tracer = Tracer::self();
+    tracer->addSpan("The span", QString::fromUtf8("\"A\\b\"\n\xc3\xb1"), 4,
+                    8);
+
+    QVERIFY(tracer->chromeTrace().contains(
+                "\"detail\":\"\\\"A\\\\b\\\"\\u000a\xc3\xb1\""));
+}
+
+void TracerTest::testExportChromeTrace() {
+    Tracer* tracer = Tracer::self();
+    tracer->addSpan("The span", "The detail", 4, 8);
+
+    KTemporaryFile temporaryFile;
+    QVERIFY(temporaryFile.open());
+
+    QVERIFY(tracer->exportChromeTrace(temporaryFile.fileName()));
+
+    QFile file(temporaryFile.fileName());
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), tracer->chromeTrace());
+}
+
+void TracerTest::testStepTransition() {
+    Tracer* tracer = Tracer::self();
+    tracer->setEnabled(true);
+
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+    tutorial.addStep(new Step("start"));
+    tutorial.addStep(new Step("record"));
+
+    tutorial.start();
+    tutorial.nextStep("record");
+    tutorial.finish();
+
+    QList<Tracer::Span> spans = tracer->spans();
+    QCOMPARE(spans.count(), 6);
+    QCOMPARE(spans[0].mName, QString("Step::setup"));
+    QCOMPARE(spans[0].mStepId, QString("start"));
+    QCOMPARE(spans[1].mName, QString("Tutorial::changeToStep"));
+    QCOMPARE(spans[1].mDetail, QString("start"));
+    QCOMPARE(spans[2].mName, QString("Step::tearDown"));
+    QCOMPARE(spans[2].mStepId, QString("start"));
+    QCOMPARE(spans[3].mName, QString("Step::setup"));
+    QCOMPARE(spans[3].mStepId, QString("record"));
+    QCOMPARE(spans[4].mName, QString("Tutorial::changeToStep"));
+    QCOMPARE(spans[4].mDetail, QString("record"));
+    QCOMPARE(spans[5].mName, QString("Step::tearDown"));
+    QCOMPARE(spans[5].mStepId, QString("record"));
+    QCOMPARE(tracer->currentStepId(), QString(""));
+}
+
+void TracerTest::testStepTransitionWhenDisabled() {
+    delete Tracer::self();
+
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+    tutorial.addStep(new Step("start"));
+    tutorial.addStep(new Step("record"));
+
+    tutorial.start();
+    tutorial.nextStep("record");
+    tutorial.finish();
+
+    //The instance (and its ring buffer) is not created when tracing is
+    //disabled
+    QVERIFY(!Tracer::sSelf);
+}
+
+}
+
+QTEST_MAIN(ktutorial::TracerTest)
+
+#include "TracerTest.moc"
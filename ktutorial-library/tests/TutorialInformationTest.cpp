@@ -19,6 +19,8 @@
 
 #include <QTest>
 
+#include <QSignalSpy>
+
 #include "TutorialInformation.h"
 
 namespace ktutorial {
@@ -31,8 +33,10 @@ private slots:
     void testConstructor();
 
     void testSetName();
+    void testSetNameChangedSignal();
 
     void testSetDescription();
+    void testSetDescriptionChangedSignal();
 
 };
 
@@ -51,6 +55,19 @@ void TutorialInformationTest::testSetName() {
     QCOMPARE(tutorialInformation.name(), QString("The name"));
 }
 
+void TutorialInformationTest::testSetNameChangedSignal() {
+    TutorialInformation tutorialInformation("someId");
+    QSignalSpy changedSpy(&tutorialInformation, SIGNAL(changed()));
+
+    tutorialInformation.setName("The name");
+
+    QCOMPARE(changedSpy.count(), 1);
+
+    tutorialInformation.setName("The name");
+
+    QCOMPARE(changedSpy.count(), 1);
+}
+
 void TutorialInformationTest::testSetDescription() {
     TutorialInformation tutorialInformation("screwLightbulbs");
     tutorialInformation.setDescription("The description");
@@ -58,6 +75,19 @@ void TutorialInformationTest::testSetDescription() {
     QCOMPARE(tutorialInformation.description(), QString("The description"));
 }
 
+void TutorialInformationTest::testSetDescriptionChangedSignal() {
+    TutorialInformation tutorialInformation("screwLightbulbs");
+    QSignalSpy changedSpy(&tutorialInformation, SIGNAL(changed()));
+
+    tutorialInformation.setDescription("The description");
+
+    QCOMPARE(changedSpy.count(), 1);
+
+    tutorialInformation.setDescription("The description");
+
+    QCOMPARE(changedSpy.count(), 1);
+}
+
 }
 
 QTEST_MAIN(ktutorial::TutorialInformationTest)
@@ -22,18 +22,21 @@
 
 #define protected public
 #define private public
+#include "Tutorial.h"
 #include "TutorialManager.h"
 #undef private
 #undef protected
 
 #include "TutorialManager_p.h"
+#include "Tutorial_p.h"
 
+#include "ObjectFinder.h"
 #include "Step.h"
-#include "Tutorial.h"
 #include "TutorialInformation.h"
 
 //Tutorial* must be declared as a metatype to be used in qvariant_cast
 Q_DECLARE_METATYPE(ktutorial::Tutorial*);
+Q_DECLARE_METATYPE(const ktutorial::TutorialInformation*);
 
 namespace ktutorial {
 
@@ -49,9 +52,19 @@ private slots:
     void testRegisterTutorialSeveralTutorials();
     void testRegisterTutorialTwice();
     void testRegisterTutorialDifferentTutorialWithSameId();
+    void testRegisterTutorialSignal();
+    void testRegisterTutorialSortedById();
+    void testRegisterTutorialAboutToBeRegisteredSignal();
+
+    void testUnregisterTutorial();
+    void testUnregisterTutorialNotRegistered();
+    void testUnregisterTutorialSignals();
+
+    void testTutorialInformationChangedSignal();
 
     void testStart();
     void testStartWithInvalidId();
+    void testStartSetsObjectFinder();
 
 private:
 
@@ -191,6 +204,151 @@ void TutorialManagerTest::testRegisterTutorialDifferentTutorialWithSameId() {
              mTutorialInformation2);
 }
 
+void TutorialManagerTest::testRegisterTutorialSignal() {
+    //TutorialInformation* must be registered in order to be used with
+    //QSignalSpy
+    qRegisterMetaType<const TutorialInformation*>("const TutorialInformation*");
+    QSignalSpy registeredSpy(mTutorialManager,
+                    SIGNAL(tutorialRegistered(const TutorialInformation*)));
+
+    mTutorialManager->registerTutorial(mTutorial1);
+
+    QCOMPARE(registeredSpy.count(), 1);
+    QVariant argument = registeredSpy.at(0).at(0);
+    QCOMPARE(qvariant_cast<const TutorialInformation*>(argument),
+             mTutorialInformation1);
+
+    //It will not be added and thus not deleted by TutorialManager, so it is
+    //created in stack
+    Tutorial tutorial3(new TutorialInformation("firstIdentifier"));
+    mTutorialManager->registerTutorial(&tutorial3);
+
+    QCOMPARE(registeredSpy.count(), 1);
+}
+
+void TutorialManagerTest::testRegisterTutorialSortedById() {
+    mTutorialManager->registerTutorial(mTutorial2);
+    mTutorialManager->registerTutorial(mTutorial1);
+
+    TutorialInformation* tutorialInformation3 =
+                                    new TutorialInformation("aIdentifier");
+    mTutorialManager->registerTutorial(new Tutorial(tutorialInformation3));
+
+    QCOMPARE(mTutorialManager->tutorialInformations().size(), 3);
+    QCOMPARE(mTutorialManager->tutorialInformations()[0],
+             (const TutorialInformation*)tutorialInformation3);
+    QCOMPARE(mTutorialManager->tutorialInformations()[1],
+             (const TutorialInformation*)mTutorialInformation1);
+    QCOMPARE(mTutorialManager->tutorialInformations()[2],
+             (const TutorialInformation*)mTutorialInformation2);
+}
+
+void TutorialManagerTest::testRegisterTutorialAboutToBeRegisteredSignal() {
+    //TutorialInformation* must be registered in order to be used with
+    //QSignalSpy
+    qRegisterMetaType<const TutorialInformation*>("const TutorialInformation*");
+    QSignalSpy aboutToBeRegisteredSpy(mTutorialManager,
+        SIGNAL(tutorialAboutToBeRegistered(const TutorialInformation*,int)));
+
+    mTutorialManager->registerTutorial(mTutorial2);
+    mTutorialManager->registerTutorial(mTutorial1);
+
+    QCOMPARE(aboutToBeRegisteredSpy.count(), 2);
+    QVariant argument = aboutToBeRegisteredSpy.at(0).at(0);
+    QCOMPARE(qvariant_cast<const TutorialInformation*>(argument),
+             (const TutorialInformation*)mTutorialInformation2);
+    QCOMPARE(aboutToBeRegisteredSpy.at(0).at(1).toInt(), 0);
+    argument = aboutToBeRegisteredSpy.at(1).at(0);
+    QCOMPARE(qvariant_cast<const TutorialInformation*>(argument),
+             (const TutorialInformation*)mTutorialInformation1);
+    QCOMPARE(aboutToBeRegisteredSpy.at(1).at(1).toInt(), 0);
+}
+
+void TutorialManagerTest::testUnregisterTutorial() {
+    mTutorialManager->registerTutorial(mTutorial1);
+    mTutorialManager->registerTutorial(mTutorial2);
+
+    QCOMPARE(mTutorialManager->unregisterTutorial("firstIdentifier"),
+             mTutorial1);
+
+    QCOMPARE(mTutorial1->parent(), (QObject*)0);
+    QCOMPARE(mTutorialManager->tutorialInformations().size(), 1);
+    QCOMPARE(mTutorialManager->tutorialInformations()[0],
+             (const TutorialInformation*)mTutorialInformation2);
+    QCOMPARE(mTutorialManager->d->mTutorials.size(), 1);
+    QCOMPARE(mTutorialManager->d->mTutorials.value(mTutorialInformation2),
+             mTutorial2);
+    QCOMPARE(mTutorialManager->d->mTutorialInformations.size(), 1);
+    QCOMPARE(mTutorialManager->d->mTutorialInformations.value(
+                                                            "secondIdentifier"),
+             mTutorialInformation2);
+}
+
+void TutorialManagerTest::testUnregisterTutorialNotRegistered() {
+    mTutorialManager->registerTutorial(mTutorial1);
+
+    QCOMPARE(mTutorialManager->unregisterTutorial("secondIdentifier"),
+             (Tutorial*)0);
+
+    QCOMPARE(mTutorialManager->tutorialInformations().size(), 1);
+    QCOMPARE(mTutorialManager->d->mTutorials.size(), 1);
+    QCOMPARE(mTutorialManager->d->mTutorialInformations.size(), 1);
+}
+
+void TutorialManagerTest::testUnregisterTutorialSignals() {
+    mTutorialManager->registerTutorial(mTutorial1);
+    mTutorialManager->registerTutorial(mTutorial2);
+
+    //TutorialInformation* must be registered in order to be used with
+    //QSignalSpy
+    qRegisterMetaType<const TutorialInformation*>("const TutorialInformation*");
+    QSignalSpy aboutToBeUnregisteredSpy(mTutorialManager,
+        SIGNAL(tutorialAboutToBeUnregistered(const TutorialInformation*,int)));
+    QSignalSpy unregisteredSpy(mTutorialManager,
+                    SIGNAL(tutorialUnregistered(const TutorialInformation*)));
+
+    mTutorialManager->unregisterTutorial("secondIdentifier");
+
+    QCOMPARE(aboutToBeUnregisteredSpy.count(), 1);
+    QVariant argument = aboutToBeUnregisteredSpy.at(0).at(0);
+    QCOMPARE(qvariant_cast<const TutorialInformation*>(argument),
+             (const TutorialInformation*)mTutorialInformation2);
+    QCOMPARE(aboutToBeUnregisteredSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(unregisteredSpy.count(), 1);
+    argument = unregisteredSpy.at(0).at(0);
+    QCOMPARE(qvariant_cast<const TutorialInformation*>(argument),
+             (const TutorialInformation*)mTutorialInformation2);
+
+    mTutorialManager->unregisterTutorial("secondIdentifier");
+
+    QCOMPARE(aboutToBeUnregisteredSpy.count(), 1);
+    QCOMPARE(unregisteredSpy.count(), 1);
+}
+
+void TutorialManagerTest::testTutorialInformationChangedSignal() {
+    mTutorialManager->registerTutorial(mTutorial1);
+    mTutorialManager->registerTutorial(mTutorial2);
+
+    //TutorialInformation* must be registered in order to be used with
+    //QSignalSpy
+    qRegisterMetaType<const TutorialInformation*>("const TutorialInformation*");
+    QSignalSpy changedSpy(mTutorialManager,
+        SIGNAL(tutorialInformationChanged(const TutorialInformation*,int)));
+
+    mTutorialInformation2->setName("The name");
+
+    QCOMPARE(changedSpy.count(), 1);
+    QVariant argument = changedSpy.at(0).at(0);
+    QCOMPARE(qvariant_cast<const TutorialInformation*>(argument),
+             (const TutorialInformation*)mTutorialInformation2);
+    QCOMPARE(changedSpy.at(0).at(1).toInt(), 1);
+
+    mTutorialManager->unregisterTutorial("secondIdentifier");
+    mTutorialInformation2->setName("The new name");
+
+    QCOMPARE(changedSpy.count(), 1);
+}
+
 void TutorialManagerTest::testStart() {
     mTutorialManager->registerTutorial(mTutorial1);
 
@@ -234,6 +392,22 @@ void TutorialManagerTest::testStartWithInvalidId() {
     QCOMPARE(finishedSpy.count(), 1);
 }
 
+void TutorialManagerTest::testStartSetsObjectFinder() {
+    mTutorialManager->registerTutorial(mTutorial1);
+
+    Step* startStep = new Step("start");
+    mTutorial1->addStep(startStep);
+
+    ObjectFinder objectFinder;
+    QObject baseObject;
+    mTutorialManager->setObjectFinder(&objectFinder, &baseObject);
+
+    mTutorialManager->start(mTutorialInformation1->id());
+
+    QCOMPARE(mTutorial1->d->mObjectFinder.data(), &objectFinder);
+    QCOMPARE(mTutorial1->d->mBaseObject.data(), &baseObject);
+}
+
 }
 
 QTEST_MAIN(ktutorial::TutorialManagerTest)
@@ -21,8 +21,11 @@
 #include <QTest>
 #include <qtest_kde.h>
 
+#include <QWidget>
+
 #define protected public
 #define private public
+#include "ObjectFinder.h"
 #include "Tutorial.h"
 #undef private
 #undef protected
@@ -31,6 +34,7 @@
 
 #include "Step.h"
 #include "TutorialInformation.h"
+#include "WaitForSignal.h"
 
 //Step* must be declared as a metatype to be used in qvariant_cast
 Q_DECLARE_METATYPE(ktutorial::Step*);
@@ -72,6 +76,18 @@ private slots:
 
     void testFinish();
 
+    void testStep();
+    void testCurrentStep();
+
+    void testTakeStep();
+    void testTakeStepWithUnknownId();
+    void testTakeStepCurrentStep();
+
+    void testPrefetchObjectsOfNextSteps();
+    void testPrefetchObjectsOfNotActivatedNextSteps();
+    void testPrefetchObjectsWithoutObjectFinder();
+    void testFinishDiscardsPrefetchedObjects();
+
 };
 
 class StepToRequestNextStep: public Step {
@@ -126,6 +142,29 @@ protected:
 
 };
 
+class StepToFindObject: public Step {
+public:
+
+    ObjectFinder* mObjectFinder;
+    QObject* mBaseObject;
+    QString mObjectName;
+    QObject* mFoundObject;
+
+    StepToFindObject(const QString& id): Step(id),
+        mObjectFinder(0),
+        mBaseObject(0),
+        mFoundObject(0) {
+    }
+
+protected:
+
+    void setup() {
+        mFoundObject = mObjectFinder->findObject<QObject*>(mObjectName,
+                                                           mBaseObject);
+    }
+
+};
+
 class MockTutorial: public Tutorial {
 public:
 
@@ -539,6 +578,262 @@ void TutorialTest::testFinish() {
 
 }
 
+void TutorialTest::testStep() {
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+
+    Step* step1 = new Step("record");
+    tutorial.addStep(step1);
+
+    QCOMPARE(tutorial.step("record"), step1);
+    QCOMPARE(tutorial.step("roll"), (Step*)0);
+}
+
+void TutorialTest::testCurrentStep() {
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+
+    Step* stepStart = new Step("start");
+    tutorial.addStep(stepStart);
+
+    QCOMPARE(tutorial.currentStep(), (Step*)0);
+
+    tutorial.start();
+
+    QCOMPARE(tutorial.currentStep(), stepStart);
+}
+
+void TutorialTest::testTakeStep() {
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+
+    StepToRequestNextStep* stepStart = new StepToRequestNextStep("start");
+    tutorial.addStep(stepStart);
+
+    StepToRequestNextStep* step1 = new StepToRequestNextStep("record");
+    tutorial.addStep(step1);
+
+    tutorial.addStep(new Step("roll"));
+
+    tutorial.start();
+
+    QCOMPARE(tutorial.takeStep("record"), step1);
+    QCOMPARE(step1->parent(), &tutorial);
+    QCOMPARE(tutorial.d->mSteps.size(), 2);
+    QVERIFY(!tutorial.d->mSteps.contains("record"));
+
+    //The taken step can not be activated, and it is no longer connected to the
+    //tutorial
+    tutorial.nextStep("record");
+    QCOMPARE(tutorial.d->mCurrentStep, stepStart);
+
+    step1->emitNextStepRequested("roll");
+    QCOMPARE(tutorial.d->mCurrentStep, stepStart);
+
+    //A step with the same id can be added again
+    Step* step2 = new Step("record");
+    tutorial.addStep(step2);
+
+    QCOMPARE(tutorial.d->mSteps.value("record"), step2);
+}
+
+void TutorialTest::testTakeStepWithUnknownId() {
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+
+    Step* step1 = new Step("record");
+    tutorial.addStep(step1);
+
+    QCOMPARE(tutorial.takeStep("roll"), (Step*)0);
+    QCOMPARE(tutorial.d->mSteps.size(), 1);
+}
+
+void TutorialTest::testTakeStepCurrentStep() {
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+
+    Step* stepStart = new Step("start");
+    tutorial.addStep(stepStart);
+
+    tutorial.start();
+
+    QCOMPARE(tutorial.takeStep("start"), stepStart);
+
+    //The step is not deactivated
+    QCOMPARE(tutorial.d->mCurrentStep, stepStart);
+    QVERIFY(stepStart->isActive());
+
+    Step* step2 = new Step("start");
+    tutorial.addStep(step2);
+    tutorial.nextStep(step2);
+
+    QCOMPARE(tutorial.d->mCurrentStep, step2);
+    QVERIFY(!stepStart->isActive());
+    QVERIFY(step2->isActive());
+}
+
+void TutorialTest::testPrefetchObjectsOfNextSteps() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+    tutorial.setObjectFinder(&objectFinder, &baseObject);
+
+    Step* stepStart = new Step("start");
+    stepStart->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())),
+                          "record");
+    tutorial.addStep(stepStart);
+
+    StepToFindObject* step1 = new StepToFindObject("record");
+    step1->mObjectFinder = &objectFinder;
+    step1->mBaseObject = &baseObject;
+    step1->mObjectName = "The object";
+    step1->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())), "start");
+    tutorial.addStep(step1);
+
+    tutorial.start();
+
+    //The objects looked up by "record" step are not known yet
+    QVERIFY(!tutorial.d->mPrefetchTimer->isActive());
+    QVERIFY(tutorial.d->mPendingLookups.isEmpty());
+
+    tutorial.nextStep("record");
+
+    QCOMPARE(step1->mFoundObject, object);
+    QCOMPARE(tutorial.d->mLookupsByStep.value("record").count(), 1);
+
+    tutorial.nextStep("start");
+
+    QVERIFY(tutorial.d->mPrefetchTimer->isActive());
+    QCOMPARE(tutorial.d->mPendingLookups.count(), 1);
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+
+    QTest::qWait(100);
+
+    QVERIFY(!tutorial.d->mPrefetchTimer->isActive());
+    QVERIFY(tutorial.d->mPendingLookups.isEmpty());
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject), object);
+
+    step1->mFoundObject = 0;
+    tutorial.nextStep("record");
+
+    QCOMPARE(step1->mFoundObject, object);
+}
+
+void TutorialTest::testPrefetchObjectsOfNotActivatedNextSteps() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+    tutorial.setObjectFinder(&objectFinder, &baseObject);
+
+    Step* stepStart = new Step("start");
+    stepStart->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())),
+                          "declared");
+    tutorial.addStep(stepStart);
+
+    Step* step1 = new Step("declared");
+    step1->addPrefetchedObjectName("The object");
+    step1->setText("See <a href=\"widget:The widget\">the widget</a>");
+    tutorial.addStep(step1);
+
+    tutorial.start();
+
+    QVERIFY(tutorial.d->mPrefetchTimer->isActive());
+    QCOMPARE(tutorial.d->mPendingLookups.count(), 2);
+    QCOMPARE(tutorial.d->mPendingLookups[0].mName, QString("The object"));
+    QCOMPARE(tutorial.d->mPendingLookups[0].mMetaObject,
+             &QObject::staticMetaObject);
+    QCOMPARE(tutorial.d->mPendingLookups[1].mName, QString("The widget"));
+    QCOMPARE(tutorial.d->mPendingLookups[1].mMetaObject,
+             &QWidget::staticMetaObject);
+
+    QTest::qWait(100);
+
+    QVERIFY(!tutorial.d->mPrefetchTimer->isActive());
+    QVERIFY(tutorial.d->mPendingLookups.isEmpty());
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject), object);
+}
+
+void TutorialTest::testPrefetchObjectsWithoutObjectFinder() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+    tutorial.setObjectFinder(0, &baseObject);
+
+    Step* stepStart = new Step("start");
+    stepStart->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())),
+                          "record");
+    tutorial.addStep(stepStart);
+
+    StepToFindObject* step1 = new StepToFindObject("record");
+    step1->mObjectFinder = &objectFinder;
+    step1->mBaseObject = &baseObject;
+    step1->mObjectName = "The object";
+    step1->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())), "start");
+    tutorial.addStep(step1);
+
+    tutorial.start();
+    tutorial.nextStep("record");
+    tutorial.nextStep("start");
+
+    QCOMPARE(step1->mFoundObject, object);
+    QVERIFY(tutorial.d->mLookupsByStep.isEmpty());
+    QVERIFY(!tutorial.d->mPrefetchTimer->isActive());
+    QVERIFY(tutorial.d->mPendingLookups.isEmpty());
+}
+
+void TutorialTest::testFinishDiscardsPrefetchedObjects() {
+    QObject baseObject;
+    QObject* object = new QObject(&baseObject);
+    object->setObjectName("The object");
+
+    ObjectFinder objectFinder;
+
+    Tutorial tutorial(new TutorialInformation("pearlOrientation"));
+    tutorial.setObjectFinder(&objectFinder, &baseObject);
+
+    Step* stepStart = new Step("start");
+    stepStart->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())),
+                          "record");
+    tutorial.addStep(stepStart);
+
+    StepToFindObject* step1 = new StepToFindObject("record");
+    step1->mObjectFinder = &objectFinder;
+    step1->mBaseObject = &baseObject;
+    step1->mObjectName = "The object";
+    step1->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())), "start");
+    tutorial.addStep(step1);
+
+    tutorial.start();
+    tutorial.nextStep("record");
+    tutorial.nextStep("start");
+
+    QTest::qWait(100);
+
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject), object);
+
+    tutorial.nextStep("record");
+    tutorial.nextStep("start");
+    tutorial.finish();
+
+    QVERIFY(!tutorial.d->mPrefetchTimer->isActive());
+    QVERIFY(tutorial.d->mPendingLookups.isEmpty());
+    QCOMPARE(objectFinder.cachedObject("The object", &baseObject,
+                                       &QObject::staticMetaObject),
+             (QObject*)0);
+}
+
 QTEST_MAIN(ktutorial::TutorialTest)
 
 #include "TutorialTest.moc"
@@ -0,0 +1,150 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "ObjectFinder.h"
+
+namespace ktutorial {
+
+/**
+ * Benchmarks finding objects in synthetic object trees of several shapes, both
+ * walking the tree and getting a prefetched object.
+ * Each object in the tree has as many children as the breadth of the tree,
+ * named "Child 0", "Child 1" and so on, so every name except the one of the
+ * last leaf is repeated in each branch. The last leaf is named "The object".
+ */
+class ObjectFinderBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void benchmarkFindObject_data();
+    void benchmarkFindObject();
+
+    void benchmarkFindPrefetchedObject_data();
+    void benchmarkFindPrefetchedObject();
+
+private:
+
+    void addTreeRows() const;
+    QObject* newTree(int depth, int breadth) const;
+    void addChildren(QObject* parent, int depth, int breadth) const;
+
+};
+
+void ObjectFinderBenchmark::benchmarkFindObject_data() {
+    addTreeRows();
+}
+
+void ObjectFinderBenchmark::benchmarkFindObject() {
+    QFETCH(int, depth);
+    QFETCH(int, breadth);
+    QFETCH(QString, name);
+
+    QObject* baseObject = newTree(depth, breadth);
+
+    ObjectFinder objectFinder;
+
+    QObject* object = 0;
+    QBENCHMARK {
+        object = objectFinder.findObject<QObject*>(name, baseObject);
+    }
+
+    QVERIFY(object);
+
+    delete baseObject;
+}
+
+void ObjectFinderBenchmark::benchmarkFindPrefetchedObject_data() {
+    addTreeRows();
+}
+
+void ObjectFinderBenchmark::benchmarkFindPrefetchedObject() {
+    QFETCH(int, depth);
+    QFETCH(int, breadth);
+    QFETCH(QString, name);
+
+    QObject* baseObject = newTree(depth, breadth);
+
+    ObjectFinder objectFinder;
+    objectFinder.prefetchObject(name, baseObject, &QObject::staticMetaObject);
+
+    QObject* object = 0;
+    QBENCHMARK {
+        object = objectFinder.findObject<QObject*>(name, baseObject);
+    }
+
+    QVERIFY(object);
+
+    delete baseObject;
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void ObjectFinderBenchmark::addTreeRows() const {
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<int>("breadth");
+    QTest::addColumn<QString>("name");
+
+    //The wide, deep and balanced trees have 2550, 4680 and 1110 objects
+    QTest::newRow("wide tree, unique name") << 2 << 50
+                                            << QString("The object");
+    QTest::newRow("wide tree, ambiguous name") << 2 << 50
+                                               << QString("Child 25");
+    QTest::newRow("deep tree, unique name") << 4 << 8
+                                            << QString("The object");
+    QTest::newRow("deep tree, ambiguous name") << 4 << 8
+                                               << QString("Child 4");
+    QTest::newRow("deep tree, ambiguous name with ancestor") << 4 << 8
+                                            << QString("Child 7/Child 4");
+    QTest::newRow("balanced tree, ambiguous name with ancestor") << 3 << 10
+                                            << QString("Child 9/Child 5");
+}
+
+QObject* ObjectFinderBenchmark::newTree(int depth, int breadth) const {
+    QObject* baseObject = new QObject();
+    addChildren(baseObject, depth, breadth);
+
+    QObject* lastLeaf = baseObject;
+    while (!lastLeaf->children().isEmpty()) {
+        lastLeaf = lastLeaf->children().last();
+    }
+    lastLeaf->setObjectName("The object");
+
+    return baseObject;
+}
+
+void ObjectFinderBenchmark::addChildren(QObject* parent, int depth,
+                                        int breadth) const {
+    if (depth == 0) {
+        return;
+    }
+
+    for (int i=0; i<breadth; ++i) {
+        QObject* child = new QObject(parent);
+        child->setObjectName(QString("Child %1").arg(i));
+        addChildren(child, depth - 1, breadth);
+    }
+}
+
+}
+
+QTEST_MAIN(ktutorial::ObjectFinderBenchmark)
+
+#include "ObjectFinderBenchmark.moc"
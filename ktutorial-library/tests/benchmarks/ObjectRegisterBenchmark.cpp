@@ -0,0 +1,145 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "ObjectRegister.h"
+#include "ResidentMemory.h"
+
+namespace ktutorial {
+namespace editorsupport {
+
+/**
+ * Benchmarks registering objects in an ObjectRegister, getting them back from
+ * their id and the memory used by each registered object.
+ */
+class ObjectRegisterBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void benchmarkIdForNewObjects();
+    void benchmarkIdForRegisteredObjects();
+    void benchmarkObjectForId();
+    void benchmarkIdForNewObjectsAfterDestroyingObjects();
+
+    void benchmarkResidentMemory();
+
+private:
+
+    QList<QObject*> mObjects;
+
+};
+
+void ObjectRegisterBenchmark::init() {
+    for (int i=0; i<10000; ++i) {
+        mObjects.append(new QObject());
+    }
+}
+
+void ObjectRegisterBenchmark::cleanup() {
+    qDeleteAll(mObjects);
+    mObjects.clear();
+}
+
+void ObjectRegisterBenchmark::benchmarkIdForNewObjects() {
+    QBENCHMARK {
+        ObjectRegister objectRegister;
+        foreach (QObject* object, mObjects) {
+            objectRegister.idForObject(object);
+        }
+    }
+}
+
+void ObjectRegisterBenchmark::benchmarkIdForRegisteredObjects() {
+    ObjectRegister objectRegister;
+    foreach (QObject* object, mObjects) {
+        objectRegister.idForObject(object);
+    }
+
+    QBENCHMARK {
+        foreach (QObject* object, mObjects) {
+            objectRegister.idForObject(object);
+        }
+    }
+}
+
+void ObjectRegisterBenchmark::benchmarkObjectForId() {
+    ObjectRegister objectRegister;
+    QList<int> ids;
+    foreach (QObject* object, mObjects) {
+        ids.append(objectRegister.idForObject(object));
+    }
+
+    QBENCHMARK {
+        foreach (int id, ids) {
+            objectRegister.objectForId(id);
+        }
+    }
+}
+
+void ObjectRegisterBenchmark::benchmarkIdForNewObjectsAfterDestroyingObjects() {
+    ObjectRegister objectRegister;
+
+    QBENCHMARK {
+        QList<QObject*> objects;
+        for (int i=0; i<1000; ++i) {
+            objects.append(new QObject());
+            objectRegister.idForObject(objects.last());
+        }
+        qDeleteAll(objects);
+    }
+}
+
+void ObjectRegisterBenchmark::benchmarkResidentMemory() {
+    const int objectCount = 100000;
+
+    QList<QObject*> objects;
+    for (int i=0; i<objectCount; ++i) {
+        objects.append(new QObject());
+    }
+
+    ObjectRegister* objectRegister = new ObjectRegister();
+    //Register one object to register the meta objects, so their memory is not
+    //taken into account
+    objectRegister->idForObject(objects.first());
+
+    qint64 residentMemoryBefore = residentMemory();
+
+    foreach (QObject* object, objects) {
+        objectRegister->idForObject(object);
+    }
+
+    qint64 residentMemoryAfter = residentMemory();
+
+    qDebug() << "Resident memory per registered object (bytes):"
+             << (residentMemoryAfter - residentMemoryBefore) / objectCount;
+
+    delete objectRegister;
+    qDeleteAll(objects);
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::editorsupport::ObjectRegisterBenchmark)
+
+#include "ObjectRegisterBenchmark.moc"
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include <QTest>
+
+#include <QTextStream>
+
+#include <KTemporaryFile>
+#include <kross/core/action.h>
+
+#include "ScriptedStep.h"
+#include "../WaitForSignal.h"
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * Benchmarks the latency from the end of a WaitFor to the execution of the
+ * script function connected to it, compared with a plain C++ slot.
+ */
+class ScriptedStepBenchmark: public QObject {
+Q_OBJECT
+
+public slots:
+
+    void dummySlot() {
+        mDummySlotCallCount++;
+    }
+
+signals:
+
+    void dummySignal();
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void benchmarkWaitForEndedScriptFunction();
+    void benchmarkWaitForEndedSlot();
+
+private:
+
+    int mDummySlotCallCount;
+    KTemporaryFile* mTemporaryFile;
+
+};
+
+void ScriptedStepBenchmark::init() {
+    mDummySlotCallCount = 0;
+
+    mTemporaryFile = new KTemporaryFile();
+    mTemporaryFile->setSuffix(".js");
+    mTemporaryFile->open();
+
+    QTextStream out(mTemporaryFile);
+    out << "function dummyFunction() { }\n";
+    out.flush();
+}
+
+void ScriptedStepBenchmark::cleanup() {
+    delete mTemporaryFile;
+}
+
+void ScriptedStepBenchmark::benchmarkWaitForEndedScriptFunction() {
+    Kross::Action scriptAction(this, "BenchmarkKrossAction");
+    scriptAction.setFile(mTemporaryFile->fileName());
+    scriptAction.trigger();
+
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+
+    WaitForSignal waitFor(this, SIGNAL(dummySignal()));
+    waitFor.setActive(true);
+
+    scriptedStep.connectWaitFor(&waitFor, &scriptAction, "dummyFunction");
+
+    QBENCHMARK {
+        emit dummySignal();
+    }
+}
+
+void ScriptedStepBenchmark::benchmarkWaitForEndedSlot() {
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+
+    WaitForSignal waitFor(this, SIGNAL(dummySignal()));
+    waitFor.setActive(true);
+
+    scriptedStep.connectWaitFor(&waitFor, this, SLOT(dummySlot()));
+
+    QBENCHMARK {
+        emit dummySignal();
+    }
+
+    QVERIFY(mDummySlotCallCount > 0);
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::scripting::ScriptedStepBenchmark)
+
+#include "ScriptedStepBenchmark.moc"
@@ -0,0 +1,146 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include <QTest>
+
+#include <QTextStream>
+
+#include <KTempDir>
+
+#define protected public
+#define private public
+#include "ScriptedTutorial.h"
+#undef private
+#undef protected
+
+#include "ResidentMemory.h"
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * Benchmarks the time to load a scripted tutorial and the memory used by each
+ * loaded tutorial, both when the script is executed on creation and when it is
+ * deferred until the tutorial is started.
+ */
+class ScriptedTutorialBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkConstructorExecuteOnCreation();
+    void benchmarkConstructorExecuteOnStart();
+    void benchmarkSetupExecuteOnStart();
+
+    void benchmarkResidentMemory_data();
+    void benchmarkResidentMemory();
+
+private:
+
+    KTempDir* mTempDir;
+    QString mFileName;
+
+};
+
+void ScriptedTutorialBenchmark::initTestCase() {
+    mTempDir = new KTempDir();
+    mFileName = mTempDir->name() + "tutorial.js";
+
+    QFile file(mFileName);
+    file.open(QIODevice::WriteOnly);
+    QTextStream out(&file);
+    out << "tutorial.tutorialInformationAsObject().setName(\"The name\");\n";
+    for (int i=0; i<20; ++i) {
+        QString stepId = i == 0? "start": QString("step%1").arg(i);
+        out << "step = ktutorial.newStep(\"" << stepId << "\");\n";
+        out << "step.setText(\"The text of the step " << i << "\");\n";
+        out << "waitFor = ktutorial.newWaitFor(\"WaitForSignal\");\n";
+        out << "waitFor.setSignal(tutorial, \"finished(Tutorial*)\");\n";
+        out << "step.addWaitFor(waitFor, \"step" << i + 1 << "\");\n";
+        out << "tutorial.addStep(step);\n";
+    }
+    file.close();
+}
+
+void ScriptedTutorialBenchmark::cleanupTestCase() {
+    delete mTempDir;
+}
+
+void ScriptedTutorialBenchmark::benchmarkConstructorExecuteOnCreation() {
+    QBENCHMARK {
+        ScriptedTutorial scriptedTutorial(mFileName);
+    }
+}
+
+void ScriptedTutorialBenchmark::benchmarkConstructorExecuteOnStart() {
+    QBENCHMARK {
+        ScriptedTutorial scriptedTutorial(mFileName,
+                                          ScriptedTutorial::ExecuteOnStart);
+    }
+}
+
+void ScriptedTutorialBenchmark::benchmarkSetupExecuteOnStart() {
+    QBENCHMARK {
+        ScriptedTutorial scriptedTutorial(mFileName,
+                                          ScriptedTutorial::ExecuteOnStart);
+        scriptedTutorial.setup();
+    }
+}
+
+void ScriptedTutorialBenchmark::benchmarkResidentMemory_data() {
+    QTest::addColumn<int>("executionMode");
+
+    QTest::newRow("ExecuteOnCreation")
+                                << (int)ScriptedTutorial::ExecuteOnCreation;
+    QTest::newRow("ExecuteOnStart")
+                                << (int)ScriptedTutorial::ExecuteOnStart;
+}
+
+void ScriptedTutorialBenchmark::benchmarkResidentMemory() {
+    QFETCH(int, executionMode);
+
+    const int tutorialCount = 200;
+
+    //Load once to initialize the interpreter, so its memory is not taken into
+    //account
+    delete new ScriptedTutorial(mFileName);
+
+    QList<ScriptedTutorial*> scriptedTutorials;
+    qint64 residentMemoryBefore = residentMemory();
+
+    for (int i=0; i<tutorialCount; ++i) {
+        scriptedTutorials.append(new ScriptedTutorial(mFileName,
+                        (ScriptedTutorial::ExecutionMode)executionMode));
+    }
+
+    qint64 residentMemoryAfter = residentMemory();
+
+    qDebug() << "Resident memory per loaded tutorial (bytes):"
+             << (residentMemoryAfter - residentMemoryBefore) / tutorialCount;
+
+    qDeleteAll(scriptedTutorials);
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::scripting::ScriptedTutorialBenchmark)
+
+#include "ScriptedTutorialBenchmark.moc"
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include <QTest>
+
+#define protected public
+#define private public
+#include "ScriptingModule.h"
+#undef private
+#undef protected
+
+#include "../WaitForSignal.h"
+
+namespace ktutorial {
+namespace scripting {
+
+/**
+ * Benchmarks the registration and creation of WaitFors in ScriptingModule, both
+ * for types registered with a factory function and for types registered with
+ * their QMetaObject.
+ */
+class ScriptingModuleBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void benchmarkRegisterWaitFor();
+    void benchmarkRegisterWaitForMetaObject();
+
+    void benchmarkNewWaitForRegisteredWithFactory();
+    void benchmarkNewWaitForRegisteredWithMetaObject();
+
+};
+
+void ScriptingModuleBenchmark::benchmarkRegisterWaitFor() {
+    QBENCHMARK {
+        ScriptingModule scriptingModule;
+        scriptingModule.registerWaitFor<WaitForSignal>("WaitForSignal");
+    }
+}
+
+void ScriptingModuleBenchmark::benchmarkRegisterWaitForMetaObject() {
+    QBENCHMARK {
+        ScriptingModule scriptingModule;
+        scriptingModule.registerWaitForMetaObject(
+                                            WaitForSignal::staticMetaObject,
+                                            "WaitForSignal");
+    }
+}
+
+void ScriptingModuleBenchmark::benchmarkNewWaitForRegisteredWithFactory() {
+    ScriptingModule scriptingModule;
+    scriptingModule.registerWaitFor<WaitForSignal>("WaitForSignal");
+
+    QBENCHMARK {
+        delete scriptingModule.newWaitFor("WaitForSignal");
+    }
+}
+
+void ScriptingModuleBenchmark::benchmarkNewWaitForRegisteredWithMetaObject() {
+    ScriptingModule scriptingModule;
+    scriptingModule.registerWaitForMetaObject(WaitForSignal::staticMetaObject,
+                                              "WaitForSignal");
+
+    QBENCHMARK {
+        delete scriptingModule.newWaitFor("WaitForSignal");
+    }
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::scripting::ScriptingModuleBenchmark)
+
+#include "ScriptingModuleBenchmark.moc"
@@ -0,0 +1,156 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "Option.h"
+#include "Step.h"
+#include "Tutorial.h"
+#include "TutorialInformation.h"
+#include "WaitForSignal.h"
+
+namespace ktutorial {
+
+/**
+ * Benchmarks the transitions between the steps of a tutorial, both requested
+ * directly and triggered by the WaitFor of the current step, with an increasing
+ * number of Options and WaitFors in each step.
+ * The tutorial has two steps that change to each other, as the time of a
+ * transition does not depend on the number of steps in the tutorial.
+ */
+class TutorialBenchmark: public QObject {
+Q_OBJECT
+
+signals:
+
+    void dummySignal();
+
+    void otherDummySignal();
+
+private slots:
+
+    void benchmarkNextStep_data();
+    void benchmarkNextStep();
+
+    void benchmarkNextStepFromWaitFor_data();
+    void benchmarkNextStepFromWaitFor();
+
+private:
+
+    void addStepRows() const;
+    Tutorial* newTutorial(int numberOfOptions, int numberOfWaitFors);
+    Step* newStep(const QString& id, const QString& nextStepId,
+                  const char* signal, int numberOfOptions,
+                  int numberOfWaitFors);
+
+};
+
+void TutorialBenchmark::benchmarkNextStep_data() {
+    addStepRows();
+}
+
+void TutorialBenchmark::benchmarkNextStep() {
+    QFETCH(int, numberOfOptions);
+    QFETCH(int, numberOfWaitFors);
+
+    Tutorial* tutorial = newTutorial(numberOfOptions, numberOfWaitFors);
+    tutorial->start();
+
+    QBENCHMARK {
+        tutorial->nextStep("second");
+        tutorial->nextStep("start");
+    }
+
+    tutorial->finish();
+    delete tutorial;
+}
+
+void TutorialBenchmark::benchmarkNextStepFromWaitFor_data() {
+    addStepRows();
+}
+
+void TutorialBenchmark::benchmarkNextStepFromWaitFor() {
+    QFETCH(int, numberOfOptions);
+    QFETCH(int, numberOfWaitFors);
+
+    Tutorial* tutorial = newTutorial(numberOfOptions, numberOfWaitFors);
+    tutorial->start();
+
+    QBENCHMARK {
+        emit dummySignal();
+        emit otherDummySignal();
+    }
+
+    tutorial->finish();
+    delete tutorial;
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void TutorialBenchmark::addStepRows() const {
+    QTest::addColumn<int>("numberOfOptions");
+    QTest::addColumn<int>("numberOfWaitFors");
+
+    QTest::newRow("bare steps") << 0 << 0;
+    QTest::newRow("3 options") << 3 << 0;
+    QTest::newRow("10 wait fors") << 0 << 10;
+    QTest::newRow("3 options and 10 wait fors") << 3 << 10;
+}
+
+Tutorial* TutorialBenchmark::newTutorial(int numberOfOptions,
+                                         int numberOfWaitFors) {
+    Tutorial* tutorial = new Tutorial(new TutorialInformation("benchmark"));
+
+    //Each step waits for a different signal; if both steps waited for the
+    //same signal, the step activated while the signal is being emitted would
+    //also be notified and change back to the first step
+    tutorial->addStep(newStep("start", "second", SIGNAL(dummySignal()),
+                              numberOfOptions, numberOfWaitFors));
+    tutorial->addStep(newStep("second", "start", SIGNAL(otherDummySignal()),
+                              numberOfOptions, numberOfWaitFors));
+
+    return tutorial;
+}
+
+Step* TutorialBenchmark::newStep(const QString& id, const QString& nextStepId,
+                                 const char* signal, int numberOfOptions,
+                                 int numberOfWaitFors) {
+    Step* step = new Step(id);
+    step->setText(QString("The text of the step %1").arg(id));
+
+    for (int i=0; i<numberOfOptions; ++i) {
+        step->addOption(new Option(QString("Option %1").arg(i)), nextStepId);
+    }
+
+    //The extra WaitFors never end, as they wait for a signal that is not
+    //emitted
+    for (int i=0; i<numberOfWaitFors; ++i) {
+        step->addWaitFor(new WaitForSignal(this, SIGNAL(destroyed())),
+                         nextStepId);
+    }
+
+    step->addWaitFor(new WaitForSignal(this, signal), nextStepId);
+
+    return step;
+}
+
+}
+
+QTEST_MAIN(ktutorial::TutorialBenchmark)
+
+#include "TutorialBenchmark.moc"
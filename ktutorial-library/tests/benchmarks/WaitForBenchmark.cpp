@@ -0,0 +1,212 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include "WaitForAnd.h"
+#include "WaitForEvent.h"
+#include "WaitForNot.h"
+#include "WaitForOr.h"
+#include "WaitForProperty.h"
+#include "WaitForSignal.h"
+
+namespace ktutorial {
+
+/**
+ * Benchmarks the dispatch of the notifications watched by the WaitFors (a
+ * signal, an event or a property change) until the wait ends, and the
+ * evaluation of composed conditions with an increasing number of children.
+ */
+class WaitForBenchmark: public QObject {
+Q_OBJECT
+Q_PROPERTY(int value READ value WRITE setValue NOTIFY valueChanged)
+public:
+
+    int value() const {
+        return mValue;
+    }
+
+    void setValue(int value) {
+        mValue = value;
+        emit valueChanged();
+    }
+
+public slots:
+
+    void countWaitEnded() {
+        mWaitEndedCount++;
+    }
+
+signals:
+
+    void dummySignal();
+
+    void otherDummySignal();
+
+    void valueChanged();
+
+private slots:
+
+    void init();
+
+    void benchmarkWaitForSignal();
+    void benchmarkWaitForEvent();
+    void benchmarkWaitForEventOtherEventType();
+    void benchmarkWaitForProperty();
+
+    void benchmarkWaitForComposed_data();
+    void benchmarkWaitForComposed();
+
+    void benchmarkWaitForNot();
+
+private:
+
+    int mValue;
+    int mWaitEndedCount;
+
+};
+
+void WaitForBenchmark::init() {
+    mValue = 0;
+    mWaitEndedCount = 0;
+}
+
+void WaitForBenchmark::benchmarkWaitForSignal() {
+    WaitForSignal waitFor(this, SIGNAL(dummySignal()));
+    connect(&waitFor, SIGNAL(waitEnded(WaitFor*)),
+            this, SLOT(countWaitEnded()));
+    waitFor.setActive(true);
+
+    QBENCHMARK {
+        emit dummySignal();
+    }
+
+    QVERIFY(mWaitEndedCount > 0);
+}
+
+void WaitForBenchmark::benchmarkWaitForEvent() {
+    QObject object;
+
+    WaitForEvent waitFor(&object, QEvent::User);
+    connect(&waitFor, SIGNAL(waitEnded(WaitFor*)),
+            this, SLOT(countWaitEnded()));
+    waitFor.setActive(true);
+
+    QEvent event(QEvent::User);
+    QBENCHMARK {
+        QCoreApplication::sendEvent(&object, &event);
+    }
+
+    QVERIFY(mWaitEndedCount > 0);
+}
+
+void WaitForBenchmark::benchmarkWaitForEventOtherEventType() {
+    QObject object;
+
+    WaitForEvent waitFor(&object, QEvent::User);
+    connect(&waitFor, SIGNAL(waitEnded(WaitFor*)),
+            this, SLOT(countWaitEnded()));
+    waitFor.setActive(true);
+
+    QEvent event(QEvent::MaxUser);
+    QBENCHMARK {
+        QCoreApplication::sendEvent(&object, &event);
+    }
+
+    QCOMPARE(mWaitEndedCount, 0);
+}
+
+void WaitForBenchmark::benchmarkWaitForProperty() {
+    WaitForProperty waitFor(this, "value", 1);
+    connect(&waitFor, SIGNAL(waitEnded(WaitFor*)),
+            this, SLOT(countWaitEnded()));
+    waitFor.setActive(true);
+
+    //The property changes between the expected value and another one, so the
+    //wait ends every second change
+    QBENCHMARK {
+        setValue(1 - mValue);
+    }
+
+    QVERIFY(mWaitEndedCount > 0);
+}
+
+void WaitForBenchmark::benchmarkWaitForComposed_data() {
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<int>("numberOfChildren");
+
+    QTest::newRow("and, 2 children") << QString("and") << 2;
+    QTest::newRow("and, 8 children") << QString("and") << 8;
+    QTest::newRow("and, 32 children") << QString("and") << 32;
+    QTest::newRow("or, 2 children") << QString("or") << 2;
+    QTest::newRow("or, 8 children") << QString("or") << 8;
+    QTest::newRow("or, 32 children") << QString("or") << 32;
+}
+
+void WaitForBenchmark::benchmarkWaitForComposed() {
+    QFETCH(QString, type);
+    QFETCH(int, numberOfChildren);
+
+    WaitForComposed* waitFor;
+    if (type == "and") {
+        waitFor = new WaitForAnd();
+    } else {
+        waitFor = new WaitForOr();
+    }
+
+    //All the children wait for the same signal, so each emission notifies
+    //every child and the whole condition is evaluated once per child
+    for (int i=0; i<numberOfChildren; ++i) {
+        waitFor->add(new WaitForSignal(this, SIGNAL(dummySignal())));
+    }
+
+    connect(waitFor, SIGNAL(waitEnded(WaitFor*)),
+            this, SLOT(countWaitEnded()));
+    waitFor->setActive(true);
+
+    QBENCHMARK {
+        emit dummySignal();
+    }
+
+    QVERIFY(mWaitEndedCount > 0);
+
+    delete waitFor;
+}
+
+void WaitForBenchmark::benchmarkWaitForNot() {
+    WaitForAnd waitFor;
+    waitFor.add(new WaitForSignal(this, SIGNAL(dummySignal())));
+    waitFor.add(new WaitForNot(new WaitForSignal(this,
+                                                 SIGNAL(otherDummySignal()))));
+
+    connect(&waitFor, SIGNAL(waitEnded(WaitFor*)),
+            this, SLOT(countWaitEnded()));
+    waitFor.setActive(true);
+
+    QBENCHMARK {
+        emit dummySignal();
+    }
+
+    QVERIFY(mWaitEndedCount > 0);
+}
+
+}
+
+QTEST_MAIN(ktutorial::WaitForBenchmark)
+
+#include "WaitForBenchmark.moc"
@@ -60,6 +60,9 @@ private slots:
     void testSignalList();
     void testSignalListWithUnknownClassName();
 
+    void testClassHierarchy();
+    void testClassHierarchyWithoutRegisteredClasses();
+
 private:
 
     QString mDummyProperty;
@@ -135,6 +138,39 @@ void ClassRegisterAdaptorTest::testSignalListWithUnknownClassName() {
     QCOMPARE(signalList.count(), 0);
 }
 
+void ClassRegisterAdaptorTest::testClassHierarchy() {
+    ObjectRegister objectRegister;
+    ClassRegisterAdaptor* adaptor = new ClassRegisterAdaptor(&objectRegister);
+
+    objectRegister.idForObject(this);
+
+    QVariantMap classHierarchy = adaptor->classHierarchy();
+    QCOMPARE(classHierarchy.count(), 2);
+
+    QVariantMap classData = classHierarchy.value(
+            "ktutorial::editorsupport::ClassRegisterAdaptorTest").toMap();
+    QCOMPARE(classData.value("superClass").toString(), QString("QObject"));
+    QCOMPARE(classData.value("propertyList").toStringList(),
+             QStringList() << "dummyProperty"
+                           << "dummyPropertyWithNotifySignal");
+    QCOMPARE(classData.value("signalList").toStringList(),
+             QStringList() << "dummySignal()" << "dummySignal(int,QString)");
+
+    classData = classHierarchy.value("QObject").toMap();
+    QCOMPARE(classData.value("superClass").toString(), QString(""));
+    QCOMPARE(classData.value("propertyList").toStringList(),
+             QStringList() << "objectName");
+    QCOMPARE(classData.value("signalList").toStringList(),
+             QStringList() << "destroyed(QObject*)" << "destroyed()");
+}
+
+void ClassRegisterAdaptorTest::testClassHierarchyWithoutRegisteredClasses() {
+    ObjectRegister objectRegister;
+    ClassRegisterAdaptor* adaptor = new ClassRegisterAdaptor(&objectRegister);
+
+    QVERIFY(adaptor->classHierarchy().isEmpty());
+}
+
 }
 }
 
@@ -19,6 +19,7 @@
 
 #include <QTest>
 
+#include <QSharedMemory>
 #include <QSignalSpy>
 #include <QWidget>
 #include <QtDBus/QtDBus>
@@ -40,6 +41,7 @@
 #include "ObjectRegister.h"
 #include "../ObjectFinder.h"
 #include "../Step.h"
+#include "../Tracer.h"
 #include "../extendedinformation/WidgetHighlighter.h"
 
 using ktutorial::extendedinformation::WidgetHighlighter;
@@ -65,13 +67,23 @@ private slots:
 
     void testStopHighlighting();
 
+    void testGrabWidget();
+    void testGrabWidgetWithNotWidgetObject();
+
     void testEnableEventSpy();
 
     void testDisableEventSpy();
 
+    void testEnableTracing();
+    void testDisableTracing();
+
+    void testChromeTrace();
+
     void testTestScriptedTutorial();
     void testTestScriptedTutorialWithStepId();
 
+    void testUpdateTestScriptedTutorialSteps();
+
 };
 
 void EditorSupportAdaptorTest::testConstructor() {
@@ -132,6 +144,36 @@ void EditorSupportAdaptorTest::testStopHighlighting() {
     QCOMPARE(window.findChildren<WidgetHighlighter*>().count(), 0);
 }
 
+void EditorSupportAdaptorTest::testGrabWidget() {
+    EditorSupport editorSupport;
+    QWidget window;
+    window.resize(400, 100);
+    editorSupport.setup(&window);
+    EditorSupportAdaptor* adaptor = new EditorSupportAdaptor(&editorSupport);
+
+    QVariantMap thumbnail = adaptor->grabWidget(adaptor->mainWindowObjectId(),
+                                                200, 200);
+
+    QCOMPARE(thumbnail.count(), 3);
+    QVERIFY(!thumbnail.value("key").toString().isEmpty());
+    QCOMPARE(thumbnail.value("key").toString(),
+             editorSupport.mThumbnailMemory->key());
+    QCOMPARE(thumbnail.value("width").toInt(), 200);
+    QCOMPARE(thumbnail.value("height").toInt(), 50);
+}
+
+void EditorSupportAdaptorTest::testGrabWidgetWithNotWidgetObject() {
+    EditorSupport editorSupport;
+    QWidget window;
+    editorSupport.setup(&window);
+    EditorSupportAdaptor* adaptor = new EditorSupportAdaptor(&editorSupport);
+
+    QObject* object = new QObject(&window);
+    int objectId = editorSupport.mObjectRegister->idForObject(object);
+
+    QVERIFY(adaptor->grabWidget(objectId, 200, 200).isEmpty());
+}
+
 void EditorSupportAdaptorTest::testEnableEventSpy() {
     QDBusConnection bus = QDBusConnection::sessionBus();
     QVERIFY(bus.isConnected());
@@ -163,6 +205,46 @@ void EditorSupportAdaptorTest::testDisableEventSpy() {
     QVERIFY(!bus.objectRegisteredAt("/ktutorial/EventSpy"));
 }
 
+void EditorSupportAdaptorTest::testEnableTracing() {
+    EditorSupport editorSupport;
+    EditorSupportAdaptor* adaptor = new EditorSupportAdaptor(&editorSupport);
+
+    QSignalSpy spanTracedSpy(adaptor,
+            SIGNAL(spanTraced(QString,QString,QString,qlonglong,qlonglong)));
+
+    adaptor->enableTracing(true);
+    Tracer::self()->addSpan("The span", "The detail", 4, 8);
+
+    QVERIFY(Tracer::isEnabled());
+    QCOMPARE(spanTracedSpy.count(), 1);
+    QCOMPARE(spanTracedSpy.at(0).at(0).toString(), QString("The span"));
+
+    adaptor->disableTracing();
+    Tracer::self()->clear();
+}
+
+void EditorSupportAdaptorTest::testDisableTracing() {
+    EditorSupport editorSupport;
+    EditorSupportAdaptor* adaptor = new EditorSupportAdaptor(&editorSupport);
+
+    adaptor->enableTracing(false);
+    adaptor->disableTracing();
+
+    QVERIFY(!Tracer::isEnabled());
+}
+
+void EditorSupportAdaptorTest::testChromeTrace() {
+    EditorSupport editorSupport;
+    EditorSupportAdaptor* adaptor = new EditorSupportAdaptor(&editorSupport);
+
+    Tracer::self()->addSpan("The span", "The detail", 4, 8);
+
+    QCOMPARE(adaptor->chromeTrace(),
+             QString::fromUtf8(Tracer::self()->chromeTrace()));
+
+    Tracer::self()->clear();
+}
+
 void EditorSupportAdaptorTest::testTestScriptedTutorial() {
     KTemporaryFile temporaryFile;
     temporaryFile.setSuffix(".js");
@@ -215,6 +297,40 @@ void EditorSupportAdaptorTest::testTestScriptedTutorialWithStepId() {
     QCOMPARE(tutorial->d->mCurrentStep->id(), QString("third step"));
 }
 
+void EditorSupportAdaptorTest::testUpdateTestScriptedTutorialSteps() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out << "tutorial.addStep(ktutorial.newStep(\"second step\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+    EditorSupportAdaptor* adaptor = new EditorSupportAdaptor(&editorSupport);
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    adaptor->testScriptedTutorial(temporaryFile.fileName());
+
+    QStringList stepIds;
+    stepIds << "second step";
+    QStringList stepScripts;
+    stepScripts << "step = ktutorial.newStep(\"second step\");\n"
+                   "step.setText(\"The new text\");\n"
+                   "tutorial.addStep(step);\n";
+
+    QVERIFY(adaptor->updateTestScriptedTutorialSteps(stepIds, stepScripts));
+
+    QVariant argument = startedSpy.at(0).at(0);
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(argument);
+    QCOMPARE(tutorial->d->mSteps.value("second step")->text(),
+             QString("The new text"));
+}
+
 }
 }
 
@@ -20,6 +20,7 @@
 #include <QTest>
 
 #include <QApplication>
+#include <QSharedMemory>
 #include <QSignalSpy>
 #include <QtDBus/QtDBus>
 
@@ -28,6 +29,7 @@
 #define protected public
 #define private public
 #include "EditorSupport.h"
+#include "ObjectRegister.h"
 #include "../Tutorial.h"
 #undef private
 #undef protected
@@ -36,10 +38,10 @@
 
 #include "ClassRegisterAdaptor.h"
 #include "EventSpy.h"
-#include "ObjectRegister.h"
 #include "ObjectRegisterAdaptor.h"
 #include "../ObjectFinder.h"
 #include "../Step.h"
+#include "../Tracer.h"
 #include "../TutorialInformation.h"
 #include "../extendedinformation/WidgetHighlighter.h"
 
@@ -95,13 +97,34 @@ private slots:
 
     void testStopHighlighting();
 
+    void testGrabWidget();
+    void testGrabWidgetSmallerThanMaxSize();
+    void testGrabWidgetSeveralTimes();
+    void testGrabWidgetWithNotWidgetObject();
+    void testGrabWidgetUsesRandomKey();
+
     void testEnableEventSpy();
 
     void testDisableEventSpy();
 
+    void testEnableTracing();
+    void testEnableTracingWithoutStreamingSpans();
+    void testDisableTracing();
+
+    void testChromeTrace();
+
     void testTestScriptedTutorial();
     void testTestScriptedTutorialWithStepId();
     void testTestScriptedTutorialWithInvalidTutorial();
+    void testTestScriptedTutorialAgain();
+    void testTestScriptedTutorialAgainWithChangedScript();
+    void testTestScriptedTutorialAgainAfterUpdatingSteps();
+
+    void testUpdateTestScriptedTutorialSteps();
+    void testUpdateTestScriptedTutorialStepsWithInvalidStepScript();
+    void testUpdateTestScriptedTutorialStepsWithDifferentNumberOfScripts();
+    void testUpdateTestScriptedTutorialStepsWithoutTestedTutorial();
+    void testUpdateTestScriptedTutorialStepsAfterFinishingTutorial();
 
     void testObjectRegisterWhenEventSpyNotifiesEventBeforeEndingConstructor();
 
@@ -109,6 +132,9 @@ private:
 
     QStringList mEventTypes;
 
+    void assertThumbnail(const QString& key, const QSize& size,
+                         const QColor& color) const;
+
 };
 
 void EditorSupportTest::init() {
@@ -243,6 +269,140 @@ void EditorSupportTest::testStopHighlighting() {
     QCOMPARE(widget->findChildren<WidgetHighlighter*>().count(), 0);
 }
 
+void EditorSupportTest::testGrabWidget() {
+    EditorSupport editorSupport;
+    QWidget window;
+    editorSupport.setup(&window);
+
+    QWidget* widget = new QWidget(&window);
+    widget->resize(400, 100);
+    widget->setAutoFillBackground(true);
+    QPalette palette = widget->palette();
+    palette.setColor(QPalette::Window, Qt::red);
+    widget->setPalette(palette);
+
+    int widgetId = editorSupport.mObjectRegister->idForObject(widget);
+    QString key;
+    QSize size = editorSupport.grabWidget(widgetId, QSize(200, 200), &key);
+
+    QCOMPARE(size, QSize(200, 50));
+    assertThumbnail(key, size, QColor(Qt::red));
+}
+
+void EditorSupportTest::testGrabWidgetSmallerThanMaxSize() {
+    EditorSupport editorSupport;
+    QWidget window;
+    editorSupport.setup(&window);
+
+    QWidget* widget = new QWidget(&window);
+    widget->resize(40, 10);
+    widget->setAutoFillBackground(true);
+    QPalette palette = widget->palette();
+    palette.setColor(QPalette::Window, Qt::blue);
+    widget->setPalette(palette);
+
+    int widgetId = editorSupport.mObjectRegister->idForObject(widget);
+    QString key;
+    QSize size = editorSupport.grabWidget(widgetId, QSize(200, 200), &key);
+
+    QCOMPARE(size, QSize(40, 10));
+    assertThumbnail(key, size, QColor(Qt::blue));
+}
+
+void EditorSupportTest::testGrabWidgetSeveralTimes() {
+    EditorSupport editorSupport;
+    QWidget window;
+    editorSupport.setup(&window);
+
+    QWidget* widget = new QWidget(&window);
+    widget->resize(40, 10);
+    widget->setAutoFillBackground(true);
+    QPalette palette = widget->palette();
+    palette.setColor(QPalette::Window, Qt::blue);
+    widget->setPalette(palette);
+
+    QWidget* bigWidget = new QWidget(&window);
+    bigWidget->resize(400, 400);
+    bigWidget->setAutoFillBackground(true);
+    palette.setColor(QPalette::Window, Qt::red);
+    bigWidget->setPalette(palette);
+
+    int widgetId = editorSupport.mObjectRegister->idForObject(widget);
+    int bigWidgetId = editorSupport.mObjectRegister->idForObject(bigWidget);
+
+    QString key;
+    QSize size = editorSupport.grabWidget(widgetId, QSize(400, 400), &key);
+
+    QCOMPARE(size, QSize(40, 10));
+    assertThumbnail(key, size, QColor(Qt::blue));
+
+    size = editorSupport.grabWidget(bigWidgetId, QSize(400, 400), &key);
+
+    QCOMPARE(size, QSize(400, 400));
+    assertThumbnail(key, size, QColor(Qt::red));
+}
+
+void EditorSupportTest::testGrabWidgetWithNotWidgetObject() {
+    EditorSupport editorSupport;
+    QWidget window;
+    editorSupport.setup(&window);
+
+    QObject* object = new QObject(&window);
+
+    int objectId = editorSupport.mObjectRegister->idForObject(object);
+
+    QString key = "Not empty";
+    QVERIFY(!editorSupport.grabWidget(objectId, QSize(200, 200),
+                                      &key).isValid());
+    QVERIFY(key.isEmpty());
+    QVERIFY(!editorSupport.grabWidget(0, QSize(200, 200), &key).isValid());
+    QVERIFY(key.isEmpty());
+}
+
+void EditorSupportTest::testGrabWidgetUsesRandomKey() {
+    EditorSupport editorSupport;
+    QWidget window;
+    editorSupport.setup(&window);
+
+    QWidget* widget = new QWidget(&window);
+    widget->resize(40, 10);
+
+    QWidget* bigWidget = new QWidget(&window);
+    bigWidget->resize(400, 400);
+
+    int widgetId = editorSupport.mObjectRegister->idForObject(widget);
+    int bigWidgetId = editorSupport.mObjectRegister->idForObject(bigWidget);
+
+    QString key;
+    editorSupport.grabWidget(widgetId, QSize(400, 400), &key);
+
+    QVERIFY(!key.isEmpty());
+    QVERIFY(!key.contains(QString::number(
+                                    QCoreApplication::applicationPid())));
+
+    EditorSupport otherEditorSupport;
+    QWidget otherWindow;
+    otherEditorSupport.setup(&otherWindow);
+
+    QWidget* otherWidget = new QWidget(&otherWindow);
+    otherWidget->resize(40, 10);
+
+    int otherWidgetId =
+                otherEditorSupport.mObjectRegister->idForObject(otherWidget);
+
+    QString otherKey;
+    QVERIFY(otherEditorSupport.grabWidget(otherWidgetId, QSize(400, 400),
+                                          &otherKey).isValid());
+    QVERIFY(otherKey != key);
+
+    //Growing the segment creates a new one with a new key
+    QString newKey;
+    QVERIFY(editorSupport.grabWidget(bigWidgetId, QSize(400, 400),
+                                     &newKey).isValid());
+    QVERIFY(!newKey.isEmpty());
+    QVERIFY(newKey != key);
+}
+
 void EditorSupportTest::testEnableEventSpy() {
     QDBusConnection bus = QDBusConnection::sessionBus();
     QVERIFY(bus.isConnected());
@@ -309,6 +469,71 @@ void EditorSupportTest::testDisableEventSpy() {
     QCOMPARE(mEventTypes.count(), 0);
 }
 
+void EditorSupportTest::testEnableTracing() {
+    EditorSupport editorSupport;
+
+    QSignalSpy spanTracedSpy(&editorSupport,
+            SIGNAL(spanTraced(QString,QString,QString,qlonglong,qlonglong)));
+
+    editorSupport.enableTracing(true);
+    Tracer::self()->addSpan("The span", "The detail", 4, 8);
+
+    QVERIFY(Tracer::isEnabled());
+    QCOMPARE(spanTracedSpy.count(), 1);
+    QCOMPARE(spanTracedSpy.at(0).at(0).toString(), QString("The span"));
+    QCOMPARE(spanTracedSpy.at(0).at(1).toString(), QString("The detail"));
+    QCOMPARE(spanTracedSpy.at(0).at(3).toLongLong(), (qlonglong)4);
+    QCOMPARE(spanTracedSpy.at(0).at(4).toLongLong(), (qlonglong)8);
+
+    editorSupport.disableTracing();
+    Tracer::self()->clear();
+}
+
+void EditorSupportTest::testEnableTracingWithoutStreamingSpans() {
+    EditorSupport editorSupport;
+
+    QSignalSpy spanTracedSpy(&editorSupport,
+            SIGNAL(spanTraced(QString,QString,QString,qlonglong,qlonglong)));
+
+    editorSupport.enableTracing(true);
+    editorSupport.enableTracing(false);
+    Tracer::self()->addSpan("The span", "The detail", 4, 8);
+
+    QVERIFY(Tracer::isEnabled());
+    QCOMPARE(spanTracedSpy.count(), 0);
+
+    editorSupport.disableTracing();
+    Tracer::self()->clear();
+}
+
+void EditorSupportTest::testDisableTracing() {
+    EditorSupport editorSupport;
+
+    QSignalSpy spanTracedSpy(&editorSupport,
+            SIGNAL(spanTraced(QString,QString,QString,qlonglong,qlonglong)));
+
+    editorSupport.enableTracing(true);
+    editorSupport.disableTracing();
+    Tracer::self()->addSpan("The span", "The detail", 4, 8);
+
+    QVERIFY(!Tracer::isEnabled());
+    QCOMPARE(spanTracedSpy.count(), 0);
+
+    Tracer::self()->clear();
+}
+
+void EditorSupportTest::testChromeTrace() {
+    EditorSupport editorSupport;
+
+    Tracer::self()->addSpan("The span", "The detail", 4, 8);
+
+    QCOMPARE(editorSupport.chromeTrace(),
+             QString::fromUtf8(Tracer::self()->chromeTrace()));
+    QVERIFY(editorSupport.chromeTrace().contains("\"name\":\"The span\""));
+
+    Tracer::self()->clear();
+}
+
 void EditorSupportTest::testTestScriptedTutorial() {
     KTemporaryFile temporaryFile;
     temporaryFile.setSuffix(".js");
@@ -356,7 +581,9 @@ void EditorSupportTest::testTestScriptedTutorial() {
     //Process deleteLater()
     QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
 
-    QCOMPARE(destroyedSpy.count(), 1);
+    //The finished tutorial is kept to be started again if tested again
+    QCOMPARE(destroyedSpy.count(), 0);
+    QCOMPARE(tutorial->parent(), &editorSupport);
 }
 
 void EditorSupportTest::testTestScriptedTutorialWithStepId() {
@@ -408,7 +635,9 @@ void EditorSupportTest::testTestScriptedTutorialWithStepId() {
     //Process deleteLater()
     QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
 
-    QCOMPARE(destroyedSpy.count(), 1);
+    //The finished tutorial is kept to be started again if tested again
+    QCOMPARE(destroyedSpy.count(), 0);
+    QCOMPARE(tutorial->parent(), &editorSupport);
 }
 
 void EditorSupportTest::testTestScriptedTutorialWithInvalidTutorial() {
@@ -433,6 +662,308 @@ void EditorSupportTest::testTestScriptedTutorialWithInvalidTutorial() {
     QCOMPARE(startedSpy.count(), 0);
 }
 
+void EditorSupportTest::testTestScriptedTutorialAgain() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out << "tutorial.addStep(ktutorial.newStep(\"second step\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName(), "second step");
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    QSignalSpy destroyedSpy(tutorial, SIGNAL(destroyed()));
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    QCOMPARE(startedSpy.count(), 2);
+    QCOMPARE(qvariant_cast<Tutorial*>(startedSpy.at(1).at(0)), tutorial);
+    QCOMPARE(destroyedSpy.count(), 0);
+    QVERIFY(tutorial->d->mCurrentStep);
+    QCOMPARE(tutorial->d->mCurrentStep->id(), QString("start"));
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+
+    QCOMPARE(destroyedSpy.count(), 0);
+}
+
+void EditorSupportTest::testTestScriptedTutorialAgainWithChangedScript() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    QSignalSpy destroyedSpy(tutorial, SIGNAL(destroyed()));
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+
+    out << "tutorial.addStep(ktutorial.newStep(\"second step\"));\n";
+    out.flush();
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+
+    QCOMPARE(destroyedSpy.count(), 1);
+    QCOMPARE(startedSpy.count(), 2);
+
+    Tutorial* newTutorial = qvariant_cast<Tutorial*>(startedSpy.at(1).at(0));
+    QVERIFY(newTutorial != tutorial);
+    QVERIFY(newTutorial->d->mSteps.contains("second step"));
+
+    newTutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(newTutorial, QEvent::DeferredDelete);
+}
+
+void EditorSupportTest::testTestScriptedTutorialAgainAfterUpdatingSteps() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    QSignalSpy destroyedSpy(tutorial, SIGNAL(destroyed()));
+
+    QStringList stepIds;
+    stepIds << "start";
+    QStringList stepScripts;
+    stepScripts << "step = ktutorial.newStep(\"start\");\n"
+                   "step.setText(\"The new start text\");\n"
+                   "tutorial.addStep(step);\n";
+
+    QVERIFY(editorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                          stepScripts));
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+
+    //The updated tutorial no longer matches its script, so it is not kept
+    QCOMPARE(destroyedSpy.count(), 1);
+}
+
+void EditorSupportTest::testUpdateTestScriptedTutorialSteps() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out << "tutorial.addStep(ktutorial.newStep(\"second step\"));\n";
+    out << "tutorial.addStep(ktutorial.newStep(\"third step\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName(), "second step");
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    Step* oldSecondStep = tutorial->d->mSteps.value("second step");
+
+    QStringList stepIds;
+    stepIds << "second step" << "third step";
+    QStringList stepScripts;
+    stepScripts << "step = ktutorial.newStep(\"second step\");\n"
+                   "step.setText(\"The new second text\");\n"
+                   "tutorial.addStep(step);\n";
+    stepScripts << "step = ktutorial.newStep(\"third step\");\n"
+                   "step.setText(\"The new third text\");\n"
+                   "tutorial.addStep(step);\n";
+
+    QVERIFY(editorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                          stepScripts));
+
+    Step* newSecondStep = tutorial->d->mSteps.value("second step");
+    QVERIFY(newSecondStep != oldSecondStep);
+    QCOMPARE(newSecondStep->text(), QString("The new second text"));
+    QCOMPARE(tutorial->d->mSteps.value("third step")->text(),
+             QString("The new third text"));
+    QCOMPARE(tutorial->d->mCurrentStep, newSecondStep);
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+}
+
+void EditorSupportTest::
+                    testUpdateTestScriptedTutorialStepsWithInvalidStepScript() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out << "tutorial.addStep(ktutorial.newStep(\"second step\"));\n";
+    out << "tutorial.addStep(ktutorial.newStep(\"third step\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    Step* oldSecondStep = tutorial->d->mSteps.value("second step");
+
+    QStringList stepIds;
+    stepIds << "second step" << "third step";
+    QStringList stepScripts;
+    stepScripts << "Just a bunch of text to make the script invalid\n";
+    stepScripts << "step = ktutorial.newStep(\"third step\");\n"
+                   "step.setText(\"The new third text\");\n"
+                   "tutorial.addStep(step);\n";
+
+    QVERIFY(!editorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                           stepScripts));
+
+    QCOMPARE(tutorial->d->mSteps.value("second step"), oldSecondStep);
+    QCOMPARE(tutorial->d->mSteps.value("third step")->text(),
+             QString("The new third text"));
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+}
+
+void EditorSupportTest::
+            testUpdateTestScriptedTutorialStepsWithDifferentNumberOfScripts() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    Step* oldStartStep = tutorial->d->mSteps.value("start");
+
+    QStringList stepIds;
+    stepIds << "start" << "second step";
+    QStringList stepScripts;
+    stepScripts << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+
+    QVERIFY(!editorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                           stepScripts));
+
+    QCOMPARE(tutorial->d->mSteps.value("start"), oldStartStep);
+
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+}
+
+void EditorSupportTest::
+                    testUpdateTestScriptedTutorialStepsWithoutTestedTutorial() {
+    EditorSupport editorSupport;
+
+    QStringList stepIds;
+    stepIds << "start";
+    QStringList stepScripts;
+    stepScripts << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+
+    QVERIFY(!editorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                           stepScripts));
+}
+
+void EditorSupportTest::
+                testUpdateTestScriptedTutorialStepsAfterFinishingTutorial() {
+    KTemporaryFile temporaryFile;
+    temporaryFile.setSuffix(".js");
+    temporaryFile.open();
+
+    QTextStream out(&temporaryFile);
+    out << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+    out.flush();
+
+    EditorSupport editorSupport;
+
+    //Tutorial* must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<Tutorial*>("Tutorial*");
+    QSignalSpy startedSpy(&editorSupport, SIGNAL(started(Tutorial*)));
+
+    editorSupport.testScriptedTutorial(temporaryFile.fileName());
+
+    Tutorial* tutorial = qvariant_cast<Tutorial*>(startedSpy.at(0).at(0));
+    tutorial->finish();
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(tutorial, QEvent::DeferredDelete);
+
+    QStringList stepIds;
+    stepIds << "start";
+    QStringList stepScripts;
+    stepScripts << "tutorial.addStep(ktutorial.newStep(\"start\"));\n";
+
+    QVERIFY(!editorSupport.updateTestScriptedTutorialSteps(stepIds,
+                                                           stepScripts));
+}
+
 //Not really a unit test, but sort of an integration test for a strange bug.
 void EditorSupportTest::
         testObjectRegisterWhenEventSpyNotifiesEventBeforeEndingConstructor() {
@@ -458,8 +989,12 @@ void EditorSupportTest::
     //is sent by QWidget constructor itself. The object is not fully
     //constructed, so SubClassWidget and SubSubClassWidget are not registered.
     ObjectRegister* objectRegister = editorSupport.mObjectRegister;
-    QCOMPARE(objectRegister->objectForId(1), &mainWidget);
-    QCOMPARE(objectRegister->objectForId(2), childWidget);
+    int mainWidgetId = objectRegister->mRegisteredIds.value(&mainWidget);
+    int childWidgetId = objectRegister->mRegisteredIds.value(childWidget);
+    QVERIFY(mainWidgetId);
+    QVERIFY(childWidgetId);
+    QCOMPARE(objectRegister->objectForId(mainWidgetId), &mainWidget);
+    QCOMPARE(objectRegister->objectForId(childWidgetId), childWidget);
     QVERIFY(objectRegister->metaObjectForClassName("QWidget"));
     QVERIFY(!objectRegister->metaObjectForClassName("SubClassWidget"));
     QVERIFY(!objectRegister->metaObjectForClassName("SubSubClassWidget"));
@@ -472,11 +1007,33 @@ void EditorSupportTest::
     ObjectRegisterAdaptor* objectRegisterAdaptor =
                             objectRegister->findChild<ObjectRegisterAdaptor*>();
 
-    QCOMPARE(objectRegisterAdaptor->className(2), QString("SubSubClassWidget"));
+    QCOMPARE(objectRegisterAdaptor->className(childWidgetId),
+             QString("SubSubClassWidget"));
     QVERIFY(objectRegister->metaObjectForClassName("SubClassWidget"));
     QVERIFY(objectRegister->metaObjectForClassName("SubSubClassWidget"));
 }
 
+/////////////////////////////////////Helpers////////////////////////////////////
+
+void EditorSupportTest::assertThumbnail(const QString& key, const QSize& size,
+                                        const QColor& color) const {
+    QSharedMemory memory(key);
+    QVERIFY(memory.attach(QSharedMemory::ReadOnly));
+    QVERIFY(memory.size() >= size.width() * size.height() * 4);
+
+    memory.lock();
+    QImage thumbnail(static_cast<const uchar*>(memory.constData()),
+                     size.width(), size.height(), size.width() * 4,
+                     QImage::Format_ARGB32);
+    QRgb topLeftPixel = thumbnail.pixel(0, 0);
+    QRgb bottomRightPixel = thumbnail.pixel(size.width() - 1,
+                                            size.height() - 1);
+    memory.unlock();
+
+    QCOMPARE(topLeftPixel, color.rgb());
+    QCOMPARE(bottomRightPixel, color.rgb());
+}
+
 }
 }
 
@@ -37,6 +37,11 @@ private slots:
 
     void testEventReceived();
 
+    void testObjectDestroyed();
+    void testObjectDestroyedWhenChildIsRemovedButNotDestroyed();
+    void testObjectDestroyedWhenChildIsNotRegistered();
+    void testObjectDestroyedWithRegisteredDescendants();
+
 };
 
 void EventSpyAdaptorTest::testConstructor() {
@@ -70,6 +75,94 @@ void EventSpyAdaptorTest::testEventReceived() {
     QCOMPARE(argument.toString(), QString("Show"));
 }
 
+void EventSpyAdaptorTest::testObjectDestroyed() {
+    EventSpy spy;
+    QObject spiedObject;
+    QObject* child = new QObject(&spiedObject);
+    spy.addObjectToSpy(&spiedObject);
+    ObjectRegister objectRegister;
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, &objectRegister);
+
+    int childId = objectRegister.idForObject(child);
+
+    QSignalSpy objectDestroyedSpy(adaptor, SIGNAL(objectDestroyed(int)));
+
+    delete child;
+
+    QCOMPARE(objectDestroyedSpy.count(), 1);
+    QVariant argument = objectDestroyedSpy.at(0).at(0);
+    QCOMPARE(argument.type(), QVariant::Int);
+    QCOMPARE(argument.toInt(), childId);
+}
+
+void EventSpyAdaptorTest::
+                    testObjectDestroyedWhenChildIsRemovedButNotDestroyed() {
+    EventSpy spy;
+    QObject spiedObject;
+    QObject child;
+    child.setParent(&spiedObject);
+    spy.addObjectToSpy(&spiedObject);
+    ObjectRegister objectRegister;
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, &objectRegister);
+
+    int childId = objectRegister.idForObject(&child);
+
+    QSignalSpy objectDestroyedSpy(adaptor, SIGNAL(objectDestroyed(int)));
+
+    child.setParent(0);
+
+    QCOMPARE(objectDestroyedSpy.count(), 0);
+    QCOMPARE(objectRegister.idForObject(&child), childId);
+}
+
+void EventSpyAdaptorTest::testObjectDestroyedWhenChildIsNotRegistered() {
+    EventSpy spy;
+    QObject spiedObject;
+    QObject* child = new QObject(&spiedObject);
+    spy.addObjectToSpy(&spiedObject);
+    ObjectRegister objectRegister;
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, &objectRegister);
+
+    QSignalSpy objectDestroyedSpy(adaptor, SIGNAL(objectDestroyed(int)));
+
+    delete child;
+
+    QCOMPARE(objectDestroyedSpy.count(), 0);
+}
+
+void EventSpyAdaptorTest::testObjectDestroyedWithRegisteredDescendants() {
+    EventSpy spy;
+    QObject spiedObject;
+    QObject* child = new QObject(&spiedObject);
+    QObject* grandchild = new QObject(child);
+    QObject* greatGrandchild = new QObject(grandchild);
+    spy.addObjectToSpy(&spiedObject);
+    ObjectRegister objectRegister;
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, &objectRegister);
+
+    int childId = objectRegister.idForObject(child);
+    int grandchildId = objectRegister.idForObject(grandchild);
+    int greatGrandchildId = objectRegister.idForObject(greatGrandchild);
+
+    QSignalSpy objectDestroyedSpy(adaptor, SIGNAL(objectDestroyed(int)));
+
+    //The descendants of the child are destroyed without sending a
+    //ChildRemoved event to their parent
+    delete child;
+
+    QCOMPARE(objectDestroyedSpy.count(), 1);
+    QCOMPARE(objectDestroyedSpy.at(0).at(0).toInt(), childId);
+
+    QCoreApplication::sendPostedEvents(&objectRegister, QEvent::MetaCall);
+
+    QCOMPARE(objectDestroyedSpy.count(), 3);
+    QList<int> ids;
+    ids << objectDestroyedSpy.at(1).at(0).toInt()
+        << objectDestroyedSpy.at(2).at(0).toInt();
+    QVERIFY(ids.contains(grandchildId));
+    QVERIFY(ids.contains(greatGrandchildId));
+}
+
 }
 }
 
@@ -21,7 +21,9 @@
 #include <QApplication>
 #include <QSignalSpy>
 
+#define private public
 #include "EventSpy.h"
+#undef private
 
 //QEvent* must be declared as a metatype to be used in qvariant_cast
 Q_DECLARE_METATYPE(QEvent*);
@@ -43,6 +45,21 @@ private slots:
     void testEventReceivedInChildObjectAddedAfterSpyingStart();
     void testEventReceivedSeveralObjects();
 
+    void testConstructorWithApplicationFilter();
+
+    void testEventReceivedWithApplicationFilter();
+    void testEventReceivedInChildObjectWithApplicationFilter();
+    void testEventReceivedInNewChildObjectWithApplicationFilter();
+    void testEventReceivedSeveralObjectsWithApplicationFilter();
+    void testEventNotReceivedInNotSpiedObjectWithApplicationFilter();
+    void testEventReceivedInReparentedObjectWithApplicationFilter();
+    void testEventReceivedInReparentedGrandchildWithApplicationFilter();
+    void testUnrelatedChildAddedKeepsCacheWithApplicationFilter();
+    void testAddObjectToSpyTwiceWithApplicationFilter();
+    void testDestroyedChildrenRemovedFromCacheWithApplicationFilter();
+    void testNotSpiedObjectAddedToSpyWithApplicationFilter();
+    void testEventNotReceivedAfterDestroyingEventSpyWithApplicationFilter();
+
 private:
 
     int mEventStarType;
@@ -138,6 +155,282 @@ void EventSpyTest::testEventReceivedSeveralObjects() {
     assertEventReceivedSignal(eventEmittedSpy, 1, &spiedObject2, &event2);
 }
 
+void EventSpyTest::testConstructorWithApplicationFilter() {
+    QObject parent;
+    EventSpy* spy = new EventSpy(&parent, EventSpy::ApplicationFilter);
+
+    QCOMPARE(spy->parent(), &parent);
+    QCOMPARE(spy->filterMode(), EventSpy::ApplicationFilter);
+}
+
+void EventSpyTest::testEventReceivedWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&spiedObject, &event);
+
+    QCOMPARE(eventEmittedSpy.count(), 1);
+    assertEventReceivedSignal(eventEmittedSpy, 0, &spiedObject, &event);
+}
+
+void EventSpyTest::testEventReceivedInChildObjectWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    QObject* childObject = new QObject(&spiedObject);
+    QObject* grandChildObject = new QObject(childObject);
+    spy.addObjectToSpy(&spiedObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event1(QEvent::Show);
+    QApplication::sendEvent(childObject, &event1);
+    QEvent event2(QEvent::Show);
+    QApplication::sendEvent(grandChildObject, &event2);
+
+    QCOMPARE(eventEmittedSpy.count(), 2);
+    assertEventReceivedSignal(eventEmittedSpy, 0, childObject, &event1);
+    assertEventReceivedSignal(eventEmittedSpy, 1, grandChildObject, &event2);
+}
+
+void EventSpyTest::testEventReceivedInNewChildObjectWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    QObject* childObject = new QObject(&spiedObject);
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(childObject, &event);
+
+    QCOMPARE(eventEmittedSpy.count(), 2);
+    //First event is a ChildAdded emitted when the childObject was added. The
+    //event is automatically destroyed afterwards, so it can not be checked here
+    assertEventReceivedSignal(eventEmittedSpy, 1, childObject, &event);
+}
+
+void EventSpyTest::testEventReceivedSeveralObjectsWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject1;
+    spy.addObjectToSpy(&spiedObject1);
+    QObject spiedObject2;
+    spy.addObjectToSpy(&spiedObject2);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event1(QEvent::Show);
+    QApplication::sendEvent(&spiedObject1, &event1);
+    QEvent event2(QEvent::Show);
+    QApplication::sendEvent(&spiedObject2, &event2);
+
+    QCOMPARE(eventEmittedSpy.count(), 2);
+    assertEventReceivedSignal(eventEmittedSpy, 0, &spiedObject1, &event1);
+    assertEventReceivedSignal(eventEmittedSpy, 1, &spiedObject2, &event2);
+}
+
+void EventSpyTest::testEventNotReceivedInNotSpiedObjectWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    QObject notSpiedObject;
+    QObject* notSpiedChildObject = new QObject(&notSpiedObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&notSpiedObject, &event);
+    QApplication::sendEvent(notSpiedChildObject, &event);
+
+    QCOMPARE(eventEmittedSpy.count(), 0);
+}
+
+void EventSpyTest::testEventReceivedInReparentedObjectWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    QObject notSpiedObject;
+    QObject* childObject = new QObject(&notSpiedObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event1(QEvent::Show);
+    QApplication::sendEvent(childObject, &event1);
+
+    QCOMPARE(eventEmittedSpy.count(), 0);
+
+    childObject->setParent(&spiedObject);
+
+    QEvent event2(QEvent::Show);
+    QApplication::sendEvent(childObject, &event2);
+
+    //First event is a ChildAdded emitted when the childObject was added. The
+    //event is automatically destroyed afterwards, so it can not be checked here
+    QCOMPARE(eventEmittedSpy.count(), 2);
+    assertEventReceivedSignal(eventEmittedSpy, 1, childObject, &event2);
+
+    childObject->setParent(&notSpiedObject);
+
+    QEvent event3(QEvent::Show);
+    QApplication::sendEvent(childObject, &event3);
+
+    //Third event is a ChildRemoved emitted when the childObject was removed
+    QCOMPARE(eventEmittedSpy.count(), 3);
+}
+
+void EventSpyTest::
+        testEventReceivedInReparentedGrandchildWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    QObject* childObject = new QObject(&spiedObject);
+    QObject* grandchildObject = new QObject(childObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event1(QEvent::Show);
+    QApplication::sendEvent(grandchildObject, &event1);
+
+    QCOMPARE(eventEmittedSpy.count(), 1);
+    QVERIFY(spy.mSpiedObjectCache.value(grandchildObject).mSpied);
+
+    QObject notSpiedObject;
+    childObject->setParent(&notSpiedObject);
+
+    QVERIFY(!spy.mSpiedObjectCache.contains(childObject));
+    QVERIFY(!spy.mSpiedObjectCache.contains(grandchildObject));
+
+    QEvent event2(QEvent::Show);
+    QApplication::sendEvent(grandchildObject, &event2);
+
+    //Second event is a ChildRemoved emitted when the childObject was removed
+    QCOMPARE(eventEmittedSpy.count(), 2);
+}
+
+void EventSpyTest::testUnrelatedChildAddedKeepsCacheWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    QObject* childObject = new QObject(&spiedObject);
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(childObject, &event);
+
+    QVERIFY(spy.mSpiedObjectCache.contains(childObject));
+
+    QObject notSpiedObject;
+    new QObject(&notSpiedObject);
+    new QObject(&spiedObject);
+
+    QVERIFY(spy.mSpiedObjectCache.contains(childObject));
+}
+
+void EventSpyTest::testAddObjectToSpyTwiceWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    spy.addObjectToSpy(&spiedObject);
+
+    QCOMPARE(spy.mSpiedObjects.count(), 1);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&spiedObject, &event);
+
+    QCOMPARE(eventEmittedSpy.count(), 1);
+}
+
+void EventSpyTest::
+        testDestroyedChildrenRemovedFromCacheWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    QObject* childObject = new QObject(&spiedObject);
+    QObject* grandchildObject = new QObject(childObject);
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(grandchildObject, &event);
+
+    QVERIFY(spy.mSpiedObjectCache.contains(childObject));
+    QVERIFY(spy.mSpiedObjectCache.contains(grandchildObject));
+
+    //The grandchild is deleted by its parent without sending a ChildRemoved
+    //event
+    delete childObject;
+
+    QVERIFY(spy.mSpiedObjectCache.isEmpty());
+}
+
+void EventSpyTest::testNotSpiedObjectAddedToSpyWithApplicationFilter() {
+    EventSpy spy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    QObject notSpiedObject;
+    QObject* childObject = new QObject(&notSpiedObject);
+
+    QSignalSpy eventEmittedSpy(&spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event1(QEvent::Show);
+    QApplication::sendEvent(childObject, &event1);
+
+    QCOMPARE(eventEmittedSpy.count(), 0);
+    QVERIFY(!spy.mSpiedObjectCache.value(childObject).mSpied);
+
+    spy.addObjectToSpy(&notSpiedObject);
+
+    QEvent event2(QEvent::Show);
+    QApplication::sendEvent(childObject, &event2);
+
+    QCOMPARE(eventEmittedSpy.count(), 1);
+    assertEventReceivedSignal(eventEmittedSpy, 0, childObject, &event2);
+    QVERIFY(spy.mSpiedObjectCache.value(childObject).mSpied);
+}
+
+void EventSpyTest::
+        testEventNotReceivedAfterDestroyingEventSpyWithApplicationFilter() {
+    EventSpy* spy = new EventSpy(0, EventSpy::ApplicationFilter);
+    QObject spiedObject;
+    spy->addObjectToSpy(&spiedObject);
+
+    QSignalSpy eventEmittedSpy(spy, SIGNAL(eventReceived(QObject*,QEvent*)));
+
+    delete spy;
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&spiedObject, &event);
+
+    QCOMPARE(eventEmittedSpy.count(), 0);
+}
+
 /////////////////////////////////Helpers////////////////////////////////////////
 
 void EventSpyTest::assertEventReceivedSignal(const QSignalSpy& spy, int index,
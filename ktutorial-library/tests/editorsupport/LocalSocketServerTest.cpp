@@ -0,0 +1,548 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QApplication>
+#include <QLocalSocket>
+#include <QTime>
+
+#include "LocalSocketServer.h"
+#include "ClassRegisterAdaptor.h"
+#include "EventSpy.h"
+#include "EventSpyAdaptor.h"
+#include "ObjectRegister.h"
+#include "ObjectRegisterAdaptor.h"
+
+namespace ktutorial {
+namespace editorsupport {
+
+class LocalSocketServerTest: public QObject {
+Q_OBJECT
+
+Q_PROPERTY(QString dummyProperty READ dummyProperty)
+
+public:
+
+    QString dummyProperty() const {
+        return "";
+    }
+
+Q_SIGNALS:
+
+    void dummySignal(int argument);
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void testListen();
+    void testListenWithServerNameInUse();
+
+    void testAuthenticateWithWrongToken();
+    void testRequestWithoutAuthentication();
+    void testAuthenticateWithTooBigMessage();
+    void testRequestWithTooBigMessage();
+    void testUnknownRequest();
+
+    void testObjectName();
+    void testClassName();
+    void testChildObjectIds();
+
+    void testSuperClass();
+    void testPropertyList();
+    void testSignalList();
+    void testClassHierarchy();
+
+    void testSeveralRequestsInOneWrite();
+
+    void testEventReceived();
+    void testEventReceivedWithoutSubscription();
+    void testEventReceivedAfterRemovingEventSpyAdaptor();
+
+private:
+
+    ObjectRegister* mObjectRegister;
+    LocalSocketServer* mServer;
+    QLocalSocket* mSocket;
+
+    void authenticate(QLocalSocket* socket, const QString& token);
+    void writeRequest(const QByteArray& request);
+    QByteArray readMessage();
+
+    QByteArray objectRequest(LocalSocketServer::Request requestType,
+                             int objectId) const;
+    QByteArray classRequest(LocalSocketServer::Request requestType,
+                            const QString& className) const;
+
+};
+
+void LocalSocketServerTest::init() {
+    mObjectRegister = new ObjectRegister();
+    ClassRegisterAdaptor* classRegisterAdaptor =
+                                    new ClassRegisterAdaptor(mObjectRegister);
+    ObjectRegisterAdaptor* objectRegisterAdaptor =
+                                    new ObjectRegisterAdaptor(mObjectRegister);
+
+    mServer = new LocalSocketServer(objectRegisterAdaptor,
+                                    classRegisterAdaptor, "The token");
+    QVERIFY(mServer->listen("ktutorial-LocalSocketServerTest"));
+
+    mSocket = new QLocalSocket();
+    mSocket->connectToServer(mServer->serverName());
+    QVERIFY(mSocket->waitForConnected(1000));
+
+    authenticate(mSocket, "The token");
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    bool authenticated = false;
+    reply >> messageType >> authenticated;
+    QVERIFY(authenticated);
+}
+
+void LocalSocketServerTest::cleanup() {
+    delete mSocket;
+    delete mServer;
+    delete mObjectRegister;
+}
+
+void LocalSocketServerTest::testListen() {
+    QVERIFY(mServer->serverName().endsWith(
+                                        "ktutorial-LocalSocketServerTest"));
+}
+
+void LocalSocketServerTest::testListenWithServerNameInUse() {
+    LocalSocketServer server(0, 0, "The token");
+
+    QVERIFY(!server.listen("ktutorial-LocalSocketServerTest"));
+    QVERIFY(server.serverName().isEmpty());
+
+    //The server already listening is not affected
+    QLocalSocket socket;
+    socket.connectToServer(mServer->serverName());
+    QVERIFY(socket.waitForConnected(1000));
+}
+
+void LocalSocketServerTest::testAuthenticateWithWrongToken() {
+    QLocalSocket socket;
+    socket.connectToServer(mServer->serverName());
+    QVERIFY(socket.waitForConnected(1000));
+
+    authenticate(&socket, "The wrong token");
+
+    QTime time;
+    time.start();
+    while (socket.state() != QLocalSocket::UnconnectedState &&
+           time.elapsed() < 1000) {
+        QCoreApplication::processEvents();
+        socket.waitForDisconnected(10);
+    }
+
+    QCOMPARE(socket.state(), QLocalSocket::UnconnectedState);
+    QCOMPARE(socket.bytesAvailable(), (qint64)0);
+}
+
+void LocalSocketServerTest::testRequestWithoutAuthentication() {
+    QObject object;
+    int objectId = mObjectRegister->idForObject(&object);
+
+    QLocalSocket socket;
+    socket.connectToServer(mServer->serverName());
+    QVERIFY(socket.waitForConnected(1000));
+
+    QDataStream out(&socket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << objectRequest(LocalSocketServer::ObjectNameRequest, objectId);
+
+    QTime time;
+    time.start();
+    while (socket.state() != QLocalSocket::UnconnectedState &&
+           time.elapsed() < 1000) {
+        QCoreApplication::processEvents();
+        socket.waitForDisconnected(10);
+    }
+
+    QCOMPARE(socket.state(), QLocalSocket::UnconnectedState);
+    QCOMPARE(socket.bytesAvailable(), (qint64)0);
+}
+
+void LocalSocketServerTest::testAuthenticateWithTooBigMessage() {
+    QLocalSocket socket;
+    socket.connectToServer(mServer->serverName());
+    QVERIFY(socket.waitForConnected(1000));
+
+    //Only the length is sent; the server must not wait for the rest
+    QDataStream out(&socket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint32)(1024 * 1024);
+
+    QTime time;
+    time.start();
+    while (socket.state() != QLocalSocket::UnconnectedState &&
+           time.elapsed() < 1000) {
+        QCoreApplication::processEvents();
+        socket.waitForDisconnected(10);
+    }
+
+    QCOMPARE(socket.state(), QLocalSocket::UnconnectedState);
+    QCOMPARE(socket.bytesAvailable(), (qint64)0);
+}
+
+void LocalSocketServerTest::testRequestWithTooBigMessage() {
+    //Only the length is sent; the server must not wait for the rest
+    QDataStream out(mSocket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint32)(16 * 1024 * 1024);
+
+    QTime time;
+    time.start();
+    while (mSocket->state() != QLocalSocket::UnconnectedState &&
+           time.elapsed() < 1000) {
+        QCoreApplication::processEvents();
+        mSocket->waitForDisconnected(10);
+    }
+
+    QCOMPARE(mSocket->state(), QLocalSocket::UnconnectedState);
+}
+
+void LocalSocketServerTest::testUnknownRequest() {
+    QObject object;
+    object.setObjectName("The object name");
+    int objectId = mObjectRegister->idForObject(&object);
+
+    QByteArray request;
+    QDataStream requestStream(&request, QIODevice::WriteOnly);
+    requestStream.setVersion(QDataStream::Qt_4_6);
+    requestStream << (quint8)42;
+
+    writeRequest(request);
+    writeRequest(objectRequest(LocalSocketServer::ObjectNameRequest,
+                               objectId));
+
+    QDataStream error(readMessage());
+    quint8 messageType;
+    QString errorMessage;
+    error >> messageType >> errorMessage;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ErrorMessage);
+    QVERIFY(!errorMessage.isEmpty());
+
+    //The replies are still in the same order as the requests
+    QDataStream reply(readMessage());
+    QString objectName;
+    reply >> messageType >> objectName;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(objectName, QString("The object name"));
+}
+
+void LocalSocketServerTest::testObjectName() {
+    QObject object;
+    object.setObjectName("The object name");
+    int objectId = mObjectRegister->idForObject(&object);
+
+    writeRequest(objectRequest(LocalSocketServer::ObjectNameRequest,
+                               objectId));
+
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    QString objectName;
+    reply >> messageType >> objectName;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(objectName, QString("The object name"));
+}
+
+void LocalSocketServerTest::testClassName() {
+    int objectId = mObjectRegister->idForObject(this);
+
+    writeRequest(objectRequest(LocalSocketServer::ClassNameRequest, objectId));
+
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    QString className;
+    reply >> messageType >> className;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(className,
+             QString("ktutorial::editorsupport::LocalSocketServerTest"));
+}
+
+void LocalSocketServerTest::testChildObjectIds() {
+    QObject parent;
+    QObject* child1 = new QObject(&parent);
+    QObject* child2 = new QObject(&parent);
+    int objectId = mObjectRegister->idForObject(&parent);
+
+    writeRequest(objectRequest(LocalSocketServer::ChildObjectIdsRequest,
+                               objectId));
+
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    QList<qint32> childObjectIds;
+    reply >> messageType >> childObjectIds;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(childObjectIds.count(), 2);
+    QCOMPARE(mObjectRegister->objectForId(childObjectIds[0]), child1);
+    QCOMPARE(mObjectRegister->objectForId(childObjectIds[1]), child2);
+}
+
+void LocalSocketServerTest::testSuperClass() {
+    mObjectRegister->idForObject(this);
+
+    writeRequest(classRequest(LocalSocketServer::SuperClassRequest,
+                        "ktutorial::editorsupport::LocalSocketServerTest"));
+
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    QString superClass;
+    reply >> messageType >> superClass;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(superClass, QString("QObject"));
+}
+
+void LocalSocketServerTest::testPropertyList() {
+    mObjectRegister->idForObject(this);
+
+    writeRequest(classRequest(LocalSocketServer::PropertyListRequest,
+                        "ktutorial::editorsupport::LocalSocketServerTest"));
+
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    QStringList propertyList;
+    reply >> messageType >> propertyList;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(propertyList.count(), 1);
+    QCOMPARE(propertyList[0], QString("dummyProperty"));
+}
+
+void LocalSocketServerTest::testSignalList() {
+    mObjectRegister->idForObject(this);
+
+    writeRequest(classRequest(LocalSocketServer::SignalListRequest,
+                        "ktutorial::editorsupport::LocalSocketServerTest"));
+
+    QDataStream reply(readMessage());
+    quint8 messageType;
+    QStringList signalList;
+    reply >> messageType >> signalList;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(signalList.count(), 1);
+    QCOMPARE(signalList[0], QString("dummySignal(int)"));
+}
+
+void LocalSocketServerTest::testClassHierarchy() {
+    mObjectRegister->idForObject(this);
+
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)LocalSocketServer::ClassHierarchyRequest;
+    writeRequest(request);
+
+    QDataStream reply(readMessage());
+    reply.setVersion(QDataStream::Qt_4_6);
+    quint8 messageType;
+    QVariantMap classHierarchy;
+    reply >> messageType >> classHierarchy;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::ReplyMessage);
+    QCOMPARE(classHierarchy.count(), 2);
+
+    QVariantMap classData = classHierarchy.value(
+            "ktutorial::editorsupport::LocalSocketServerTest").toMap();
+    QCOMPARE(classData.value("superClass").toString(), QString("QObject"));
+    QCOMPARE(classData.value("propertyList").toStringList(),
+             QStringList() << "dummyProperty");
+    QCOMPARE(classData.value("signalList").toStringList(),
+             QStringList() << "dummySignal(int)");
+    QVERIFY(classHierarchy.contains("QObject"));
+}
+
+void LocalSocketServerTest::testSeveralRequestsInOneWrite() {
+    QObject object;
+    object.setObjectName("The object name");
+    int objectId = mObjectRegister->idForObject(&object);
+
+    QByteArray requests;
+    QDataStream out(&requests, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << objectRequest(LocalSocketServer::ObjectNameRequest, objectId);
+    out << objectRequest(LocalSocketServer::ClassNameRequest, objectId);
+    mSocket->write(requests);
+
+    QDataStream reply1(readMessage());
+    quint8 messageType;
+    QString objectName;
+    reply1 >> messageType >> objectName;
+
+    QCOMPARE(objectName, QString("The object name"));
+
+    QDataStream reply2(readMessage());
+    QString className;
+    reply2 >> messageType >> className;
+
+    QCOMPARE(className, QString("QObject"));
+}
+
+void LocalSocketServerTest::testEventReceived() {
+    EventSpy spy;
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, mObjectRegister);
+    mServer->setEventSpyAdaptor(adaptor);
+
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out << (quint8)LocalSocketServer::SubscribeToEventsRequest;
+    writeRequest(request);
+
+    //Wait for the subscription to be handled
+    QTest::qWait(100);
+
+    //Send an event not managed by QObject to avoid messing up its internal
+    //state
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&spiedObject, &event);
+
+    QDataStream message(readMessage());
+    quint8 messageType;
+    qint32 objectId;
+    QString eventType;
+    message >> messageType >> objectId >> eventType;
+
+    QCOMPARE(messageType, (quint8)LocalSocketServer::EventReceivedMessage);
+    QCOMPARE(objectId, (qint32)mObjectRegister->idForObject(&spiedObject));
+    QCOMPARE(eventType, QString("Show"));
+}
+
+void LocalSocketServerTest::testEventReceivedWithoutSubscription() {
+    EventSpy spy;
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, mObjectRegister);
+    mServer->setEventSpyAdaptor(adaptor);
+
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&spiedObject, &event);
+
+    QVERIFY(readMessage().isEmpty());
+}
+
+void LocalSocketServerTest::testEventReceivedAfterRemovingEventSpyAdaptor() {
+    EventSpy spy;
+    QObject spiedObject;
+    spy.addObjectToSpy(&spiedObject);
+    EventSpyAdaptor* adaptor = new EventSpyAdaptor(&spy, mObjectRegister);
+    mServer->setEventSpyAdaptor(adaptor);
+
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out << (quint8)LocalSocketServer::SubscribeToEventsRequest;
+    writeRequest(request);
+
+    QTest::qWait(100);
+
+    mServer->setEventSpyAdaptor(0);
+
+    QEvent event(QEvent::Show);
+    QApplication::sendEvent(&spiedObject, &event);
+
+    QVERIFY(readMessage().isEmpty());
+}
+
+/////////////////////////////////Helpers////////////////////////////////////////
+
+void LocalSocketServerTest::authenticate(QLocalSocket* socket,
+                                         const QString& token) {
+    QByteArray request;
+    QDataStream requestStream(&request, QIODevice::WriteOnly);
+    requestStream.setVersion(QDataStream::Qt_4_6);
+    requestStream << (quint8)LocalSocketServer::AuthenticateRequest << token;
+
+    QDataStream out(socket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << request;
+}
+
+void LocalSocketServerTest::writeRequest(const QByteArray& request) {
+    QDataStream out(mSocket);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << request;
+}
+
+QByteArray LocalSocketServerTest::readMessage() {
+    //The server and the client live in the same thread, so the events have to
+    //be processed for the server to answer
+    QTime time;
+    time.start();
+    while (time.elapsed() < 1000) {
+        QCoreApplication::processEvents();
+
+        if (mSocket->bytesAvailable() >= (qint64)sizeof(quint32)) {
+            QDataStream sizeStream(mSocket->peek(sizeof(quint32)));
+            quint32 size;
+            sizeStream >> size;
+
+            if (mSocket->bytesAvailable() >=
+                                    (qint64)(sizeof(quint32) + size)) {
+                QDataStream in(mSocket);
+                in.setVersion(QDataStream::Qt_4_6);
+                QByteArray message;
+                in >> message;
+                return message;
+            }
+        }
+
+        mSocket->waitForReadyRead(10);
+    }
+
+    return QByteArray();
+}
+
+QByteArray LocalSocketServerTest::objectRequest(
+                                    LocalSocketServer::Request requestType,
+                                    int objectId) const {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)requestType << (qint32)objectId;
+    return request;
+}
+
+QByteArray LocalSocketServerTest::classRequest(
+                                    LocalSocketServer::Request requestType,
+                                    const QString& className) const {
+    QByteArray request;
+    QDataStream out(&request, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_4_6);
+    out << (quint8)requestType << className;
+    return request;
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::editorsupport::LocalSocketServerTest)
+
+#include "LocalSocketServerTest.moc"
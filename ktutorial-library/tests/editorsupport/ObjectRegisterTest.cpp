@@ -18,7 +18,14 @@
 
 #include <QTest>
 
+#include <QCoreApplication>
+#include <QSignalSpy>
+
+#define protected public
+#define private public
 #include "ObjectRegister.h"
+#undef private
+#undef protected
 
 class DummyClass: public QObject {
 Q_OBJECT
@@ -46,10 +53,22 @@ private slots:
     void testRegisterObjectSeveralObjects();
     void testRegisterObjectTwice();
     void testRegisterNullObject();
+    void testRegisterObjectWithoutFreeSlots();
+
+    void testRegisteredClasses();
 
     void testObjectForIdWithDestroyedObject();
+    void testObjectForIdWithDestroyedObjectAndReusedSlot();
+    void testObjectForIdWithInvalidId();
+
+    void testReleaseIdForDestroyedObject();
+    void testReleaseIdForDestroyedObjectWithAliveObject();
+    void testReleaseIdForDestroyedObjectWithUnregisteredObject();
+    void testReleaseIdForDestroyedObjectWithMaximumGeneration();
+    void testReleaseIdForDestroyedObjectWithDestroyedDescendants();
 
     void testClear();
+    void testRegisterObjectAfterClear();
 
 };
 
@@ -122,6 +141,42 @@ void ObjectRegisterTest::testRegisterNullObject() {
     QCOMPARE(objectRegister.objectForId(id), (QObject*)0);
 }
 
+void ObjectRegisterTest::testRegisterObjectWithoutFreeSlots() {
+    ObjectRegister objectRegister;
+    objectRegister.mSlots.resize(ObjectRegister::IndexMask);
+    QObject object;
+
+    QCOMPARE(objectRegister.idForObject(&object), 0);
+    QVERIFY(objectRegister.mRegisteredIds.isEmpty());
+    QCOMPARE(objectRegister.mSlots.count(), (int)ObjectRegister::IndexMask);
+}
+
+void ObjectRegisterTest::testRegisteredClasses() {
+    ObjectRegister objectRegister;
+    DummyChildClass1 object;
+
+    objectRegister.idForObject(&object);
+
+    QStringList classNames = objectRegister.registeredClassNames();
+    QCOMPARE(classNames.count(), 3);
+    QVERIFY(classNames.contains("DummyChildClass1"));
+    QVERIFY(classNames.contains("DummyClass"));
+    QVERIFY(classNames.contains("QObject"));
+
+    QCOMPARE(objectRegister.propertyListForClassName("DummyChildClass1"),
+             QStringList());
+    QCOMPARE(objectRegister.signalListForClassName("DummyChildClass1"),
+             QStringList());
+    QCOMPARE(objectRegister.propertyListForClassName("QObject"),
+             QStringList() << "objectName");
+    QCOMPARE(objectRegister.signalListForClassName("QObject"),
+             QStringList() << "destroyed(QObject*)" << "destroyed()");
+    QCOMPARE(objectRegister.propertyListForClassName("UnknownClassName"),
+             QStringList());
+    QCOMPARE(objectRegister.signalListForClassName("UnknownClassName"),
+             QStringList());
+}
+
 void ObjectRegisterTest::testObjectForIdWithDestroyedObject() {
     ObjectRegister objectRegister;
     QObject* object = new QObject();
@@ -135,6 +190,139 @@ void ObjectRegisterTest::testObjectForIdWithDestroyedObject() {
              &QObject::staticMetaObject);
 }
 
+void ObjectRegisterTest::testObjectForIdWithDestroyedObjectAndReusedSlot() {
+    ObjectRegister objectRegister;
+    QObject* object = new QObject();
+
+    int id = objectRegister.idForObject(object);
+
+    delete object;
+
+    QList<QObject*> objects;
+    QList<int> ids;
+    for (int i=0; i<200; ++i) {
+        objects.append(new QObject());
+        ids.append(objectRegister.idForObject(objects[i]));
+    }
+
+    QCOMPARE(objectRegister.objectForId(id), (QObject*)0);
+    QVERIFY(!ids.contains(id));
+    for (int i=0; i<200; ++i) {
+        QCOMPARE(objectRegister.objectForId(ids[i]), objects[i]);
+        QCOMPARE(objectRegister.idForObject(objects[i]), ids[i]);
+    }
+
+    qDeleteAll(objects);
+}
+
+void ObjectRegisterTest::testObjectForIdWithInvalidId() {
+    ObjectRegister objectRegister;
+    QObject object;
+
+    int id = objectRegister.idForObject(&object);
+
+    QCOMPARE(objectRegister.objectForId(-1), (QObject*)0);
+    QCOMPARE(objectRegister.objectForId(id + 1), (QObject*)0);
+    QCOMPARE(objectRegister.objectForId(id * 2), (QObject*)0);
+}
+
+void ObjectRegisterTest::testReleaseIdForDestroyedObject() {
+    ObjectRegister objectRegister;
+    QObject* object = new QObject();
+
+    int id = objectRegister.idForObject(object);
+
+    QSignalSpy objectDestroyedSpy(&objectRegister,
+                                  SIGNAL(objectDestroyed(int)));
+
+    delete object;
+
+    QCOMPARE(objectRegister.releaseIdForDestroyedObject(object), id);
+    QCOMPARE(objectRegister.releaseIdForDestroyedObject(object), 0);
+    QCOMPARE(objectRegister.objectForId(id), (QObject*)0);
+    QCOMPARE(objectDestroyedSpy.count(), 1);
+    QCOMPARE(objectDestroyedSpy.at(0).at(0).toInt(), id);
+
+    QObject otherObject;
+    QVERIFY(objectRegister.idForObject(&otherObject) != id);
+}
+
+void ObjectRegisterTest::testReleaseIdForDestroyedObjectWithAliveObject() {
+    ObjectRegister objectRegister;
+    QObject object;
+
+    int id = objectRegister.idForObject(&object);
+
+    QCOMPARE(objectRegister.releaseIdForDestroyedObject(&object), 0);
+    QCOMPARE(objectRegister.objectForId(id), &object);
+    QCOMPARE(objectRegister.idForObject(&object), id);
+}
+
+void ObjectRegisterTest::
+                    testReleaseIdForDestroyedObjectWithUnregisteredObject() {
+    ObjectRegister objectRegister;
+    QObject object;
+
+    QCOMPARE(objectRegister.releaseIdForDestroyedObject(&object), 0);
+}
+
+void ObjectRegisterTest::
+                        testReleaseIdForDestroyedObjectWithMaximumGeneration() {
+    ObjectRegister objectRegister;
+    QObject* object = new QObject();
+
+    int id = objectRegister.idForObject(object);
+    objectRegister.mSlots[id & ObjectRegister::IndexMask].mGeneration =
+                                            ObjectRegister::MaximumGeneration;
+    id = (ObjectRegister::MaximumGeneration << ObjectRegister::IndexBits) |
+         (id & ObjectRegister::IndexMask);
+    objectRegister.mRegisteredIds.insert(object, id);
+
+    delete object;
+
+    QCOMPARE(objectRegister.releaseIdForDestroyedObject(object), id);
+    QVERIFY(objectRegister.mFreeSlots.isEmpty());
+
+    QObject otherObject;
+    int otherId = objectRegister.idForObject(&otherObject);
+
+    QVERIFY(otherId != id);
+    QVERIFY((otherId & ObjectRegister::IndexMask) !=
+            (id & ObjectRegister::IndexMask));
+    QCOMPARE(objectRegister.objectForId(id), (QObject*)0);
+}
+
+void ObjectRegisterTest::
+                    testReleaseIdForDestroyedObjectWithDestroyedDescendants() {
+    ObjectRegister objectRegister;
+    QObject* object = new QObject();
+    QObject* child = new QObject(object);
+    QObject* grandchild = new QObject(child);
+    QObject aliveObject;
+
+    int id = objectRegister.idForObject(object);
+    int grandchildId = objectRegister.idForObject(grandchild);
+    int aliveObjectId = objectRegister.idForObject(&aliveObject);
+
+    QSignalSpy objectDestroyedSpy(&objectRegister,
+                                  SIGNAL(objectDestroyed(int)));
+
+    //The descendants are destroyed without notifying their parent
+    delete object;
+
+    QCOMPARE(objectRegister.releaseIdForDestroyedObject(object), id);
+    QCOMPARE(objectDestroyedSpy.count(), 1);
+    QCOMPARE(objectDestroyedSpy.at(0).at(0).toInt(), id);
+
+    QCoreApplication::sendPostedEvents(&objectRegister, QEvent::MetaCall);
+
+    QCOMPARE(objectDestroyedSpy.count(), 2);
+    QCOMPARE(objectDestroyedSpy.at(1).at(0).toInt(), grandchildId);
+    QCOMPARE(objectRegister.objectForId(grandchildId), (QObject*)0);
+    QVERIFY(!objectRegister.mRegisteredIds.contains(grandchild));
+    QCOMPARE(objectRegister.objectForId(aliveObjectId), &aliveObject);
+}
+
 void ObjectRegisterTest::testClear() {
     ObjectRegister objectRegister;
     QObject object;
@@ -148,6 +336,23 @@ void ObjectRegisterTest::testClear() {
     QCOMPARE(objectRegister.metaObjectForClassName("QObject"), (QMetaObject*)0);
 }
 
+void ObjectRegisterTest::testRegisterObjectAfterClear() {
+    ObjectRegister objectRegister;
+    QObject object;
+
+    int id1 = objectRegister.idForObject(&object);
+
+    objectRegister.clear();
+
+    int id2 = objectRegister.idForObject(&object);
+
+    QVERIFY(id2 != id1);
+    QCOMPARE(objectRegister.objectForId(id1), (QObject*)0);
+    QCOMPARE(objectRegister.objectForId(id2), &object);
+    QCOMPARE(objectRegister.metaObjectForClassName("QObject"),
+             &QObject::staticMetaObject);
+}
+
 }
 }
 
@@ -0,0 +1,147 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+#include <QTest>
+
+#include <QDir>
+#include <QSignalSpy>
+#include <QTextStream>
+
+#include <KStandardDirs>
+#include <qtest_kde.h>
+
+#define protected public
+#define private public
+#include "DeferredTutorialLoader.h"
+#undef private
+#undef protected
+
+#include "../TutorialInformation.h"
+#include "../TutorialManager.h"
+
+//TutorialInformation* must be declared as a metatype to be used in
+//qvariant_cast
+Q_DECLARE_METATYPE(const ktutorial::TutorialInformation*);
+
+namespace ktutorial {
+namespace scripting {
+
+class DeferredTutorialLoaderTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testConstructor();
+
+    void testStart();
+
+private:
+
+    QString mDirectory;
+    QFile* mTutorialValid1;
+    QFile* mTutorialValid2;
+    QFile* mTutorialInvalid;
+
+    void writeFile(QFile* file, const QString& contents);
+
+};
+
+void DeferredTutorialLoaderTest::initTestCase() {
+    mDirectory = KGlobal::dirs()->saveLocation("appdata", "tutorials/");
+
+    mTutorialValid1 = new QFile(mDirectory + "valid1.js");
+    writeFile(mTutorialValid1, "i = 42;\n");
+
+    mTutorialValid2 = new QFile(mDirectory + "valid2.js");
+    writeFile(mTutorialValid2, "i = 108;\n");
+
+    mTutorialInvalid = new QFile(mDirectory + "invalid.js");
+    writeFile(mTutorialInvalid, "unknownFunction();\n");
+}
+
+void DeferredTutorialLoaderTest::cleanupTestCase() {
+    mTutorialValid1->remove();
+    delete mTutorialValid1;
+
+    mTutorialValid2->remove();
+    delete mTutorialValid2;
+
+    mTutorialInvalid->remove();
+    delete mTutorialInvalid;
+
+    QDir().rmdir(mDirectory);
+}
+
+void DeferredTutorialLoaderTest::testConstructor() {
+    TutorialManager tutorialManager;
+    QObject parent;
+    DeferredTutorialLoader* deferredTutorialLoader =
+                        new DeferredTutorialLoader(&tutorialManager, &parent);
+
+    QCOMPARE(deferredTutorialLoader->parent(), &parent);
+    QCOMPARE(deferredTutorialLoader->mTutorialManager, &tutorialManager);
+    QVERIFY(deferredTutorialLoader->mPendingScriptFiles.isEmpty());
+}
+
+void DeferredTutorialLoaderTest::testStart() {
+    TutorialManager tutorialManager;
+    DeferredTutorialLoader deferredTutorialLoader(&tutorialManager);
+
+    //TutorialInformation* must be registered in order to be used with
+    //QSignalSpy
+    qRegisterMetaType<const TutorialInformation*>("const TutorialInformation*");
+    QSignalSpy registeredSpy(&tutorialManager,
+                    SIGNAL(tutorialRegistered(const TutorialInformation*)));
+    QSignalSpy finishedSpy(&deferredTutorialLoader, SIGNAL(finished()));
+
+    deferredTutorialLoader.start();
+
+    //Nothing is loaded until the event loop runs
+    QCOMPARE(tutorialManager.tutorialInformations().size(), 0);
+    QCOMPARE(finishedSpy.count(), 0);
+
+    for (int i=0; i<100 && finishedSpy.count() == 0; ++i) {
+        QTest::qWait(50);
+    }
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(registeredSpy.count(), 2);
+    QCOMPARE(tutorialManager.tutorialInformations().size(), 2);
+    QVERIFY(deferredTutorialLoader.mPendingScriptFiles.isEmpty());
+    QVERIFY(!deferredTutorialLoader.mScriptManager.mTutorialIndex);
+}
+
+/////////////////////////////////Helpers////////////////////////////////////////
+
+void DeferredTutorialLoaderTest::writeFile(QFile* file,
+                                           const QString& contents) {
+    file->open(QIODevice::WriteOnly);
+    QTextStream out(file);
+    out << contents;
+    out.flush();
+    file->close();
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::scripting::DeferredTutorialLoaderTest)
+
+#include "DeferredTutorialLoaderTest.moc"
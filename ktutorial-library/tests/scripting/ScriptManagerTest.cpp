@@ -25,11 +25,13 @@
 #define protected public
 #define private public
 #include "ScriptManager.h"
+#include "ScriptedTutorial.h"
 #undef private
 #undef protected
 
 #include "../TutorialInformation.h"
 #include "../TutorialManager.h"
+#include "../TutorialManager_p.h"
 
 namespace ktutorial {
 namespace scripting {
@@ -43,8 +45,17 @@ private slots:
     void cleanupTestCase();
 
     void testLoadTutorials();
+    void testLoadTutorialsUsingIndex();
 
-    void testLoadTutorialsFromDirectory();
+    void testFindScriptFiles();
+
+    void testExamineScriptFile();
+    void testExamineScriptFileDeferred();
+    void testExamineScriptFileWithoutInterpreter();
+
+    void testLoadTutorialScript();
+    void testLoadTutorialScriptDeferred();
+    void testLoadTutorialScriptInvalid();
 
 private:
 
@@ -52,6 +63,9 @@ private:
     QFile* mTutorialValid1;
     QFile* mTutorialValid2;
     QFile* mTutorialInvalid;
+    QFile* mTutorialDeferred;
+    QFile* mTutorialDeferredSideCar;
+    QFile* mNotATutorial;
 
     bool contains(const QList<const TutorialInformation*>& tutorialInformations,
                   const QString& id);
@@ -80,6 +94,27 @@ void ScriptManagerTest::initTestCase() {
     out.setDevice(mTutorialInvalid);
     out << "unknownFunction();\n";
     mTutorialInvalid->close();
+
+    //The script is not executed, so its errors go unnoticed
+    mTutorialDeferred = new QFile(mDirectory + "deferred.js");
+    mTutorialDeferred->open(QIODevice::WriteOnly);
+    out.setDevice(mTutorialDeferred);
+    out << "unknownFunction();\n";
+    mTutorialDeferred->close();
+
+    mTutorialDeferredSideCar = new QFile(mDirectory + "deferred.js.desktop");
+    mTutorialDeferredSideCar->open(QIODevice::WriteOnly);
+    out.setDevice(mTutorialDeferredSideCar);
+    out << "[Desktop Entry]\n";
+    out << "Name=The name\n";
+    out << "Comment=The description\n";
+    mTutorialDeferredSideCar->close();
+
+    mNotATutorial = new QFile(mDirectory + "notATutorial.txt");
+    mNotATutorial->open(QIODevice::WriteOnly);
+    out.setDevice(mNotATutorial);
+    out << "Just some text\n";
+    mNotATutorial->close();
 }
 
 void ScriptManagerTest::cleanupTestCase() {
@@ -92,6 +127,15 @@ void ScriptManagerTest::cleanupTestCase() {
     mTutorialInvalid->remove();
     delete mTutorialInvalid;
 
+    mTutorialDeferred->remove();
+    delete mTutorialDeferred;
+
+    mTutorialDeferredSideCar->remove();
+    delete mTutorialDeferredSideCar;
+
+    mNotATutorial->remove();
+    delete mNotATutorial;
+
     QDir().rmdir(mDirectory);
 }
 
@@ -104,24 +148,147 @@ void ScriptManagerTest::testLoadTutorials() {
     //Tutorials are only written to user data directory, but not system data
     //directory, as the process may not have enough permissions. So it isn't
     //really tested if the system data directory is taken into account :(
-    QCOMPARE(tutorialManager.tutorialInformations().size(), 2);
+    QCOMPARE(tutorialManager.tutorialInformations().size(), 3);
     QVERIFY(contains(tutorialManager.tutorialInformations(),
                      mDirectory + "valid1.js"));
     QVERIFY(contains(tutorialManager.tutorialInformations(),
                      mDirectory + "valid2.js"));
+    QVERIFY(contains(tutorialManager.tutorialInformations(),
+                     mDirectory + "deferred.js"));
 }
 
-void ScriptManagerTest::testLoadTutorialsFromDirectory() {
+void ScriptManagerTest::testLoadTutorialsUsingIndex() {
     ScriptManager scriptManager;
     TutorialManager tutorialManager;
 
-    scriptManager.loadTutorialsFromDirectory(&tutorialManager, mDirectory);
+    scriptManager.loadTutorials(&tutorialManager);
 
-    QCOMPARE(tutorialManager.tutorialInformations().size(), 2);
-    QVERIFY(contains(tutorialManager.tutorialInformations(),
+    TutorialManager indexedTutorialManager;
+
+    scriptManager.loadTutorials(&indexedTutorialManager);
+
+    QCOMPARE(indexedTutorialManager.tutorialInformations().size(), 3);
+    QVERIFY(contains(indexedTutorialManager.tutorialInformations(),
                      mDirectory + "valid1.js"));
-    QVERIFY(contains(tutorialManager.tutorialInformations(),
+    QVERIFY(contains(indexedTutorialManager.tutorialInformations(),
                      mDirectory + "valid2.js"));
+    QVERIFY(contains(indexedTutorialManager.tutorialInformations(),
+                     mDirectory + "deferred.js"));
+
+    const TutorialInformation* tutorialInformation =
+        indexedTutorialManager.d->mTutorialInformations.value(
+                                                    mDirectory + "valid1.js");
+    ScriptedTutorial* scriptedTutorial = static_cast<ScriptedTutorial*>(
+        indexedTutorialManager.d->mTutorials.value(tutorialInformation));
+    QVERIFY(scriptedTutorial->isValid());
+    QVERIFY(!scriptedTutorial->mExecuted);
+    QVERIFY(!scriptManager.mTutorialIndex);
+}
+
+void ScriptManagerTest::testFindScriptFiles() {
+    QStringList fileNames =
+                ScriptManager::findScriptFiles(QStringList() << mDirectory);
+
+    QCOMPARE(fileNames.size(), 5);
+    QVERIFY(fileNames.contains(mDirectory + "valid1.js"));
+    QVERIFY(fileNames.contains(mDirectory + "valid2.js"));
+    QVERIFY(fileNames.contains(mDirectory + "invalid.js"));
+    QVERIFY(fileNames.contains(mDirectory + "deferred.js"));
+    QVERIFY(fileNames.contains(mDirectory + "notATutorial.txt"));
+}
+
+void ScriptManagerTest::testExamineScriptFile() {
+    ScriptManager scriptManager;
+
+    TutorialScript tutorialScript;
+    QVERIFY(scriptManager.examineScriptFile(mDirectory + "valid1.js",
+                                            &tutorialScript));
+
+    QCOMPARE(tutorialScript.mFileName, mDirectory + "valid1.js");
+    QCOMPARE(tutorialScript.mInterpreter, QString("javascript"));
+    QVERIFY(!tutorialScript.mDeferred);
+    QVERIFY(!tutorialScript.mIndexed);
+}
+
+void ScriptManagerTest::testExamineScriptFileDeferred() {
+    ScriptManager scriptManager;
+
+    TutorialScript tutorialScript;
+    QVERIFY(scriptManager.examineScriptFile(mDirectory + "deferred.js",
+                                            &tutorialScript));
+
+    QCOMPARE(tutorialScript.mFileName, mDirectory + "deferred.js");
+    QCOMPARE(tutorialScript.mInterpreter, QString("javascript"));
+    QVERIFY(tutorialScript.mDeferred);
+    QCOMPARE(tutorialScript.mName, QString("The name"));
+    QCOMPARE(tutorialScript.mDescription, QString("The description"));
+    QVERIFY(!tutorialScript.mIndexed);
+}
+
+void ScriptManagerTest::testExamineScriptFileWithoutInterpreter() {
+    ScriptManager scriptManager;
+
+    TutorialScript tutorialScript;
+    QVERIFY(!scriptManager.examineScriptFile(mDirectory + "notATutorial.txt",
+                                             &tutorialScript));
+}
+
+void ScriptManagerTest::testLoadTutorialScript() {
+    ScriptManager scriptManager;
+    TutorialManager tutorialManager;
+
+    TutorialScript tutorialScript;
+    tutorialScript.mFileName = mDirectory + "valid1.js";
+    tutorialScript.mInterpreter = "javascript";
+
+    scriptManager.loadTutorialScript(&tutorialManager, tutorialScript);
+
+    QCOMPARE(tutorialManager.tutorialInformations().size(), 1);
+    ScriptedTutorial* scriptedTutorial = static_cast<ScriptedTutorial*>(
+        tutorialManager.d->mTutorials.value(
+                            tutorialManager.tutorialInformations()[0]));
+    QCOMPARE(scriptedTutorial->tutorialInformation()->id(),
+             mDirectory + "valid1.js");
+    QVERIFY(scriptedTutorial->mExecuted);
+}
+
+void ScriptManagerTest::testLoadTutorialScriptDeferred() {
+    ScriptManager scriptManager;
+    TutorialManager tutorialManager;
+
+    TutorialScript tutorialScript;
+    tutorialScript.mFileName = mDirectory + "deferred.js";
+    tutorialScript.mInterpreter = "javascript";
+    tutorialScript.mDeferred = true;
+    tutorialScript.mName = "The name";
+    tutorialScript.mDescription = "The description";
+
+    scriptManager.loadTutorialScript(&tutorialManager, tutorialScript);
+
+    QCOMPARE(tutorialManager.tutorialInformations().size(), 1);
+    ScriptedTutorial* scriptedTutorial = static_cast<ScriptedTutorial*>(
+        tutorialManager.d->mTutorials.value(
+                            tutorialManager.tutorialInformations()[0]));
+    QCOMPARE(scriptedTutorial->tutorialInformation()->id(),
+             mDirectory + "deferred.js");
+    QCOMPARE(scriptedTutorial->tutorialInformation()->name(),
+             QString("The name"));
+    QCOMPARE(scriptedTutorial->tutorialInformation()->description(),
+             QString("The description"));
+    QVERIFY(!scriptedTutorial->mExecuted);
+}
+
+void ScriptManagerTest::testLoadTutorialScriptInvalid() {
+    ScriptManager scriptManager;
+    TutorialManager tutorialManager;
+
+    TutorialScript tutorialScript;
+    tutorialScript.mFileName = mDirectory + "invalid.js";
+    tutorialScript.mInterpreter = "javascript";
+
+    scriptManager.loadTutorialScript(&tutorialManager, tutorialScript);
+
+    QCOMPARE(tutorialManager.tutorialInformations().size(), 0);
 }
 
 /////////////////////////////////Helpers////////////////////////////////////////
@@ -48,9 +48,15 @@ public slots:
         mDummySlotCallCount++;
     }
 
+    void dummySlotWithArgument(QObject* object) {
+        mDummySlotCallCount++;
+        mDummySlotArgument = object;
+    }
+
 signals:
 
     void dummySignal();
+    void anotherDummySignal();
 
 private slots:
 
@@ -65,9 +71,16 @@ private slots:
     void testTearDown();
     void testTearDownObjectArgument();
 
+    void testConnectSetup();
+    void testConnectSetupNotKrossAction();
+
+    void testConnectTearDown();
+    void testConnectTearDownNotKrossAction();
+
     void testConnectWaitFor();
     void testConnectWaitForFunctionNameWithParenthesis();
     void testConnectWaitForNotKrossAction();
+    void testConnectSeveralWaitFors();
 
     void testDisconnectWaitFor();
     void testDisconnectWaitForNotKrossAction();
@@ -75,6 +88,7 @@ private slots:
 private:
 
     int mDummySlotCallCount;
+    QObject* mDummySlotArgument;
 
     KTemporaryFile* mTemporaryFile;
 
@@ -82,6 +96,7 @@ private:
 
 void ScriptedStepTest::init() {
     mDummySlotCallCount = 0;
+    mDummySlotArgument = 0;
 
     mTemporaryFile = new KTemporaryFile();
     mTemporaryFile->setSuffix(".js");
@@ -173,6 +188,69 @@ void ScriptedStepTest::testTearDownObjectArgument() {
     QCOMPARE(qvariant_cast<QObject*>(argument), &scriptedStep);
 }
 
+void ScriptedStepTest::testConnectSetup() {
+    QTextStream out(mTemporaryFile);
+    out << "function setupFunction(step) { "
+                                "testObject.dummySlotWithArgument(step); }\n";
+    out.flush();
+
+    Kross::Action scriptAction(this, "TestKrossAction");
+    scriptAction.setFile(mTemporaryFile->fileName());
+    scriptAction.addObject(this, "testObject");
+    scriptAction.trigger();
+
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+    scriptedStep.connectSetup(&scriptAction, "setupFunction()");
+
+    QCOMPARE(mDummySlotCallCount, 0);
+    scriptedStep.setup();
+    QCOMPARE(mDummySlotCallCount, 1);
+    QCOMPARE(mDummySlotArgument, &scriptedStep);
+    scriptedStep.tearDown();
+    QCOMPARE(mDummySlotCallCount, 1);
+}
+
+void ScriptedStepTest::testConnectSetupNotKrossAction() {
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+    scriptedStep.connectSetup(this, SLOT(dummySlotWithArgument(QObject*)));
+
+    QCOMPARE(mDummySlotCallCount, 0);
+    scriptedStep.setup();
+    QCOMPARE(mDummySlotCallCount, 1);
+    QCOMPARE(mDummySlotArgument, &scriptedStep);
+}
+
+void ScriptedStepTest::testConnectTearDown() {
+    QTextStream out(mTemporaryFile);
+    out << "function tearDownFunction(step) { "
+                                "testObject.dummySlotWithArgument(step); }\n";
+    out.flush();
+
+    Kross::Action scriptAction(this, "TestKrossAction");
+    scriptAction.setFile(mTemporaryFile->fileName());
+    scriptAction.addObject(this, "testObject");
+    scriptAction.trigger();
+
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+    scriptedStep.connectTearDown(&scriptAction, "tearDownFunction");
+
+    scriptedStep.setup();
+    QCOMPARE(mDummySlotCallCount, 0);
+    scriptedStep.tearDown();
+    QCOMPARE(mDummySlotCallCount, 1);
+    QCOMPARE(mDummySlotArgument, &scriptedStep);
+}
+
+void ScriptedStepTest::testConnectTearDownNotKrossAction() {
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+    scriptedStep.connectTearDown(this, "dummySlotWithArgument(QObject*)");
+
+    QCOMPARE(mDummySlotCallCount, 0);
+    scriptedStep.tearDown();
+    QCOMPARE(mDummySlotCallCount, 1);
+    QCOMPARE(mDummySlotArgument, &scriptedStep);
+}
+
 void ScriptedStepTest::testConnectWaitFor() {
     QTextStream out(mTemporaryFile);
     out << "function dummyFunction() { testObject.dummySlot(); }\n";
@@ -230,6 +308,38 @@ void ScriptedStepTest::testConnectWaitForNotKrossAction() {
     QCOMPARE(mDummySlotCallCount, 1);
 }
 
+void ScriptedStepTest::testConnectSeveralWaitFors() {
+    QTextStream out(mTemporaryFile);
+    out << "function dummyFunction() { testObject.dummySlot(); }\n";
+    out << "function anotherDummyFunction() { testObject.dummySlot(); "
+                                             "testObject.dummySlot(); }\n";
+    out.flush();
+
+    Kross::Action scriptAction(this, "TestKrossAction");
+    scriptAction.setFile(mTemporaryFile->fileName());
+    scriptAction.addObject(this, "testObject");
+    scriptAction.trigger();
+
+    ScriptedStep scriptedStep("theIdOfTheScriptedStep");
+
+    WaitForSignal waitFor1(this, SIGNAL(dummySignal()));
+    waitFor1.setActive(true);
+    WaitForSignal waitFor2(this, SIGNAL(anotherDummySignal()));
+    waitFor2.setActive(true);
+
+    scriptedStep.connectWaitFor(&waitFor1, &scriptAction, "dummyFunction");
+    scriptedStep.connectWaitFor(&waitFor2, &scriptAction,
+                                "anotherDummyFunction");
+
+    QCOMPARE(mDummySlotCallCount, 0);
+    emit dummySignal();
+    QCOMPARE(mDummySlotCallCount, 1);
+    emit anotherDummySignal();
+    QCOMPARE(mDummySlotCallCount, 3);
+    emit dummySignal();
+    QCOMPARE(mDummySlotCallCount, 4);
+}
+
 void ScriptedStepTest::testDisconnectWaitFor() {
     QTextStream out(mTemporaryFile);
     out << "function dummyFunction() { testObject.dummySlot(); }\n";
@@ -32,6 +32,7 @@
 #undef protected
 
 #include "ScriptingModule.h"
+#include "../Step.h"
 #include "../TutorialInformation.h"
 
 //ScriptedTutorial* must be declared as a metatype to be used in qvariant_cast
@@ -52,17 +53,32 @@ private slots:
     void testConstructorInvalidFile();
     void testConstructorInvalidLanguage();
     void testConstructorInvalidScript();
+    void testConstructorExecuteOnStart();
+    void testConstructorExecuteOnStartInvalidLanguage();
 
     void testSetup();
     void testSetupObjectArgument();
+    void testSetupExecuteOnStart();
+    void testSetupExecuteOnStartInvalidScript();
 
     void testTearDown();
     void testTearDownObjectArgument();
 
+    void testUpdateStep();
+    void testUpdateStepTwice();
+    void testUpdateCurrentStep();
+    void testUpdateNotExistingStep();
+    void testUpdateStepWithInvalidScript();
+    void testUpdateStepWithScriptThatDoesNotAddTheStep();
+    void testUpdateStepExecuteOnStart();
+
 private:
 
     KTemporaryFile* mTemporaryFile;
 
+    void writeTutorialWithTwoSteps();
+    QString stepScript(const QString& stepId, const QString& text) const;
+
 };
 
 void ScriptedTutorialTest::init() {
@@ -131,6 +147,35 @@ void ScriptedTutorialTest::testConstructorInvalidScript() {
     QVERIFY(!scriptedTutorial.isValid());
 }
 
+void ScriptedTutorialTest::testConstructorExecuteOnStart() {
+    QTextStream out(mTemporaryFile);
+    out << "tutorial.tutorialInformationAsObject().setName(\"The name\");\n";
+    out.flush();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName(),
+                                      ScriptedTutorial::ExecuteOnStart);
+
+    QVERIFY(scriptedTutorial.tutorialInformation());
+    QCOMPARE(scriptedTutorial.tutorialInformation()->id(),
+             mTemporaryFile->fileName());
+    QCOMPARE(scriptedTutorial.tutorialInformation()->name(), QString());
+    QVERIFY(scriptedTutorial.isValid());
+    QVERIFY(!scriptedTutorial.mExecuted);
+}
+
+void ScriptedTutorialTest::testConstructorExecuteOnStartInvalidLanguage() {
+    delete mTemporaryFile;
+    mTemporaryFile = new KTemporaryFile();
+    mTemporaryFile->setSuffix(".bishuo");
+    mTemporaryFile->open();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName(),
+                                      ScriptedTutorial::ExecuteOnStart);
+
+    QVERIFY(!scriptedTutorial.isValid());
+    QVERIFY(!scriptedTutorial.mExecuted);
+}
+
 void ScriptedTutorialTest::testSetup() {
     QSKIP("Skipped until setup argument is set again to scripting::ScriptedTutorial*", SkipAll);
 
@@ -169,6 +214,57 @@ void ScriptedTutorialTest::testSetupObjectArgument() {
     QCOMPARE(qvariant_cast<QObject*>(argument), &scriptedTutorial);
 }
 
+void ScriptedTutorialTest::testSetupExecuteOnStart() {
+    QTextStream out(mTemporaryFile);
+    out << "tutorial.tutorialInformationAsObject().setName(\"The name\");\n";
+    out << "setupCalls = 0;\n";
+    out << "function tutorialSetup(scriptedTutorial) { setupCalls++; }\n";
+    out << "function getSetupCalls() { return setupCalls; }\n";
+    out << "connect(tutorial, \"setup(QObject*)\",\n"
+        << "        this, \"tutorialSetup(QObject*)\");\n";
+    out.flush();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName(),
+                                      ScriptedTutorial::ExecuteOnStart);
+
+    QSignalSpy setupSpy(&scriptedTutorial, SIGNAL(setup(QObject*)));
+
+    scriptedTutorial.setup();
+
+    QVERIFY(scriptedTutorial.isValid());
+    QVERIFY(scriptedTutorial.mExecuted);
+    QCOMPARE(scriptedTutorial.tutorialInformation()->name(),
+             QString("The name"));
+    QCOMPARE(setupSpy.count(), 1);
+    QCOMPARE(scriptedTutorial.mScriptAction->callFunction("getSetupCalls")
+                                                                    .toInt(),
+             1);
+
+    //The script is executed only once
+    scriptedTutorial.setup();
+
+    QCOMPARE(setupSpy.count(), 2);
+    QCOMPARE(scriptedTutorial.mScriptAction->callFunction("getSetupCalls")
+                                                                    .toInt(),
+             2);
+}
+
+void ScriptedTutorialTest::testSetupExecuteOnStartInvalidScript() {
+    QTextStream out(mTemporaryFile);
+    out << "someUnknownFunction();";
+    out.flush();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName(),
+                                      ScriptedTutorial::ExecuteOnStart);
+
+    QVERIFY(scriptedTutorial.isValid());
+
+    scriptedTutorial.setup();
+
+    QVERIFY(scriptedTutorial.mExecuted);
+    QVERIFY(!scriptedTutorial.isValid());
+}
+
 void ScriptedTutorialTest::testTearDown() {
     QSKIP("Skipped until tearDown argument is set again to scripting::ScriptedTutorial*", SkipAll);
 
@@ -207,6 +303,156 @@ void ScriptedTutorialTest::testTearDownObjectArgument() {
     QCOMPARE(qvariant_cast<QObject*>(argument), &scriptedTutorial);
 }
 
+void ScriptedTutorialTest::testUpdateStep() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName());
+    scriptedTutorial.start();
+
+    Step* oldStep = scriptedTutorial.step("second");
+    QSignalSpy destroyedSpy(oldStep, SIGNAL(destroyed()));
+
+    QVERIFY(scriptedTutorial.updateStep("second", stepScript("second",
+                                                             "The new text")));
+
+    Step* newStep = scriptedTutorial.step("second");
+    QVERIFY(newStep);
+    QVERIFY(newStep != oldStep);
+    QCOMPARE(newStep->text(), QString("The new text"));
+    QCOMPARE(scriptedTutorial.currentStep()->id(), QString("start"));
+    QVERIFY(scriptedTutorial.mStepScriptActions.contains("second"));
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(oldStep, QEvent::DeferredDelete);
+
+    QCOMPARE(destroyedSpy.count(), 1);
+
+    scriptedTutorial.nextStep("second");
+
+    QCOMPARE(scriptedTutorial.currentStep(), newStep);
+    QVERIFY(newStep->isActive());
+}
+
+void ScriptedTutorialTest::testUpdateStepTwice() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName());
+    scriptedTutorial.start();
+
+    QVERIFY(scriptedTutorial.updateStep("second", stepScript("second",
+                                                             "The new text")));
+
+    Kross::Action* oldStepScriptAction =
+                            scriptedTutorial.mStepScriptActions.value("second");
+    QSignalSpy destroyedSpy(oldStepScriptAction, SIGNAL(destroyed()));
+
+    QVERIFY(scriptedTutorial.updateStep("second",
+                                    stepScript("second", "The newer text")));
+
+    QCOMPARE(scriptedTutorial.step("second")->text(),
+             QString("The newer text"));
+    QVERIFY(scriptedTutorial.mStepScriptActions.value("second") !=
+                oldStepScriptAction);
+
+    //Process deleteLater()
+    QCoreApplication::sendPostedEvents(oldStepScriptAction,
+                                       QEvent::DeferredDelete);
+
+    QCOMPARE(destroyedSpy.count(), 1);
+}
+
+void ScriptedTutorialTest::testUpdateCurrentStep() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName());
+    scriptedTutorial.start();
+
+    Step* oldStep = scriptedTutorial.step("start");
+
+    QVERIFY(scriptedTutorial.updateStep("start", stepScript("start",
+                                                            "The new text")));
+
+    Step* newStep = scriptedTutorial.step("start");
+    QVERIFY(newStep != oldStep);
+    QCOMPARE(scriptedTutorial.currentStep(), newStep);
+    QVERIFY(newStep->isActive());
+    QVERIFY(!oldStep->isActive());
+}
+
+void ScriptedTutorialTest::testUpdateNotExistingStep() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName());
+    scriptedTutorial.start();
+
+    QVERIFY(scriptedTutorial.updateStep("third", stepScript("third",
+                                                            "The text")));
+
+    QVERIFY(scriptedTutorial.step("third"));
+    QCOMPARE(scriptedTutorial.step("third")->text(), QString("The text"));
+    QCOMPARE(scriptedTutorial.currentStep()->id(), QString("start"));
+}
+
+void ScriptedTutorialTest::testUpdateStepWithInvalidScript() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName());
+    scriptedTutorial.start();
+
+    Step* oldStep = scriptedTutorial.step("second");
+
+    QString invalidStepScript = stepScript("second", "The new text") +
+                                "someUnknownFunction();";
+    QVERIFY(!scriptedTutorial.updateStep("second", invalidStepScript));
+
+    QCOMPARE(scriptedTutorial.step("second"), oldStep);
+    QCOMPARE(oldStep->text(), QString("The text"));
+    QVERIFY(!scriptedTutorial.mStepScriptActions.contains("second"));
+    QVERIFY(scriptedTutorial.isValid());
+}
+
+void ScriptedTutorialTest::testUpdateStepWithScriptThatDoesNotAddTheStep() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName());
+    scriptedTutorial.start();
+
+    Step* oldStep = scriptedTutorial.step("second");
+
+    QVERIFY(!scriptedTutorial.updateStep("second", stepScript("third",
+                                                              "The text")));
+
+    QCOMPARE(scriptedTutorial.step("second"), oldStep);
+    QVERIFY(!scriptedTutorial.mStepScriptActions.contains("second"));
+}
+
+void ScriptedTutorialTest::testUpdateStepExecuteOnStart() {
+    writeTutorialWithTwoSteps();
+
+    ScriptedTutorial scriptedTutorial(mTemporaryFile->fileName(),
+                                      ScriptedTutorial::ExecuteOnStart);
+
+    QVERIFY(!scriptedTutorial.updateStep("second", stepScript("second",
+                                                              "The text")));
+    QVERIFY(!scriptedTutorial.step("second"));
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void ScriptedTutorialTest::writeTutorialWithTwoSteps() {
+    QTextStream out(mTemporaryFile);
+    out << stepScript("start", "The text");
+    out << stepScript("second", "The text");
+    out.flush();
+}
+
+QString ScriptedTutorialTest::stepScript(const QString& stepId,
+                                         const QString& text) const {
+    return QString("step = ktutorial.newStep(\"%1\");\n"
+                   "step.setText(\"%2\");\n"
+                   "tutorial.addStep(step);\n").arg(stepId).arg(text);
+}
+
 }
 }
 
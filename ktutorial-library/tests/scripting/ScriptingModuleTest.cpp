@@ -73,6 +73,11 @@ private slots:
     void testRegisterWaitForMetaObjectConstructorNotInvokable();
     void testRegisterWaitForMetaObjectConstructorNotPublic();
 
+    void testRegisterWaitFor();
+    void testRegisterWaitForWithDefaultName();
+    void testRegisterWaitForTwiceWithSameName();
+    void testRegisterWaitForWithNameOfMetaObject();
+
     void testNewOption();
 
     void testNewStep();
@@ -80,6 +85,7 @@ private slots:
     void testNewWaitFor();
     void testNewWaitForInNamespace();
     void testNewWaitForNotRegistered();
+    void testNewWaitForRegisteredWithFactory();
 
 private:
 
@@ -87,6 +93,8 @@ private:
                             const QString& typeName);
     QMetaObject& metaObject(ScriptingModule* scriptingModule,
                             const QString& typeName);
+    bool containsFactory(ScriptingModule* scriptingModule,
+                         const QString& typeName);
 
 };
 
@@ -191,6 +199,15 @@ void ScriptingModuleTest::testSelf() {
     QVERIFY(containsMetaObject(scriptingModule, "WaitForWindow"));
     type = metaObject(scriptingModule, "WaitForWindow");
     QCOMPARE(type.className(), WaitForWindow::staticMetaObject.className());
+
+    QVERIFY(containsFactory(scriptingModule, "WaitForAnd"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForEvent"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForNot"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForOr"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForProperty"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForSignal"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForStepActivation"));
+    QVERIFY(containsFactory(scriptingModule, "WaitForWindow"));
 }
 
 void ScriptingModuleTest::testRegisterWaitForMetaObject() {
@@ -292,6 +309,50 @@ void ScriptingModuleTest::testRegisterWaitForMetaObjectConstructorNotPublic() {
     QVERIFY(!containsMetaObject(&scriptingModule, "MockWaitFor5"));
 }
 
+void ScriptingModuleTest::testRegisterWaitFor() {
+    ScriptingModule scriptingModule;
+
+    QVERIFY(scriptingModule.registerWaitFor<MockWaitFor>("MockWaitFor"));
+    QVERIFY(containsFactory(&scriptingModule, "MockWaitFor"));
+    QVERIFY(containsMetaObject(&scriptingModule, "MockWaitFor"));
+    QMetaObject& type = metaObject(&scriptingModule, "MockWaitFor");
+    QCOMPARE(type.className(), MockWaitFor::staticMetaObject.className());
+}
+
+void ScriptingModuleTest::testRegisterWaitForWithDefaultName() {
+    ScriptingModule scriptingModule;
+
+    QVERIFY(scriptingModule.registerWaitFor<MockWaitFor>());
+    QVERIFY(containsFactory(&scriptingModule,
+                            "ktutorial::scripting::MockWaitFor"));
+    QVERIFY(containsMetaObject(&scriptingModule,
+                               "ktutorial::scripting::MockWaitFor"));
+    QMetaObject& type = metaObject(&scriptingModule,
+                                   "ktutorial::scripting::MockWaitFor");
+    QCOMPARE(type.className(), MockWaitFor::staticMetaObject.className());
+}
+
+void ScriptingModuleTest::testRegisterWaitForTwiceWithSameName() {
+    ScriptingModule scriptingModule;
+    scriptingModule.registerWaitFor<MockWaitFor>("MockWaitFor");
+
+    QVERIFY(!scriptingModule.registerWaitFor<MockWaitFor2>("MockWaitFor"));
+    QVERIFY(containsFactory(&scriptingModule, "MockWaitFor"));
+    QMetaObject& type = metaObject(&scriptingModule, "MockWaitFor");
+    QCOMPARE(type.className(), MockWaitFor::staticMetaObject.className());
+}
+
+void ScriptingModuleTest::testRegisterWaitForWithNameOfMetaObject() {
+    ScriptingModule scriptingModule;
+    scriptingModule.registerWaitForMetaObject(MockWaitFor::staticMetaObject,
+                                              "MockWaitFor");
+
+    QVERIFY(!scriptingModule.registerWaitFor<MockWaitFor2>("MockWaitFor"));
+    QVERIFY(!containsFactory(&scriptingModule, "MockWaitFor"));
+    QMetaObject& type = metaObject(&scriptingModule, "MockWaitFor");
+    QCOMPARE(type.className(), MockWaitFor::staticMetaObject.className());
+}
+
 void ScriptingModuleTest::testNewOption() {
     ScriptingModule scriptingModule;
     //TODO Remove cast when return type is changed
@@ -346,6 +407,17 @@ void ScriptingModuleTest::testNewWaitForNotRegistered() {
     QVERIFY(waitFor.isNull());
 }
 
+void ScriptingModuleTest::testNewWaitForRegisteredWithFactory() {
+    ScriptingModule scriptingModule;
+    scriptingModule.registerWaitFor<MockWaitFor2>("DummyWaitFor");
+    //TODO Remove cast when return type is changed
+    QSharedPointer<WaitFor> waitFor((WaitFor*)scriptingModule.
+                                        newWaitFor("DummyWaitFor"));
+
+    QVERIFY(!waitFor.isNull());
+    QVERIFY(!waitFor.dynamicCast<MockWaitFor2>().isNull());
+}
+
 /////////////////////////////////////Helpers////////////////////////////////////
 
 bool ScriptingModuleTest::containsMetaObject(ScriptingModule* scriptingModule,
@@ -358,6 +430,11 @@ QMetaObject& ScriptingModuleTest::metaObject(ScriptingModule* scriptingModule,
     return scriptingModule->mWaitForMetaObjects.find(typeName).value();
 }
 
+bool ScriptingModuleTest::containsFactory(ScriptingModule* scriptingModule,
+                                          const QString& typeName) {
+    return scriptingModule->mWaitForFactories.contains(typeName);
+}
+
 }
 }
 
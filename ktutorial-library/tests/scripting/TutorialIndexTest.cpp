@@ -0,0 +1,255 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#include <QTextStream>
+
+#include <KTemporaryFile>
+#include <qtest_kde.h>
+
+#define protected public
+#define private public
+#include "TutorialIndex.h"
+#undef private
+#undef protected
+
+#include <KConfig>
+
+#include "../TutorialInformation.h"
+
+namespace ktutorial {
+namespace scripting {
+
+class TutorialIndexTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void testConstructor();
+
+    void testInsert();
+    void testInsertInvalidTutorial();
+    void testInsertReplacingEntry();
+
+    void testIsUpToDateModifiedFile();
+    void testIsUpToDateRemovedFile();
+    void testIsUpToDateAddedSideCarFile();
+    void testIsUpToDateUnknownInterpreter();
+
+    void testRemoveUnusedEntries();
+
+    void testSave();
+    void testDestructorDoesNotSave();
+
+private:
+
+    KTemporaryFile* mIndexFile;
+    KTemporaryFile* mScriptFile;
+
+};
+
+void TutorialIndexTest::init() {
+    mIndexFile = new KTemporaryFile();
+    mIndexFile->open();
+
+    mScriptFile = new KTemporaryFile();
+    mScriptFile->setSuffix(".js");
+    mScriptFile->open();
+
+    QTextStream out(mScriptFile);
+    out << "i = 42;\n";
+    out.flush();
+}
+
+void TutorialIndexTest::cleanup() {
+    QFile::remove(mScriptFile->fileName() + ".desktop");
+
+    delete mScriptFile;
+    delete mIndexFile;
+}
+
+void TutorialIndexTest::testConstructor() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    QVERIFY(!tutorialIndex.isUpToDate(mScriptFile->fileName()));
+    QVERIFY(!tutorialIndex.isValid(mScriptFile->fileName()));
+}
+
+void TutorialIndexTest::testInsert() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    TutorialInformation tutorialInformation(mScriptFile->fileName());
+    tutorialInformation.setName("The name");
+    tutorialInformation.setDescription("The description");
+
+    tutorialIndex.insert(mScriptFile->fileName(), "javascript",
+                         &tutorialInformation);
+
+    QVERIFY(tutorialIndex.isUpToDate(mScriptFile->fileName()));
+    QVERIFY(tutorialIndex.isValid(mScriptFile->fileName()));
+    QCOMPARE(tutorialIndex.interpreter(mScriptFile->fileName()),
+             QString("javascript"));
+    QCOMPARE(tutorialIndex.id(mScriptFile->fileName()),
+             mScriptFile->fileName());
+    QCOMPARE(tutorialIndex.name(mScriptFile->fileName()), QString("The name"));
+    QCOMPARE(tutorialIndex.description(mScriptFile->fileName()),
+             QString("The description"));
+}
+
+void TutorialIndexTest::testInsertInvalidTutorial() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    tutorialIndex.insert(mScriptFile->fileName(), "", 0);
+
+    QVERIFY(tutorialIndex.isUpToDate(mScriptFile->fileName()));
+    QVERIFY(!tutorialIndex.isValid(mScriptFile->fileName()));
+    QCOMPARE(tutorialIndex.interpreter(mScriptFile->fileName()), QString(""));
+    QCOMPARE(tutorialIndex.id(mScriptFile->fileName()), QString(""));
+    QCOMPARE(tutorialIndex.name(mScriptFile->fileName()), QString(""));
+    QCOMPARE(tutorialIndex.description(mScriptFile->fileName()), QString(""));
+}
+
+void TutorialIndexTest::testInsertReplacingEntry() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    TutorialInformation tutorialInformation(mScriptFile->fileName());
+    tutorialInformation.setName("The name");
+    tutorialInformation.setDescription("The description");
+
+    tutorialIndex.insert(mScriptFile->fileName(), "javascript",
+                         &tutorialInformation);
+    tutorialIndex.insert(mScriptFile->fileName(), "javascript", 0);
+
+    QVERIFY(tutorialIndex.isUpToDate(mScriptFile->fileName()));
+    QVERIFY(!tutorialIndex.isValid(mScriptFile->fileName()));
+    QCOMPARE(tutorialIndex.name(mScriptFile->fileName()), QString(""));
+    QCOMPARE(tutorialIndex.description(mScriptFile->fileName()), QString(""));
+}
+
+void TutorialIndexTest::testIsUpToDateModifiedFile() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    tutorialIndex.insert(mScriptFile->fileName(), "javascript", 0);
+
+    QTextStream out(mScriptFile);
+    out << "i = 108;\n";
+    out.flush();
+
+    QVERIFY(!tutorialIndex.isUpToDate(mScriptFile->fileName()));
+}
+
+void TutorialIndexTest::testIsUpToDateRemovedFile() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    QString fileName = mScriptFile->fileName();
+    tutorialIndex.insert(fileName, "javascript", 0);
+
+    delete mScriptFile;
+    mScriptFile = new KTemporaryFile();
+
+    QVERIFY(!tutorialIndex.isUpToDate(fileName));
+}
+
+void TutorialIndexTest::testIsUpToDateAddedSideCarFile() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    tutorialIndex.insert(mScriptFile->fileName(), "javascript", 0);
+
+    QFile sideCarFile(mScriptFile->fileName() + ".desktop");
+    sideCarFile.open(QIODevice::WriteOnly);
+    QTextStream out(&sideCarFile);
+    out << "[Desktop Entry]\n";
+    out << "Name=The name\n";
+    out.flush();
+    sideCarFile.close();
+
+    QVERIFY(!tutorialIndex.isUpToDate(mScriptFile->fileName()));
+}
+
+void TutorialIndexTest::testIsUpToDateUnknownInterpreter() {
+    TutorialIndex tutorialIndex(mIndexFile->fileName());
+
+    tutorialIndex.insert(mScriptFile->fileName(), "bishuo", 0);
+
+    QVERIFY(!tutorialIndex.isUpToDate(mScriptFile->fileName()));
+}
+
+void TutorialIndexTest::testRemoveUnusedEntries() {
+    KTemporaryFile otherScriptFile;
+    otherScriptFile.setSuffix(".js");
+    otherScriptFile.open();
+
+    TutorialIndex* tutorialIndex = new TutorialIndex(mIndexFile->fileName());
+    tutorialIndex->insert(mScriptFile->fileName(), "javascript", 0);
+    tutorialIndex->insert(otherScriptFile.fileName(), "javascript", 0);
+    tutorialIndex->save();
+    delete tutorialIndex;
+
+    tutorialIndex = new TutorialIndex(mIndexFile->fileName());
+    QVERIFY(tutorialIndex->isUpToDate(mScriptFile->fileName()));
+
+    tutorialIndex->removeUnusedEntries();
+
+    QVERIFY(tutorialIndex->mConfig->hasGroup(mScriptFile->fileName()));
+    QVERIFY(!tutorialIndex->mConfig->hasGroup(otherScriptFile.fileName()));
+    QVERIFY(tutorialIndex->mConfig->hasGroup("General"));
+
+    delete tutorialIndex;
+}
+
+void TutorialIndexTest::testSave() {
+    TutorialInformation tutorialInformation(mScriptFile->fileName());
+    tutorialInformation.setName("The name");
+    tutorialInformation.setDescription("The description");
+
+    TutorialIndex* tutorialIndex = new TutorialIndex(mIndexFile->fileName());
+    tutorialIndex->insert(mScriptFile->fileName(), "javascript",
+                          &tutorialInformation);
+    tutorialIndex->save();
+    delete tutorialIndex;
+
+    TutorialIndex savedTutorialIndex(mIndexFile->fileName());
+
+    QVERIFY(savedTutorialIndex.isUpToDate(mScriptFile->fileName()));
+    QVERIFY(savedTutorialIndex.isValid(mScriptFile->fileName()));
+    QCOMPARE(savedTutorialIndex.name(mScriptFile->fileName()),
+             QString("The name"));
+    QCOMPARE(savedTutorialIndex.description(mScriptFile->fileName()),
+             QString("The description"));
+}
+
+void TutorialIndexTest::testDestructorDoesNotSave() {
+    TutorialIndex* tutorialIndex = new TutorialIndex(mIndexFile->fileName());
+    tutorialIndex->insert(mScriptFile->fileName(), "javascript", 0);
+    delete tutorialIndex;
+
+    TutorialIndex savedTutorialIndex(mIndexFile->fileName());
+
+    QVERIFY(!savedTutorialIndex.isUpToDate(mScriptFile->fileName()));
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::scripting::TutorialIndexTest)
+
+#include "TutorialIndexTest.moc"
@@ -0,0 +1,301 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Daniel Calviño Sánchez <danxuliu@gmail.com>     *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; If not, see <http://www.gnu.org/licenses/>.  *
+ ***************************************************************************/
+
+
+#include <QTest>
+
+#define protected public
+#define private public
+#include "TutorialListFilterModel.h"
+#undef private
+#undef protected
+
+#include "TutorialListModel.h"
+#include "../Tutorial.h"
+#include "../TutorialInformation.h"
+#include "../TutorialManager.h"
+
+namespace ktutorial {
+namespace view {
+
+class TutorialListFilterModelTest: public QObject {
+Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void testConstructor();
+
+    void testSortByNameIgnoringCase();
+
+    void testSetFilterText();
+    void testSetFilterTextMatchingDescription();
+    void testSetFilterTextIgnoringCase();
+    void testSetFilterTextNarrowing();
+    void testSetFilterTextWidening();
+    void testSetFilterTextEmpty();
+
+    void testRegisterTutorialAfterSettingTheFilter();
+    void testUnregisterTutorialAfterSettingTheFilter();
+    void testChangeTutorialInformationAfterSettingTheFilter();
+    void testChangeTutorialNameWithoutFilter();
+
+    void testGetTutorialInformationForIndex();
+    void testGetTutorialInformationForIndexWithInvalidIndex();
+
+private:
+
+    TutorialManager* mTutorialManager;
+    TutorialInformation* mTutorialInformation1;
+    TutorialInformation* mTutorialInformation2;
+    TutorialInformation* mTutorialInformation3;
+    TutorialListModel* mTutorialListModel;
+    TutorialListFilterModel* mTutorialListFilterModel;
+
+    void registerTutorial(TutorialInformation* tutorialInformation,
+                          const QString& name, const QString& description);
+
+    void assertFilteredTutorials(
+                const QList<const TutorialInformation*>& tutorialInformations);
+
+};
+
+void TutorialListFilterModelTest::init() {
+    mTutorialManager = new TutorialManager();
+
+    mTutorialInformation1 = new TutorialInformation("tutorial1");
+    registerTutorial(mTutorialInformation1, "Using the editor",
+                     "Learn how to edit files");
+    mTutorialInformation2 = new TutorialInformation("tutorial2");
+    registerTutorial(mTutorialInformation2, "Printing",
+                     "Learn how to print the edited files");
+    mTutorialInformation3 = new TutorialInformation("tutorial3");
+    registerTutorial(mTutorialInformation3, "Configuration",
+                     "Change the settings");
+
+    mTutorialListModel = new TutorialListModel(mTutorialManager);
+    mTutorialListFilterModel = new TutorialListFilterModel(mTutorialListModel);
+}
+
+void TutorialListFilterModelTest::cleanup() {
+    delete mTutorialListFilterModel;
+    delete mTutorialListModel;
+    delete mTutorialManager;
+}
+
+void TutorialListFilterModelTest::testConstructor() {
+    TutorialListModel tutorialListModel(mTutorialManager);
+    TutorialListFilterModel tutorialListFilterModel(&tutorialListModel);
+
+    QCOMPARE(tutorialListFilterModel.sourceModel(),
+             (QAbstractItemModel*)&tutorialListModel);
+    QCOMPARE(tutorialListFilterModel.filterText(), QString(""));
+    QCOMPARE(tutorialListFilterModel.rowCount(), 3);
+}
+
+void TutorialListFilterModelTest::testSortByNameIgnoringCase() {
+    TutorialInformation* tutorialInformation0 =
+                                        new TutorialInformation("tutorial0");
+    registerTutorial(tutorialInformation0, "printing in colour", "");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3
+                                << mTutorialInformation2
+                                << tutorialInformation0
+                                << mTutorialInformation1);
+}
+
+void TutorialListFilterModelTest::testSetFilterText() {
+    mTutorialListFilterModel->setFilterText("print");
+
+    QCOMPARE(mTutorialListFilterModel->filterText(), QString("print"));
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2);
+}
+
+void TutorialListFilterModelTest::testSetFilterTextMatchingDescription() {
+    mTutorialListFilterModel->setFilterText("edit");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+}
+
+void TutorialListFilterModelTest::testSetFilterTextIgnoringCase() {
+    mTutorialListFilterModel->setFilterText("CONFIG");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3);
+}
+
+void TutorialListFilterModelTest::testSetFilterTextNarrowing() {
+    mTutorialListFilterModel->setFilterText("e");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+
+    mTutorialListFilterModel->setFilterText("ed");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+    QCOMPARE(mTutorialListFilterModel->mRejectedTutorials.count(), 1);
+    QVERIFY(mTutorialListFilterModel->mRejectedTutorials.contains(
+                                                        mTutorialInformation3));
+
+    mTutorialListFilterModel->setFilterText("edited");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2);
+    QCOMPARE(mTutorialListFilterModel->mRejectedTutorials.count(), 2);
+}
+
+void TutorialListFilterModelTest::testSetFilterTextWidening() {
+    mTutorialListFilterModel->setFilterText("edited");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2);
+
+    mTutorialListFilterModel->setFilterText("edit");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+
+    mTutorialListFilterModel->setFilterText("settings");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3);
+}
+
+void TutorialListFilterModelTest::testSetFilterTextEmpty() {
+    mTutorialListFilterModel->setFilterText("print");
+    mTutorialListFilterModel->setFilterText("");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+}
+
+void TutorialListFilterModelTest::testRegisterTutorialAfterSettingTheFilter() {
+    mTutorialListFilterModel->setFilterText("edit");
+
+    TutorialInformation* tutorialInformation0 =
+                                        new TutorialInformation("tutorial0");
+    registerTutorial(tutorialInformation0, "Editing images", "");
+    TutorialInformation* tutorialInformation4 =
+                                        new TutorialInformation("tutorial4");
+    registerTutorial(tutorialInformation4, "Exporting", "");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << tutorialInformation0
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+}
+
+void
+TutorialListFilterModelTest::testUnregisterTutorialAfterSettingTheFilter() {
+    mTutorialListFilterModel->setFilterText("edit");
+
+    delete mTutorialManager->unregisterTutorial("tutorial1");
+    delete mTutorialManager->unregisterTutorial("tutorial3");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation2);
+    QCOMPARE(mTutorialListFilterModel->mSearchTexts.count(), 1);
+    QVERIFY(mTutorialListFilterModel->mRejectedTutorials.isEmpty());
+}
+
+void TutorialListFilterModelTest::
+                        testChangeTutorialInformationAfterSettingTheFilter() {
+    mTutorialListFilterModel->setFilterText("edit");
+
+    mTutorialInformation3->setDescription("Edit the settings");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3
+                                << mTutorialInformation2
+                                << mTutorialInformation1);
+
+    mTutorialInformation1->setName("Using the text area");
+    mTutorialInformation1->setDescription("Learn how to write text");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation3
+                                << mTutorialInformation2);
+}
+
+void TutorialListFilterModelTest::testChangeTutorialNameWithoutFilter() {
+    mTutorialInformation1->setName("Advanced editing");
+
+    assertFilteredTutorials(QList<const TutorialInformation*>()
+                                << mTutorialInformation1
+                                << mTutorialInformation3
+                                << mTutorialInformation2);
+}
+
+void TutorialListFilterModelTest::testGetTutorialInformationForIndex() {
+    mTutorialListFilterModel->setFilterText("settings");
+
+    QModelIndex index = mTutorialListFilterModel->index(0, 0);
+    QCOMPARE(mTutorialListFilterModel->getTutorialInformationForIndex(index),
+             (const TutorialInformation*)mTutorialInformation3);
+}
+
+void TutorialListFilterModelTest::
+                        testGetTutorialInformationForIndexWithInvalidIndex() {
+    mTutorialListFilterModel->setFilterText("settings");
+
+    QModelIndex index = mTutorialListFilterModel->index(1, 0);
+    QCOMPARE(mTutorialListFilterModel->getTutorialInformationForIndex(index),
+             (const TutorialInformation*)0);
+}
+
+/////////////////////////////////// Helpers ////////////////////////////////////
+
+void TutorialListFilterModelTest::registerTutorial(
+                                    TutorialInformation* tutorialInformation,
+                                    const QString& name,
+                                    const QString& description) {
+    tutorialInformation->setName(name);
+    tutorialInformation->setDescription(description);
+    mTutorialManager->registerTutorial(new Tutorial(tutorialInformation));
+}
+
+void TutorialListFilterModelTest::assertFilteredTutorials(
+                const QList<const TutorialInformation*>& tutorialInformations) {
+    QCOMPARE(mTutorialListFilterModel->rowCount(),
+             tutorialInformations.count());
+    for (int i=0; i<tutorialInformations.count(); ++i) {
+        QModelIndex index = mTutorialListFilterModel->index(i, 0);
+        QCOMPARE(
+            mTutorialListFilterModel->getTutorialInformationForIndex(index),
+            tutorialInformations[i]);
+    }
+}
+
+}
+}
+
+QTEST_MAIN(ktutorial::view::TutorialListFilterModelTest)
+
+#include "TutorialListFilterModelTest.moc"
@@ -19,6 +19,8 @@
 
 #include <QTest>
 
+#include <QSignalSpy>
+
 #include <KLocalizedString>
 
 #define protected public
@@ -41,6 +43,10 @@ private slots:
 
     void testConstructor();
 
+    void testRegisterTutorialAfterCreatingTheModel();
+    void testUnregisterTutorialAfterCreatingTheModel();
+    void testChangeTutorialInformationAfterCreatingTheModel();
+
     void testRowCount();
     void testRowCountNoTutorials();
     void testRowCountWithAnIndex();
@@ -66,6 +72,95 @@ void TutorialListModelTest::testConstructor() {
     QCOMPARE(tutorialListModel.mTutorialManager, &tutorialManager);
 }
 
+void TutorialListModelTest::testRegisterTutorialAfterCreatingTheModel() {
+    TutorialManager tutorialManager;
+
+    Tutorial* tutorial1 = new Tutorial(new TutorialInformation("tutorial1"));
+    tutorialManager.registerTutorial(tutorial1);
+
+    TutorialListModel tutorialListModel(&tutorialManager);
+
+    //QModelIndex must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<QModelIndex>("QModelIndex");
+    QSignalSpy aboutToBeInsertedSpy(&tutorialListModel,
+                        SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)));
+    QSignalSpy insertedSpy(&tutorialListModel,
+                        SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    Tutorial* tutorial0 = new Tutorial(new TutorialInformation("tutorial0"));
+    tutorialManager.registerTutorial(tutorial0);
+
+    QCOMPARE(tutorialListModel.rowCount(), 2);
+    QCOMPARE(aboutToBeInsertedSpy.count(), 1);
+    QCOMPARE(aboutToBeInsertedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(aboutToBeInsertedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(tutorialListModel.getTutorialInformationForIndex(
+                                            tutorialListModel.index(0, 0)),
+             tutorial0->tutorialInformation());
+}
+
+void TutorialListModelTest::
+                        testChangeTutorialInformationAfterCreatingTheModel() {
+    TutorialManager tutorialManager;
+
+    Tutorial* tutorial0 = new Tutorial(new TutorialInformation("tutorial0"));
+    tutorialManager.registerTutorial(tutorial0);
+    Tutorial* tutorial1 = new Tutorial(new TutorialInformation("tutorial1"));
+    tutorialManager.registerTutorial(tutorial1);
+
+    TutorialListModel tutorialListModel(&tutorialManager);
+
+    //QModelIndex must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<QModelIndex>("QModelIndex");
+    QSignalSpy dataChangedSpy(&tutorialListModel,
+                        SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+
+    tutorial1->tutorialInformation()->setName("The name");
+
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QVariant argument = dataChangedSpy.at(0).at(0);
+    QCOMPARE(qvariant_cast<QModelIndex>(argument).row(), 1);
+    argument = dataChangedSpy.at(0).at(1);
+    QCOMPARE(qvariant_cast<QModelIndex>(argument).row(), 1);
+    QCOMPARE(tutorialListModel.data(tutorialListModel.index(1, 0),
+                                    Qt::DisplayRole).toString(),
+             QString("The name"));
+}
+
+void TutorialListModelTest::testUnregisterTutorialAfterCreatingTheModel() {
+    TutorialManager tutorialManager;
+
+    Tutorial* tutorial0 = new Tutorial(new TutorialInformation("tutorial0"));
+    tutorialManager.registerTutorial(tutorial0);
+    Tutorial* tutorial1 = new Tutorial(new TutorialInformation("tutorial1"));
+    tutorialManager.registerTutorial(tutorial1);
+
+    TutorialListModel tutorialListModel(&tutorialManager);
+
+    //QModelIndex must be registered in order to be used with QSignalSpy
+    qRegisterMetaType<QModelIndex>("QModelIndex");
+    QSignalSpy aboutToBeRemovedSpy(&tutorialListModel,
+                        SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)));
+    QSignalSpy removedSpy(&tutorialListModel,
+                        SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+    delete tutorialManager.unregisterTutorial("tutorial0");
+
+    QCOMPARE(tutorialListModel.rowCount(), 1);
+    QCOMPARE(aboutToBeRemovedSpy.count(), 1);
+    QCOMPARE(aboutToBeRemovedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(aboutToBeRemovedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(removedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(tutorialListModel.getTutorialInformationForIndex(
+                                            tutorialListModel.index(0, 0)),
+             tutorial1->tutorialInformation());
+}
+
 void TutorialListModelTest::testRowCount() {
     TutorialManager tutorialManager;
 
@@ -22,6 +22,7 @@
 #include <QtTest/QTestKeyClicksEvent>
 #include <qtest_kde.h>
 
+#include <KLineEdit>
 #include <KPushButton>
 
 #define protected public
@@ -56,6 +57,9 @@ private slots:
     void selectTutorial();
     void selectSeveralTutorials();
 
+    void filterTutorials();
+    void filterTutorialsHidingSelectedTutorial();
+
     void startTutorial();
     void startTutorialUsingEnterKey();
 
@@ -79,6 +83,8 @@ private:
     QAbstractItemView* tutorialList(
                             TutorialManagerDialog* tutorialManagerDialog);
 
+    KLineEdit* searchLineEdit(TutorialManagerDialog* tutorialManagerDialog);
+
     QLabel* descriptionLabel(TutorialManagerDialog* tutorialManagerDialog);
 
     KPushButton* startButton(TutorialManagerDialog* tutorialManagerDialog);
@@ -256,6 +262,53 @@ void TutorialManagerDialogTest::selectSeveralTutorials() {
              mTutorialInformation3);
 }
 
+void TutorialManagerDialogTest::filterTutorials() {
+    mTutorialManager->registerTutorial(mTutorial1);
+    mTutorialManager->registerTutorial(mTutorial2);
+    mTutorialManager->registerTutorial(mTutorial3);
+
+    mTutorialManagerDialog->show();
+
+    QTest::qWaitForWindowShown(mTutorialManagerDialog);
+
+    QTest::keyClicks(searchLineEdit(mTutorialManagerDialog), "IR");
+
+    QAbstractItemModel* model = tutorialList(mTutorialManagerDialog)->model();
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->data(model->index(0, 0)).toString(),
+             QString("First tutorial"));
+    QCOMPARE(model->data(model->index(1, 0)).toString(),
+             QString("Third tutorial"));
+}
+
+void TutorialManagerDialogTest::filterTutorialsHidingSelectedTutorial() {
+    mTutorialManager->registerTutorial(mTutorial1);
+    mTutorialManager->registerTutorial(mTutorial2);
+    mTutorialManager->registerTutorial(mTutorial3);
+
+    mTutorialManagerDialog->show();
+
+    QTest::qWaitForWindowShown(mTutorialManagerDialog);
+
+    QItemSelectionModel* selectionModel =
+                        tutorialList(mTutorialManagerDialog)->selectionModel();
+    selectionModel->select(selectionModel->model()->index(1, 0),
+                           QItemSelectionModel::Select);
+
+    QCOMPARE(mTutorialManagerDialog->mCurrentTutorialInformation,
+             mTutorialInformation2);
+    QVERIFY(startButton(mTutorialManagerDialog)->isEnabled());
+
+    QTest::keyClicks(searchLineEdit(mTutorialManagerDialog), "third");
+
+    QCOMPARE(tutorialList(mTutorialManagerDialog)->model()->rowCount(), 1);
+    QCOMPARE(selectionModel->selectedRows().count(), 0);
+    QCOMPARE(mTutorialManagerDialog->mCurrentTutorialInformation,
+             (const TutorialInformation*)0);
+    QCOMPARE(descriptionLabel(mTutorialManagerDialog)->text(), QString(""));
+    QVERIFY(!startButton(mTutorialManagerDialog)->isEnabled());
+}
+
 void TutorialManagerDialogTest::startTutorial() {
     mTutorialManager->registerTutorial(mTutorial1);
     mTutorialManager->registerTutorial(mTutorial2);
@@ -355,6 +408,11 @@ QAbstractItemView* TutorialManagerDialogTest::tutorialList(
     return tutorialManagerDialog->ui->tutorialsList;
 }
 
+KLineEdit* TutorialManagerDialogTest::searchLineEdit(
+                                TutorialManagerDialog* tutorialManagerDialog) {
+    return tutorialManagerDialog->ui->searchLineEdit;
+}
+
 QLabel* TutorialManagerDialogTest::descriptionLabel(
                                 TutorialManagerDialog* tutorialManagerDialog) {
     return tutorialManagerDialog->ui->descriptionLabel;